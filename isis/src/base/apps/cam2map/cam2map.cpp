@@ -2,11 +2,13 @@
 
 #include "Camera.h"
 #include "CubeAttribute.h"
+#include "FileName.h"
 #include "IException.h"
 #include "IString.h"
 #include "ProjectionFactory.h"
 #include "PushFrameCameraDetectorMap.h"
 #include "Pvl.h"
+#include "SerialNumber.h"
 #include "Target.h"
 #include "TProjection.h"
 
@@ -255,6 +257,49 @@ namespace Isis {
     // Output the mapping group used to the Gui session log
     PvlGroup cleanMapping = outmap->Mapping();
 
+    // Use the lookup grids in place of the camera model if the user has them
+    GeometryLookup *lookup = NULL;
+    if (ui.WasEntered("LOOKUP")) {
+      if (!incam->IsBandIndependent()) {
+        QString msg = "The camera model of [" + icube->fileName() + "] is band dependent "
+                      "and can not be projected with a lookup cube";
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+
+      Cube lookupCube(ui.GetCubeName("LOOKUP"), "r");
+      lookup = new GeometryLookup(lookupCube);
+      if (lookup->Samples() != icube->sampleCount() || lookup->Lines() != icube->lineCount()) {
+        QString msg = "The lookup cube [" + ui.GetCubeName("LOOKUP") + "] was made from an "
+                      "image with [" + toString(lookup->Samples()) + "] samples and [" +
+                      toString(lookup->Lines()) + "] lines, the input cube has [" +
+                      toString(icube->sampleCount()) + "] samples and [" +
+                      toString(icube->lineCount()) + "] lines";
+        delete lookup;
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+
+      // The grids must describe this image, not another one of the same size.
+      // Lookup cubes without a serial number are matched by file name.
+      QString serialNumber = SerialNumber::Compose(*icube);
+      QString fromName = FileName(icube->fileName()).name();
+      bool matches = true;
+      if (!lookup->ImageSerialNumber().isEmpty() && lookup->ImageSerialNumber() != "Unknown" &&
+          serialNumber != "Unknown") {
+        matches = (lookup->ImageSerialNumber() == serialNumber);
+      }
+      else if (!lookup->From().isEmpty()) {
+        matches = (lookup->From() == fromName);
+      }
+      if (!matches) {
+        QString msg = "The lookup cube [" + ui.GetCubeName("LOOKUP") + "] was made from [" +
+                      lookup->From() + "] with serial number [" +
+                      lookup->ImageSerialNumber() + "], not from the input cube [" +
+                      fromName + "] with serial number [" + serialNumber + "]";
+        delete lookup;
+        throw IException(IException::User, msg, _FILEINFO_);
+      }
+    }
+
     // Allocate the output cube and add the mapping labels
     QString fname = ui.GetCubeName("TO");
     Isis::CubeAttributeOutput &atts = ui.GetOutputAttribute("TO");
@@ -304,19 +349,31 @@ namespace Isis {
       ocube->putGroup(alpha);
     }
 
+    auto forwardTransform = [&]() -> Transform * {
+      if (lookup) {
+        return new lookup2mapForward(icube->sampleCount(), icube->lineCount(), lookup,
+                                     samples, lines, outmap, trim);
+      }
+      return new cam2mapForward(icube->sampleCount(), icube->lineCount(), incam,
+                                samples, lines, outmap, trim);
+    };
+
+    auto reverseTransform = [&]() -> Transform * {
+      if (lookup) {
+        return new lookup2mapReverse(icube->sampleCount(), icube->lineCount(), lookup,
+                                     samples, lines, outmap, trim);
+      }
+      return new cam2mapReverse(icube->sampleCount(), icube->lineCount(), incam,
+                                samples, lines, outmap, trim, occlusion);
+    };
+
     // We will need a transform class
     Transform *transform = 0;
 
     // Okay we need to decide how to apply the rubbersheeting for the transform
     // Does the user want to define how it is done?
     if (ui.GetString("WARPALGORITHM") == "FORWARDPATCH") {
-      transform = new cam2mapForward(icube->sampleCount(),
-                                     icube->lineCount(),
-                                     incam,
-                                     samples,
-                                     lines,
-                                     outmap,
-                                     trim);
+      transform = forwardTransform();
 
       int patchSize = ui.GetInteger("PATCHSIZE");
       if (patchSize <= 1) {
@@ -328,9 +385,7 @@ namespace Isis {
     }
 
     else if (ui.GetString("WARPALGORITHM") == "REVERSEPATCH") {
-      transform = new cam2mapReverse(icube->sampleCount(),
-                                     icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+      transform = reverseTransform();
 
       int patchSize = ui.GetInteger("PATCHSIZE");
       int minPatchSize = 4;
@@ -346,9 +401,7 @@ namespace Isis {
     // Handle framing cameras.  Always process using the backward
     // driven system (tfile).
     else if (incam->GetCameraType() == Camera::Framing) {
-      transform = new cam2mapReverse(icube->sampleCount(),
-                                     icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+      transform = reverseTransform();
       p.SetTiling(4, 4);
       p.StartProcess(*transform, *interp);
     }
@@ -361,9 +414,7 @@ namespace Isis {
     // to determine patch size based on 1) if the limb is in the file
     // or 2) if the DTM is much coarser than the image
     else if (incam->GetCameraType() == Camera::LineScan) {
-      transform = new cam2mapForward(icube->sampleCount(),
-                                     icube->lineCount(), incam, samples,lines,
-                                     outmap, trim);
+      transform = forwardTransform();
 
       p.processPatchTransform(*transform, *interp);
     }
@@ -378,9 +429,7 @@ namespace Isis {
     // TODO: What about the THEMIS VIS Camera.  Will tall narrow (128x4) patches
     // work okay?
     else if (incam->GetCameraType() == Camera::PushFrame) {
-      transform = new cam2mapForward(icube->sampleCount(),
-                                     icube->lineCount(), incam, samples,lines,
-                                     outmap, trim);
+      transform = forwardTransform();
 
       // Get the frame height
       PushFrameCameraDetectorMap *dmap = (PushFrameCameraDetectorMap *) incam->DetectorMap();
@@ -417,9 +466,7 @@ namespace Isis {
     // types have not be analyized.  This includes Radar and Point.  Continue to
     // use the reverse geom option with the default tiling hints
     else {
-      transform = new cam2mapReverse(icube->sampleCount(),
-                                     icube->lineCount(), incam, samples,lines,
-                                     outmap, trim, occlusion);
+      transform = reverseTransform();
 
       int tileStart, tileEnd;
       incam->GetGeometricTilingHint(tileStart, tileEnd);
@@ -440,6 +487,7 @@ namespace Isis {
     delete outmap;
     delete transform;
     delete interp;
+    delete lookup;
   }
 
   // Transform object constructor
@@ -567,6 +615,119 @@ namespace Isis {
     return p_outputLines;
   }
 
+  // Transform object constructor
+  lookup2mapForward::lookup2mapForward(const int inputSamples, const int inputLines,
+                                       GeometryLookup *lookup, const int outputSamples,
+                                       const int outputLines, TProjection *outmap,
+                                       bool trim) {
+    p_inputSamples = inputSamples;
+    p_inputLines = inputLines;
+    p_lookup = lookup;
+
+    p_outputSamples = outputSamples;
+    p_outputLines = outputLines;
+    p_outmap = outmap;
+
+    p_trim = trim;
+  }
+
+  // Transform method mapping input line/samps to lat/lons to output line/samps
+  bool lookup2mapForward::Xform(double &outSample, double &outLine,
+                                const double inSample, const double inLine) {
+    // See if the input image coordinate converts to a lat/lon
+    if (!p_lookup->SetImage(inSample, inLine)) return false;
+
+    // Does that ground coordinate work in the map projection
+    double lat = p_lookup->UniversalLatitude();
+    double lon = p_lookup->UniversalLongitude();
+    if (!p_outmap->SetUniversalGround(lat, lon)) return false;
+
+    // See if we should trim
+    if ((p_trim) && (p_outmap->HasGroundRange())) {
+      if (p_outmap->Latitude() < p_outmap->MinimumLatitude()) return false;
+      if (p_outmap->Latitude() > p_outmap->MaximumLatitude()) return false;
+      if (p_outmap->Longitude() < p_outmap->MinimumLongitude()) return false;
+      if (p_outmap->Longitude() > p_outmap->MaximumLongitude()) return false;
+    }
+
+    // Get the output sample/line coordinate
+    outSample = p_outmap->WorldX();
+    outLine = p_outmap->WorldY();
+
+    // Make sure the point is inside the output image
+    if (outSample < 0.5) return false;
+    if (outLine < 0.5) return false;
+    if (outSample > p_outputSamples + 0.5) return false;
+    if (outLine > p_outputLines + 0.5) return false;
+
+    // Everything is good
+    return true;
+  }
+
+  int lookup2mapForward::OutputSamples() const {
+    return p_outputSamples;
+  }
+
+  int lookup2mapForward::OutputLines() const {
+    return p_outputLines;
+  }
+
+
+  // Transform object constructor
+  lookup2mapReverse::lookup2mapReverse(const int inputSamples, const int inputLines,
+                                       GeometryLookup *lookup, const int outputSamples,
+                                       const int outputLines, TProjection *outmap,
+                                       bool trim) {
+    p_inputSamples = inputSamples;
+    p_inputLines = inputLines;
+    p_lookup = lookup;
+
+    p_outputSamples = outputSamples;
+    p_outputLines = outputLines;
+    p_outmap = outmap;
+
+    p_trim = trim;
+  }
+
+  // Transform method mapping output line/samps to lat/lons to input line/samps
+  bool lookup2mapReverse::Xform(double &inSample, double &inLine,
+                                const double outSample, const double outLine) {
+    // See if the output image coordinate converts to lat/lon
+    if (!p_outmap->SetWorld(outSample, outLine)) return false;
+
+    // See if we should trim
+    if ((p_trim) && (p_outmap->HasGroundRange())) {
+      if (p_outmap->Latitude() < p_outmap->MinimumLatitude()) return false;
+      if (p_outmap->Latitude() > p_outmap->MaximumLatitude()) return false;
+      if (p_outmap->Longitude() < p_outmap->MinimumLongitude()) return false;
+      if (p_outmap->Longitude() > p_outmap->MaximumLongitude()) return false;
+    }
+
+    // Get the universal lat/lon and see if it can be converted to input line/samp
+    double lat = p_outmap->UniversalLatitude();
+    double lon = p_outmap->UniversalLongitude();
+    if (!p_lookup->SetUniversalGround(lat, lon)) return false;
+
+    // Make sure the point is inside the input image
+    if (p_lookup->Sample() < 0.5) return false;
+    if (p_lookup->Line() < 0.5) return false;
+    if (p_lookup->Sample() > p_inputSamples + 0.5) return false;
+    if (p_lookup->Line() > p_inputLines + 0.5) return false;
+
+    // Everything is good
+    inSample = p_lookup->Sample();
+    inLine = p_lookup->Line();
+    return true;
+  }
+
+  int lookup2mapReverse::OutputSamples() const {
+    return p_outputSamples;
+  }
+
+  int lookup2mapReverse::OutputLines() const {
+    return p_outputLines;
+  }
+
   void bandChange(const int band) {
     incam->SetBand(band);
   }
@@ -2,6 +2,7 @@
 #define cam2map_h
 
 #include "Application.h"
+#include "GeometryLookup.h"
 #include "TProjection.h"
 #include "Transform.h"
 #include "UserInterface.h"
@@ -83,6 +84,78 @@ namespace Isis {
       int OutputSamples() const;
       int OutputLines() const;
   };
+
+  /**
+   * Maps output pixels to the input image through the ground to image grid
+   * of a geometry lookup cube instead of the camera model.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class lookup2mapReverse : public Transform {
+    private:
+      GeometryLookup *p_lookup;
+      TProjection *p_outmap;
+      int p_inputSamples;
+      int p_inputLines;
+      bool p_trim;
+      int p_outputSamples;
+      int p_outputLines;
+
+    public:
+      // constructor
+      lookup2mapReverse(const int inputSamples, const int inputLines,
+                        GeometryLookup *lookup,
+                        const int outputSamples, const int outputLines,
+                        TProjection *outmap,
+                        bool trim);
+
+      // destructor
+      ~lookup2mapReverse() {};
+
+      // Implementations for parent's pure virtual members
+      bool Xform(double &inSample, double &inLine,
+                 const double outSample, const double outLine);
+      int OutputSamples() const;
+      int OutputLines() const;
+  };
+
+  /**
+   * Maps input pixels to the output map through the image to ground grid of
+   * a geometry lookup cube instead of the camera model.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class lookup2mapForward : public Transform {
+    private:
+      GeometryLookup *p_lookup;
+      TProjection *p_outmap;
+      int p_inputSamples;
+      int p_inputLines;
+      bool p_trim;
+      int p_outputSamples;
+      int p_outputLines;
+
+    public:
+      // constructor
+      lookup2mapForward(const int inputSamples, const int inputLines,
+                        GeometryLookup *lookup,
+                        const int outputSamples, const int outputLines,
+                        TProjection *outmap,
+                        bool trim);
+
+      // destructor
+      ~lookup2mapForward() {};
+
+      // Implementations for parent's pure virtual members
+      bool Xform(double &outSample, double &outLine,
+                 const double inSample, const double inLine);
+      int OutputSamples() const;
+      int OutputLines() const;
+  };
 }
 
 #endif
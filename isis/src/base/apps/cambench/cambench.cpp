@@ -0,0 +1,301 @@
+#include "cambench.h"
+
+#include <cmath>
+#include <fstream>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QStringList>
+
+#include <nlohmann/json.hpp>
+
+#include "Camera.h"
+#include "CameraDistortionMap.h"
+#include "Cube.h"
+#include "FileList.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+#include "SpecialPixel.h"
+
+using namespace std;
+using json = nlohmann::json;
+
+namespace Isis {
+
+  namespace {
+    //! A pixel of the sweep and the ground point it maps to
+    struct SweepPoint {
+      double sample;
+      double line;
+      double lat;
+      double lon;
+    };
+
+    //! The image coordinates the ground points map back to, Null if they fail
+    struct SweepResult {
+      vector<double> samples;
+      vector<double> lines;
+      json timing;
+    };
+
+    QString cameraTypeName(Camera *cam) {
+      switch (cam->GetCameraType()) {
+        case Camera::Framing:
+          return "Framing";
+        case Camera::PushFrame:
+          return "PushFrame";
+        case Camera::LineScan:
+          return "LineScan";
+        case Camera::Radar:
+          return "Radar";
+        case Camera::Point:
+          return "Point";
+        case Camera::RollingShutter:
+          return "RollingShutter";
+        case Camera::Csm:
+          return "Csm";
+      }
+      return "Unknown";
+    }
+
+
+    json rate(int calls, int succeeded, qint64 nanoseconds) {
+      double seconds = nanoseconds / 1.0e9;
+      json result;
+      result["calls"] = calls;
+      result["succeeded"] = succeeded;
+      result["seconds"] = seconds;
+      result["perSecond"] = (seconds > 0.0) ? calls / seconds : 0.0;
+      return result;
+    }
+
+
+    /**
+     * Maps the sweep pixels to the ground, then maps the ground points back
+     * to the image, timing both directions.
+     */
+    SweepResult sweep(Camera *cam, vector<SweepPoint> &points, bool setPoints) {
+      SweepResult result;
+      QElapsedTimer timer;
+
+      int succeeded = 0;
+      timer.start();
+      for (SweepPoint &point : points) {
+        if (cam->SetImage(point.sample, point.line)) {
+          succeeded++;
+          if (setPoints) {
+            point.lat = cam->UniversalLatitude();
+            point.lon = cam->UniversalLongitude();
+          }
+        }
+      }
+      result.timing["setImage"] = rate(points.size(), succeeded, timer.nsecsElapsed());
+
+      int calls = 0;
+      succeeded = 0;
+      timer.start();
+      for (const SweepPoint &point : points) {
+        double sample = Null;
+        double line = Null;
+        if (point.lat != Null) {
+          calls++;
+          if (cam->SetUniversalGround(point.lat, point.lon)) {
+            succeeded++;
+            sample = cam->Sample();
+            line = cam->Line();
+          }
+        }
+        result.samples.push_back(sample);
+        result.lines.push_back(line);
+      }
+      result.timing["setGround"] = rate(calls, succeeded, timer.nsecsElapsed());
+
+      // Round trip error of the pixels that mapped both ways
+      double maximum = 0.0;
+      double sum = 0.0;
+      int count = 0;
+      for (int i = 0; i < (int) points.size(); i++) {
+        if (result.samples[i] == Null) continue;
+        double error = hypot(result.samples[i] - points[i].sample,
+                             result.lines[i] - points[i].line);
+        maximum = max(maximum, error);
+        sum += error;
+        count++;
+      }
+      result.timing["roundTrip"]["points"] = count;
+      result.timing["roundTrip"]["maximum"] = maximum;
+      result.timing["roundTrip"]["mean"] = (count > 0) ? sum / count : 0.0;
+      return result;
+    }
+
+
+    /**
+     * Benchmarks the camera of one cube.  Returns false if an accelerated
+     * mode differed from the original by more than the tolerance.
+     */
+    bool benchmark(const QString &fileName, UserInterface &ui, json &report, Pvl *log) {
+      int samples = ui.GetInteger("SAMPLES");
+      int lines = ui.GetInteger("LINES");
+      double tolerance = ui.GetDouble("TOLERANCE");
+
+      report["file"] = fileName.toStdString();
+      PvlGroup results("Results");
+      results += PvlKeyword("From", fileName);
+
+      Cube cube(fileName, "r");
+      QElapsedTimer timer;
+      timer.start();
+      Camera *cam = cube.camera();
+      report["loadSeconds"] = timer.nsecsElapsed() / 1.0e9;
+      report["instrument"] = cam->instrumentId().toStdString();
+      report["spacecraft"] = cam->spacecraftNameShort().toStdString();
+      report["cameraType"] = cameraTypeName(cam).toStdString();
+      results += PvlKeyword("InstrumentId", cam->instrumentId());
+
+      // Pixel centers evenly spread over the image
+      vector<SweepPoint> points;
+      for (int l = 0; l < lines; l++) {
+        for (int s = 0; s < samples; s++) {
+          SweepPoint point;
+          point.sample = 0.5 + cube.sampleCount() * (s + 0.5) / samples;
+          point.line = 0.5 + cube.lineCount() * (l + 0.5) / lines;
+          point.lat = Null;
+          point.lon = Null;
+          points.push_back(point);
+        }
+      }
+
+      // The original models are measured without the inverse distortion grid
+      // that the InverseDistortionGrid preference builds
+      CameraDistortionMap *distortionMap = cam->DistortionMap();
+      if (distortionMap) {
+        distortionMap->ClearInverseGrid();
+      }
+
+      SweepResult original = sweep(cam, points, true);
+      report["original"] = original.timing;
+      results += PvlKeyword("SetImageRate",
+                            toString((double) original.timing["setImage"]["perSecond"]),
+                            "calls/second");
+      results += PvlKeyword("SetGroundRate",
+                            toString((double) original.timing["setGround"]["perSecond"]),
+                            "calls/second");
+      results += PvlKeyword("MaximumRoundTripError",
+                            toString((double) original.timing["roundTrip"]["maximum"]),
+                            "pixels");
+
+      bool withinTolerance = true;
+      if (ui.GetBoolean("ACCELERATED") && distortionMap) {
+        timer.start();
+        bool built = distortionMap->BuildInverseGrid();
+        double buildSeconds = timer.nsecsElapsed() / 1.0e9;
+
+        if (built) {
+          SweepResult grid = sweep(cam, points, false);
+          distortionMap->ClearInverseGrid();
+
+          // Compare the accelerated ground to image mapping with the original
+          double difference = 0.0;
+          int mismatched = 0;
+          for (int i = 0; i < (int) points.size(); i++) {
+            if ((original.samples[i] == Null) != (grid.samples[i] == Null)) {
+              mismatched++;
+            }
+            else if (original.samples[i] != Null) {
+              difference = max(difference, hypot(grid.samples[i] - original.samples[i],
+                                                 grid.lines[i] - original.lines[i]));
+            }
+          }
+          withinTolerance = (difference <= tolerance && mismatched == 0);
+
+          json accelerated = grid.timing;
+          accelerated["mode"] = "InverseDistortionGrid";
+          accelerated["buildSeconds"] = buildSeconds;
+          accelerated["maximumDifference"] = difference;
+          accelerated["mismatchedPoints"] = mismatched;
+          accelerated["withinTolerance"] = withinTolerance;
+          report["accelerated"] = accelerated;
+
+          results += PvlKeyword("AcceleratedSetGroundRate",
+                                toString((double) grid.timing["setGround"]["perSecond"]),
+                                "calls/second");
+          results += PvlKeyword("MaximumAcceleratedDifference", toString(difference), "pixels");
+        }
+      }
+
+      log->addGroup(results);
+      return withinTolerance;
+    }
+  }
+
+
+  /**
+   * Sweeps a grid of pixels through the camera of each input cube, timing
+   * image to ground and ground to image mapping and measuring the round trip
+   * error, and compares the accelerated modes with the original models.
+   *
+   * @param ui The user interface to parse the parameters from
+   * @param log The Pvl that the results are written to
+   */
+  void cambench(UserInterface &ui, Pvl *log) {
+    FileList cubes;
+    if (ui.WasEntered("FROMLIST")) {
+      cubes.read(FileName(ui.GetFileName("FROMLIST")));
+    }
+    if (ui.WasEntered("FROM")) {
+      cubes.append(FileName(ui.GetCubeName("FROM")));
+    }
+    if (cubes.empty()) {
+      QString msg = "At least one cube must be entered with FROM or FROMLIST";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    json report;
+    report["samples"] = ui.GetInteger("SAMPLES");
+    report["lines"] = ui.GetInteger("LINES");
+    report["tolerance"] = ui.GetDouble("TOLERANCE");
+    report["cameras"] = json::array();
+
+    Progress progress;
+    progress.SetText("Benchmarking cameras");
+    progress.SetMaximumSteps(cubes.size());
+    progress.CheckStatus();
+
+    QStringList exceeded;
+    for (const FileName &cube : cubes) {
+      QString fileName = cube.expanded();
+      json camera;
+      try {
+        if (!benchmark(fileName, ui, camera, log)) {
+          exceeded.append(fileName);
+        }
+      }
+      catch (IException &e) {
+        // Keep going so one bad cube does not hide the others
+        camera["file"] = fileName.toStdString();
+        camera["error"] = e.toString().toStdString();
+      }
+      report["cameras"].push_back(camera);
+      progress.CheckStatus();
+    }
+
+    QString toName = FileName(ui.GetFileName("TO")).expanded();
+    std::ofstream output(toName.toStdString());
+    if (!output) {
+      QString msg = "Unable to open [" + toName + "] for writing";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    output << report.dump(2) << std::endl;
+    output.close();
+
+    if (!exceeded.empty()) {
+      QString msg = "The accelerated camera models of [" + exceeded.join(", ") +
+                    "] differ from the original models by more than the tolerance of [" +
+                    toString(ui.GetDouble("TOLERANCE")) + "] pixels";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+  }
+}
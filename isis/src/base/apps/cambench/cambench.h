@@ -0,0 +1,11 @@
+#ifndef cambench_h
+#define cambench_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void cambench(UserInterface &ui, Pvl *log);
+}
+
+#endif
@@ -0,0 +1,61 @@
+#include "camlookup.h"
+
+#include "Camera.h"
+#include "Cube.h"
+#include "FileName.h"
+#include "GeometryLookup.h"
+#include "IException.h"
+#include "IString.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+#include "SerialNumber.h"
+#include "Target.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Computes the image to ground and ground to image lookup grids of the
+   * camera of a cube and writes them to a lookup cube, which cam2map can
+   * project the cube with instead of the camera model.
+   *
+   * @param ui The user interface to parse the parameters from
+   * @param log The Pvl that the results are written to
+   */
+  void camlookup(UserInterface &ui, Pvl *log) {
+    QString fromName = ui.GetCubeName("FROM");
+    Cube icube(fromName, "r");
+    Camera *cam = icube.camera();
+
+    if (cam->target()->isSky()) {
+      QString msg = "The image [" + fromName + "] is targeting the sky";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    if (!cam->IsBandIndependent()) {
+      QString msg = "The camera model of [" + fromName + "] is band dependent, a lookup "
+                    "cube holds the geometry of a single band";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    Progress progress;
+    GeometryLookup lookup(cam, icube.sampleCount(), icube.lineCount(),
+                          ui.GetInteger("SPACING"), &progress);
+
+    Cube ocube;
+    ocube.setDimensions(lookup.SampleNodes(), lookup.LineNodes(), 3);
+    ocube.setPixelType(Real);
+    ocube.create(FileName(ui.GetCubeName("TO")).expanded());
+    lookup.write(ocube, FileName(fromName).name(), SerialNumber::Compose(icube));
+    ocube.close();
+    icube.close();
+
+    PvlGroup results("Results");
+    results += PvlKeyword("SampleNodes", toString(lookup.SampleNodes()));
+    results += PvlKeyword("LineNodes", toString(lookup.LineNodes()));
+    results += PvlKeyword("Spacing", toString(lookup.Spacing()), "pixels");
+    if (log) {
+      log->addGroup(results);
+    }
+  }
+}
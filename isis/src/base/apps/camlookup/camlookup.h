@@ -0,0 +1,11 @@
+#ifndef camlookup_h
+#define camlookup_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void camlookup(UserInterface &ui, Pvl *log=nullptr);
+}
+
+#endif
@@ -0,0 +1,155 @@
+#include "compacthist.h"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include <QByteArray>
+#include <QFile>
+#include <QFileInfo>
+
+#include "Cube.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+
+using namespace std;
+
+namespace Isis {
+
+  namespace {
+    //! A blob stored in the cube file after the labels and DN data
+    struct StoredBlob {
+      PvlObject *object;
+      BigInt startByte;
+      QByteArray data;
+    };
+
+    /**
+     * Reads the data of an attached blob, including any chunks appended to it
+     * after it was written.
+     */
+    QByteArray readBlobData(fstream &stream, const PvlObject &object) {
+      vector<BigInt> startBytes(1, (BigInt) object["StartByte"]);
+      vector<int> nbytes(1, (int) object["Bytes"]);
+      if (object.hasKeyword("ChunkStartBytes")) {
+        const PvlKeyword &chunkStartBytes = object["ChunkStartBytes"];
+        const PvlKeyword &chunkBytes = object["ChunkBytes"];
+        if (chunkStartBytes.size() != chunkBytes.size()) {
+          QString msg = "The ChunkStartBytes and ChunkBytes keywords of " + object.name() +
+                        " [" + (QString) object["Name"] + "] have different sizes";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
+        for (int i = 0; i < chunkStartBytes.size(); i++) {
+          startBytes.push_back(toBigInt(chunkStartBytes[i]));
+          nbytes.push_back(toInt(chunkBytes[i]));
+        }
+      }
+
+      QByteArray data;
+      for (size_t i = 0; i < startBytes.size(); i++) {
+        QByteArray part(nbytes[i], '\0');
+        stream.seekg(startBytes[i] - 1, ios::beg);
+        stream.read(part.data(), nbytes[i]);
+        if (!stream.good()) {
+          QString msg = "Unable to read " + object.name() + " [" + (QString) object["Name"] + "]";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+        data.append(part);
+      }
+      return data;
+    }
+  }
+
+
+  /**
+   * Rewrites the blobs of a cube with attached labels end to end after the
+   * DN data. Appended History entries are merged into their History blob, and
+   * the space left by blobs that were rewritten elsewhere in the file is
+   * removed.
+   *
+   * @param ui The user interface to parse the parameters from
+   * @param log The Pvl that the Results group is added to
+   */
+  void compacthist(UserInterface &ui, Pvl *log) {
+    QString fileName = FileName(ui.GetCubeName("FROM")).expanded();
+    BigInt originalBytes = QFileInfo(fileName).size();
+
+    Cube cube;
+    cube.open(fileName, "rw");
+    if (!cube.labelsAttached()) {
+      QString msg = "Cube [" + fileName + "] has detached labels. Only cubes with "
+                    "attached labels can be compacted";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    fstream stream(fileName.toLatin1().data(), ios::in | ios::out | ios::binary);
+    if (!stream) {
+      QString msg = "Unable to open cube [" + fileName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    // Read every blob stored in the cube file before moving any of them
+    Pvl &label = *cube.label();
+    vector<StoredBlob> blobs;
+    for (int i = 0; i < label.objects(); i++) {
+      PvlObject &object = label.object(i);
+      if (object.hasKeyword("StartByte") && object.hasKeyword("Bytes") &&
+          !object.hasKeyword("^" + object.name())) {
+        StoredBlob blob;
+        blob.object = &object;
+        blob.startByte = object["StartByte"];
+        blob.data = readBlobData(stream, object);
+        blobs.push_back(blob);
+      }
+    }
+
+    BigInt compactedBytes = originalBytes;
+    if (!blobs.empty()) {
+      stable_sort(blobs.begin(), blobs.end(),
+                  [](const StoredBlob &a, const StoredBlob &b) {
+                    return a.startByte < b.startByte;
+                  });
+
+      // The first blob starts right after the labels and DN data, which may be
+      // before the first stored blob if that one was rewritten elsewhere
+      BigInt startByte = (BigInt) cube.labelSize() + cube.dataSize() + 1;
+      stream.seekp(startByte - 1, ios::beg);
+      for (StoredBlob &blob : blobs) {
+        stream.write(blob.data.constData(), blob.data.size());
+        if (!stream.good()) {
+          QString msg = "Unable to write " + blob.object->name() + " [" +
+                        (QString) (*blob.object)["Name"] + "]";
+          throw IException(IException::Io, msg, _FILEINFO_);
+        }
+
+        (*blob.object)["StartByte"] = toString(startByte);
+        (*blob.object)["Bytes"] = toString(blob.data.size());
+        if (blob.object->hasKeyword("ChunkStartBytes")) {
+          blob.object->deleteKeyword("ChunkStartBytes");
+          blob.object->deleteKeyword("ChunkBytes");
+        }
+        startByte += blob.data.size();
+      }
+      compactedBytes = startByte - 1;
+    }
+    stream.close();
+    cube.close();
+
+    if (compactedBytes < originalBytes && !QFile::resize(fileName, compactedBytes)) {
+      QString msg = "Unable to truncate cube [" + fileName + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    PvlGroup results("Results");
+    results += PvlKeyword("Blobs", toString((int) blobs.size()));
+    results += PvlKeyword("OriginalBytes", toString(originalBytes));
+    results += PvlKeyword("CompactedBytes", toString(compactedBytes));
+    if (log) {
+      log->addGroup(results);
+    }
+  }
+}
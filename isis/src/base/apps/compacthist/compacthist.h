@@ -0,0 +1,11 @@
+#ifndef compacthist_h
+#define compacthist_h
+
+#include "Pvl.h"
+#include "UserInterface.h"
+
+namespace Isis {
+  extern void compacthist(UserInterface &ui, Pvl *log);
+}
+
+#endif
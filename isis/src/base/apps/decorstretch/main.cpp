@@ -1,28 +1,35 @@
 #include "Isis.h"
 
+#include "Brick.h"
 #include "GaussianStretch.h"
 #include "PrincipalComponentAnalysis.h"
 #include "ProcessBySpectra.h"
+#include "Progress.h"
 #include "Statistics.h"
 
+#include <algorithm>
 #include <iomanip>
+#include <vector>
 
-//Third-party matrix library
-#include "tnt_array2d.h"
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
 
 using namespace std;
 using namespace Isis;
 
-void getData(Buffer &in);
+void getData(Buffer &in, PrincipalComponentAnalysis &brickPca);
 void transform(Buffer &in, Buffer &out);
 void normalizeAndInvert(Buffer &in, Buffer &out);
 
 PrincipalComponentAnalysis pca(0);
 vector<GaussianStretch *> stretches;
+int sampleIncrement, lineIncrement;
 
 QString tmpFileName = "Temporary_DecorrelationStretch_Transform.cub";
 
 void IsisMain() {
+  UserInterface &ui = Application::GetUserInterface();
   ProcessByBrick p;
   Cube *icube = p.SetInputCube("FROM");
   int numDimensions = icube->bandCount();
@@ -36,16 +43,42 @@ void IsisMain() {
 
   // Get the data for the transform matrix
   pca = Isis::PrincipalComponentAnalysis(numDimensions);
-  ProcessByBrick p2;
-  p2.SetBrickSize(128, 128, numDimensions);
-  p2.SetInputCube("FROM");
-  p2.Progress()->SetText("Computing transform");
-  p2.StartProcess(getData);
-  p2.EndProcess();
+  sampleIncrement = ui.GetInteger("SINC");
+  lineIncrement = ui.GetInteger("LINC");
+
+  // Accumulate the bricks a batch at a time, each brick on its own, and merge
+  //   each batch in brick order, so the sums do not depend on the threads and
+  //   only one batch of partial sums is kept
+  Brick brick(*icube, 128, 128, numDimensions);
+  int bricks = brick.Bricks();
+  int batchSize = 2 * QThreadPool::globalInstance()->maxThreadCount();
+  Progress progress;
+  progress.SetText("Computing transform");
+  progress.SetMaximumSteps(bricks);
+  progress.CheckStatus();
+  for (int first = 0; first < bricks; first += batchSize) {
+    QVector<int> batch;
+    for (int i = first; i < min(bricks, first + batchSize); i++) {
+      batch.append(i);
+    }
+    vector<PrincipalComponentAnalysis> batchPcas(batch.size(),
+                                                PrincipalComponentAnalysis(numDimensions));
+    QtConcurrent::blockingMap(batch, [&](int &i) {
+      Brick in(*icube, 128, 128, numDimensions);
+      in.setpos(i);
+      icube->read(in);
+      getData(in, batchPcas[i - first]);
+    });
+
+    for (const PrincipalComponentAnalysis &brickPca : batchPcas) {
+      pca.Merge(brickPca);
+      progress.CheckStatus();
+    }
+  }
   pca.ComputeTransform();
 
   p.Progress()->SetText("Transforming Cube");
-  p.StartProcess(transform);
+  p.ProcessCube(transform, true);
   p.EndProcess();
 
   Isis::CubeAttributeInput cai;
@@ -58,7 +91,7 @@ void IsisMain() {
   p.SetOutputCube("TO");
   p.SetBrickSize(128, 128, numDimensions);
   p.Progress()->SetText("Stretching Cube");
-  p.StartProcess(normalizeAndInvert);
+  p.ProcessCube(normalizeAndInvert, true);
 
   for (int i = 0; i < numDimensions; i++) {
      delete stretches[i];
@@ -70,54 +103,51 @@ void IsisMain() {
 }
 
 
-void getData(Buffer &in) {
-  pca.AddData(in.DoubleBuffer(), in.size() / in.BandDimension() );
-}
+// Accumulate the data of one brick for the transform matrix
+void getData(Buffer &in, PrincipalComponentAnalysis &brickPca) {
+  int pixels = in.size() / in.BandDimension();
 
-// Processing routine for the pca with one input cube
-void transform(Buffer &in, Buffer &out) {
-
-  for (int i = 0; i < in.SampleDimension(); i++) {
-
-    for (int j = 0; j < in.LineDimension(); j++) {
-
-      TNT::Array2D<double> pre(1, in.BandDimension());
-      for (int k = 0; k < pre.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        pre[0][k] = in[index];
+  if (sampleIncrement == 1 && lineIncrement == 1) {
+    brickPca.AddData(in.DoubleBuffer(), pixels);
+  }
+  else {
+    // Only use every SINC sample of every LINC line
+    vector<int> indexes;
+    for (int line = 0; line < in.LineDimension(); line++) {
+      if ((in.Line() + line - 1) % lineIncrement != 0) continue;
+      for (int samp = 0; samp < in.SampleDimension(); samp++) {
+        if ((in.Sample() + samp - 1) % sampleIncrement != 0) continue;
+        indexes.push_back(line * in.SampleDimension() + samp);
       }
+    }
 
-      TNT::Array2D<double> post = pca.Transform(pre);
-
-      for (int k = 0; k < post.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        out[index] = post[0][k];
+    int count = indexes.size();
+    vector<double> data(count * in.BandDimension());
+    for (int band = 0; band < in.BandDimension(); band++) {
+      for (int i = 0; i < count; i++) {
+        data[band * count + i] = in[band * pixels + indexes[i]];
       }
     }
+    brickPca.AddData(data.data(), count);
   }
 }
 
+// Processing routine for the pca with one input cube
+void transform(Buffer &in, Buffer &out) {
+  pca.Transform(in.DoubleBuffer(), out.DoubleBuffer(), in.size() / in.BandDimension());
+}
+
 // Processing routine for the pca with two input cubes
 void normalizeAndInvert(Buffer &in, Buffer &out) {
+  int pixels = in.size() / in.BandDimension();
 
-  for (int i = 0; i < in.SampleDimension(); i++) {
-    for (int j = 0; j < in.LineDimension(); j++) {
-      TNT::Array2D<double> pre(1, in.BandDimension() );
-      for (int k = 0; k < pre.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        // Stretch the data before inverting it
-        // NOTE: this needs to be modified to use a GAUSSIAN STRETCH
-        //pre[0][k] = (in[index]-bandStats[k]->Average())/bandStats[k]->StandardDeviation();
-        pre[0][k] = stretches[k]->Map(in[index]);
-      }
-
-      TNT::Array2D<double> post = pca.Inverse(pre);
-
-      for (int k = 0; k < post.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        out[index] = post[0][k];
-      }
+  // Stretch the data before inverting it
+  vector<double> stretched(in.size());
+  for (int k = 0; k < in.BandDimension(); k++) {
+    for (int i = 0; i < pixels; i++) {
+      stretched[k * pixels + i] = stretches[k]->Map(in[k * pixels + i]);
     }
   }
-}
 
+  pca.Inverse(stretched.data(), out.DoubleBuffer(), pixels);
+}
@@ -1,4 +1,5 @@
 #include <cmath>
+#include <vector>
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
 #include "Pvl.h"
@@ -10,9 +11,8 @@
 using namespace std;
 using namespace Isis;
 
-void useFilter(Buffer &in, double &v);
 void setFilter(int size, double stdDev);
-double *coefs;
+vector<double> coefs;
 void IsisMain() {
 
   ProcessByBoxcar p;
@@ -32,14 +32,14 @@ void IsisMain() {
   //Set the Boxcar size based on the input size
   p.SetBoxcarSize(size, size);
 
-  //Reference a pointer to an array of kernel data values
-  coefs = new double[size*size];
+  //Fill the array of kernel data values
+  coefs.resize(size*size);
   setFilter(size, stdDev);
 
-  p.StartProcess(useFilter);
+  //Special pixels are left out of the weighted sum
+  p.SetKernel(coefs, 1.0, ProcessByBoxcar::SkipSpecial);
+  p.ProcessCubeKernel();
   p.EndProcess();
-
-  delete [] coefs;
 }
 
 void setFilter(int size, double stdDev) {
@@ -66,12 +66,3 @@ void setFilter(int size, double stdDev) {
   }
 }
 
-
-void useFilter(Buffer &in, double &v) {
-  v = 0;
-  for(int i = 0 ; i < in.size() ; i++) {
-    if(!IsSpecial(in[i])) {
-      v += in[i] * coefs[i] ;
-    }
-  }
-}
@@ -1,4 +1,5 @@
 #include "Isis.h"
+#include "ImageHistogram.h"
 #include "ProcessByLine.h"
 #include "SpecialPixel.h"
 #include "Statistics.h"
@@ -8,9 +9,6 @@
 using namespace std;
 using namespace Isis;
 
-Stretch stretch;
-void remap(Buffer &in, Buffer &out);
-
 void IsisMain() {
 
   // Setup the input and output cubes
@@ -24,25 +22,25 @@ void IsisMain() {
   double maximum = ui.GetDouble("MAXPER");
   int increment = ui.GetInteger("INCREMENT");
 
-  // Histograms from input cubes
+  // Histogram from the input cube
   Histogram *from = icube->histogram();
-  Histogram *match = icube->histogram();
 
   double fromMin = from->Percent(minimum);
   double fromMax = from->Percent(maximum);
   int fromBins = from->Bins();
-  double data[fromBins];
+  vector<double> data(fromBins);
   double slope = (fromMax - fromMin) / (fromBins - 1);
 
-  // Set "match" to have the same data range and number of bins as "to"
-  match->SetBins(fromBins);
-  //match->SetValidRange(fromMin, fromMax);
+  // "match" has the same data range and number of bins as "from" and holds a
+  //   flat distribution, so it is built directly rather than read from the cube
+  ImageHistogram *match = new ImageHistogram(from->BinRangeStart(), from->BinRangeEnd(),
+                                             fromBins);
   for(int i = 0; i < fromBins; i++) {
     data[i] = fromMin + (slope * i);
   }
-  match->AddData(data, fromBins);
+  match->AddData(data.data(), fromBins);
 
-  stretch.ClearPairs();
+  Stretch stretch;
   double lastPer = from->Percent(minimum);
   stretch.AddPair(lastPer, match->Percent(minimum));
   for(double i = increment + minimum; i < maximum; i += increment) {
@@ -59,14 +57,16 @@ void IsisMain() {
     stretch.AddPair(curPer, match->Percent(maximum));
   }
 
-  // Start the processing
-  p.StartProcess(remap);
+  delete from;
+  delete match;
+
+  // Byte and word cubes are stretched through a lookup table
+  stretch.CompileLookup(icube->pixelType(), icube->base(), icube->multiplier());
+
+  // Adjust FROM cumulative distribution to be flatter, one line per thread
+  auto remap = [&stretch](Buffer &in, Buffer &out) -> void {
+    stretch.Map(in.DoubleBuffer(), out.DoubleBuffer(), in.size());
+  };
+  p.ProcessCube(remap, true);
   p.EndProcess();
 }
-
-// Adjust FROM cumulative distribution to be flatter
-void remap(Buffer &in, Buffer &out) {
-  for(int i = 0; i < in.size(); i++) {
-    out[i] = stretch.Map(in[i]);
-  }
-}   // end remap .
@@ -8,10 +8,6 @@
 using namespace std;
 using namespace Isis;
 
-Stretch stretch;
-
-void remap(vector<Buffer *> &in, vector<Buffer *> &out);
-
 void IsisMain() {
   // Setup the input and output cubes along with histograms
   ProcessByLine p;
@@ -27,7 +23,7 @@ void IsisMain() {
   double minimum = ui.GetDouble("MINPER");
   double maximum = ui.GetDouble("MAXPER");
 
-  stretch.ClearPairs();
+  Stretch stretch;
 
   // CDF mode selected
   if(ui.GetString("STRETCH") == "CDF") {
@@ -54,17 +50,16 @@ void IsisMain() {
     stretch.AddPair(from->Percent(maximum), match->Percent(maximum));
   }
 
-  // Start the processing
-  p.StartProcess(remap);
-  p.EndProcess();
-}
+  delete from;
+  delete match;
 
-// Adjust FROM histogram to resemble MATCH's histogram
-void remap(vector<Buffer *> &in, vector<Buffer *> &out) {
-  Buffer &from = *in[0];
-  Buffer &to = *out[0];
+  // Byte and word cubes are stretched through a lookup table
+  stretch.CompileLookup(icube->pixelType(), icube->base(), icube->multiplier());
 
-  for(int i = 0; i < from.size(); i++) {
-    to[i] = stretch.Map(from[i]);
-  }
-}   // end remap
+  // Adjust FROM histogram to resemble MATCH's histogram, one line per thread
+  auto remap = [&stretch](Buffer &in, Buffer &out) -> void {
+    stretch.Map(in.DoubleBuffer(), out.DoubleBuffer(), in.size());
+  };
+  p.ProcessCube(remap, true);
+  p.EndProcess();
+}
@@ -4,26 +4,24 @@
 
 #include "AlphaCube.h"
 #include "FourierTransform.h"
-#include "ProcessByTile.h"
+#include "IException.h"
+#include "ProcessByBrick.h"
 
 using namespace std;
 using namespace Isis;
 
-void IFFT1(vector<Buffer *> &in, vector<Buffer *> &out);
-void IFFT2(vector<Buffer *> &in, vector<Buffer *> &out);
+void IFFT(vector<Buffer *> &in, vector<Buffer *> &out);
 
 FourierTransform fft;
-QString tmpMagFileName = "Temporary_IFFT_Magnitude.cub";
-QString tmpPhaseFileName = "Temporary_IFFT_Phase.cub";
 
 void IsisMain() {
-  // We will be processing by line first
-  ProcessByTile lProc;
-  lProc.Progress()->SetText("First pass");
+  // Each band is transformed as a whole, so we process by band sized bricks
+  ProcessByBrick p;
+  p.Progress()->SetText("Transforming");
 
   // Setup the input and output cubes
-  Cube *magCube = lProc.SetInputCube("MAGNITUDE");
-  Cube *phaseCube = lProc.SetInputCube("PHASE");
+  Cube *magCube = p.SetInputCube("MAGNITUDE");
+  Cube *phaseCube = p.SetInputCube("PHASE");
 
   AlphaCube acube(*magCube);
   int initSamples = acube.BetaSamples();
@@ -35,49 +33,27 @@ void IsisMain() {
 
   // error checking for valid input cubes
   // i.e. the dimensions of the magnitude and phase cubes
-  // are the same and are powers of two
-  if(!fft.IsPowerOfTwo(numSamples) || !fft.IsPowerOfTwo(numLines)
-      || magCube->sampleCount() != phaseCube->sampleCount()
+  // are the same
+  if(magCube->sampleCount() != phaseCube->sampleCount()
       || magCube->lineCount() != phaseCube->lineCount()) {
-    cerr << "Invalid Cubes: the dimensions of both cubes must be equal"
-            " powers of 2." << endl;
-    return;
+    QString msg = "Invalid Cubes: the dimensions of both cubes must be equal.";
+    throw IException(IException::User, msg, _FILEINFO_);
   }
 
-  lProc.SetTileSize(numSamples, 1);
-
-  Isis::CubeAttributeOutput cao;
-
-  lProc.SetOutputCube(tmpMagFileName, cao, numSamples, numLines, numBands);
-  lProc.SetOutputCube(tmpPhaseFileName, cao, numSamples, numLines, numBands);
-
-  // Start the line processing
-  lProc.ProcessCubes(&IFFT2);
-  lProc.Finalize();
-
-  // Then process by sample
-  ProcessByTile sProc;
-  sProc.Progress()->SetText("Second pass");
-  sProc.SetTileSize(1, numLines);
-
-  // Setup the input and output cubes
-  Isis::CubeAttributeInput cai;
-
-  sProc.SetInputCube(tmpMagFileName, cai);
-  sProc.SetInputCube(tmpPhaseFileName, cai);
+  p.SetBrickSize(numSamples, numLines, 1);
 
   // the final output cube is cropped back to the original size
-  Cube *outputCube = sProc.SetOutputCube("TO", initSamples, initLines, numBands);
+  Cube *outputCube = p.SetOutputCube("TO", initSamples, initLines, numBands);
 
-  //Start the sample proccessing
-  sProc.ProcessCubes(&IFFT1);
+  // The transform of each band is already spread over the processing threads
+  p.ProcessCubes(&IFFT, false);
 
   // Remove the AlphaCube if the alpha and beta dimensions match the output cube dimensions
   // (i.e. remove this group if it didn't exist before running fft).
   int outputSamples = outputCube->sampleCount();
   int outputLines = outputCube->lineCount();
   if (initSamples == outputSamples
-      && initLines == outputLines 
+      && initLines == outputLines
       && acube.AlphaSamples() == outputSamples
       && acube.AlphaLines() == outputLines) {
     Pvl *label = outputCube->label();
@@ -87,60 +63,34 @@ void IsisMain() {
     }
   }
 
-  sProc.Finalize();
-
-  remove(tmpMagFileName.toLatin1().data());
-  remove(tmpPhaseFileName.toLatin1().data());
+  p.Finalize();
 }
 
-// Processing routine for the inverse fft
-void IFFT1(vector<Buffer *> &in, vector<Buffer *> &out) {
-  Buffer &inReal = *in[0];
-  Buffer &inImag = *in[1];
+// Processing routine for the inverse fft of one band
+void IFFT(vector<Buffer *> &in, vector<Buffer *> &out) {
+  Buffer &mag = *in[0];
+  Buffer &phase = *in[1];
 
-  int n = inReal.size();
-  vector< complex<double> > input(n);
+  int ns = mag.SampleDimension();
+  int nl = mag.LineDimension();
+  vector< complex<double> > data(mag.size());
 
   // copy and rearrange the data to fit the algorithm
   // the image is centered at zero, the array begins at zero
-  for(int i = 0; i < n / 2; i++) {
-    input[i] = complex<double>(inReal[i+n/2], inImag[i+n/2]);
-    input[i+n/2] = complex<double>(inReal[i], inImag[i]);
+  for(int line = 0; line < nl; line++) {
+    int fromLine = (line + nl / 2) % nl;
+    for(int samp = 0; samp < ns; samp++) {
+      int from = fromLine * ns + (samp + ns / 2) % ns;
+      data[line * ns + samp] = polar(mag[from], phase[from]);
+    }
   }
 
   // compute the inverse fft
-  vector< complex<double> > output = fft.Inverse(input);
+  fft.Transform2D(data, ns, nl, true);
 
   Buffer &image = *out[0];
   // and copy the result to the output cube
-  for(int i = 0; i < n; i++) {
-    image[i] = real(output[i]);
-  }
-}
-
-// Processing routine for the inverse fft with two output cubes
-void IFFT2(vector<Buffer *> &in, vector<Buffer *> &out) {
-  Buffer &mag = *in[0];
-  Buffer &phase = *in[1];
-
-  int n = mag.size();
-  vector< complex<double> > input(n);
-
-  // copy and rearrange the data to fit the algorithm
-  // the image is centered at zero, the array begins at zero
-  for(int i = 0; i < n / 2; i++) {
-    input[i] = complex<double>(polar(mag[i+n/2], phase[i+n/2]));
-    input[i+n/2] = complex<double>(polar(mag[i], phase[i]));
-  }
-
-  // compute the inverse fft
-  vector< complex<double> > output = fft.Inverse(input);
-
-  Buffer &realCube = *out[0];
-  Buffer &imagCube = *out[1];
-  // and copy the result to the output cubes
-  for(int i = 0; i < n; i++) {
-    realCube[i] = real(output[i]);
-    imagCube[i] = imag(output[i]);
+  for(int i = 0; i < image.size(); i++) {
+    image[i] = real(data[i]);
   }
 }
@@ -12,10 +12,6 @@
 using namespace std;
 using namespace Isis;
 
-void filter(Buffer &in, double &v);
-vector <double> coefs;
-double weight;
-
 void IsisMain() {
 
   // Get information from the input kernel
@@ -55,33 +51,17 @@ void IsisMain() {
   p.SetBoxcarSize(samples, lines);
 
   // Iterate through the input kernel's data values to fill the coefs array
+  vector<double> coefs;
   for(int i = 0 ; i < kern["data"].size() ; i ++) {
     coefs.push_back(toDouble(kern["data"][i]));
   }
 
   // Weight for multiplication of resultant immidately before completion
-  weight = kern["weight"];
+  double weight = kern["weight"];
 
-  p.StartProcess(filter);
+  // If a special pixel is encountered with the boxcar, resultant pixel is nulled
+  p.SetKernel(coefs, weight, ProcessByBoxcar::NullIfAnySpecial);
+  p.ProcessCubeKernel();
   p.EndProcess();
 }
 
-
-//! The filter depends on the user input kernel
-void filter(Buffer &in, double &result) {
-  result = 0.0;
-  for(int i = 0; i < in.size() && result != Isis::Null; i++) {
-    if(!IsSpecial(in[i])) {
-      result += in[i] * coefs[i] ;
-    }
-    else {
-      // If a special pixel is encountered with the boxcar, resultant pixel is nulled
-      result = Isis::Null;
-    }
-  }
-
-  // If the result isn't null, finish the processing
-  if(result != Isis::Null) {
-    result *= weight;
-  }
-}
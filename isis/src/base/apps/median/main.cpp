@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
+#include "SlidingRank.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -17,9 +16,9 @@ double high;
 bool propagate;
 unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+void FilterAll(double centerPixel, const SlidingRank &window, double &v);
+void FilterValid(double centerPixel, const SlidingRank &window, double &v);
+void FilterInvalid(double centerPixel, const SlidingRank &window, double &v);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -65,15 +64,15 @@ void IsisMain() {
 
   //Check for filter style, and process accordingly
   if(ui.GetString("FILTER") == "ALL") {
-    p.StartProcess(FilterAll);
+    p.ProcessCubeRank(FilterAll, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "INSIDE") {
-    p.StartProcess(FilterValid);
+    p.ProcessCubeRank(FilterValid, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("FILTER") == "OUTSIDE") {
-    p.StartProcess(FilterInvalid);
+    p.ProcessCubeRank(FilterInvalid, low, high);
     p.EndProcess();
   }
 }
@@ -81,9 +80,7 @@ void IsisMain() {
 //Function which loops through every pixel in the boxcar,
 //and outputs the median value to the center pixel, if
 //the center pixel is valid.
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterValid(double centerPixel, const SlidingRank &window, double &v) {
   //Check if the center pixel is a Special Pixel type to be
   //filtered. If not, ignore the pixel and move on
   if(IsSpecial(centerPixel)) {
@@ -113,21 +110,11 @@ void FilterValid(Buffer &in, double &v) {
     return;
   }
 
-  //Build a vector containing the non-Special pixel values
-  //from the input buffer. If there are not enough to meet
-  //the minimum requirements, write a user-selected value
-  //to the center. If there are, sort the vector and write
-  //the median value to the center.
-  std::vector<double> boxdata(0);
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  //The window holds the non-Special pixel values from the
+  //boxcar. If there are not enough to meet the minimum
+  //requirements, write a user-selected value to the center.
+  //If there are, write the median value to the center.
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -137,16 +124,13 @@ void FilterValid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
 //Function to loop through the boxcar and find and write
 //the median value to the center pixel, but only if the
 //center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterInvalid(double centerPixel, const SlidingRank &window, double &v) {
   //Check for Special Pixels and handle according to user
   //input.
   if(IsSpecial(centerPixel)) {
@@ -176,21 +160,11 @@ void FilterInvalid(Buffer &in, double &v) {
     return;
   }
 
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  //The window holds the non-Special pixel values from the
+  //input boxcar. If there aren't enough to meet the minimum
+  //requirements, write a user-selected value to the center
+  //pixel, otherwise write the median value.
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -200,16 +174,13 @@ void FilterInvalid(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
 //Function to find the median value of the boxcar and
 //write it to the center, regardless of the validity
 //of the center pixel value
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterAll(double centerPixel, const SlidingRank &window, double &v) {
   //Check for Special Pixels and handle according to user
   //input.
   if(IsSpecial(centerPixel)) {
@@ -235,21 +206,11 @@ void FilterAll(Buffer &in, double &v) {
     }
   }
 
-  //Build a vector of non-Special pixel values from the
-  //input boxcar, then sort and find the median value.
-  //If there aren't enough to meet the minimum requirements,
-  //write a user-selected value to the center pixel.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  //The window holds the non-Special pixel values from the
+  //input boxcar. If there aren't enough to meet the minimum
+  //requirements, write a user-selected value to the center
+  //pixel, otherwise write the median value.
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -259,7 +220,6 @@ void FilterAll(Buffer &in, double &v) {
       return;
     }
   }
-  sort(boxdata.begin(), boxdata.end());
-  v = boxdata[(boxdata.size()-1)/2];
+  v = window.median();
 }
 
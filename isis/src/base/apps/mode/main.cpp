@@ -1,8 +1,7 @@
 #include "Isis.h"
 #include "ProcessByBoxcar.h"
+#include "SlidingRank.h"
 #include "SpecialPixel.h"
-#include <algorithm>
-#include <vector>
 
 using namespace std;
 using namespace Isis;
@@ -17,9 +16,10 @@ double low;
 double high;
 unsigned int  minimum;
 
-void FilterAll(Buffer &in, double &v);
-void FilterValid(Buffer &in, double &v);
-void FilterInvalid(Buffer &in, double &v);
+void FilterAll(double centerPixel, const SlidingRank &window, double &v);
+void FilterValid(double centerPixel, const SlidingRank &window, double &v);
+void FilterInvalid(double centerPixel, const SlidingRank &window, double &v);
+double ModeValue(double centerPixel, const SlidingRank &window);
 
 void IsisMain() {
   //Set up ProcessByBoxcar
@@ -66,15 +66,15 @@ void IsisMain() {
 
   //Check for filter style, and process accordingly
   if(ui.GetString("PIXELS") == "ALL") {
-    p.StartProcess(FilterAll);
+    p.ProcessCubeRank(FilterAll, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("PIXELS") == "INSIDE") {
-    p.StartProcess(FilterValid);
+    p.ProcessCubeRank(FilterValid, low, high);
     p.EndProcess();
   }
   else if(ui.GetString("PIXELS") == "OUTSIDE") {
-    p.StartProcess(FilterInvalid);
+    p.ProcessCubeRank(FilterInvalid, low, high);
     p.EndProcess();
   }
 }
@@ -82,9 +82,7 @@ void IsisMain() {
 //Function which loops through every pixel int the boxcar,
 //and outputs the mode value to the center pixel, if
 //the center pixel is valid
-void FilterValid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterValid(double centerPixel, const SlidingRank &window, double &v) {
   //Check if the center pixel is valid
   //Valid is defined as a Special Pixel declared as a
   //valid type, or a normal value between low and high.
@@ -116,19 +114,9 @@ void FilterValid(Buffer &in, double &v) {
     v = centerPixel;
   }
 
-  //Gather all non-special pixels into a vector and determine
-  //the mode, provided there are enough for filtering
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  //The window holds all non-special pixels, determine the
+  //mode, provided there are enough for filtering
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -138,34 +126,14 @@ void FilterValid(Buffer &in, double &v) {
       return;
     }
   }
-
-  //Determine the most common(mode) pixel value
-  double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
-  int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
-  }
-  v = modeVal;
+  v = ModeValue(centerPixel, window);
 }
 
 
 //Function to loop through the boxcar and find and write
 //the mode value to the center pixel, but only if the
 //center pixel is invalid
-void FilterInvalid(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterInvalid(double centerPixel, const SlidingRank &window, double &v) {
   //Check if the center pixel is valid
   //Valid is defined as a Special Pixel declared as a
   //valid type, or a normal value between low and high.
@@ -197,21 +165,10 @@ void FilterInvalid(Buffer &in, double &v) {
     v = centerPixel;
   }
 
-  //Now, build a vector containing non-Special pixels,
-  //and, if there are enough, process the vector to
+  //Now, if the window holds enough non-Special pixels,
   //determine the mode. If there aren't enough, write
   //a user selected value to the center.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -221,31 +178,12 @@ void FilterInvalid(Buffer &in, double &v) {
       return;
     }
   }
-  //Sort the vector, and determine the mode pixel value
-  double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
-  int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
-  }
-  v = modeVal;
+  v = ModeValue(centerPixel, window);
 }
 
 //Function to process the boxcar and determine the mode,
 //regardless of validity of the center pixel
-void FilterAll(Buffer &in, double &v) {
-  double centerPixel = in[(in.size()-1)/2];
-
+void FilterAll(double centerPixel, const SlidingRank &window, double &v) {
   //Check if the center pixel is valid
   //Valid is defined as a Special Pixel declared as a
   //valid type, or a normal value between low and high.
@@ -274,21 +212,10 @@ void FilterAll(Buffer &in, double &v) {
     }
   }
 
-  //Now, build a vector containing non-Special pixels,
-  //and, if there are enough, process the vector to
+  //Now, if the window holds enough non-Special pixels,
   //determine the mode. If there aren't enough, write
   //a user selected value to the center.
-  std::vector<double> boxdata(0);
-
-  for(int i = 0; i < in.size(); i++) {
-    if(!IsSpecial(in[i]) && in[i] >= low && in[i] <= high) {
-      boxdata.push_back(in[i]);
-    }
-    else {
-      continue;
-    }
-  }
-  if(boxdata.size() < minimum) {
+  if(window.count() < (int) minimum) {
     if(propagate) {
       v = centerPixel;
       return;
@@ -298,22 +225,25 @@ void FilterAll(Buffer &in, double &v) {
       return;
     }
   }
-  //Sort the vector, and determine the mode pixel value
+  v = ModeValue(centerPixel, window);
+}
+
+//Determine the most common(mode) pixel value of the window.
+//A value is only taken as the mode once a larger value
+//follows it, and only if it occurs more than once, so the
+//center pixel is returned when no value qualifies
+double ModeValue(double centerPixel, const SlidingRank &window) {
   double modeVal = centerPixel;
-  sort(boxdata.begin(), boxdata.end());
-  int count = 1;
   int maxCount = 1;
-  for(unsigned int i = 1; i < boxdata.size(); i++) {
-    if(boxdata[i] == boxdata[i-1]) {
-      count++;
-    }
-    else {
-      if(count > maxCount) {
-        modeVal = boxdata[i-1];
-        maxCount = count;
-      }
-      count = 1;
-    }
-  }
-  v = modeVal;
+  double previousVal = centerPixel;
+  int previousCount = 0;
+  window.forEachValue([&](double value, int count) {
+    if(previousCount > maxCount) {
+      modeVal = previousVal;
+      maxCount = previousCount;
+    }
+    previousVal = value;
+    previousCount = count;
+  });
+  return modeVal;
 }
@@ -1,7 +1,17 @@
 #include "Isis.h"
+
+#include <algorithm>
+#include <vector>
+
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "tnt_array2d.h"
+#include "Brick.h"
 #include "PrincipalComponentAnalysis.h"
 #include "ProcessBySpectra.h"
+#include "Progress.h"
 #include "Statistics.h"
 #include "Table.h"
 #include "TableField.h"
@@ -10,13 +20,14 @@
 using namespace std;
 using namespace Isis;
 
-void PCA(Buffer &in);
+void PCA(Buffer &in, PrincipalComponentAnalysis &brickPca);
 void Transform(Buffer &in, Buffer &out);
 void Inverse(Buffer &in, Buffer &out);
 
 PrincipalComponentAnalysis pca(0);
 
 int numDimensions;
+int sampleIncrement, lineIncrement;
 
 void IsisMain() {
   UserInterface &ui = Application::GetUserInterface();
@@ -34,12 +45,38 @@ void IsisMain() {
     Cube *ocube = p.SetOutputCube(ui.GetAsString("TO"), cao, icube->sampleCount(), icube->lineCount(), icube->bandCount());
     numDimensions = icube->bandCount();
     pca = Isis::PrincipalComponentAnalysis(numDimensions);
-    ProcessByBrick p2;
-    p2.SetBrickSize(128, 128, icube->bandCount());
-    p2.SetInputCube("FROM");
-    p2.Progress()->SetText("Computing Transform");
-    p2.StartProcess(PCA);
-    p2.EndProcess();
+    sampleIncrement = ui.GetInteger("SINC");
+    lineIncrement = ui.GetInteger("LINC");
+
+    // Accumulate the bricks a batch at a time, each brick on its own, and merge
+    //   each batch in brick order, so the sums do not depend on the threads and
+    //   only one batch of partial sums is kept
+    Brick brick(*icube, 128, 128, numDimensions);
+    int bricks = brick.Bricks();
+    int batchSize = 2 * QThreadPool::globalInstance()->maxThreadCount();
+    Progress progress;
+    progress.SetText("Computing Transform");
+    progress.SetMaximumSteps(bricks);
+    progress.CheckStatus();
+    for (int first = 0; first < bricks; first += batchSize) {
+      QVector<int> batch;
+      for (int i = first; i < min(bricks, first + batchSize); i++) {
+        batch.append(i);
+      }
+      vector<PrincipalComponentAnalysis> batchPcas(batch.size(),
+                                                  PrincipalComponentAnalysis(numDimensions));
+      QtConcurrent::blockingMap(batch, [&](int &i) {
+        Brick in(*icube, 128, 128, numDimensions);
+        in.setpos(i);
+        icube->read(in);
+        PCA(in, batchPcas[i - first]);
+      });
+
+      for (const PrincipalComponentAnalysis &brickPca : batchPcas) {
+        pca.Merge(brickPca);
+        progress.CheckStatus();
+      }
+    }
     pca.ComputeTransform();
     TNT::Array2D<double> transform = pca.TransformMatrix();
 
@@ -59,7 +96,7 @@ void IsisMain() {
     }
 
     p.Progress()->SetText("Transforming Cube");
-    p.StartProcess(Transform);
+    p.ProcessCube(Transform, true);
     ocube->write(table);
     p.EndProcess();
   }
@@ -87,7 +124,7 @@ void IsisMain() {
           && label->object(i)["Name"].isEquivalent("Transform Matrix")) label->deleteObject(i);
     }
     p.Progress()->SetText("Inverting Cube");
-    p.StartProcess(Inverse);
+    p.ProcessCube(Inverse, true);
     p.EndProcess();
   }
   else {
@@ -98,46 +135,39 @@ void IsisMain() {
 
 // Processing routine for the pca with one input cube
 void Transform(Buffer &in, Buffer &out) {
-  for(int i = 0; i < in.SampleDimension(); i++) {
-    for(int j = 0; j < in.LineDimension(); j++) {
-      TNT::Array2D<double> pre(1, in.BandDimension());
-      for(int k = 0; k < pre.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        pre[0][k] = in[index];
-      }
-
-      TNT::Array2D<double> post = pca.Transform(pre);
-
-      for(int k = 0; k < post.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        out[index] = post[0][k];
-      }
-    }
-  }
+  pca.Transform(in.DoubleBuffer(), out.DoubleBuffer(), in.size() / in.BandDimension());
 }
 
 // Processing routine for the pca with two input cubes
 void Inverse(Buffer &in, Buffer &out) {
-  for(int i = 0; i < in.SampleDimension(); i++) {
-    for(int j = 0; j < in.LineDimension(); j++) {
-      TNT::Array2D<double> pre(1, in.BandDimension());
-      for(int k = 0; k < pre.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        if(k + 1 > in.size()) pre[0][k] = 0.0;
-        else pre[0][k] = in[index];
-      }
+  pca.Inverse(in.DoubleBuffer(), out.DoubleBuffer(), in.size() / in.BandDimension());
+}
 
-      TNT::Array2D<double> post = pca.Inverse(pre);
+// Accumulate the data of one brick for computing the principal components
+void PCA(Buffer &in, PrincipalComponentAnalysis &brickPca) {
+  int pixels = in.size() / in.BandDimension();
+
+  if(sampleIncrement == 1 && lineIncrement == 1) {
+    brickPca.AddData(in.DoubleBuffer(), pixels);
+  }
+  else {
+    // Only use every SINC sample of every LINC line
+    std::vector<int> indexes;
+    for(int line = 0; line < in.LineDimension(); line++) {
+      if((in.Line() + line - 1) % lineIncrement != 0) continue;
+      for(int samp = 0; samp < in.SampleDimension(); samp++) {
+        if((in.Sample() + samp - 1) % sampleIncrement != 0) continue;
+        indexes.push_back(line * in.SampleDimension() + samp);
+      }
+    }
 
-      for(int k = 0; k < post.dim2(); k++) {
-        int index = i + j * in.SampleDimension() + k * in.SampleDimension() * in.LineDimension();
-        out[index] = post[0][k];
+    int count = indexes.size();
+    std::vector<double> data(count * in.BandDimension());
+    for(int band = 0; band < in.BandDimension(); band++) {
+      for(int i = 0; i < count; i++) {
+        data[band * count + i] = in[band * pixels + indexes[i]];
       }
     }
+    brickPca.AddData(data.data(), count);
   }
 }
-
-// Analyze the cube and compute the principal components
-void PCA(Buffer &in) {
-  pca.AddData(in.DoubleBuffer(), in.size() / in.BandDimension());
-}
@@ -1,3 +1,4 @@
+#include "FileName.h"
 #include "IException.h"
 #include "IString.h"
 #include "ProcessByLine.h"
@@ -10,6 +11,67 @@
 using namespace std;
 namespace Isis{
 
+  /**
+   * Writes 2x, 4x, 8x, ... averaged reductions of the input cube in one pass
+   * over the input. TO receives the 2x reduction and each further level is
+   * written next to it with its reduction factor in the file name, for
+   * example reduced.4x.cub.
+   *
+   * @param ui The user interface to parse the parameters from
+   * @param p The process with the input cube set, used to propagate labels
+   * @param inCube The opened input cube
+   * @param log The Pvl that the Results groups are added to
+   */
+  static void reduceLevels(UserInterface &ui, ProcessByLine &p, Cube &inCube, Pvl *log) {
+    if (ui.GetString("ALGORITHM") != "AVERAGE") {
+      QString msg = "MODE=LEVELS only supports ALGORITHM=AVERAGE";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    int levels = ui.GetInteger("LEVELS");
+    double vper = ui.GetDouble("VALIDPER") / 100.;
+    int ins = inCube.sampleCount();
+    int inl = inCube.lineCount();
+    if (ins < (1 << levels) || inl < (1 << levels)) {
+      QString msg = "The input cube is too small for [" + toString(levels) + "] levels";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    CubeAttributeOutput &att = ui.GetOutputAttribute("TO");
+    FileName to(ui.GetCubeName("TO"));
+    vector<Cube *> outCubes;
+    for (int level = 1; level <= levels; level++) {
+      int factor = 1 << level;
+      QString name = to.expanded();
+      if (level > 1) {
+        name = to.removeExtension().addExtension(toString(factor) + "x")
+                 .addExtension(to.extension()).expanded();
+      }
+      outCubes.push_back(p.SetOutputCube(name, att, (ins + factor - 1) / factor,
+                                         (inl + factor - 1) / factor, inCube.bandCount()));
+    }
+    p.ClearInputCubes();
+
+    Reduce::averageLevels(&inCube, outCubes, vper);
+
+    for (int level = 1; level <= levels; level++) {
+      int factor = 1 << level;
+      Cube *ocube = outCubes[level - 1];
+      Average average(&inCube, factor, factor, vper, "NULL");
+      PvlGroup results = average.UpdateOutputLabel(ocube);
+      results["OutputLines"] = toString(ocube->lineCount());
+      results["OutputSamples"] = toString(ocube->sampleCount());
+      results += PvlKeyword("Level", toString(level));
+      results += PvlKeyword("FileName", ocube->fileName());
+      if (log) {
+        log->addGroup(results);
+      }
+    }
+
+    inCube.close();
+    p.EndProcess();
+  }
+
   void reduce(UserInterface &ui, Pvl *log) {
     try {
       // We will be processing by line
@@ -41,6 +103,11 @@ namespace Isis{
       QString alg  = ui.GetString("ALGORITHM");
       double vper = ui.GetDouble("VALIDPER") / 100.;
 
+      if(ui.GetString("MODE") == "LEVELS") {
+        reduceLevels(ui, p, inCube, log);
+        return;
+      }
+
       if(ui.GetString("MODE") == "TOTAL") {
         ons = ui.GetInteger("ONS");
         onl = ui.GetInteger("ONL");
@@ -71,12 +138,12 @@ namespace Isis{
       PvlGroup results;
       if(alg == "AVERAGE"){
         Average average(&inCube, sscale, lscale, vper, replaceMode);
-        p.ProcessCubeInPlace(average, false);
+        p.ProcessCubeInPlace(average, true);
         results = average.UpdateOutputLabel(ocube);
       }
       else if(alg == "NEAREST") {
         Nearest near(&inCube, sscale, lscale);
-        p.ProcessCubeInPlace(near, false);
+        p.ProcessCubeInPlace(near, true);
         results = near.UpdateOutputLabel(ocube);
       }
 
@@ -68,6 +68,9 @@ namespace Isis {
     if(ui.WasEntered("HRS"))
       str.SetHrs(StringToPixel(ui.GetString("HRS")));
 
+    // Byte and word cubes are stretched through a lookup table
+    str.CompileLookup(inCube->pixelType(), inCube->base(), inCube->multiplier());
+
     p.SetOutputCubeStretch("TO", &ui);
 
     // Start the processing
@@ -87,8 +90,6 @@ namespace Isis {
 
   // Line processing routine
   void stretchProcess(Buffer &in, Buffer &out) {
-    for(int i = 0; i < in.size(); i++) {
-      out[i] = str.Map(in[i]);
-    }
+    str.Map(in.DoubleBuffer(), out.DoubleBuffer(), in.size());
   }
 }
@@ -6,17 +6,13 @@
 #include "UserInterface.h"
 #include "IException.h"
 
+#include <vector>
+
 #include <QList>
 
 using namespace std;
 using namespace Isis;
 
-void getStats(vector<Buffer *> &in, vector<Buffer *> &out);
-void toneMatch(Buffer &in, Buffer &out);
-
-MultivariateStatistics stats;
-double base, mult;
-
 void IsisMain() {
   // We will be processing by line
   ProcessByLine p;
@@ -36,6 +32,7 @@ void IsisMain() {
 
   // Set up the overlap statistics object
   OverlapStatistics oStats(from, match);
+  MultivariateStatistics stats;
 
   if( ui.GetBoolean("POVERLAP") ) {
     //Make sure the projections overlap
@@ -53,11 +50,21 @@ void IsisMain() {
     p.SetInputCube("FROM", Isis::OneBand);
     p.SetInputCube("MATCH", Isis::OneBand);
 
-    // Get the statistics from the cubes
-    p.StartProcess(getStats);
+    // Get the statistics from the cubes, accumulating each line on its own
+    //   thread and merging the lines in order afterwards
+    vector<MultivariateStatistics> lineStats(from.lineCount());
+    auto getStats = [&lineStats](vector<Buffer *> &in, vector<Buffer *> &out) -> void {
+      lineStats[in[0]->Line() - 1].AddData(in[0]->DoubleBuffer(), in[1]->DoubleBuffer(),
+                                           in[0]->size());
+    };
+    p.ProcessCubes(getStats, true);
+    for (const MultivariateStatistics &line : lineStats) {
+      stats.Merge(line);
+    }
   }
 
   // compute the linear regression fit of the mvstats data
+  double base, mult;
   stats.LinearRegression(base, mult);
 
   PvlGroup results("Results");
@@ -78,25 +85,16 @@ void IsisMain() {
   p.ClearInputCubes();
   p.SetInputCube("FROM");
   p.SetOutputCube("TO");
-  p.StartProcess(toneMatch);
-  p.EndProcess();
-}
-
-
-
-void getStats(vector<Buffer *> &in, vector<Buffer *> &out) {
-  stats.AddData(in[0]->DoubleBuffer(), in[1]->DoubleBuffer(), in[0]->size());
-}
-
-
-
-void toneMatch(Buffer &in, Buffer &out) {
-  for(int i = 0; i < in.size(); i++) {
-    if(Isis::IsSpecial(in[i])) {
-      out[i] = in[i];
-    }
-    else {
-      out[i] = base + mult * in[i];
+  auto toneMatch = [base, mult](Buffer &in, Buffer &out) -> void {
+    for(int i = 0; i < in.size(); i++) {
+      if(Isis::IsSpecial(in[i])) {
+        out[i] = in[i];
+      }
+      else {
+        out[i] = base + mult * in[i];
+      }
     }
-  }
+  };
+  p.ProcessCube(toneMatch, true);
+  p.EndProcess();
 }
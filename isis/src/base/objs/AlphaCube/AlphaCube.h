@@ -106,7 +106,7 @@ namespace Isis {
        * 
        * @return double Beta line
        */
-      inline double AlphaLine(double betaLine) {
+      inline double AlphaLine(double betaLine) const {
         return p_lineSlope * (betaLine - 0.5) + p_alphaStartingLine;
       };
       
@@ -118,7 +118,7 @@ namespace Isis {
        * 
        * @return double Beta sample
        */
-      inline double AlphaSample(double betaSample) {
+      inline double AlphaSample(double betaSample) const {
         return p_sampSlope * (betaSample - 0.5) + p_alphaStartingSample;
       };
       
@@ -130,7 +130,7 @@ namespace Isis {
        * 
        * @return double Alpha line
        */
-      inline double BetaLine(double alphaLine) {
+      inline double BetaLine(double alphaLine) const {
         return (alphaLine - p_alphaStartingLine) / p_lineSlope + 0.5;
       };
       
@@ -142,7 +142,7 @@ namespace Isis {
        * 
        * @return double Alpha sample
        */
-      inline double BetaSample(double alphaSample) {
+      inline double BetaSample(double alphaSample) const {
         return (alphaSample - p_alphaStartingSample) / p_sampSlope + 0.5;
       };
 
@@ -14,6 +14,7 @@ find files of those names at the top level of this repository. **/
 
 #include "FileName.h"
 #include "IException.h"
+#include "IString.h"
 #include "Message.h"
 #include "Pvl.h"
 
@@ -70,6 +71,8 @@ namespace Isis {
     p_type = other.p_type;
     p_detached = other.p_detached;
     p_labelFile = other.p_labelFile;
+    p_chunkStartBytes = other.p_chunkStartBytes;
+    p_chunkBytes = other.p_chunkBytes;
 
     p_buffer = NULL;
 
@@ -97,6 +100,8 @@ namespace Isis {
     p_type = other.p_type;
     p_detached = other.p_detached;
     p_labelFile = other.p_labelFile;
+    p_chunkStartBytes = other.p_chunkStartBytes;
+    p_chunkBytes = other.p_chunkBytes;
 
     p_buffer = NULL;
 
@@ -158,6 +163,11 @@ namespace Isis {
    *  Also, if a keyword label pointer is found, the filename for the detached
    *  blob is stored and the pointer is removed from the blob pvl.
    *
+   *  Data appended to a blob after it was written is listed in the
+   *  ChunkStartBytes and ChunkBytes keywords. The chunks are read after the
+   *  data at StartByte, and the keywords are removed from the blob pvl so the
+   *  blob is written back contiguously.
+   *
    *  @param pvl The Pvl to be searched
    *  @param keywords A list of keyword, value pairs to match inside the blob's
    *  PVL object. Only if all the keyword match is the blob processed. This is used
@@ -228,6 +238,24 @@ namespace Isis {
     try {
       p_startByte = p_blobPvl["StartByte"];
       p_nbytes = p_blobPvl["Bytes"];
+      p_chunkStartBytes.clear();
+      p_chunkBytes.clear();
+      if (p_blobPvl.hasKeyword("ChunkStartBytes")) {
+        const PvlKeyword &chunkStartBytes = p_blobPvl["ChunkStartBytes"];
+        const PvlKeyword &chunkBytes = p_blobPvl["ChunkBytes"];
+        if (chunkStartBytes.size() != chunkBytes.size()) {
+          QString msg = "The ChunkStartBytes and ChunkBytes keywords of " + p_type +
+                        " [" + p_blobName + "] have different sizes";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
+        for (int i = 0; i < chunkStartBytes.size(); i++) {
+          p_chunkStartBytes.push_back(toBigInt(chunkStartBytes[i]));
+          p_chunkBytes.push_back(toInt(chunkBytes[i]));
+          p_nbytes += p_chunkBytes.back();
+        }
+        p_blobPvl.deleteKeyword("ChunkStartBytes");
+        p_blobPvl.deleteKeyword("ChunkBytes");
+      }
       p_detached = "";
       if (p_blobPvl.hasKeyword("^" + p_type)) {
         QString path = "";
@@ -353,18 +381,31 @@ namespace Isis {
     if (p_buffer != NULL) delete [] p_buffer;
     p_buffer = new char[p_nbytes];
 
-    streampos sbyte = p_startByte - 1;
-    stream.seekg(sbyte, std::ios::beg);
-    if (!stream.good()) {
-      QString msg = "Error preparing to read data from " + p_type +
-                   " [" + p_blobName + "]";
-      throw IException(IException::Io, msg, _FILEINFO_);
+    // The data at StartByte is followed by any appended chunks
+    std::vector<BigInt> startBytes(1, p_startByte);
+    std::vector<int> nbytes(1, p_nbytes);
+    startBytes.insert(startBytes.end(), p_chunkStartBytes.begin(), p_chunkStartBytes.end());
+    for (int chunkBytes : p_chunkBytes) {
+      nbytes[0] -= chunkBytes;
+      nbytes.push_back(chunkBytes);
     }
 
-    stream.read(p_buffer, p_nbytes);
-    if (!stream.good()) {
-      QString msg = "Error reading data from " + p_type + " [" + p_blobName + "]";
-      throw IException(IException::Io, msg, _FILEINFO_);
+    char *ptr = p_buffer;
+    for (size_t i = 0; i < startBytes.size(); i++) {
+      streampos sbyte = startBytes[i] - 1;
+      stream.seekg(sbyte, std::ios::beg);
+      if (!stream.good()) {
+        QString msg = "Error preparing to read data from " + p_type +
+                     " [" + p_blobName + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+
+      stream.read(ptr, nbytes[i]);
+      if (!stream.good()) {
+        QString msg = "Error reading data from " + p_type + " [" + p_blobName + "]";
+        throw IException(IException::Io, msg, _FILEINFO_);
+      }
+      ptr += nbytes[i];
     }
   }
 
@@ -8,6 +8,7 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 
 #include <string>
+#include <vector>
 #include <QList>
 #include <QPair>
 
@@ -96,6 +97,9 @@ namespace Isis {
       QString p_type;      //!< Type of data stored in the buffer
       QString p_detached;  //!< Used for reading detached blobs
       QString p_labelFile; //!< The file containing the labels
+      //! Start bytes of data appended to the blob after StartByte/Bytes
+      std::vector<BigInt> p_chunkStartBytes;
+      std::vector<int> p_chunkBytes; //!< Sizes of the appended data
   };
 };
 
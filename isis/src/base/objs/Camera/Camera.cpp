@@ -464,7 +464,7 @@ namespace Isis {
     //cout.precision(15);
     //cout << "Backward Time: " << Time().Et() << endl;
     // Convert undistorted x/y to distorted x/y
-    bool success = p_distortionMap->SetUndistortedFocalPlane(ux, uy);
+    bool success = p_distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy);
     if (success) {
       double focalPlaneX = p_distortionMap->FocalPlaneX();
       double focalPlaneY = p_distortionMap->FocalPlaneY();
@@ -1454,7 +1454,7 @@ namespace Isis {
     if (p_skyMap->SetSky(ra, dec)) {
       double ux = p_skyMap->FocalPlaneX();
       double uy = p_skyMap->FocalPlaneY();
-      if (p_distortionMap->SetUndistortedFocalPlane(ux, uy)) {
+      if (p_distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy)) {
         double dx = p_distortionMap->FocalPlaneX();
         double dy = p_distortionMap->FocalPlaneY();
         if (p_focalPlaneMap->SetFocalPlane(dx, dy)) {
@@ -2901,6 +2901,17 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the AlphaCube that relates cube coordinates to the coordinates of
+   * the parent image the camera models
+   *
+   * @return @b const AlphaCube&
+   */
+  const AlphaCube &Camera::alphaCube() const {
+    return *p_alphaCube;
+  }
+
+
   /**
    * Returns a pointer to the CameraGroundMap object
    *
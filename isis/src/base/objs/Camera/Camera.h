@@ -319,6 +319,7 @@ namespace Isis {
       CameraDetectorMap *DetectorMap();
       CameraGroundMap *GroundMap();
       CameraSkyMap *SkyMap();
+      const AlphaCube &alphaCube() const;
 
       QString instrumentId();
 
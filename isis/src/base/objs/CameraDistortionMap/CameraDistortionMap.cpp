@@ -7,6 +7,15 @@ find files of those names at the top level of this repository. **/
 #include "IString.h"
 #include "CameraDistortionMap.h"
 
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "CameraDetectorMap.h"
+#include "CameraFocalPlaneMap.h"
+#include "IException.h"
+#include "PushFrameCameraDetectorMap.h"
+
 namespace Isis {
   /**
    * Camera distortion map constructor
@@ -25,6 +34,7 @@ namespace Isis {
     p_camera = parent;
     p_camera->SetDistortionMap(this);
     p_zDirection = zDirection;
+    p_gridNodes = 0;
   }
 
 
@@ -56,6 +66,7 @@ namespace Isis {
    * @todo Add latex equation to the documentation
    */
   void CameraDistortionMap::SetDistortion(int naifIkCode) {
+    ClearInverseGrid();
     QString odkkey = "INS" + toString(naifIkCode) + "_OD_K";
     for (int i = 0; i < 3; ++i) {
       p_odk.push_back(p_camera->Spice::getDouble(odkkey, i));
@@ -186,6 +197,265 @@ namespace Isis {
   }
 
 
+  /**
+   * Build an inverse distortion grid covering the parent image.
+   *
+   * The extent of the grid is the undistorted focal plane bounding box of the
+   * detector area that the parent image covers, padded by 5%, and the grid is
+   * verified to the same tolerance the default iteration uses, 1/100 of a
+   * pixel.  Radar, point and CSM cameras do not get a grid.
+   *
+   * @return @b bool True if a grid was built
+   * @see BuildInverseGrid(double, double, double, double, double, int)
+   */
+  bool CameraDistortionMap::BuildInverseGrid() {
+    ClearInverseGrid();
+
+    Camera::CameraType type = p_camera->GetCameraType();
+    CameraDetectorMap *detectorMap = p_camera->DetectorMap();
+    CameraFocalPlaneMap *focalMap = p_camera->FocalPlaneMap();
+    if (type == Camera::Radar || type == Camera::Point || type == Camera::Csm ||
+        detectorMap == NULL || focalMap == NULL) {
+      return false;
+    }
+
+    // Detector extent of the parent image, see CameraDetectorMap::SetParent
+    double startSample = detectorMap->AdjustedStartingSample();
+    double endSample = startSample + p_camera->ParentSamples() * detectorMap->SampleScaleFactor();
+    double startLine = detectorMap->AdjustedStartingLine();
+    double endLine = startLine + p_camera->ParentLines() * detectorMap->LineScaleFactor();
+    if (type == Camera::LineScan) {
+      startLine = focalMap->DetectorLineOffset() - detectorMap->LineScaleFactor();
+      endLine = focalMap->DetectorLineOffset() + detectorMap->LineScaleFactor();
+    }
+    else if (type == Camera::PushFrame) {
+      PushFrameCameraDetectorMap *frameletMap =
+          dynamic_cast<PushFrameCameraDetectorMap *>(detectorMap);
+      if (frameletMap != NULL) {
+        startLine = frameletMap->GetBandFirstDetectorLine();
+        endLine = startLine + frameletMap->frameletHeight();
+      }
+    }
+
+    // Undistorted bounding box of the edges of the detector area
+    const int edgePoints = 16;
+    double minX = DBL_MAX;
+    double maxX = -DBL_MAX;
+    double minY = DBL_MAX;
+    double maxY = -DBL_MAX;
+    for (int edge = 0; edge < 4; edge++) {
+      for (int i = 0; i <= edgePoints; i++) {
+        double fraction = (double) i / edgePoints;
+        double sample = startSample + fraction * (endSample - startSample);
+        double line = startLine + fraction * (endLine - startLine);
+        if (edge == 0) line = startLine;
+        if (edge == 1) line = endLine;
+        if (edge == 2) sample = startSample;
+        if (edge == 3) sample = endSample;
+
+        if (focalMap->SetDetector(sample, line) &&
+            SetFocalPlane(focalMap->FocalPlaneX(), focalMap->FocalPlaneY())) {
+          minX = std::min(minX, p_undistortedFocalPlaneX);
+          maxX = std::max(maxX, p_undistortedFocalPlaneX);
+          minY = std::min(minY, p_undistortedFocalPlaneY);
+          maxY = std::max(maxY, p_undistortedFocalPlaneY);
+        }
+      }
+    }
+    double pitch = p_camera->PixelPitch();
+    if (minX > maxX || minY > maxY || !(pitch > 0.0)) {
+      return false;
+    }
+
+    // Pad the box, and make sure narrow detectors still get a few pixels across
+    double padX = std::max(0.05 * (maxX - minX), 2.0 * pitch);
+    double padY = std::max(0.05 * (maxY - minY), 2.0 * pitch);
+    return BuildInverseGrid(minX - padX, maxX + padX, minY - padY, maxY + padY, pitch / 100.0);
+  }
+
+
+  /**
+   * Build a grid of distorted focal plane coordinates over a rectangle of the
+   * undistorted focal plane, so that SetUndistortedFocalPlaneFromGrid can
+   * interpolate instead of inverting the distortion model.
+   *
+   * The grid nodes are computed with SetUndistortedFocalPlane, so this works
+   * with any distortion model whose inverse only depends on the undistorted
+   * coordinate.  Each cell is verified by comparing its interpolated center to
+   * SetUndistortedFocalPlane.  The grid is refined until every cell is within
+   * the tolerance or maxNodes is reached; cells that are still outside the
+   * tolerance, or that touch a node where SetUndistortedFocalPlane failed,
+   * fall back to SetUndistortedFocalPlane.
+   *
+   * Maps that change their distortion model after the grid is built, such as
+   * band dependent maps, must call ClearInverseGrid.
+   *
+   * @param minX The minimum undistorted focal plane x in millimeters
+   * @param maxX The maximum undistorted focal plane x in millimeters
+   * @param minY The minimum undistorted focal plane y in millimeters
+   * @param maxY The maximum undistorted focal plane y in millimeters
+   * @param tolerance The maximum interpolation error in millimeters
+   * @param maxNodes The maximum number of nodes along each axis
+   *
+   * @return @b bool True if any cell of the grid can be used
+   */
+  bool CameraDistortionMap::BuildInverseGrid(double minX, double maxX, double minY, double maxY,
+                                             double tolerance, int maxNodes) {
+    ClearInverseGrid();
+    if (!(maxX > minX) || !(maxY > minY) || !(tolerance > 0.0) || maxNodes < 2) {
+      QString msg = "Invalid inverse distortion grid of [" + toString(maxNodes) +
+                    "] nodes over x [" + toString(minX) + ", " + toString(maxX) +
+                    "] and y [" + toString(minY) + ", " + toString(maxY) +
+                    "] with a tolerance of [" + toString(tolerance) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    p_gridMinX = minX;
+    p_gridMaxX = maxX;
+    p_gridMinY = minY;
+    p_gridMaxY = maxY;
+
+    // 33, 65, 129, ... nodes, so each refinement halves the cells
+    int nodes = std::min(33, maxNodes);
+    while (!fillInverseGrid(nodes, tolerance) && nodes < maxNodes) {
+      nodes = std::min(2 * nodes - 1, maxNodes);
+    }
+
+    if (std::find(p_gridCellValid.begin(), p_gridCellValid.end(), 1) == p_gridCellValid.end()) {
+      ClearInverseGrid();
+      return false;
+    }
+    return true;
+  }
+
+
+  /**
+   * Fill the grid nodes and verify the cells for a number of nodes per axis.
+   *
+   * @param nodes The number of nodes along each axis
+   * @param tolerance The maximum interpolation error in millimeters
+   *
+   * @return @b bool True if every cell is within the tolerance
+   */
+  bool CameraDistortionMap::fillInverseGrid(int nodes, double tolerance) {
+    // Leave the grid unused while the nodes are computed by iteration
+    p_gridNodes = 0;
+    p_gridScaleX = (nodes - 1) / (p_gridMaxX - p_gridMinX);
+    p_gridScaleY = (nodes - 1) / (p_gridMaxY - p_gridMinY);
+    p_gridX.assign(nodes * nodes, 0.0);
+    p_gridY.assign(nodes * nodes, 0.0);
+    std::vector<char> nodeValid(nodes * nodes, 0);
+
+    for (int j = 0; j < nodes; j++) {
+      double uy = p_gridMinY + j / p_gridScaleY;
+      for (int i = 0; i < nodes; i++) {
+        double ux = p_gridMinX + i / p_gridScaleX;
+        int node = j * nodes + i;
+        if (SetUndistortedFocalPlane(ux, uy)) {
+          p_gridX[node] = p_focalPlaneX;
+          p_gridY[node] = p_focalPlaneY;
+          nodeValid[node] = 1;
+        }
+      }
+    }
+
+    int cells = nodes - 1;
+    p_gridCellValid.assign(cells * cells, 0);
+    bool allValid = true;
+    for (int j = 0; j < cells; j++) {
+      for (int i = 0; i < cells; i++) {
+        int node = j * nodes + i;
+        bool valid = nodeValid[node] && nodeValid[node + 1] &&
+                     nodeValid[node + nodes] && nodeValid[node + nodes + 1];
+
+        // At the cell center the bilinear interpolation is the node average
+        if (valid && SetUndistortedFocalPlane(p_gridMinX + (i + 0.5) / p_gridScaleX,
+                                              p_gridMinY + (j + 0.5) / p_gridScaleY)) {
+          double x = 0.25 * (p_gridX[node] + p_gridX[node + 1] +
+                             p_gridX[node + nodes] + p_gridX[node + nodes + 1]);
+          double y = 0.25 * (p_gridY[node] + p_gridY[node + 1] +
+                             p_gridY[node + nodes] + p_gridY[node + nodes + 1]);
+          valid = fabs(x - p_focalPlaneX) <= tolerance && fabs(y - p_focalPlaneY) <= tolerance;
+        }
+        else {
+          valid = false;
+        }
+
+        p_gridCellValid[j * cells + i] = valid;
+        allValid = allValid && valid;
+      }
+    }
+
+    p_gridNodes = nodes;
+    return allValid;
+  }
+
+
+  /**
+   * Discard the inverse distortion grid, so SetUndistortedFocalPlaneFromGrid
+   * always uses SetUndistortedFocalPlane.
+   */
+  void CameraDistortionMap::ClearInverseGrid() {
+    p_gridNodes = 0;
+    p_gridX.clear();
+    p_gridY.clear();
+    p_gridCellValid.clear();
+  }
+
+
+  /**
+   * @return @b bool True if an inverse distortion grid has been built
+   */
+  bool CameraDistortionMap::HasInverseGrid() const {
+    return p_gridNodes > 0;
+  }
+
+
+  /**
+   * Compute distorted focal plane x/y from the inverse distortion grid.
+   *
+   * If the undistorted coordinate is inside a verified cell of the grid the
+   * distorted coordinate is bilinearly interpolated from the cell's nodes.
+   * Otherwise, or if no grid has been built, this is the same as
+   * SetUndistortedFocalPlane.
+   *
+   * @param ux undistorted focal plane x in millimeters
+   * @param uy undistorted focal plane y in millimeters
+   *
+   * @return @b bool if the conversion was successful
+   * @see BuildInverseGrid
+   */
+  bool CameraDistortionMap::SetUndistortedFocalPlaneFromGrid(double ux, double uy) {
+    if (p_gridNodes > 0 &&
+        ux >= p_gridMinX && ux <= p_gridMaxX && uy >= p_gridMinY && uy <= p_gridMaxY) {
+      double fx = (ux - p_gridMinX) * p_gridScaleX;
+      double fy = (uy - p_gridMinY) * p_gridScaleY;
+      int i = std::min((int) fx, p_gridNodes - 2);
+      int j = std::min((int) fy, p_gridNodes - 2);
+
+      if (p_gridCellValid[j * (p_gridNodes - 1) + i]) {
+        double wx = fx - i;
+        double wy = fy - j;
+        int node = j * p_gridNodes + i;
+        int above = node + p_gridNodes;
+
+        double x0 = p_gridX[node] + wx * (p_gridX[node + 1] - p_gridX[node]);
+        double x1 = p_gridX[above] + wx * (p_gridX[above + 1] - p_gridX[above]);
+        double y0 = p_gridY[node] + wx * (p_gridY[node + 1] - p_gridY[node]);
+        double y1 = p_gridY[above] + wx * (p_gridY[above + 1] - p_gridY[above]);
+
+        p_undistortedFocalPlaneX = ux;
+        p_undistortedFocalPlaneY = uy;
+        p_focalPlaneX = x0 + wy * (x1 - x0);
+        p_focalPlaneY = y0 + wy * (y1 - y0);
+        return true;
+      }
+    }
+
+    return SetUndistortedFocalPlane(ux, uy);
+  }
+
+
   /**
    * Retrieve the distortion coefficients used for this model.
    *
@@ -50,6 +50,13 @@ namespace Isis {
 
       virtual bool SetUndistortedFocalPlane(double ux, double uy);
 
+      bool BuildInverseGrid();
+      bool BuildInverseGrid(double minX, double maxX, double minY, double maxY,
+                            double tolerance, int maxNodes = 257);
+      void ClearInverseGrid();
+      bool HasInverseGrid() const;
+      bool SetUndistortedFocalPlaneFromGrid(double ux, double uy);
+
       std::vector<double> OpticalDistortionCoefficients() const;
 
       double ZDirection() const;
@@ -69,6 +76,20 @@ namespace Isis {
       double p_zDirection;              //!< Undistorted focal plane z
 
       std::vector<double> p_odk;        //!< Vector of distortion coefficients
+
+    private:
+      bool fillInverseGrid(int nodes, double tolerance);
+
+      int p_gridNodes;                  //!< Nodes along each axis of the inverse grid
+      double p_gridMinX;                //!< Undistorted x of the first grid column
+      double p_gridMinY;                //!< Undistorted y of the first grid row
+      double p_gridScaleX;              //!< Grid columns per millimeter
+      double p_gridScaleY;              //!< Grid rows per millimeter
+      double p_gridMaxX;                //!< Undistorted x of the last grid column
+      double p_gridMaxY;                //!< Undistorted y of the last grid row
+      std::vector<double> p_gridX;      //!< Distorted x at each grid node
+      std::vector<double> p_gridY;      //!< Distorted y at each grid node
+      std::vector<char> p_gridCellValid; //!< True for cells that interpolate within tolerance
   };
 };
 #endif
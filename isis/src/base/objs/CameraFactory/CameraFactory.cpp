@@ -14,9 +14,11 @@ find files of those names at the top level of this repository. **/
 #include "CameraFactory.h"
 
 #include "Camera.h"
+#include "CameraDistortionMap.h"
 #include "CSMCamera.h"
 #include "FileName.h"
 #include "IException.h"
+#include "NaifStatus.h"
 #include "Plugin.h"
 #include "Preference.h"
 
@@ -29,7 +31,28 @@ using namespace std;
 
 namespace Isis {
   Plugin CameraFactory::m_cameraPlugin;
+  QHash<QString, int> CameraFactory::m_cameraGroups;
   bool CameraFactory::m_initialized = false;
+  bool CameraFactory::m_csmInitialized = false;
+
+  namespace {
+    /**
+     * Normalizes a plugin group name the way PvlKeyword::stringEqual()
+     * compares names, so the index finds the same groups as Pvl::findGroup().
+     *
+     * @param group The plugin group name
+     *
+     * @return QString The normalized name
+     */
+    QString pluginKey(const QString &group) {
+      QString key;
+      key.reserve(group.size());
+      for (const QChar &c : group) {
+        if (!c.isSpace() && c != '_') key += c.toUpper();
+      }
+      return key;
+    }
+  }
 
   /**
    * Creates a Camera object using Pvl Specifications
@@ -43,16 +66,21 @@ namespace Isis {
    * @throws Isis::iException::Camera - Unable to initialize camera model
    */
   Camera *CameraFactory::Create(Cube &cube) {
+    // Cameras load and read kernels while they are constructed, so only one
+    // thread creates a camera at a time
+    NaifLock lock;
+
     // Try to load a plugin file in the current working directory and then
     // load the system file
 
-    initPlugin();
+    initCameraPlugins();
 
     try {
       // Is there a CSM blob on the cube?
       if (cube.hasBlob("CSMState", "String")) {
         // Create ISIS CSM Camera Model
         try {
+          initCsmPlugins();
           return new CSMCamera(cube);
         }
         catch (IException &e) {
@@ -104,7 +132,16 @@ namespace Isis {
         plugin = (Camera * ( *)(Isis::Cube &cube)) ptr;
 
         // Create the camera as requested
-        return (*plugin)(cube);
+        Camera *camera = (*plugin)(cube);
+
+        // Optionally let the distortion map interpolate its inverse
+        PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+        if (performance.hasKeyword("InverseDistortionGrid") &&
+            QString(performance["InverseDistortionGrid"]).toUpper() == "ON" &&
+            camera->DistortionMap() != NULL) {
+          camera->DistortionMap()->BuildInverseGrid();
+        }
+        return camera;
       }
     }
     catch(IException &e) {
@@ -119,8 +156,18 @@ namespace Isis {
    * directories specified in IsisPreferences for CSM cameras.
    */
   void CameraFactory::initPlugin() {
+    initCameraPlugins();
+    initCsmPlugins();
+  }
+
+
+  /**
+   * Reads the plugin files for the ISIS cameras and indexes the newest group
+   * of each camera. The camera libraries are only loaded when a camera is
+   * created from them.
+   */
+  void CameraFactory::initCameraPlugins() {
     if (!m_initialized) {
-      // Handle the ISIS camera plugins
       if (m_cameraPlugin.fileName() == "") {
         FileName localFile("Camera.plugin");
         if (localFile.fileExists())
@@ -131,9 +178,24 @@ namespace Isis {
           m_cameraPlugin.read(systemFile.expanded());
       }
 
-      // Find the CSM plugins by searching the directories identified in the Preferences.
-      // Load the found libraries. This causes the static instance(s) to be constructed,
-      // and thus registering the model with the csm Plugin class.
+      // Later groups are newer versions of the same camera
+      m_cameraGroups.clear();
+      for (int i = 0; i < m_cameraPlugin.groups(); i++) {
+        m_cameraGroups.insert(pluginKey(m_cameraPlugin.group(i).name()), i);
+      }
+    }
+    m_initialized = true;
+  }
+
+
+  /**
+   * Finds the CSM plugins by searching the directories identified in the
+   * Preferences. Loading the found libraries causes the static instance(s) to
+   * be constructed, and thus registers the model with the csm Plugin class.
+   * This is only done once a CSM camera is needed.
+   */
+  void CameraFactory::initCsmPlugins() {
+    if (!m_csmInitialized) {
       Preference &p = Preference::Preferences();
       PvlGroup &grp = p.findGroup("Plugins", Isis::Pvl::Traverse);
       for (int i = 0; i<grp["CSMDirectory"].size(); i++) {
@@ -147,7 +209,26 @@ namespace Isis {
         }
       }
     }
-    m_initialized = true;
+    m_csmInitialized = true;
+  }
+
+
+  /**
+   * Finds the newest plugin group of a camera.
+   *
+   * @param group The SpacecraftName/InstrumentId name of the camera
+   *
+   * @return const PvlGroup& The plugin group
+   *
+   * @throws IException::Unknown - Unable to find PVL group
+   */
+  const PvlGroup &CameraFactory::findCameraPlugin(const QString &group) {
+    QHash<QString, int>::const_iterator index = m_cameraGroups.constFind(pluginKey(group));
+    if (index == m_cameraGroups.constEnd()) {
+      QString msg = "Unable to find PVL group [" + group + "].";
+      throw IException(IException::Unknown, msg, _FILEINFO_);
+    }
+    return m_cameraPlugin.group(index.value());
   }
 
 
@@ -173,7 +254,7 @@ namespace Isis {
   int CameraFactory::CameraVersion(Pvl &lab) {
     // Try to load a plugin file in the current working directory and then
     // load the system file
-    initPlugin();
+    initCameraPlugins();
 
     try {
       // First get the spacecraft and instrument and combine them
@@ -187,19 +268,8 @@ namespace Isis {
 
       PvlGroup plugin;
       try {
-        bool found = false;
         // Find the most recent (last) version of the camera model
-        for (int i = m_cameraPlugin.groups() - 1; i >= 0; i--) {
-          if (m_cameraPlugin.group(i) == group) {
-            plugin = m_cameraPlugin.group(i);
-            found = true;
-            break;
-          }
-        }
-        if (!found) {
-          QString msg = "Unable to find PVL group [" + group + "].";
-          throw IException(IException::Unknown, msg, _FILEINFO_);
-        }
+        plugin = findCameraPlugin(group);
       }
       catch(IException &e) {
         QString msg = "Unsupported camera model, unable to find plugin for ";
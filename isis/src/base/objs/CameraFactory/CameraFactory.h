@@ -6,6 +6,9 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <QHash>
+#include <QString>
+
 #include "Plugin.h"
 
 namespace Isis {
@@ -57,6 +60,10 @@ namespace Isis {
       static void initPlugin();
 
     private:
+      static void initCameraPlugins();
+      static void initCsmPlugins();
+      static const PvlGroup &findCameraPlugin(const QString &group);
+
       /**
        * Constructor (Its private, so you cannot use it.  Use the Create method
        * instead
@@ -67,7 +74,10 @@ namespace Isis {
       ~CameraFactory() {};
 
       static Plugin m_cameraPlugin;   //!< The plugin file for the camera
+      //! Index of the newest plugin group of each camera, by normalized name
+      static QHash<QString, int> m_cameraGroups;
       static bool m_initialized; //!<Has the plugin list been initialized
+      static bool m_csmInitialized; //!< Have the CSM plugin libraries been loaded
   };
 };
 
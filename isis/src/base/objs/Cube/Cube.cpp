@@ -862,6 +862,9 @@ namespace Isis {
     // if the history does not exist in the cube, this function creates it.
     }
     History history(historyBlob);
+    if (isOpen() && m_attached && !m_tempCube && historyBlob.Size() > 0) {
+      history.setSource(m_labelFileName->expanded(), name, historyBlob.Size());
+    }
     return history;
   }
 
@@ -1095,13 +1098,125 @@ namespace Isis {
    * The History will be written to the Cube as a BLOB and can be accessed
    * using Cube::readHistory.
    *
+   * When the History was read from this cube and the History BLOB has not
+   * changed since, only the new entries are written. They are appended to the
+   * end of the file and listed in the ChunkStartBytes and ChunkBytes keywords
+   * of the BLOB, so adding an entry does not rewrite the whole history. The
+   * history is written in full again when it has too many chunks or the
+   * label has no room for another one.
+   *
    * @param history The history to write to the Cube.
    * @param name The name for the history BLOB. This is used for backwards compatibility
    *             with cubes from before the History BLOB name was standardized.
    */
   void Cube::write(History &history, const QString &name) {
+    if (isOpen() && m_attached && m_labelFile->isWritable() &&
+        appendHistory(history, name)) {
+      return;
+    }
+
     Blob histBlob = history.toBlob(name);
     write(histBlob);
+
+    if (m_attached) {
+      history.setSource(m_labelFileName->expanded(), name, histBlob.Size());
+    }
+  }
+
+
+  /**
+   * Appends the entries added to a History since it was read from or written
+   * to this cube to its History BLOB.
+   *
+   * @param history The history to write to the Cube.
+   * @param name The name of the history BLOB.
+   *
+   * @return @b bool False if the History BLOB is not the one the history
+   *                 was read from, and has to be written in full.
+   */
+  bool Cube::appendHistory(History &history, const QString &name) {
+    QMutexLocker locker(m_mutex);
+    QMutexLocker locker2(m_ioHandler->dataFileMutex());
+
+    PvlObject *historyObject = NULL;
+    for (int i = 0; i < m_label->objects(); i++) {
+      PvlObject &obj = m_label->object(i);
+      if (obj.isNamed("History") && obj.hasKeyword("Name") &&
+          QString(obj["Name"]).toUpper() == name.toUpper()) {
+        historyObject = &obj;
+        break;
+      }
+    }
+    if (!historyObject || historyObject->hasKeyword("^History")) {
+      return false;
+    }
+
+    int bytes = (int) (*historyObject)["Bytes"];
+    if (historyObject->hasKeyword("ChunkBytes")) {
+      const PvlKeyword &chunkBytes = (*historyObject)["ChunkBytes"];
+      for (int i = 0; i < chunkBytes.size(); i++) {
+        bytes += toInt(chunkBytes[i]);
+      }
+    }
+    if (!history.isStoredIn(m_labelFileName->expanded(), name, bytes)) {
+      return false;
+    }
+
+    // Every append adds a chunk to the label, so once there are too many the
+    // history is written in full again as a single chunk
+    const int maxChunks = 16;
+    if (historyObject->hasKeyword("ChunkStartBytes") &&
+        (*historyObject)["ChunkStartBytes"].size() >= maxChunks) {
+      return false;
+    }
+
+    std::string entries = history.unstoredEntries();
+    if (entries.empty()) {
+      return true;
+    }
+
+    fstream stream(m_labelFileName->expanded().toLatin1().data(),
+                   ios::in | ios::out | ios::binary);
+    stream.seekp(0, ios::end);
+
+    // Append after the cube DN data and labels, like a new blob
+    streampos endByte = stream.tellp();
+    streampos maxbyte = (streampos) m_labelBytes;
+    if (m_storesDnData) {
+      maxbyte += (streampos) m_ioHandler->getDataSize();
+    }
+    if (endByte < maxbyte) {
+      stream.seekp(maxbyte, ios::beg);
+    }
+
+    BigInt startByte = (BigInt) stream.tellp() + 1;
+
+    PvlObject original = *historyObject;
+    if (!historyObject->hasKeyword("ChunkStartBytes")) {
+      historyObject->addKeyword(PvlKeyword("ChunkStartBytes"));
+      historyObject->addKeyword(PvlKeyword("ChunkBytes"));
+    }
+    (*historyObject)["ChunkStartBytes"].addValue(toString(startByte));
+    (*historyObject)["ChunkBytes"].addValue(toString((int) entries.size()));
+
+    // Write the history in full if the new chunk does not fit in the label
+    m_label->setFormatTemplate(m_formatTemplateFile->original());
+    ostringstream temp;
+    temp << *m_label << endl;
+    if ((int) temp.str().length() >= m_labelBytes) {
+      *historyObject = original;
+      return false;
+    }
+
+    stream.write(entries.c_str(), entries.size());
+    if (!stream.good()) {
+      *historyObject = original;
+      QString msg = "Error appending to History [" + name + "] in cube [" + fileName() + "]";
+      throw IException(IException::Io, msg, _FILEINFO_);
+    }
+
+    history.setSource(m_labelFileName->expanded(), name, bytes + (int) entries.size());
+    return true;
   }
 
 
@@ -1648,18 +1763,13 @@ namespace Isis {
       throw IException(IException::Programmer, msg, _FILEINFO_);
     }
 
-    int bandStart = band;
-    int bandStop = band;
     int maxSteps = lineCount();
     if (band == 0) {
-      bandStart = 1;
-      bandStop = bandCount();
       maxSteps = lineCount() * bandCount();
     }
 
     Progress progress;
-    Histogram *hist = new ImageHistogram(*this, band, &progress);
-    LineManager line(*this);
+    ImageHistogram *hist = new ImageHistogram(*this, band, &progress);
 
     // This range is for throwing out data; the default parameters are OK always
     //hist->SetValidRange(validMin, validMax);
@@ -1679,19 +1789,12 @@ namespace Isis {
     //hist->SetBinRange(binMin, binMax);
     hist->SetValidRange(binMin,binMax);
 
-    // Loop and get the histogram
+    // Get the histogram, gathering strips of lines in parallel
     progress.SetText(msg);
     progress.SetMaximumSteps(maxSteps);
     progress.CheckStatus();
 
-    for(int useBand = bandStart ; useBand <= bandStop ; useBand++) {
-      for(int i = 1; i <= lineCount(); i++) {
-        line.SetLine(i, useBand);
-        read(line);
-        hist->AddData(line.DoubleBuffer(), line.size());
-        progress.CheckStatus();
-      }
-    }
+    hist->AddCubeData(*this, band, &progress);
 
     return hist;
   }
@@ -1904,6 +2007,20 @@ namespace Isis {
   }
 
 
+  /**
+   * Returns the number of bytes of DN data stored in the cube file, including
+   * the padding of partial tiles.
+   *
+   * @return BigInt The size of the DN data, 0 if the cube does not store DN data
+   */
+  BigInt Cube::dataSize() const {
+    if (!m_storesDnData || !m_ioHandler) {
+      return 0;
+    }
+    return m_ioHandler->getDataSize();
+  }
+
+
   /**
    * This method returns a boolean value
    *
@@ -291,6 +291,7 @@ namespace Isis {
       double base() const;
       ByteOrder byteOrder() const;
       Camera *camera();
+      BigInt dataSize() const;
       FileName externalCubeFileName() const;
       virtual QString fileName() const;
       Format format() const;
@@ -328,6 +329,7 @@ namespace Isis {
 
 
     private:
+      bool appendHistory(History &history, const QString &name);
       void applyVirtualBandsToLabel();
       void cleanUp(bool remove);
 
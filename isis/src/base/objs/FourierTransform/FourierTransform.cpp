@@ -7,8 +7,365 @@ find files of those names at the top level of this repository. **/
 
 #include "FourierTransform.h"
 
+#include <memory>
+
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
+#include "IException.h"
+#include "IString.h"
+
 using namespace std;
 
+namespace {
+  //! Largest prime factor handled directly by the mixed-radix butterflies
+  const int MaxDirectRadix = 61;
+
+  //! Number of columns transformed together by the column pass of the 2D transforms
+  const int ColumnBlockSize = 16;
+
+  /**
+   * Precomputed factorization and twiddle factors for transforms of one
+   * length. Plans are read-only once constructed so a single plan can be
+   * shared by every thread transforming rows (or columns) of an image.
+   */
+  class FftPlan {
+    public:
+      FftPlan(int n);
+
+      /**
+       * @return int The length of the transforms done by this plan
+       */
+      int size() const {
+        return m_n;
+      }
+
+      void execute(const complex<double> *in, complex<double> *out, bool inverse) const;
+
+    private:
+      void forward(const complex<double> *in, complex<double> *out) const;
+      void mixedRadix(complex<double> *out, const complex<double> *in,
+                      int stride, int factorIndex) const;
+      void bluestein(const complex<double> *in, complex<double> *out) const;
+
+      int m_n;                                  //!< Length of the transform
+      vector<int> m_factors;                    //!< Radices, in the order they are applied
+      vector< complex<double> > m_twiddles;     //!< exp(-2 pi i k / n) for k in [0, n)
+
+      bool m_useBluestein;                      //!< True if n has a large prime factor
+      vector< complex<double> > m_chirp;        //!< exp(-pi i k^2 / n) for k in [0, n)
+      vector< complex<double> > m_chirpFilter;  //!< Transformed conjugate chirp
+      unique_ptr<FftPlan> m_convolutionPlan;    //!< Power of two plan for Bluestein
+  };
+
+
+  /**
+   * Factors n and precomputes the twiddle factors. Radix 4 is preferred,
+   * followed by 2 and then odd primes. If n has a prime factor larger than
+   * MaxDirectRadix the transform is computed with Bluestein's algorithm as
+   * a power of two convolution instead.
+   *
+   * @param n The length of the transforms
+   */
+  FftPlan::FftPlan(int n) : m_n(n), m_useBluestein(false) {
+    if (n < 1) {
+      QString msg = "Unable to create a Fourier transform of length [" +
+                    Isis::toString(n) + "]";
+      throw Isis::IException(Isis::IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int remaining = n;
+    while (remaining % 4 == 0) {
+      m_factors.push_back(4);
+      remaining /= 4;
+    }
+    while (remaining % 2 == 0) {
+      m_factors.push_back(2);
+      remaining /= 2;
+    }
+    for (int p = 3; p * p <= remaining; p += 2) {
+      while (remaining % p == 0) {
+        m_factors.push_back(p);
+        remaining /= p;
+      }
+    }
+    if (remaining > 1) {
+      m_factors.push_back(remaining);
+    }
+
+    for (unsigned int i = 0; i < m_factors.size(); i++) {
+      if (m_factors[i] > MaxDirectRadix) {
+        m_useBluestein = true;
+      }
+    }
+
+    if (!m_useBluestein) {
+      m_twiddles.resize(n);
+      for (int k = 0; k < n; k++) {
+        m_twiddles[k] = polar(1.0, -2.0 * Isis::PI * k / n);
+      }
+      return;
+    }
+
+    // Bluestein: X[k] = c[k] * sum_j (x[j] c[j]) conj(c[k-j]) with
+    // c[k] = exp(-pi i k^2 / n), evaluated as a circular convolution of a
+    // power of two length of at least 2n - 1.
+    int m = 1;
+    while (m < 2 * n - 1) {
+      m *= 2;
+    }
+    m_convolutionPlan.reset(new FftPlan(m));
+
+    m_chirp.resize(n);
+    for (int k = 0; k < n; k++) {
+      // k^2 mod 2n keeps the angle small enough to stay accurate
+      long long k2 = ((long long) k * k) % (2LL * n);
+      m_chirp[k] = polar(1.0, -Isis::PI * k2 / n);
+    }
+
+    vector< complex<double> > filter(m, 0.0);
+    filter[0] = conj(m_chirp[0]);
+    for (int k = 1; k < n; k++) {
+      filter[k] = conj(m_chirp[k]);
+      filter[m - k] = conj(m_chirp[k]);
+    }
+    m_chirpFilter.resize(m);
+    m_convolutionPlan->execute(&filter[0], &m_chirpFilter[0], false);
+  }
+
+
+  /**
+   * Transforms one vector. The input and output must not overlap. The
+   * inverse transform is not scaled.
+   *
+   * @param in The n input values
+   * @param out The n output values
+   * @param inverse True for the inverse (positive exponent) transform
+   */
+  void FftPlan::execute(const complex<double> *in, complex<double> *out, bool inverse) const {
+    if (!inverse) {
+      forward(in, out);
+      return;
+    }
+
+    // inverse(x) = conj(forward(conj(x)))
+    vector< complex<double> > conjugated(m_n);
+    for (int i = 0; i < m_n; i++) {
+      conjugated[i] = conj(in[i]);
+    }
+    forward(&conjugated[0], out);
+    for (int i = 0; i < m_n; i++) {
+      out[i] = conj(out[i]);
+    }
+  }
+
+
+  /**
+   * Forward transform of one vector.
+   *
+   * @param in The n input values
+   * @param out The n output values
+   */
+  void FftPlan::forward(const complex<double> *in, complex<double> *out) const {
+    if (m_n == 1) {
+      out[0] = in[0];
+    }
+    else if (m_useBluestein) {
+      bluestein(in, out);
+    }
+    else {
+      mixedRadix(out, in, 1, 0);
+    }
+  }
+
+
+  /**
+   * Recursive decimation in time step. The sub-transforms of every
+   * stride-th input value are computed into consecutive blocks of the
+   * output, which are then combined by the radix p butterflies.
+   *
+   * @param out Output block for this sub-transform
+   * @param in First input value of this sub-transform
+   * @param stride Distance between the input values of this sub-transform
+   * @param factorIndex The index of the radix used at this level
+   */
+  void FftPlan::mixedRadix(complex<double> *out, const complex<double> *in,
+                           int stride, int factorIndex) const {
+    int p = m_factors[factorIndex];
+    int m = m_n / (stride * p);
+
+    if (m == 1) {
+      for (int j = 0; j < p; j++) {
+        out[j] = in[j * stride];
+      }
+    }
+    else {
+      for (int j = 0; j < p; j++) {
+        mixedRadix(out + j * m, in + j * stride, stride * p, factorIndex + 1);
+      }
+    }
+
+    if (p == 2) {
+      for (int k = 0; k < m; k++) {
+        complex<double> t = out[k + m] * m_twiddles[k * stride];
+        out[k + m] = out[k] - t;
+        out[k] += t;
+      }
+    }
+    else if (p == 4) {
+      for (int k = 0; k < m; k++) {
+        complex<double> a = out[k];
+        complex<double> b = out[k + m] * m_twiddles[k * stride];
+        complex<double> c = out[k + 2 * m] * m_twiddles[2 * k * stride];
+        complex<double> d = out[k + 3 * m] * m_twiddles[3 * k * stride];
+
+        complex<double> aPlusC = a + c;
+        complex<double> aMinusC = a - c;
+        complex<double> bPlusD = b + d;
+        // -i * (b - d)
+        complex<double> bMinusDRotated(imag(b) - imag(d), real(d) - real(b));
+
+        out[k] = aPlusC + bPlusD;
+        out[k + m] = aMinusC + bMinusDRotated;
+        out[k + 2 * m] = aPlusC - bPlusD;
+        out[k + 3 * m] = aMinusC - bMinusDRotated;
+      }
+    }
+    else {
+      // generic odd prime radix
+      vector< complex<double> > t(p);
+      int rootStride = stride * m;
+      for (int k = 0; k < m; k++) {
+        for (int j = 0; j < p; j++) {
+          t[j] = out[k + j * m] * m_twiddles[j * k * stride];
+        }
+        for (int q = 0; q < p; q++) {
+          complex<double> sum = t[0];
+          for (int j = 1; j < p; j++) {
+            sum += t[j] * m_twiddles[((j * q) % p) * rootStride];
+          }
+          out[k + q * m] = sum;
+        }
+      }
+    }
+  }
+
+
+  /**
+   * Forward transform of a length with a large prime factor using
+   * Bluestein's chirp-z algorithm.
+   *
+   * @param in The n input values
+   * @param out The n output values
+   */
+  void FftPlan::bluestein(const complex<double> *in, complex<double> *out) const {
+    int m = m_convolutionPlan->size();
+    vector< complex<double> > a(m, 0.0);
+    vector< complex<double> > spectrum(m);
+
+    for (int k = 0; k < m_n; k++) {
+      a[k] = in[k] * m_chirp[k];
+    }
+    m_convolutionPlan->execute(&a[0], &spectrum[0], false);
+
+    for (int k = 0; k < m; k++) {
+      spectrum[k] *= m_chirpFilter[k];
+    }
+    m_convolutionPlan->execute(&spectrum[0], &a[0], true);
+
+    for (int k = 0; k < m_n; k++) {
+      out[k] = m_chirp[k] * a[k] / (double) m;
+    }
+  }
+
+
+  /**
+   * Calls functor(i) for every i in [0, count), spreading the calls over the
+   * global thread pool when more than one thread is available.
+   *
+   * @param count The number of calls
+   * @param functor The thread safe work to do for each index
+   */
+  template <typename Functor>
+  void parallelFor(int count, const Functor &functor) {
+    if (count > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1) {
+      QVector<int> indices(count);
+      for (int i = 0; i < count; i++) {
+        indices[i] = i;
+      }
+      QtConcurrent::blockingMap(indices, [&functor](int &index) { functor(index); });
+    }
+    else {
+      for (int i = 0; i < count; i++) {
+        functor(i);
+      }
+    }
+  }
+
+
+  /**
+   * Transforms every row of a row major image in place.
+   *
+   * @param data The image
+   * @param plan A plan for the row length
+   * @param lines The number of rows
+   * @param inverse True for the (unscaled) inverse transform
+   */
+  void rowPass(vector< complex<double> > &data, const FftPlan &plan, int lines, bool inverse) {
+    int samples = plan.size();
+    parallelFor(lines, [&](int line) {
+      vector< complex<double> > row(data.begin() + (size_t) line * samples,
+                                    data.begin() + (size_t) (line + 1) * samples);
+      plan.execute(&row[0], &data[(size_t) line * samples], inverse);
+    });
+  }
+
+
+  /**
+   * Transforms every column of a row major image in place. Columns are
+   * gathered ColumnBlockSize at a time into a contiguous buffer so the
+   * image is read and written a row segment at a time rather than with a
+   * full row stride per value.
+   *
+   * @param data The image
+   * @param plan A plan for the column length
+   * @param samples The number of columns
+   * @param inverse True for the (unscaled) inverse transform
+   */
+  void columnPass(vector< complex<double> > &data, const FftPlan &plan, int samples, bool inverse) {
+    int lines = plan.size();
+    int blocks = (samples + ColumnBlockSize - 1) / ColumnBlockSize;
+    parallelFor(blocks, [&](int block) {
+      int firstSample = block * ColumnBlockSize;
+      int width = min(ColumnBlockSize, samples - firstSample);
+      vector< complex<double> > columns((size_t) width * lines);
+      vector< complex<double> > transformed(lines);
+
+      for (int line = 0; line < lines; line++) {
+        const complex<double> *row = &data[(size_t) line * samples + firstSample];
+        for (int c = 0; c < width; c++) {
+          columns[(size_t) c * lines + line] = row[c];
+        }
+      }
+
+      for (int c = 0; c < width; c++) {
+        plan.execute(&columns[(size_t) c * lines], &transformed[0], inverse);
+        for (int line = 0; line < lines; line++) {
+          columns[(size_t) c * lines + line] = transformed[line];
+        }
+      }
+
+      for (int line = 0; line < lines; line++) {
+        complex<double> *row = &data[(size_t) line * samples + firstSample];
+        for (int c = 0; c < width; c++) {
+          row[c] = columns[(size_t) c * lines + line];
+        }
+      }
+    });
+  }
+}
+
 namespace Isis {
   //! Constructs the FourierTransform object.
   FourierTransform::FourierTransform() {};
@@ -161,4 +518,212 @@ namespace Isis {
     if(IsPowerOfTwo(n)) return n;
     return(int)pow(2.0, lg(n) + 1);
   }
+
+
+  /**
+   * Applies the Fourier transform (or its inverse) to data of any length
+   * without padding. The inverse is scaled by 1/n so that it undoes the
+   * forward transform, as Inverse() does.
+   *
+   * @param data The data to be transformed, replaced with the result.
+   * @param inverse True to apply the inverse transform.
+   */
+  void FourierTransform::TransformInPlace(std::vector< std::complex<double> > &data,
+                                          bool inverse) {
+    if (data.empty()) return;
+
+    FftPlan plan(data.size());
+    vector< complex<double> > input(data);
+    plan.execute(&input[0], &data[0], inverse);
+
+    if (inverse) {
+      double scale = 1.0 / data.size();
+      for (unsigned int i = 0; i < data.size(); i++) {
+        data[i] *= scale;
+      }
+    }
+  }
+
+
+  /**
+   * Applies the Fourier transform to real data of any length. Since the
+   * transform of real data is conjugate symmetric only the first n/2 + 1
+   * values are returned. For even lengths the even and odd samples are
+   * packed into a single complex transform of half the length.
+   *
+   * @param input The data to be transformed.
+   *
+   * @return vector The non-negative frequency half of the transform.
+   */
+  std::vector< std::complex<double> >
+  FourierTransform::RealTransform(const std::vector<double> &input) {
+    int n = input.size();
+    vector< complex<double> > output(n / 2 + 1);
+    if (n == 0) return vector< complex<double> >();
+
+    if (n % 2 == 1) {
+      vector< complex<double> > full(input.begin(), input.end());
+      TransformInPlace(full);
+      for (int k = 0; k <= n / 2; k++) {
+        output[k] = full[k];
+      }
+      return output;
+    }
+
+    int half = n / 2;
+    FftPlan plan(half);
+    vector< complex<double> > packed(half);
+    vector< complex<double> > z(half);
+    for (int j = 0; j < half; j++) {
+      packed[j] = complex<double>(input[2 * j], input[2 * j + 1]);
+    }
+    plan.execute(&packed[0], &z[0], false);
+
+    // even = (Z[k] + conj(Z[h-k])) / 2, odd = (Z[k] - conj(Z[h-k])) / 2i
+    for (int k = 0; k <= half; k++) {
+      complex<double> zk = z[k % half];
+      complex<double> zc = conj(z[(half - k) % half]);
+      complex<double> even = 0.5 * (zk + zc);
+      complex<double> odd = complex<double>(0.0, -0.5) * (zk - zc);
+      output[k] = even + polar(1.0, -2.0 * PI * k / n) * odd;
+    }
+
+    return output;
+  }
+
+
+  /**
+   * Applies the two dimensional Fourier transform (or its inverse) to an
+   * image of any size. The rows and blocks of columns are transformed in
+   * parallel. The inverse is scaled by 1/(samples * lines).
+   *
+   * @param data The image in row major order, replaced with the result.
+   * @param samples The number of samples (columns) in the image
+   * @param lines The number of lines (rows) in the image
+   * @param inverse True to apply the inverse transform.
+   */
+  void FourierTransform::Transform2D(std::vector< std::complex<double> > &data,
+                                     int samples, int lines, bool inverse) {
+    if (samples < 1 || lines < 1 || data.size() != (size_t) samples * lines) {
+      QString msg = "Image data of size [" + toString((int) data.size()) +
+                    "] does not match the image dimensions [" + toString(samples) +
+                    "] samples by [" + toString(lines) + "] lines";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    FftPlan rowPlan(samples);
+    FftPlan columnPlan(lines);
+    rowPass(data, rowPlan, lines, inverse);
+    columnPass(data, columnPlan, samples, inverse);
+
+    if (inverse) {
+      double scale = 1.0 / ((double) samples * lines);
+      for (unsigned int i = 0; i < data.size(); i++) {
+        data[i] *= scale;
+      }
+    }
+  }
+
+
+  /**
+   * Applies the two dimensional Fourier transform to a real image of any
+   * size. Pairs of rows are transformed together as the real and imaginary
+   * parts of one complex row and only the non-negative frequency columns
+   * are transformed; the remaining columns are filled in from conjugate
+   * symmetry.
+   *
+   * @param data The image in row major order
+   * @param samples The number of samples (columns) in the image
+   * @param lines The number of lines (rows) in the image
+   *
+   * @return vector The full complex transform in row major order.
+   */
+  std::vector< std::complex<double> >
+  FourierTransform::RealTransform2D(const std::vector<double> &data, int samples, int lines) {
+    if (samples < 1 || lines < 1 || data.size() != (size_t) samples * lines) {
+      QString msg = "Image data of size [" + toString((int) data.size()) +
+                    "] does not match the image dimensions [" + toString(samples) +
+                    "] samples by [" + toString(lines) + "] lines";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    int half = samples / 2 + 1;
+    vector< complex<double> > spectrum((size_t) half * lines);
+    FftPlan rowPlan(samples);
+
+    parallelFor((lines + 1) / 2, [&](int pair) {
+      int firstLine = 2 * pair;
+      bool haveSecond = firstLine + 1 < lines;
+      const double *a = &data[(size_t) firstLine * samples];
+      const double *b = haveSecond ? &data[(size_t) (firstLine + 1) * samples] : NULL;
+
+      vector< complex<double> > packed(samples);
+      vector< complex<double> > z(samples);
+      for (int i = 0; i < samples; i++) {
+        packed[i] = complex<double>(a[i], b ? b[i] : 0.0);
+      }
+      rowPlan.execute(&packed[0], &z[0], false);
+
+      for (int k = 0; k < half; k++) {
+        complex<double> zk = z[k];
+        complex<double> zc = conj(z[(samples - k) % samples]);
+        spectrum[(size_t) firstLine * half + k] = 0.5 * (zk + zc);
+        if (haveSecond) {
+          spectrum[(size_t) (firstLine + 1) * half + k] = complex<double>(0.0, -0.5) * (zk - zc);
+        }
+      }
+    });
+
+    FftPlan columnPlan(lines);
+    columnPass(spectrum, columnPlan, half, false);
+
+    vector< complex<double> > output((size_t) samples * lines);
+    for (int line = 0; line < lines; line++) {
+      int mirrorLine = (lines - line) % lines;
+      for (int k = 0; k < samples; k++) {
+        if (k < half) {
+          output[(size_t) line * samples + k] = spectrum[(size_t) line * half + k];
+        }
+        else {
+          output[(size_t) line * samples + k] =
+              conj(spectrum[(size_t) mirrorLine * half + (samples - k)]);
+        }
+      }
+    }
+
+    return output;
+  }
+
+
+  /**
+   * Checks to see if the input integer has no prime factors other than 2, 3
+   * and 5. Transforms of these lengths are the fastest after powers of two.
+   *
+   * @param n The input integer
+   *
+   * @return bool - Returns true if the input is 2, 3, 5 smooth
+   */
+  bool FourierTransform::IsFastSize(int n) {
+    if (n < 1) return false;
+    while (n % 2 == 0) n /= 2;
+    while (n % 3 == 0) n /= 3;
+    while (n % 5 == 0) n /= 5;
+    return n == 1;
+  }
+
+
+  /**
+   * This function returns the smallest integer greater than or equal to n
+   * with no prime factors other than 2, 3 and 5. Padding to this size
+   * wastes much less space than padding to a power of two.
+   *
+   * @param n The input integer
+   *
+   * @return int - the next fast transform length
+   */
+  int FourierTransform::NextFastSize(int n) {
+    if (n < 1) return 1;
+    while (!IsFastSize(n)) n++;
+    return n;
+  }
 }
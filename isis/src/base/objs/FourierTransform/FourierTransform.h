@@ -21,6 +21,15 @@ namespace Isis {
    * Fourier (or frequency) domain. The inverse transform takes data
    * from the frequency domain to the spatial.
    *
+   * Transform() and Inverse() operate on a single vector whose length is
+   * padded to a power of two. Transform2D() and RealTransform2D() operate on
+   * whole images stored in row major (sample fastest) order. They support any
+   * length through a mixed-radix algorithm (with Bluestein's algorithm for
+   * lengths containing large prime factors), transform columns in cache sized
+   * blocks and spread the rows and column blocks over the global thread pool.
+   * RealTransform() and RealTransform2D() take advantage of real valued input
+   * to do roughly half the work of the complex transforms.
+   *
    * If you would like to see FourierTransform being used
    *         in implementation, see fft.cpp or ifft.cpp.
    *
@@ -40,6 +49,18 @@ namespace Isis {
       int lg(int n);
       int BitReverse(int n, int x);
       int NextPowerOfTwo(int n);
+
+      void TransformInPlace(std::vector< std::complex<double> > &data,
+                            bool inverse = false);
+      std::vector< std::complex<double> > RealTransform(const std::vector<double> &input);
+
+      void Transform2D(std::vector< std::complex<double> > &data,
+                       int samples, int lines, bool inverse = false);
+      std::vector< std::complex<double> > RealTransform2D(const std::vector<double> &data,
+                                                          int samples, int lines);
+
+      bool IsFastSize(int n);
+      int NextFastSize(int n);
   };
 }
 
@@ -0,0 +1,146 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "FusedCameraPipeline.h"
+
+#include <typeinfo>
+#include <vector>
+
+#include "Camera.h"
+#include "CameraDetectorMap.h"
+#include "CameraFocalPlaneMap.h"
+#include "CameraGroundMap.h"
+#include "Distance.h"
+#include "EllipsoidShape.h"
+#include "RadialDistortionMap.h"
+#include "SpicePosition.h"
+#include "SpiceRotation.h"
+#include "Target.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Copies the orientation of a camera at its current time for a fused
+   * pipeline.  Only framing cameras of unprojected cubes looking at a target
+   * through the base CameraGroundMap are accepted, so the orientation is the
+   * same for every pixel.
+   *
+   * @param camera The camera
+   * @param instrumentRotation Returns the J2000 to camera rotation
+   * @param bodyRotation Returns the J2000 to body-fixed rotation
+   * @param observer Returns the body-fixed spacecraft position in kilometers
+   *
+   * @return bool False if the camera can not use a fused pipeline
+   */
+  bool setUpFusedOrientation(Camera *camera, double instrumentRotation[9],
+                             double bodyRotation[9], double observer[3]) {
+    if (camera->GetCameraType() != Camera::Framing || camera->HasProjection() ||
+        !camera->isTimeSet() || camera->target()->isSky() || !camera->GroundMap() ||
+        typeid(*camera->GroundMap()) != typeid(CameraGroundMap)) {
+      return false;
+    }
+
+    vector<double> instrumentMatrix = camera->instrumentRotation()->Matrix();
+    vector<double> bodyMatrix = camera->bodyRotation()->Matrix();
+    const vector<double> &position = camera->bodyRotation()->ReferenceVector(
+        camera->instrumentPosition()->Coordinate());
+    for (int i = 0; i < 9; i++) {
+      instrumentRotation[i] = instrumentMatrix[i];
+      bodyRotation[i] = bodyMatrix[i];
+    }
+    for (int i = 0; i < 3; i++) {
+      observer[i] = position[i];
+    }
+    return true;
+  }
+
+
+  /**
+   * Copies the detector map of a camera.
+   *
+   * @param camera The camera
+   *
+   * @return bool False if the camera does not use the base CameraDetectorMap
+   */
+  bool FramingDetectorStage::setUp(Camera *camera) {
+    CameraDetectorMap *detectorMap = camera->DetectorMap();
+    if (!detectorMap || typeid(*detectorMap) != typeid(CameraDetectorMap)) {
+      return false;
+    }
+
+    m_alphaCube = camera->alphaCube();
+    m_sampleSumming = detectorMap->SampleScaleFactor();
+    m_lineSumming = detectorMap->LineScaleFactor();
+    m_startingSample = detectorMap->AdjustedStartingSample();
+    m_startingLine = detectorMap->AdjustedStartingLine();
+    return true;
+  }
+
+
+  /**
+   * Copies the focal plane map of a camera.
+   *
+   * @param camera The camera
+   *
+   * @return bool False if the camera does not use the base CameraFocalPlaneMap
+   */
+  bool AffineFocalPlaneStage::setUp(Camera *camera) {
+    CameraFocalPlaneMap *focalPlaneMap = camera->FocalPlaneMap();
+    if (!focalPlaneMap || typeid(*focalPlaneMap) != typeid(CameraFocalPlaneMap)) {
+      return false;
+    }
+
+    for (int i = 0; i < 3; i++) {
+      m_transX[i] = focalPlaneMap->TransX()[i];
+      m_transY[i] = focalPlaneMap->TransY()[i];
+    }
+    m_sampleOrigin = focalPlaneMap->DetectorSampleOrigin();
+    m_lineOrigin = focalPlaneMap->DetectorLineOrigin();
+    return true;
+  }
+
+
+  /**
+   * Copies the distortion map of a camera.
+   *
+   * @param camera The camera
+   *
+   * @return bool False if the camera does not use a RadialDistortionMap
+   */
+  bool RadialDistortionStage::setUp(Camera *camera) {
+    CameraDistortionMap *distortionMap = camera->DistortionMap();
+    if (!distortionMap || typeid(*distortionMap) != typeid(RadialDistortionMap)) {
+      return false;
+    }
+
+    m_k1 = static_cast<RadialDistortionMap *>(distortionMap)->K1();
+    m_z = distortionMap->UndistortedFocalPlaneZ();
+    return true;
+  }
+
+
+  /**
+   * Copies the radii of the target of a camera.
+   *
+   * @param camera The camera
+   *
+   * @return bool False if the shape model of the target is not an EllipsoidShape
+   */
+  bool EllipsoidSurfaceStage::setUp(Camera *camera) {
+    ShapeModel *shape = camera->target()->shape();
+    if (!shape || typeid(*shape) != typeid(EllipsoidShape)) {
+      return false;
+    }
+
+    vector<Distance> radii = camera->target()->radii();
+    m_a = radii[0].kilometers();
+    m_b = radii[1].kilometers();
+    m_c = radii[2].kilometers();
+    return true;
+  }
+}
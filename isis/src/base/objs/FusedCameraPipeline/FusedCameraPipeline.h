@@ -0,0 +1,305 @@
+#ifndef FusedCameraPipeline_h
+#define FusedCameraPipeline_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <cmath>
+
+#include <SpiceUsr.h>
+
+#include "AlphaCube.h"
+#include "Constants.h"
+#include "ShapeModel.h"
+#include "SpecialPixel.h"
+
+namespace Isis {
+  class Camera;
+
+  bool setUpFusedOrientation(Camera *camera, double instrumentRotation[9],
+                             double bodyRotation[9], double observer[3]);
+
+  /**
+   * Detector stage of a fused camera pipeline for a camera with the base
+   * CameraDetectorMap.  Converts cube coordinates to parent coordinates with
+   * the AlphaCube of the camera and then to detector coordinates.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   */
+  class FramingDetectorStage {
+    public:
+      bool setUp(Camera *camera);
+
+      /**
+       * Computes the detector coordinate of a cube coordinate.
+       *
+       * @param sample The cube sample
+       * @param line The cube line
+       * @param detectorSample Returns the detector sample
+       * @param detectorLine Returns the detector line
+       */
+      inline void toDetector(double sample, double line,
+                             double &detectorSample, double &detectorLine) const {
+        detectorSample = (m_alphaCube.AlphaSample(sample) - 1.0) * m_sampleSumming +
+                         m_startingSample;
+        detectorLine = (m_alphaCube.AlphaLine(line) - 1.0) * m_lineSumming + m_startingLine;
+      }
+
+    private:
+      AlphaCube m_alphaCube;   //!< Crop and scale of the cube from its parent
+      double m_sampleSumming;  //!< Detector sample summing
+      double m_lineSumming;    //!< Detector line summing
+      double m_startingSample; //!< Starting detector sample adjusted for summing
+      double m_startingLine;   //!< Starting detector line adjusted for summing
+  };
+
+
+  /**
+   * Focal plane stage of a fused camera pipeline for a camera with the base
+   * CameraFocalPlaneMap, an affine transform of the centered detector
+   * coordinate.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   */
+  class AffineFocalPlaneStage {
+    public:
+      bool setUp(Camera *camera);
+
+      /**
+       * Computes the distorted focal plane coordinate of a detector coordinate.
+       *
+       * @param detectorSample The detector sample
+       * @param detectorLine The detector line
+       * @param x Returns the focal plane x in millimeters
+       * @param y Returns the focal plane y in millimeters
+       */
+      inline void toFocalPlane(double detectorSample, double detectorLine,
+                               double &x, double &y) const {
+        double sample = detectorSample - m_sampleOrigin;
+        double line = detectorLine - m_lineOrigin;
+        x = m_transX[0] + (m_transX[1] * sample) + (m_transX[2] * line);
+        y = m_transY[0] + (m_transY[1] * sample) + (m_transY[2] * line);
+      }
+
+    private:
+      double m_transX[3];    //!< Detector to focal plane x coefficients
+      double m_transY[3];    //!< Detector to focal plane y coefficients
+      double m_sampleOrigin; //!< Detector sample of the focal plane origin
+      double m_lineOrigin;   //!< Detector line of the focal plane origin
+  };
+
+
+  /**
+   * Distortion stage of a fused camera pipeline for a camera with a
+   * RadialDistortionMap, a single radial coefficient.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   */
+  class RadialDistortionStage {
+    public:
+      bool setUp(Camera *camera);
+
+      /**
+       * Removes the distortion from a focal plane coordinate.
+       *
+       * @param x The distorted focal plane x
+       * @param y The distorted focal plane y
+       * @param look Returns the undistorted look direction in the camera frame
+       */
+      inline void undistort(double x, double y, double look[3]) const {
+        double offsetSqrd = x * x + y * y;
+        look[0] = x * (1.0 + m_k1 * offsetSqrd);
+        look[1] = y * (1.0 + m_k1 * offsetSqrd);
+        look[2] = m_z;
+      }
+
+    private:
+      double m_k1; //!< Radial distortion coefficient
+      double m_z;  //!< Undistorted focal plane z, the signed focal length
+  };
+
+
+  /**
+   * Surface stage of a fused camera pipeline for a target with an
+   * EllipsoidShape.
+   *
+   * @author 2026-10-18 ISIS Development Team
+   */
+  class EllipsoidSurfaceStage {
+    public:
+      bool setUp(Camera *camera);
+
+      /**
+       * Intersects a body-fixed ray with the ellipsoid.
+       *
+       * @param observer The body-fixed position of the observer in kilometers
+       * @param look The body-fixed look direction
+       * @param point Returns the body-fixed intersection in kilometers
+       *
+       * @return bool True if the ray hits the ellipsoid
+       */
+      inline bool intersect(const double observer[3], const double look[3],
+                            double point[3]) const {
+        return ShapeModel::rayEllipsoidIntersection(observer, look, m_a, m_b, m_c, point);
+      }
+
+    private:
+      double m_a; //!< Semi-axis along x in kilometers
+      double m_b; //!< Semi-axis along y in kilometers
+      double m_c; //!< Semi-axis along z in kilometers
+  };
+
+
+  /**
+   * @brief Maps batches of pixels to the ground without the virtual camera chain
+   *
+   * Camera::SetImage walks the detector, focal plane, distortion and ground
+   * maps and the shape model through virtual calls, keeping the state of each
+   * step in the map objects.  A FusedCameraPipeline composes concrete stages
+   * for a common camera configuration at compile time, so mapping a batch of
+   * pixels is one inlined loop.
+   *
+   * setUp() only accepts a camera whose maps and shape are exactly the ones
+   * the stages reproduce and whose time does not change from pixel to pixel.
+   * Every other camera stays on the dynamic chain.  The pipeline copies the
+   * pointing and position of the current time and band, so it must be set up
+   * again after the camera changes either.
+   *
+   * @ingroup Camera
+   *
+   * @author 2026-10-18 ISIS Development Team
+   */
+  template <typename Detector, typename FocalPlane, typename Distortion, typename Surface>
+  class FusedCameraPipeline {
+    public:
+      /**
+       * Sets up the pipeline from a camera at its current time.
+       *
+       * @param camera The camera to copy the stages and orientation from
+       *
+       * @return bool False if the camera does not match the stages, in which
+       *              case the pipeline must not be used
+       */
+      bool setUp(Camera *camera) {
+        m_valid = setUpFusedOrientation(camera, m_instrumentRotation, m_bodyRotation,
+                                        m_observer) &&
+                  m_detector.setUp(camera) && m_focalPlane.setUp(camera) &&
+                  m_distortion.setUp(camera) && m_surface.setUp(camera);
+        return m_valid;
+      }
+
+
+      /**
+       * Returns if the last setUp() succeeded.
+       *
+       * @return bool True if the pipeline can be used
+       */
+      bool isValid() const {
+        return m_valid;
+      }
+
+
+      /**
+       * Maps a batch of cube coordinates to the ground.  Pixels that miss the
+       * target get Null latitudes, longitudes and radii.
+       *
+       * @param count The number of pixels
+       * @param samples The cube samples
+       * @param lines The cube lines
+       * @param latitudes Returns the planetocentric latitudes in degrees
+       * @param longitudes Returns the positive east longitudes in degrees,
+       *                   from 0 to 360
+       * @param radii Returns the local radii in meters
+       *
+       * @return int The number of pixels that hit the target
+       */
+      int mapImage(int count, const double *samples, const double *lines,
+                   double *latitudes, double *longitudes, double *radii) const {
+        int hits = 0;
+        for (int i = 0; i < count; i++) {
+          double detectorSample, detectorLine;
+          m_detector.toDetector(samples[i], lines[i], detectorSample, detectorLine);
+
+          double x, y;
+          m_focalPlane.toFocalPlane(detectorSample, detectorLine, x, y);
+
+          double lookC[3];
+          m_distortion.undistort(x, y, lookC);
+          vhat_c(lookC, lookC);
+
+          double lookB[3];
+          lookToBodyFixed(lookC, lookB);
+
+          double point[3];
+          if (m_surface.intersect(m_observer, lookB, point)) {
+            toGround(point, latitudes[i], longitudes[i], radii[i]);
+            hits++;
+          }
+          else {
+            latitudes[i] = Null;
+            longitudes[i] = Null;
+            radii[i] = Null;
+          }
+        }
+        return hits;
+      }
+
+    private:
+      /**
+       * Rotates a look direction from the camera frame to the body-fixed
+       * frame through J2000, the way Sensor::SetLookDirection does.
+       */
+      inline void lookToBodyFixed(const double lookC[3], double lookB[3]) const {
+        double lookJ[3];
+        for (int i = 0; i < 3; i++) {
+          lookJ[i] = m_instrumentRotation[i] * lookC[0] +
+                     m_instrumentRotation[3 + i] * lookC[1] +
+                     m_instrumentRotation[6 + i] * lookC[2];
+        }
+        for (int i = 0; i < 3; i++) {
+          lookB[i] = m_bodyRotation[3 * i] * lookJ[0] +
+                     m_bodyRotation[3 * i + 1] * lookJ[1] +
+                     m_bodyRotation[3 * i + 2] * lookJ[2];
+        }
+      }
+
+
+      /**
+       * Converts a body-fixed point in kilometers to latitude, longitude and
+       * radius, the way SurfacePoint does.
+       */
+      inline static void toGround(const double point[3], double &latitude,
+                                  double &longitude, double &radius) {
+        double x = point[0] * 1000.0;
+        double y = point[1] * 1000.0;
+        double z = point[2] * 1000.0;
+
+        latitude = atan2(z, sqrt(x * x + y * y)) * RAD2DEG;
+        double lon = (x == 0.0 && y == 0.0) ? 0.0 : atan2(y, x);
+        if (lon < 0) {
+          lon += 2 * PI;
+        }
+        longitude = lon * RAD2DEG;
+        radius = sqrt(x * x + y * y + z * z);
+      }
+
+      Detector m_detector;             //!< Cube to detector stage
+      FocalPlane m_focalPlane;         //!< Detector to focal plane stage
+      Distortion m_distortion;         //!< Distortion removal stage
+      Surface m_surface;               //!< Ground intersection stage
+      double m_instrumentRotation[9];  //!< J2000 to camera rotation
+      double m_bodyRotation[9];        //!< J2000 to body-fixed rotation
+      double m_observer[3];            //!< Body-fixed spacecraft position in kilometers
+      bool m_valid = false;            //!< If the last setUp() succeeded
+  };
+
+
+  //! Framing camera with a single coefficient radial distortion and an ellipsoid target
+  typedef FusedCameraPipeline<FramingDetectorStage, AffineFocalPlaneStage,
+                              RadialDistortionStage, EllipsoidSurfaceStage>
+          FramingRadialEllipsoidPipeline;
+}
+
+#endif
@@ -0,0 +1,580 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "GeometryLookup.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "Camera.h"
+#include "Constants.h"
+#include "Cube.h"
+#include "FusedCameraPipeline.h"
+#include "IException.h"
+#include "IString.h"
+#include "LineManager.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "SpecialPixel.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+using namespace std;
+
+namespace Isis {
+
+  /**
+   * Computes the lookup grids of a camera.  The image to ground grid has a
+   * node every spacing pixels, including the last sample and line of the
+   * image.  The ground to image grid covers the latitude and longitude range
+   * of the image to ground nodes with about as many nodes.
+   *
+   * @param camera The camera of the image
+   * @param samples The number of samples in the image
+   * @param lines The number of lines in the image
+   * @param spacing The number of pixels between grid nodes
+   * @param progress Reports the progress of the computation, if not NULL
+   *
+   * @throws IException::User "No pixels of the image intersect the target"
+   */
+  GeometryLookup::GeometryLookup(Camera *camera, int samples, int lines, int spacing,
+                                 Progress *progress) {
+    initializeGrid(samples, lines, spacing);
+    m_latitudeNodes = max(m_lineNodes, 2);
+    m_longitudeNodes = max(m_sampleNodes, 2);
+
+    if (progress) {
+      progress->SetText("Computing lookup grids");
+      progress->SetMaximumSteps(m_lineNodes + m_latitudeNodes);
+      progress->CheckStatus();
+    }
+
+    // Cameras with a fused pipeline map each line of nodes as one batch
+    FramingRadialEllipsoidPipeline pipeline;
+    pipeline.setUp(camera);
+    vector<double> nodeSamples(m_sampleNodes);
+    for (int i = 0; i < m_sampleNodes; i++) {
+      nodeSamples[i] = nodeCoordinate(i, m_samples);
+    }
+
+    for (int j = 0; j < m_lineNodes; j++) {
+      double line = nodeCoordinate(j, m_lines);
+      if (pipeline.isValid()) {
+        vector<double> nodeLines(m_sampleNodes, line);
+        int first = m_nodeLatitudes.size();
+        m_nodeLatitudes.resize(first + m_sampleNodes);
+        m_nodeLongitudes.resize(first + m_sampleNodes);
+        m_nodeRadii.resize(first + m_sampleNodes);
+        pipeline.mapImage(m_sampleNodes, nodeSamples.data(), nodeLines.data(),
+                          &m_nodeLatitudes[first], &m_nodeLongitudes[first], &m_nodeRadii[first]);
+      }
+      else {
+        for (int i = 0; i < m_sampleNodes; i++) {
+          if (camera->SetImage(nodeSamples[i], line)) {
+            m_nodeLatitudes.push_back(camera->UniversalLatitude());
+            m_nodeLongitudes.push_back(camera->UniversalLongitude());
+            m_nodeRadii.push_back(camera->LocalRadius().meters());
+          }
+          else {
+            m_nodeLatitudes.push_back(Null);
+            m_nodeLongitudes.push_back(Null);
+            m_nodeRadii.push_back(Null);
+          }
+        }
+      }
+      if (progress) progress->CheckStatus();
+    }
+    computeDirections();
+
+    // Unwrap the longitudes around the center of the image so that images
+    // crossing the longitude seam get a continuous range
+    int reference = (m_lineNodes / 2) * m_sampleNodes + m_sampleNodes / 2;
+    for (int k = 0; k < (int) m_nodeLatitudes.size() && IsSpecial(m_nodeLatitudes[reference]); k++) {
+      reference = k;
+    }
+    if (IsSpecial(m_nodeLatitudes[reference])) {
+      QString msg = "No pixels of the image intersect the target";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    double referenceLongitude = m_nodeLongitudes[reference];
+    m_minimumLatitude = m_maximumLatitude = m_nodeLatitudes[reference];
+    m_minimumLongitude = m_maximumLongitude = referenceLongitude;
+    for (int k = 0; k < (int) m_nodeLatitudes.size(); k++) {
+      if (IsSpecial(m_nodeLatitudes[k])) continue;
+      double longitude = referenceLongitude +
+                         remainder(m_nodeLongitudes[k] - referenceLongitude, 360.0);
+      m_minimumLatitude = min(m_minimumLatitude, m_nodeLatitudes[k]);
+      m_maximumLatitude = max(m_maximumLatitude, m_nodeLatitudes[k]);
+      m_minimumLongitude = min(m_minimumLongitude, longitude);
+      m_maximumLongitude = max(m_maximumLongitude, longitude);
+    }
+
+    // Pad the range by a node on each side, the pixels between the outer
+    // nodes and the edge of the image can fall outside it
+    double latitudePad = max((m_maximumLatitude - m_minimumLatitude) / (m_latitudeNodes - 1),
+                             1.0e-6);
+    double longitudePad = max((m_maximumLongitude - m_minimumLongitude) / (m_longitudeNodes - 1),
+                              1.0e-6);
+    m_minimumLatitude = max(m_minimumLatitude - latitudePad, -90.0);
+    m_maximumLatitude = min(m_maximumLatitude + latitudePad, 90.0);
+    m_minimumLongitude -= longitudePad;
+    m_maximumLongitude = min(m_maximumLongitude + longitudePad, m_minimumLongitude + 360.0);
+
+    for (int j = 0; j < m_latitudeNodes; j++) {
+      double latitude = m_minimumLatitude +
+                        (m_maximumLatitude - m_minimumLatitude) * j / (m_latitudeNodes - 1);
+      for (int i = 0; i < m_longitudeNodes; i++) {
+        double longitude = m_minimumLongitude +
+                           (m_maximumLongitude - m_minimumLongitude) * i / (m_longitudeNodes - 1);
+        longitude = fmod(longitude, 360.0);
+        if (longitude < 0.0) longitude += 360.0;
+
+        // Nodes a little outside the image help the interpolation at its edges
+        double sample = Null;
+        double line = Null;
+        if (camera->SetUniversalGround(latitude, longitude) &&
+            camera->Sample() > 0.5 - m_spacing && camera->Sample() < m_samples + 0.5 + m_spacing &&
+            camera->Line() > 0.5 - m_spacing && camera->Line() < m_lines + 0.5 + m_spacing) {
+          sample = camera->Sample();
+          line = camera->Line();
+        }
+        m_groundSamples.push_back(sample);
+        m_groundLines.push_back(line);
+      }
+      if (progress) progress->CheckStatus();
+    }
+  }
+
+
+  /**
+   * Reads the lookup grids from a lookup cube written by write().
+   *
+   * @param lookupCube The lookup cube
+   *
+   * @throws IException::User "The cube is not a geometry lookup cube"
+   */
+  GeometryLookup::GeometryLookup(Cube &lookupCube) {
+    if (!lookupCube.hasGroup("GeometryLookup") || !lookupCube.hasTable("ImageToGround") ||
+        !lookupCube.hasTable("GroundToImage")) {
+      QString msg = "The cube [" + lookupCube.fileName() + "] is not a geometry lookup "
+                    "cube, create one with camlookup";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+
+    PvlGroup &group = lookupCube.group("GeometryLookup");
+    initializeGrid(toInt(group["Samples"][0]), toInt(group["Lines"][0]),
+                   toInt(group["Spacing"][0]));
+    if (group.hasKeyword("From")) {
+      m_from = group["From"][0];
+    }
+    if (group.hasKeyword("SerialNumber")) {
+      m_serialNumber = group["SerialNumber"][0];
+    }
+
+    Table imageToGround = lookupCube.readTable("ImageToGround");
+    if (imageToGround.Records() != m_sampleNodes * m_lineNodes) {
+      QString msg = "The ImageToGround table of [" + lookupCube.fileName() + "] has [" +
+                    toString(imageToGround.Records()) + "] records, expected [" +
+                    toString(m_sampleNodes * m_lineNodes) + "]";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    for (int k = 0; k < imageToGround.Records(); k++) {
+      m_nodeLatitudes.push_back((double) imageToGround[k]["Latitude"]);
+      m_nodeLongitudes.push_back((double) imageToGround[k]["Longitude"]);
+      m_nodeRadii.push_back((double) imageToGround[k]["Radius"]);
+    }
+    computeDirections();
+
+    Table groundToImage = lookupCube.readTable("GroundToImage");
+    PvlObject &label = groundToImage.Label();
+    m_minimumLatitude = toDouble(label["MinimumLatitude"][0]);
+    m_maximumLatitude = toDouble(label["MaximumLatitude"][0]);
+    m_minimumLongitude = toDouble(label["MinimumLongitude"][0]);
+    m_maximumLongitude = toDouble(label["MaximumLongitude"][0]);
+    m_latitudeNodes = toInt(label["LatitudeNodes"][0]);
+    m_longitudeNodes = toInt(label["LongitudeNodes"][0]);
+    if (m_latitudeNodes < 2 || m_longitudeNodes < 2 ||
+        groundToImage.Records() != m_latitudeNodes * m_longitudeNodes) {
+      QString msg = "The GroundToImage table of [" + lookupCube.fileName() + "] has [" +
+                    toString(groundToImage.Records()) + "] records, expected [" +
+                    toString(m_latitudeNodes * m_longitudeNodes) + "]";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    for (int k = 0; k < groundToImage.Records(); k++) {
+      m_groundSamples.push_back((double) groundToImage[k]["Sample"]);
+      m_groundLines.push_back((double) groundToImage[k]["Line"]);
+    }
+  }
+
+
+  //! Destroys the GeometryLookup
+  GeometryLookup::~GeometryLookup() {
+  }
+
+
+  /**
+   * Writes the lookup grids to a cube.  The cube must already be created with
+   * SampleNodes() samples, LineNodes() lines and three bands.
+   *
+   * @param lookupCube The cube to write
+   * @param from The name of the image the grids describe, recorded in the label
+   * @param serialNumber The serial number of the image the grids describe,
+   *                     recorded in the label
+   *
+   * @throws IException::Programmer "The cube does not have the dimensions of the grid"
+   */
+  void GeometryLookup::write(Cube &lookupCube, const QString &from,
+                             const QString &serialNumber) const {
+    if (lookupCube.sampleCount() != m_sampleNodes || lookupCube.lineCount() != m_lineNodes ||
+        lookupCube.bandCount() != 3) {
+      QString msg = "The cube [" + lookupCube.fileName() + "] must have [" +
+                    toString(m_sampleNodes) + "] samples, [" + toString(m_lineNodes) +
+                    "] lines and [3] bands to hold the lookup grid";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    const vector<double> *bands[] = {&m_nodeLatitudes, &m_nodeLongitudes, &m_nodeRadii};
+    LineManager line(lookupCube);
+    for (line.begin(); !line.end(); line++) {
+      const vector<double> &values = *bands[line.Band() - 1];
+      int first = (line.Line() - 1) * m_sampleNodes;
+      for (int i = 0; i < line.size(); i++) {
+        line[i] = values[first + i];
+      }
+      lookupCube.write(line);
+    }
+
+    PvlGroup group("GeometryLookup");
+    if (!from.isEmpty()) {
+      group += PvlKeyword("From", from);
+    }
+    if (!serialNumber.isEmpty()) {
+      group += PvlKeyword("SerialNumber", serialNumber);
+    }
+    group += PvlKeyword("Samples", toString(m_samples));
+    group += PvlKeyword("Lines", toString(m_lines));
+    group += PvlKeyword("Spacing", toString(m_spacing), "pixels");
+    lookupCube.putGroup(group);
+
+    PvlGroup bandBin("BandBin");
+    PvlKeyword names("Name");
+    names += "Latitude";
+    names += "Longitude";
+    names += "Radius";
+    bandBin += names;
+    lookupCube.putGroup(bandBin);
+
+    TableField latitude("Latitude", TableField::Double);
+    TableField longitude("Longitude", TableField::Double);
+    TableField radius("Radius", TableField::Double);
+    TableRecord groundRecord;
+    groundRecord += latitude;
+    groundRecord += longitude;
+    groundRecord += radius;
+    Table imageToGround("ImageToGround", groundRecord);
+    imageToGround.Label() += PvlKeyword("SampleNodes", toString(m_sampleNodes));
+    imageToGround.Label() += PvlKeyword("LineNodes", toString(m_lineNodes));
+    for (int k = 0; k < (int) m_nodeLatitudes.size(); k++) {
+      groundRecord[0] = m_nodeLatitudes[k];
+      groundRecord[1] = m_nodeLongitudes[k];
+      groundRecord[2] = m_nodeRadii[k];
+      imageToGround += groundRecord;
+    }
+    lookupCube.write(imageToGround);
+
+    TableField sample("Sample", TableField::Double);
+    TableField lineField("Line", TableField::Double);
+    TableRecord imageRecord;
+    imageRecord += sample;
+    imageRecord += lineField;
+    Table groundToImage("GroundToImage", imageRecord);
+    groundToImage.Label() += PvlKeyword("MinimumLatitude", toString(m_minimumLatitude));
+    groundToImage.Label() += PvlKeyword("MaximumLatitude", toString(m_maximumLatitude));
+    groundToImage.Label() += PvlKeyword("MinimumLongitude", toString(m_minimumLongitude));
+    groundToImage.Label() += PvlKeyword("MaximumLongitude", toString(m_maximumLongitude));
+    groundToImage.Label() += PvlKeyword("LatitudeNodes", toString(m_latitudeNodes));
+    groundToImage.Label() += PvlKeyword("LongitudeNodes", toString(m_longitudeNodes));
+    for (int k = 0; k < (int) m_groundSamples.size(); k++) {
+      imageRecord[0] = m_groundSamples[k];
+      imageRecord[1] = m_groundLines[k];
+      groundToImage += imageRecord;
+    }
+    lookupCube.write(groundToImage);
+  }
+
+
+  /**
+   * Sets the image coordinate and interpolates its ground point.
+   *
+   * @param sample The sample of the image
+   * @param line The line of the image
+   *
+   * @return bool False if the coordinate is outside the image or the grid
+   *              nodes around it missed the target
+   */
+  bool GeometryLookup::SetImage(double sample, double line) {
+    if (sample < 0.5 || line < 0.5 || sample > m_samples + 0.5 || line > m_lines + 0.5) {
+      return false;
+    }
+
+    double latitude, longitude, radius;
+    if (!interpolate(sample, line, latitude, longitude, radius)) return false;
+
+    m_sample = sample;
+    m_line = line;
+    m_latitude = latitude;
+    m_longitude = longitude;
+    m_radius = radius;
+    return true;
+  }
+
+
+  /**
+   * Sets the ground point and finds the image coordinate it maps to.
+   *
+   * @param latitude The planetocentric latitude in degrees
+   * @param longitude The positive east longitude in degrees
+   *
+   * @return bool False if the ground point is not in the image
+   */
+  bool GeometryLookup::SetUniversalGround(double latitude, double longitude) {
+    double sample, line;
+    if (!guess(latitude, longitude, sample, line)) return false;
+
+    // Refine the guess so that it maps back to the ground point through the
+    // image to ground grid, measuring the misses on the ground in degrees
+    // east and north
+    // East misses are scaled by the cosine of the latitude, so at the poles
+    // the east derivatives vanish and the Newton step is singular
+    double cosLatitude = cos(latitude * DEG2RAD);
+    if (cosLatitude < 1.0e-10) return false;
+    const double step = 0.1;
+    bool converged = false;
+    double nodeLatitude, nodeLongitude, radius;
+    for (int iteration = 0; iteration < 20 && !converged; iteration++) {
+      if (sample < 0.5 - m_spacing || sample > m_samples + 0.5 + m_spacing ||
+          line < 0.5 - m_spacing || line > m_lines + 0.5 + m_spacing) {
+        return false;
+      }
+
+      double sampleLatitude, sampleLongitude, lineLatitude, lineLongitude, unused;
+      if (!interpolate(sample, line, nodeLatitude, nodeLongitude, radius) ||
+          !interpolate(sample + step, line, sampleLatitude, sampleLongitude, unused) ||
+          !interpolate(sample, line + step, lineLatitude, lineLongitude, unused)) {
+        return false;
+      }
+
+      double east = remainder(longitude - nodeLongitude, 360.0) * cosLatitude;
+      double north = latitude - nodeLatitude;
+      double eastBySample = remainder(sampleLongitude - nodeLongitude, 360.0) * cosLatitude / step;
+      double northBySample = (sampleLatitude - nodeLatitude) / step;
+      double eastByLine = remainder(lineLongitude - nodeLongitude, 360.0) * cosLatitude / step;
+      double northByLine = (lineLatitude - nodeLatitude) / step;
+
+      // Compare the determinant to the size of the derivatives so a nearly
+      // singular step (or a NaN) is rejected rather than divided by
+      double determinant = eastBySample * northByLine - eastByLine * northBySample;
+      double scale = (fabs(eastBySample) + fabs(eastByLine)) *
+                     (fabs(northBySample) + fabs(northByLine));
+      if (!(fabs(determinant) > 1.0e-12 * scale)) return false;
+
+      double sampleStep = (east * northByLine - eastByLine * north) / determinant;
+      double lineStep = (eastBySample * north - east * northBySample) / determinant;
+      sample += sampleStep;
+      line += lineStep;
+      converged = (sampleStep * sampleStep + lineStep * lineStep < 1.0e-8);
+    }
+
+    if (!converged) return false;
+    if (sample < 0.5 || line < 0.5 || sample > m_samples + 0.5 || line > m_lines + 0.5) {
+      return false;
+    }
+    if (!interpolate(sample, line, nodeLatitude, nodeLongitude, radius)) return false;
+
+    m_sample = sample;
+    m_line = line;
+    m_latitude = latitude;
+    m_longitude = fmod(longitude, 360.0);
+    if (m_longitude < 0.0) m_longitude += 360.0;
+    m_radius = radius;
+    return true;
+  }
+
+
+  /**
+   * Sets up the image to ground grid dimensions and clears the last point.
+   */
+  void GeometryLookup::initializeGrid(int samples, int lines, int spacing) {
+    if (samples < 1 || lines < 1 || spacing < 1) {
+      QString msg = "Invalid lookup grid of [" + toString(samples) + "] samples, [" +
+                    toString(lines) + "] lines and a spacing of [" + toString(spacing) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_samples = samples;
+    m_lines = lines;
+    m_spacing = spacing;
+    m_sampleNodes = (samples - 2 + spacing) / spacing + 1;
+    m_lineNodes = (lines - 2 + spacing) / spacing + 1;
+
+    m_latitude = Null;
+    m_longitude = Null;
+    m_radius = Null;
+    m_sample = Null;
+    m_line = Null;
+  }
+
+
+  /**
+   * Converts the image to ground nodes to body-fixed unit vectors, which
+   * interpolate across the longitude seam and near the poles.
+   */
+  void GeometryLookup::computeDirections() {
+    m_nodeDirections.assign(3 * m_nodeLatitudes.size(), 0.0);
+    for (int k = 0; k < (int) m_nodeLatitudes.size(); k++) {
+      if (IsSpecial(m_nodeLatitudes[k])) continue;
+      double latitude = m_nodeLatitudes[k] * DEG2RAD;
+      double longitude = m_nodeLongitudes[k] * DEG2RAD;
+      m_nodeDirections[3 * k] = cos(latitude) * cos(longitude);
+      m_nodeDirections[3 * k + 1] = cos(latitude) * sin(longitude);
+      m_nodeDirections[3 * k + 2] = sin(latitude);
+    }
+  }
+
+
+  /**
+   * @return double The image coordinate of a grid node, the last node is on
+   *                the last pixel of the image
+   */
+  double GeometryLookup::nodeCoordinate(int node, int size) const {
+    return min(1.0 + (double) node * m_spacing, (double) size);
+  }
+
+
+  /**
+   * Finds the grid cell containing an image coordinate, or the nearest cell
+   * if it is outside the grid.
+   *
+   * @param coordinate The sample or line
+   * @param nodes The number of grid nodes in that direction
+   * @param size The number of pixels in that direction
+   * @param node Returns the first node of the cell
+   * @param weight Returns the weight of the second node of the cell
+   */
+  void GeometryLookup::cell(double coordinate, int nodes, int size,
+                            int &node, double &weight) const {
+    if (nodes == 1) {
+      node = 0;
+      weight = 0.0;
+      return;
+    }
+
+    node = (int) floor((coordinate - 1.0) / m_spacing);
+    node = max(0, min(node, nodes - 2));
+    double first = nodeCoordinate(node, size);
+    double second = nodeCoordinate(node + 1, size);
+    weight = (coordinate - first) / (second - first);
+  }
+
+
+  /**
+   * Interpolates the ground point of an image coordinate from the four
+   * nearest image to ground nodes.
+   *
+   * @return bool False if any of the nodes missed the target
+   */
+  bool GeometryLookup::interpolate(double sample, double line, double &latitude,
+                                   double &longitude, double &radius) const {
+    int i, j;
+    double sampleWeight, lineWeight;
+    cell(sample, m_sampleNodes, m_samples, i, sampleWeight);
+    cell(line, m_lineNodes, m_lines, j, lineWeight);
+    int nextSample = min(i + 1, m_sampleNodes - 1);
+    int nextLine = min(j + 1, m_lineNodes - 1);
+
+    int nodes[4] = {j * m_sampleNodes + i, j * m_sampleNodes + nextSample,
+                    nextLine * m_sampleNodes + i, nextLine * m_sampleNodes + nextSample};
+    double weights[4] = {(1.0 - sampleWeight) * (1.0 - lineWeight),
+                         sampleWeight * (1.0 - lineWeight),
+                         (1.0 - sampleWeight) * lineWeight,
+                         sampleWeight * lineWeight};
+
+    double direction[3] = {0.0, 0.0, 0.0};
+    radius = 0.0;
+    for (int k = 0; k < 4; k++) {
+      if (IsSpecial(m_nodeLatitudes[nodes[k]])) return false;
+      direction[0] += weights[k] * m_nodeDirections[3 * nodes[k]];
+      direction[1] += weights[k] * m_nodeDirections[3 * nodes[k] + 1];
+      direction[2] += weights[k] * m_nodeDirections[3 * nodes[k] + 2];
+      radius += weights[k] * m_nodeRadii[nodes[k]];
+    }
+
+    double equatorial = hypot(direction[0], direction[1]);
+    if (equatorial == 0.0 && direction[2] == 0.0) return false;
+    latitude = atan2(direction[2], equatorial) * RAD2DEG;
+    longitude = atan2(direction[1], direction[0]) * RAD2DEG;
+    if (longitude < 0.0) longitude += 360.0;
+    return true;
+  }
+
+
+  /**
+   * Interpolates the image coordinate of a ground point from the ground to
+   * image grid.  Where some of the surrounding nodes missed the image the
+   * nearest node that hit is used.
+   *
+   * @return bool False if the ground point is outside the grid or none of
+   *              the surrounding nodes hit the image
+   */
+  bool GeometryLookup::guess(double latitude, double longitude,
+                             double &sample, double &line) const {
+    double unwrapped = m_minimumLongitude + fmod(longitude - m_minimumLongitude, 360.0);
+    if (unwrapped < m_minimumLongitude) unwrapped += 360.0;
+    if (latitude < m_minimumLatitude || latitude > m_maximumLatitude ||
+        unwrapped > m_maximumLongitude) {
+      return false;
+    }
+
+    double column = (unwrapped - m_minimumLongitude) /
+                    (m_maximumLongitude - m_minimumLongitude) * (m_longitudeNodes - 1);
+    double row = (latitude - m_minimumLatitude) /
+                 (m_maximumLatitude - m_minimumLatitude) * (m_latitudeNodes - 1);
+    int i = min((int) column, m_longitudeNodes - 2);
+    int j = min((int) row, m_latitudeNodes - 2);
+    double columnWeight = column - i;
+    double rowWeight = row - j;
+
+    int nodes[4] = {j * m_longitudeNodes + i, j * m_longitudeNodes + i + 1,
+                    (j + 1) * m_longitudeNodes + i, (j + 1) * m_longitudeNodes + i + 1};
+    double weights[4] = {(1.0 - columnWeight) * (1.0 - rowWeight),
+                         columnWeight * (1.0 - rowWeight),
+                         (1.0 - columnWeight) * rowWeight,
+                         columnWeight * rowWeight};
+
+    sample = 0.0;
+    line = 0.0;
+    int valid = 0;
+    int nearest = -1;
+    for (int k = 0; k < 4; k++) {
+      if (IsSpecial(m_groundSamples[nodes[k]])) continue;
+      valid++;
+      sample += weights[k] * m_groundSamples[nodes[k]];
+      line += weights[k] * m_groundLines[nodes[k]];
+      if (nearest < 0 || weights[k] > weights[nearest]) nearest = k;
+    }
+
+    if (valid == 0) return false;
+    if (valid < 4) {
+      sample = m_groundSamples[nodes[nearest]];
+      line = m_groundLines[nodes[nearest]];
+    }
+    return true;
+  }
+}
@@ -0,0 +1,161 @@
+#ifndef GeometryLookup_h
+#define GeometryLookup_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <vector>
+
+#include <QString>
+
+#include "Distance.h"
+
+namespace Isis {
+  class Camera;
+  class Cube;
+  class Progress;
+
+  /**
+   * @brief Image to ground lookup grid of a camera
+   *
+   * Holds the ground coordinates of a sub-sampled grid of image pixels, and a
+   * grid of the image coordinates of ground points over the area the image
+   * covers, so that images can be projected repeatedly without the camera
+   * model. The grids are computed once from the camera and written to a
+   * lookup cube, see camlookup.
+   *
+   * The ground point of a pixel is interpolated bilinearly between the
+   * nearest grid nodes. The pixel of a ground point starts from the
+   * interpolated inverse grid and is refined with Newton's method on the
+   * image to ground grid, so the two directions agree with each other.
+   *
+   * The lookup cube has one pixel per grid node with the Latitude, Longitude
+   * and Radius bands for display. The grids are read from the ImageToGround
+   * and GroundToImage tables, which keep the full double precision.
+   *
+   * @ingroup Geometry
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class GeometryLookup {
+    public:
+      GeometryLookup(Camera *camera, int samples, int lines, int spacing,
+                     Progress *progress = NULL);
+      GeometryLookup(Cube &lookupCube);
+      ~GeometryLookup();
+
+      void write(Cube &lookupCube, const QString &from = "",
+                 const QString &serialNumber = "") const;
+
+      bool SetImage(double sample, double line);
+      bool SetUniversalGround(double latitude, double longitude);
+
+      //! @return The planetocentric latitude of the last point set, in degrees
+      double UniversalLatitude() const {
+        return m_latitude;
+      }
+
+      //! @return The positive east longitude of the last point set, 0 to 360 degrees
+      double UniversalLongitude() const {
+        return m_longitude;
+      }
+
+      //! @return The radius of the last point set
+      Distance LocalRadius() const {
+        return Distance(m_radius, Distance::Meters);
+      }
+
+      //! @return The sample of the last point set
+      double Sample() const {
+        return m_sample;
+      }
+
+      //! @return The line of the last point set
+      double Line() const {
+        return m_line;
+      }
+
+      //! @return The number of samples in the image
+      int Samples() const {
+        return m_samples;
+      }
+
+      //! @return The number of lines in the image
+      int Lines() const {
+        return m_lines;
+      }
+
+      //! @return The number of pixels between grid nodes
+      int Spacing() const {
+        return m_spacing;
+      }
+
+      //! @return The number of grid nodes across the image
+      int SampleNodes() const {
+        return m_sampleNodes;
+      }
+
+      //! @return The number of grid nodes down the image
+      int LineNodes() const {
+        return m_lineNodes;
+      }
+
+
+      //! @return The name of the image the grids were made from, empty if unknown
+      QString From() const {
+        return m_from;
+      }
+
+
+      //! @return The serial number of the image the grids were made from, empty if unknown
+      QString ImageSerialNumber() const {
+        return m_serialNumber;
+      }
+
+    private:
+      void initializeGrid(int samples, int lines, int spacing);
+      void computeDirections();
+      double nodeCoordinate(int node, int size) const;
+      void cell(double coordinate, int nodes, int size, int &node, double &weight) const;
+      bool interpolate(double sample, double line, double &latitude, double &longitude,
+                       double &radius) const;
+      bool guess(double latitude, double longitude, double &sample, double &line) const;
+
+      int m_samples;     //!< The number of samples in the image
+      int m_lines;       //!< The number of lines in the image
+      int m_spacing;     //!< The number of pixels between grid nodes
+      int m_sampleNodes; //!< The number of grid nodes across the image
+      int m_lineNodes;   //!< The number of grid nodes down the image
+      QString m_from;         //!< The name of the image the grids were made from
+      QString m_serialNumber; //!< The serial number of the image the grids were made from
+
+      //! Latitude of each image to ground node, by line then sample, Null if it missed
+      std::vector<double> m_nodeLatitudes;
+      std::vector<double> m_nodeLongitudes; //!< Longitude of each image to ground node
+      std::vector<double> m_nodeRadii;      //!< Radius of each image to ground node in meters
+      std::vector<double> m_nodeDirections; //!< Body-fixed unit vector of each node
+
+      double m_minimumLatitude;  //!< Latitude of the first row of the inverse grid
+      double m_maximumLatitude;  //!< Latitude of the last row of the inverse grid
+      double m_minimumLongitude; //!< Longitude of the first column of the inverse grid
+      double m_maximumLongitude; //!< Longitude of the last column of the inverse grid
+      int m_latitudeNodes;       //!< The number of rows in the inverse grid
+      int m_longitudeNodes;      //!< The number of columns in the inverse grid
+
+      //! Sample of each ground to image node, by latitude then longitude, Null if it missed
+      std::vector<double> m_groundSamples;
+      std::vector<double> m_groundLines; //!< Line of each ground to image node
+
+      double m_latitude;  //!< Latitude of the last point set
+      double m_longitude; //!< Longitude of the last point set
+      double m_radius;    //!< Radius of the last point set in meters
+      double m_sample;    //!< Sample of the last point set
+      double m_line;      //!< Line of the last point set
+  };
+}
+
+#endif
@@ -311,6 +311,30 @@ namespace Isis {
     }
   }
 
+  /**
+   * Add the bin counts and statistics of another histogram, for example one
+   * filled on another thread, to this one. Both histograms must have the same
+   * bins and bin range.
+   *
+   * @param other The histogram to add to this one
+   *
+   * @throws IException::Programmer The histograms have different bins
+   */
+  void Histogram::Merge(const Histogram &other) {
+    if (other.p_bins.size() != p_bins.size() ||
+        other.BinRangeStart() != BinRangeStart() || other.BinRangeEnd() != BinRangeEnd()) {
+      string msg = "Cannot merge a histogram of [" + IString((int)other.p_bins.size()) +
+                   "] bins into a histogram of [" + IString((int)p_bins.size()) +
+                   "] bins with a different bin range";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    Statistics::Merge(other);
+    for (unsigned int i = 0; i < p_bins.size(); i++) {
+      p_bins[i] += other.p_bins[i];
+    }
+  }
+
   /**
    * Returns the median.
    *
@@ -93,6 +93,7 @@ namespace Isis {
       virtual void AddData(const double *data, const unsigned int count);
       virtual void AddData(const double data);
       virtual void RemoveData(const double *data, const unsigned int count);
+      void Merge(const Histogram &other);
 
       double Median() const;
       double Mode() const;
@@ -91,6 +91,73 @@ namespace Isis {
   }
 
 
+  /**
+   * Records that this history, with all of its entries, is stored in the
+   * History blob of a cube. Cube::write appends only the entries added after
+   * this to the blob while it is unchanged.
+   *
+   * @param fileName The expanded name of the cube file
+   * @param name Name of the History blob in the cube
+   * @param bytes Number of bytes in the History blob
+   */
+  void History::setSource(const QString &fileName, const QString &name, int bytes) {
+    p_sourceFile = fileName;
+    p_sourceName = name;
+    p_sourceBytes = bytes;
+    p_storedEntries = p_history.objects();
+  }
+
+
+  /**
+   * Checks whether the entries recorded with setSource are still the contents
+   * of a History blob.
+   *
+   * @param fileName The expanded name of the cube file
+   * @param name Name of the History blob in the cube
+   * @param bytes Number of bytes the History blob has in the cube now
+   *
+   * @return @b bool True if the blob holds the stored entries
+   */
+  bool History::isStoredIn(const QString &fileName, const QString &name, int bytes) const {
+    return p_sourceBytes > 0 && bytes == p_sourceBytes &&
+           fileName == p_sourceFile && name.compare(p_sourceName, Qt::CaseInsensitive) == 0;
+  }
+
+
+  /**
+   * Returns the number of bytes of history stored in the source cube.
+   *
+   * @return @b int Bytes recorded by setSource, or 0
+   */
+  int History::storedBytes() const {
+    return p_sourceBytes;
+  }
+
+
+  /**
+   * Formats the entries added since setSource, to be appended to the stored
+   * History blob. Appending them gives the same entries as toBlob.
+   *
+   * @return @b std::string The formatted entries, empty if there are none
+   */
+  std::string History::unstoredEntries() const {
+    if (p_storedEntries >= p_history.objects()) {
+      return "";
+    }
+
+    Pvl entries;
+    entries.setTerminator("");
+    for (int i = p_storedEntries; i < p_history.objects(); i++) {
+      entries.addObject(p_history.object(i));
+    }
+
+    ostringstream ostr;
+    if (p_sourceBytes > 0) ostr << std::endl;
+    ostr << entries;
+    return ostr.str();
+  }
+
+
   /**
    * Reads p_histBuffer into a pvl
    *
@@ -47,10 +47,19 @@ namespace Isis {
 
       Blob toBlob(const QString &name = "IsisCube");
 
+      void setSource(const QString &fileName, const QString &name, int bytes);
+      bool isStoredIn(const QString &fileName, const QString &name, int bytes) const;
+      int storedBytes() const;
+      std::string unstoredEntries() const;
+
     private:
       Pvl p_history; //!< History Pvl
       char *p_histBuffer = nullptr; //!< Store for read in history data
       int p_bufferSize = 0;
+      QString p_sourceFile; //!< Cube file the history is stored in
+      QString p_sourceName; //!< Name of the History blob in p_sourceFile
+      int p_sourceBytes = 0; //!< Bytes of history stored in p_sourceFile
+      int p_storedEntries = 0; //!< Entries in p_history stored in p_sourceFile
   };
 };
 
@@ -13,6 +13,7 @@ find files of those names at the top level of this repository. **/
 #include "FileName.h"
 #include "JP2Exporter.h"
 #include "PixelType.h"
+#include "PngExporter.h"
 #include "ProcessExport.h"
 #include "QtExporter.h"
 #include "TiffExporter.h"
@@ -102,7 +103,7 @@ namespace Isis {
                             QString compression) {
     ProcessExport &p = process();
     if (!p.HasInputRange()) p.SetInputRange();
-    p.ProcessCubes(*this);
+    exportChannels();
     
     outputName = outputName.addExtension(m_extension);
     
@@ -110,6 +111,16 @@ namespace Isis {
   }
 
 
+  /**
+   * Runs the stretched input channels through the write method a line at a
+   * time.  Exporters that can write the image in pieces override this to
+   * process the channels in parallel strips.
+   */
+  void ImageExporter::exportChannels() {
+    process().ProcessCubes(*this);
+  }
+
+
   /**
    * Number of samples (columns) in the output image.
    *
@@ -378,8 +389,9 @@ namespace Isis {
    * has knowledge of whether or not it can write a particular format.  Because
    * the ability to export an image format is not mutually exclusive amongst
    * exporters, the order of condieration here matters.  For example, using a
-   * TIFF exporter takes precedence over a Qt exporter for TIFF images, because
-   * the former can process cubes greater than 2GB while the latter cannot.  It
+   * TIFF or PNG exporter takes precedence over a Qt exporter for those formats,
+   * because the former can process cubes greater than 2GB while the latter
+   * cannot.  It
    * is the caller's responsibility to delete the exporter instance when they
    * are finished with it.
    *
@@ -397,6 +409,9 @@ namespace Isis {
     else if (JP2Exporter::canWriteFormat(format)) {
       exporter = new JP2Exporter();
     }
+    else if (PngExporter::canWriteFormat(format)) {
+      exporter = new PngExporter();
+    }
     else if (QtExporter::canWriteFormat(format)) {
       exporter = new QtExporter(format);
     }
@@ -99,6 +99,8 @@ namespace Isis {
 
       virtual void initialize(ExportDescription &desc) = 0;
 
+      virtual void exportChannels();
+
       // member variable mutators
       void setExtension(QString extension);
       void setExportDescription(ExportDescription &desc);
@@ -6,18 +6,84 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "ImageHistogram.h"
 
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "Brick.h"
 #include "ControlNet.h"
 #include "ControlMeasure.h"
 
+#include <algorithm>
 #include <iostream>
 #include <math.h>
 #include <stdio.h>
 #include <string>
+#include <vector>
 
 using namespace std;
 
 namespace Isis {
+  namespace {
+    //! The number of lines each thread reads and accumulates at a time
+    const int linesPerStrip = 64;
+
+    /**
+     * Accumulates a region of a cube in strips of lines that are gathered in
+     * parallel. Each strip is added to a copy of the empty prototype and the
+     * copies are merged into the total in cube order, so the result does not
+     * depend on the thread scheduling. The progress is checked once per line.
+     *
+     * @param cube The cube to read
+     * @param total The accumulator the region is merged into
+     * @param prototype An empty accumulator with the same setup as total
+     */
+    template <typename Accumulator>
+    void accumulateCube(Cube &cube, Accumulator &total, const Accumulator &prototype,
+                        int startBand, int endBand, int startSample, int samples,
+                        int startLine, int endLine, Progress *progress) {
+      int lines = endLine - startLine + 1;
+      if (samples < 1 || lines < 1) return;
+
+      int stripsPerBand = (lines + linesPerStrip - 1) / linesPerStrip;
+      int strips = stripsPerBand * (endBand - startBand + 1);
+      int batchSize = max(1, QThreadPool::globalInstance()->maxThreadCount());
+
+      for (int firstStrip = 0; firstStrip < strips; firstStrip += batchSize) {
+        QVector<int> batch;
+        for (int strip = firstStrip; strip < min(strips, firstStrip + batchSize); strip++) {
+          batch.append(strip);
+        }
+        vector<Accumulator> partial(batch.size(), prototype);
+
+        auto gatherStrip = [&](int &strip) {
+          int line = startLine + (strip % stripsPerBand) * linesPerStrip;
+          int band = startBand + strip / stripsPerBand;
+          Brick data(samples, min(linesPerStrip, endLine - line + 1), 1, cube.pixelType());
+          data.SetBasePosition(startSample, line, band);
+          cube.read(data);
+          partial[strip - firstStrip].AddData(data.DoubleBuffer(), data.size());
+        };
+        if (batch.size() > 1) {
+          QtConcurrent::blockingMap(batch, gatherStrip);
+        }
+        else {
+          gatherStrip(batch[0]);
+        }
+
+        for (int i = 0; i < batch.size(); i++) {
+          total.Merge(partial[i]);
+          if (progress != NULL) {
+            int line = startLine + (batch[i] % stripsPerBand) * linesPerStrip;
+            for (int l = line; l < min(endLine + 1, line + linesPerStrip); l++) {
+              progress->CheckStatus();
+            }
+          }
+        }
+      }
+    }
+  }
+
 
   /**
    * Constructs a histogram object. Only data between the minimum and maximum
@@ -61,35 +127,19 @@ namespace Isis {
                        endSample, endLine);
 
     if (addCubeData) {
-      Brick cubeDataBrick((int)(endSample - startSample + 1),
-                          1, 1, cube.pixelType());
+      if (startLine == Null) startLine = 1.0;
+      if (endLine == Null) endLine = cube.lineCount();
 
       // if band == 0, then we're gathering data for all bands.
-      int startBand = statsBand;
-      int endBand = statsBand;
-
-      if (statsBand == 0) {
-        startBand = 1;
-        endBand = cube.bandCount();
-      }
+      int bands = (statsBand == 0) ? cube.bandCount() : 1;
 
       if (progress != NULL) {
         progress->SetText("Gathering histogram");
-        progress->SetMaximumSteps(
-          (int)(endLine - startLine + 1) * (int)(endBand - startBand + 1));
+        progress->SetMaximumSteps((int)(endLine - startLine + 1) * bands);
         progress->CheckStatus();
       }
 
-      for (int band = startBand; band <= endBand; band++) {
-        for (int line = (int)startLine; line <= endLine; line++) {
-          cubeDataBrick.SetBasePosition(qRound(startSample), line, band);
-          cube.read(cubeDataBrick);
-          AddData(cubeDataBrick.DoubleBuffer(), cubeDataBrick.size());
-          if (progress != NULL) {
-            progress->CheckStatus();
-          }
-        }
-      }
+      AddCubeData(cube, statsBand, progress, startSample, startLine, endSample, endLine);
     }
   }
 
@@ -162,8 +212,6 @@ namespace Isis {
     // If we still need our min/max DN values, find them.
     if (minDnValue == Null || maxDnValue == Null) {
 
-      Brick cubeDataBrick((int)(endSample - startSample + 1),
-                          1, 1, cube.pixelType() );
       Statistics stats;
 
       // if band == 0, then we're gathering stats for all bands. I'm really
@@ -185,18 +233,8 @@ namespace Isis {
         progress->CheckStatus();
       }
 
-      for (int band = startBand; band <= endBand; band++) {
-        for (int line = (int)startLine; line <= endLine; line++) {
-
-          cubeDataBrick.SetBasePosition(qRound(startSample), line, band);
-          cube.read(cubeDataBrick);
-          stats.AddData(cubeDataBrick.DoubleBuffer(), cubeDataBrick.size());
-
-          if (progress != NULL) {
-            progress->CheckStatus();
-          }
-        }
-      }
+      accumulateCube(cube, stats, Statistics(), startBand, endBand, qRound(startSample),
+                     (int)(endSample - startSample + 1), (int)startLine, (int)endLine, progress);
 
       if (stats.ValidPixels() == 0) {
         minDnValue = 0.0;
@@ -247,6 +285,45 @@ namespace Isis {
     }
   }
 
+  /**
+   * Add a region of a cube to the histogram. The region is read in strips of
+   * lines that are binned in parallel and merged, which gives the same
+   * histogram as adding the region line by line. The progress is checked once
+   * per line but is not set up.
+   *
+   * @param cube  The cube to read the data from
+   * @param statsBand  The band to add, or 0 for every band
+   * @param progress  The Progress object to check as lines are added
+   * @param startSample  The sample to start reading cube data from
+   * @param startLine  The line to start reading cube data from
+   * @param endSample  The sample to stop reading cube data at (Null for nsamps)
+   * @param endLine  The line to stop reading cube data at (Null for nlines)
+   */
+  void ImageHistogram::AddCubeData(Cube &cube, int statsBand, Progress *progress,
+                                   double startSample, double startLine,
+                                   double endSample, double endLine) {
+    if ( (statsBand < 0) || (statsBand > cube.bandCount() ) ) {
+      string msg = "Cannot gather histogram for band [" + IString(statsBand) +
+          "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    if (startSample == Null) startSample = 1.0;
+    if (endSample == Null) endSample = cube.sampleCount();
+    if (startLine == Null) startLine = 1.0;
+    if (endLine == Null) endLine = cube.lineCount();
+
+    int startBand = (statsBand == 0) ? 1 : statsBand;
+    int endBand = (statsBand == 0) ? cube.bandCount() : statsBand;
+
+    // The copy keeps the bins and ranges of this histogram but none of its data
+    ImageHistogram empty(*this);
+    empty.Reset();
+    accumulateCube(cube, *this, empty, startBand, endBand, qRound(startSample),
+                   (int)(endSample - startSample + 1), (int)startLine, (int)endLine, progress);
+  }
+
+
   /**
    * Add a single double data to the histogram.  Of course this can be invoke multiple times.
    * e.g. once for each residual in a network for instance.
@@ -52,6 +52,10 @@ namespace Isis {
       virtual void AddData(const double data);
       virtual void RemoveData(const double *data, const unsigned int count);
 
+      void AddCubeData(Cube &cube, int statsBand, Progress *progress = NULL,
+                       double startSample = 1.0, double startLine = 1.0,
+                       double endSample = Null, double endLine = Null);
+
       virtual void BinRange(const int index, double &low, double &high) const;
 
     private:
@@ -235,6 +235,7 @@ namespace Isis {
   int Kernels::Discover() {
     _kernels.clear();
     SpiceInt count;
+    NaifLock lock;
     NaifStatus::CheckErrors();
     ktotal_c("ALL", &count);
     int nfound(0);
@@ -331,6 +332,7 @@ namespace Isis {
    *
    */
   void Kernels::InitializeNaifKernelPool() {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     kclear_c();
     NaifStatus::CheckErrors();
@@ -498,6 +500,7 @@ namespace Isis {
         SpiceInt  handle;
         SpiceBoolean found;
 
+        NaifLock lock;
         NaifStatus::CheckErrors();
         kinfo_c(_kernels[i].fullpath.toLatin1().data(), sizeof(ktype), sizeof(source),
                  ktype,source, &handle, &found);
@@ -774,6 +777,7 @@ namespace Isis {
   bool Kernels::Load(Kernels::KernelFile &kfile) {
     if (IsNaifType(kfile.ktype)) {
       if (!kfile.loaded) {
+        NaifLock lock;
         NaifStatus::CheckErrors();
         try {
           furnsh_c(kfile.fullpath.toLatin1().data());
@@ -816,6 +820,7 @@ namespace Isis {
     bool wasLoaded(false);
     if (kfile.loaded) {
       if (kfile.managed) {
+         NaifLock lock;
          NaifStatus::CheckErrors();
          try {
            unload_c(kfile.fullpath.toLatin1().data());
@@ -1065,6 +1070,7 @@ namespace Isis {
         SpiceInt  handle;
         SpiceBoolean found;
 
+        NaifLock lock;
         NaifStatus::CheckErrors();
         kinfo_c(kf.fullpath.toLatin1().data(), sizeof(ktype), sizeof(source), ktype,
                 source, &handle, &found);
@@ -69,15 +69,14 @@ namespace Isis {
    */
   void LabelTranslationManager::Auto(Pvl &outputLabel) {
     // Attempt to translate every group in the translation table
-    for(int i = 0; i < TranslationTable().groups(); i++) {
-      PvlGroup &g = TranslationTable().group(i);
-      if(IsAuto(g.name())) {
+    foreach(QString groupName, translationGroupNames()) {
+      if(IsAuto(groupName)) {
         try {
-          PvlContainer *con = CreateContainer(g.name(), outputLabel);
-          (*con) += DoTranslation(g.name());
+          PvlContainer *con = CreateContainer(groupName, outputLabel);
+          (*con) += DoTranslation(groupName);
         }
         catch(IException &e) {
-          if(!IsOptional(g.name())) {
+          if(!IsOptional(groupName)) {
             throw e;//??? is this needed???
           }
         }
@@ -112,7 +112,7 @@ class LineOffsetFunctor :
       // Try to use SetUndistortedFocalPlane, if that does not work use the distorted x,y
       // under the assumption (bad|good) that extrapolating the distortion
       // is causing the distorted x,y to be way off the sensor, and thus not very good anyway.
-      if (m_camera->DistortionMap()->SetUndistortedFocalPlane(ux, uy)) {
+      if (m_camera->DistortionMap()->SetUndistortedFocalPlaneFromGrid(ux, uy)) {
         // Get the natural (distorted focal plane coordinates)
         dx = m_camera->DistortionMap()->FocalPlaneX();
         dy = m_camera->DistortionMap()->FocalPlaneY();
@@ -35,7 +35,7 @@ namespace Isis {
     double uy = p_camera->FocalLength() * lookC[1] / lookC[2];
 
     CameraDistortionMap *distortionMap = p_camera->DistortionMap();
-    if(!distortionMap->SetUndistortedFocalPlane(ux, uy)) return false;
+    if(!distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy)) return false;
     double dx = distortionMap->FocalPlaneX();
     double dy = distortionMap->FocalPlaneY();
 
@@ -52,7 +52,7 @@ namespace Isis {
     ux = p_camera->FocalLength() * lookC[0] / lookC[2];
     uy = p_camera->FocalLength() * lookC[1] / lookC[2];
 
-    if(!distortionMap->SetUndistortedFocalPlane(ux, uy)) return false;
+    if(!distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy)) return false;
     dx = distortionMap->FocalPlaneX();
     dy = distortionMap->FocalPlaneY();
 
@@ -91,7 +91,7 @@ namespace Isis {
       ux = p_camera->FocalLength() * lookC[0] / lookC[2];
       uy = p_camera->FocalLength() * lookC[1] / lookC[2];
 
-      if(!distortionMap->SetUndistortedFocalPlane(ux, uy)) return false;
+      if(!distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy)) return false;
       dx = distortionMap->FocalPlaneX();
       dy = distortionMap->FocalPlaneY();
 
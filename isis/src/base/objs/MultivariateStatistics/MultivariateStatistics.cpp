@@ -144,6 +144,22 @@ namespace Isis {
   }
 
 
+  /**
+   * Add the accumulators and counters of another MultivariateStatistics
+   * object, for example one filled on another thread, to this one.
+   *
+   * @param other The statistics to add to these
+   */
+  void MultivariateStatistics::Merge(const MultivariateStatistics &other) {
+    p_x.Merge(other.p_x);
+    p_y.Merge(other.p_y);
+    p_sumxy += other.p_sumxy;
+    p_validPixels += other.p_validPixels;
+    p_invalidPixels += other.p_invalidPixels;
+    p_totalPixels += other.p_totalPixels;
+  }
+
+
   /**
    * Computes and returns the covariance between the two data sets If there are
    * no valid data (pixels) then NULL8 is returned.
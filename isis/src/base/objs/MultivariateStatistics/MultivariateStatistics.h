@@ -63,6 +63,7 @@ namespace Isis {
       void AddData(double x, double y, unsigned int count = 1);
       void RemoveData(const double *x, const double *y,
                       const unsigned int count);
+      void Merge(const MultivariateStatistics &other);
 
       Isis::Statistics X() const;
       Isis::Statistics Y() const;
@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 #include "NaifStatus.h"
 
 #include <iostream>
+#include <string>
 
 #include <SpiceUsr.h>
 
@@ -16,16 +17,41 @@ find files of those names at the top level of this repository. **/
 #include "PvlToPvlTranslationManager.h"
 
 namespace Isis {
+  namespace {
+    // The NAIF messages are at most this long, see getmsg_c
+    const int SHORT_DESC_LEN = 26;
+    const int LONG_DESC_LEN = 1841;
+
+    //! The number of NaifLocks the current thread holds
+    thread_local int lockDepth = 0;
+
+    //! A NAIF error that was still set when the current thread released its last lock
+    thread_local bool hasPendingError = false;
+    thread_local std::string pendingShort;
+    thread_local std::string pendingLong;
+  }
+
   bool NaifStatus::initialized = false;
 
+
   /**
-   * This method looks for any naif errors that might have occurred. It
-   * then compares the error to a list of known naif errors and converts
-   * the error into an iException.
+   * Returns the mutex that serializes access to the NAIF library.  Use a
+   * NaifLock rather than locking it directly so errors stay with the thread
+   * that caused them.
    *
-   * @param resetNaif True if the NAIF error status should be reset (naif calls valid)
+   * @return std::recursive_mutex& The NAIF mutex
    */
-  void NaifStatus::CheckErrors(bool resetNaif) {
+  std::recursive_mutex &NaifStatus::mutex() {
+    static std::recursive_mutex naifMutex;
+    return naifMutex;
+  }
+
+
+  /**
+   * Sets the NAIF error action to return and print nothing, once.  Must be
+   * called with the NAIF mutex held.
+   */
+  void NaifStatus::initialize() {
     if(!initialized) {
       SpiceChar returnAct[32] = "RETURN";
       SpiceChar printAct[32] = "NONE";
@@ -33,17 +59,47 @@ namespace Isis {
       errprt_c("SET", sizeof(printAct), printAct);     // ... and print nothing
       initialized = true;
     }
+  }
+
 
-    // Do nothing if NAIF didn't fail
-    //getmsg_c("", 0, NULL);
+  /**
+   * Moves a NAIF error to the current thread and resets the NAIF error status
+   * so other threads do not see it.  The first error is kept, as NAIF does.
+   * Must be called with the NAIF mutex held.
+   */
+  void NaifStatus::captureErrors() {
     if(!failed_c()) return;
 
+    if(!hasPendingError) {
+      SpiceChar naifShort[SHORT_DESC_LEN];
+      SpiceChar naifLong[LONG_DESC_LEN];
+      getmsg_c("SHORT", SHORT_DESC_LEN, naifShort);
+      getmsg_c("LONG", LONG_DESC_LEN, naifLong);
+      pendingShort = naifShort;
+      pendingLong = naifLong;
+      hasPendingError = true;
+    }
+    reset_c();
+  }
+
+
+  /**
+   * This method looks for any naif errors that might have occurred. It
+   * then compares the error to a list of known naif errors and converts
+   * the error into an iException.
+   *
+   * Errors left by NAIF calls made under a NaifLock on another thread are
+   * not reported.
+   *
+   * @param resetNaif True if the NAIF error status should be reset (naif calls valid)
+   */
+  void NaifStatus::CheckErrors(bool resetNaif) {
     // This method has been documented with the information provided
     //   from the NAIF documentation at:
     //    naif/cspice61/packages/cspice/doc/html/req/error.html
 
 
-    // This message is a character string containing a very terse, usually
+    // The short message is a character string containing a very terse, usually
     // abbreviated, description of the problem. The message is a character
     // string of length not more than 25 characters. It always has the form:
     // SPICE(...)
@@ -52,17 +108,42 @@ namespace Isis {
     // varies with the specific instance of the error they indicate.
     // Because of the brief format of the short error messages, it is practical
     // to use them in a test to determine which type of error has occurred.
-    const int SHORT_DESC_LEN = 26;
-    SpiceChar naifShort[SHORT_DESC_LEN];
-    getmsg_c("SHORT", SHORT_DESC_LEN, naifShort);
-
-    // This message may be up to 1840 characters long. The CSPICE error handling
+    //
+    // The long message may be up to 1840 characters long. The CSPICE error handling
     // mechanism makes no use of its contents. Its purpose is to provide human-readable
     // information about errors. Long error messages generated by CSPICE routines often
     // contain data relevant to the specific error they describe.
-    const int LONG_DESC_LEN = 1841;
-    SpiceChar naifLong[LONG_DESC_LEN];
-    getmsg_c("LONG", LONG_DESC_LEN, naifLong);
+    QString naifShort;
+    QString naifLong;
+    {
+      NaifLock lock;
+
+      if(hasPendingError) {
+        naifShort = QString::fromStdString(pendingShort);
+        naifLong = QString::fromStdString(pendingLong);
+        if(resetNaif) {
+          hasPendingError = false;
+          reset_c();
+        }
+      }
+      else if(failed_c()) {
+        SpiceChar shortMessage[SHORT_DESC_LEN];
+        SpiceChar longMessage[LONG_DESC_LEN];
+        getmsg_c("SHORT", SHORT_DESC_LEN, shortMessage);
+        getmsg_c("LONG", LONG_DESC_LEN, longMessage);
+        naifShort = shortMessage;
+        naifLong = longMessage;
+
+        // Now process the error
+        if(resetNaif) {
+          reset_c();
+        }
+      }
+      else {
+        // Do nothing if NAIF didn't fail
+        return;
+      }
+    }
 
     // Search for known naif errors...
     QString errMsg;
@@ -88,15 +169,33 @@ namespace Isis {
     catch(IException &) {
     }
 
-    // Now process the error
-    if(resetNaif) {
-      reset_c();
-    }
-
     errMsg += " The short explanation ";
-    errMsg += "provided by NAIF is [" + QString(naifShort) + "]. ";
-    errMsg += "The Naif error is [" + QString(naifLong) + "]";
+    errMsg += "provided by NAIF is [" + naifShort + "]. ";
+    errMsg += "The Naif error is [" + naifLong + "]";
 
     throw IException(IException::Unknown, errMsg, _FILEINFO_);
   }
+
+
+  /**
+   * Locks the NAIF mutex, waiting for any other thread to release it.
+   */
+  NaifLock::NaifLock() {
+    NaifStatus::mutex().lock();
+    lockDepth++;
+    NaifStatus::initialize();
+  }
+
+
+  /**
+   * Unlocks the NAIF mutex.  Releasing the last lock on a thread moves any
+   * NAIF error to that thread.
+   */
+  NaifLock::~NaifLock() {
+    lockDepth--;
+    if(lockDepth == 0) {
+      NaifStatus::captureErrors();
+    }
+    NaifStatus::mutex().unlock();
+  }
 }
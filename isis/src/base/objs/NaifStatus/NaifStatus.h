@@ -7,6 +7,8 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <mutex>
+
 namespace Isis {
   /**
    * @brief Class for checking for errors in the NAIF library
@@ -14,6 +16,12 @@ namespace Isis {
    * The Naif Status class looks for errors that have occurred in NAIF calls. If
    * an error has occurred, it will be converted to an iException.
    *
+   * The NAIF toolkit keeps its kernel pool and its error status in global
+   * state.  Code that may run on more than one thread holds a NaifLock around
+   * its NAIF calls.  An error that is still set when a thread releases its
+   * last lock is moved to that thread and the NAIF status is reset, so
+   * CheckErrors reports errors only to the thread that caused them.
+   *
    * @author 2008-06-13 Steven Lambright
    *
    * @internal
@@ -21,9 +29,48 @@ namespace Isis {
   class NaifStatus {
     public:
       static void CheckErrors(bool resetNaif = true);
+
+      static std::recursive_mutex &mutex();
+
     private:
+      friend class NaifLock;
+
+      static void initialize();
+      static void captureErrors();
+
       static bool initialized;
   };
+
+
+  /**
+   * @brief Serializes access to the NAIF library
+   *
+   * Holds the NAIF mutex for its lifetime.  Locks may be nested on the same
+   * thread.  Loading and unloading kernels and reading them through the NAIF
+   * routines must happen under a lock; evaluating cached positions and
+   * rotations does not touch NAIF and needs no lock.
+   *
+   * @code
+   *   {
+   *     NaifLock lock;
+   *     spkez_c(target, et, "J2000", "NONE", observer, state, &lt);
+   *     NaifStatus::CheckErrors();
+   *   }
+   * @endcode
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class NaifLock {
+    public:
+      NaifLock();
+      ~NaifLock();
+
+    private:
+      NaifLock(const NaifLock &other) = delete;
+      NaifLock &operator=(const NaifLock &other) = delete;
+  };
 };
 
 #endif
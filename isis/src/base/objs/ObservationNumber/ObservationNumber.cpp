@@ -81,15 +81,18 @@ namespace Isis {
   PvlGroup ObservationNumber::FindObservationTranslation(Pvl &label) {
     Pvl outLabel;
 
+    // The translation managers are kept for each thread so observation
+    // numbers can be composed in parallel, see SerialNumberList
+
     // Get the mission name
     static QString missionTransFile = "$ISISROOT/appdata/translations/MissionName2DataDir.trn";
-    static PvlToPvlTranslationManager missionXlater(missionTransFile);
+    static thread_local PvlToPvlTranslationManager missionXlater(missionTransFile);
     missionXlater.SetLabel(label);
     QString mission = missionXlater.Translate("MissionName");
 
     // Get the instrument name
     static QString instTransFile = "$ISISROOT/appdata/translations/Instruments.trn";
-    static PvlToPvlTranslationManager instrumentXlater(instTransFile);
+    static thread_local PvlToPvlTranslationManager instrumentXlater(instTransFile);
     instrumentXlater.SetLabel(label);
     QString instrument = instrumentXlater.Translate("InstrumentName");
 
@@ -98,7 +101,8 @@ namespace Isis {
     //   from the disk is not necessary every time. To do this, we'll use a map to store
     //   the translation managers and observation number keys with a string identifier to find them.
     //   This identifier needs to have the mission name and the instrument name.
-    static std::map<QString, std::pair<PvlToPvlTranslationManager, PvlKeyword> > missionTranslators;
+    static thread_local std::map<QString, std::pair<PvlToPvlTranslationManager, PvlKeyword> >
+        missionTranslators;
     QString key = mission + "_" + instrument;
     std::map<QString, std::pair<PvlToPvlTranslationManager, PvlKeyword> >::iterator
     translationIterator = missionTranslators.find(key);
@@ -6,9 +6,11 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Plugin.h"
 
+#include <mutex>
 #include <ostream>
 
 #include <QCoreApplication>
+#include <QHash>
 #include <QLibrary>
 #include <QStringList>
 
@@ -28,6 +30,9 @@ namespace Isis {
    * keyword ROUTINE.  When you write this function make sure to place extern
    * "C" infront of it to eliminate C++ symbol mangling.
    *
+   * Each library is only loaded, and each routine only resolved, the first
+   * time it is used.
+   *
    * @param group The group name.
    *
    * @return A void pointer to a C function (i.e., the plugin)
@@ -40,12 +45,24 @@ namespace Isis {
     // Get the library and plugin to load
     PvlGroup &g = findGroup(group);
     QString library = g["Library"];
+    QString pluginName = g["Routine"];
+
+    // The libraries stay loaded until the application exits, so the routines
+    // resolved from them are shared by every plugin that uses them
+    static std::mutex resolvedMutex;
+    static QHash<QString, QFunctionPointer> resolvedRoutines;
+
+    QString routineKey = library + "/" + pluginName;
+    std::lock_guard<std::mutex> lock(resolvedMutex);
+    QHash<QString, QFunctionPointer>::const_iterator resolved =
+        resolvedRoutines.constFind(routineKey);
+    if (resolved != resolvedRoutines.constEnd()) {
+      return resolved.value();
+    }
 
     QString path = "./";
     Isis::FileName libraryFile(path + library);
 
-    QString pluginName = g["Routine"];
-
     // Open the library, resolve the routine name, and return the function
     // address. The function will stay in memory until the application exists
     // so the scope of lib does not matter.
@@ -66,6 +83,7 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
+    resolvedRoutines.insert(routineKey, plugin);
     return plugin;
   }
 } // end namespace isis
@@ -0,0 +1,255 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "PngExporter.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Buffer.h"
+#include "Endian.h"
+#include "ExportDescription.h"
+#include "FileName.h"
+#include "IException.h"
+#include "IString.h"
+
+using namespace Isis;
+
+
+namespace Isis {
+  /**
+   * Construct the PNG exporter.
+   */
+  PngExporter::PngExporter() : StreamExporter() {
+    m_file = NULL;
+    m_png = NULL;
+    m_info = NULL;
+    m_raster = NULL;
+
+    setExtension("png");
+  }
+
+
+  /**
+   * Destruct the exporter.
+   */
+  PngExporter::~PngExporter() {
+    close();
+
+    delete [] m_raster;
+    m_raster = NULL;
+  }
+
+
+  /**
+   * Generic initialization with the export description.  PNG images can only
+   * hold unsigned pixels, so signed word output is rejected.
+   *
+   * @param desc Export description containing necessary channel information
+   */
+  void PngExporter::initialize(ExportDescription &desc) {
+    if (desc.pixelType() != UnsignedByte && desc.pixelType() != UnsignedWord) {
+      QString msg = "Invalid pixel type. The PNG exporter requires an unsigned byte "
+                    "(i.e. 8BIT) or unsigned word (i.e. U16BIT) output.";
+      throw IException(IException::User, msg, _FILEINFO_);
+    }
+    StreamExporter::initialize(desc);
+  }
+
+
+  /**
+   * Creates the buffer to store a line of data with one or more bands.
+   */
+  void PngExporter::createBuffer() {
+    PixelType type = pixelType();
+    int mult = (type == Isis::UnsignedByte) ? 1 : 2;
+    int size = samples() * bands() * mult;
+
+    try {
+      m_raster = new unsigned char[size];
+    }
+    catch (...) {
+      throw IException(IException::Unknown,
+          "Could not allocate enough memory", _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Open the output file for writing and write the PNG header, then let the
+   * base ImageExporter handle the generic black-box writing routine and finish
+   * the image.
+   *
+   * @param outputName The filename of the output cube
+   * @param quality The quality of the output from 0 to 100.  Lower qualities
+   *                use more zlib compression, the same as the Qt PNG writer.
+   * @param compression The compression algorithm used. Not used for PNG
+   */
+  void PngExporter::write(FileName outputName, int quality,
+                          QString compression) {
+    outputName = outputName.addExtension(extension());
+
+    m_file = fopen(outputName.expanded().toLatin1().data(), "wb");
+    if (m_file == NULL) {
+      throw IException(IException::Programmer,
+          "Could not open output image", _FILEINFO_);
+    }
+
+    m_png = png_create_write_struct(PNG_LIBPNG_VER_STRING, NULL, NULL, NULL);
+    if (m_png) m_info = png_create_info_struct(m_png);
+    if (m_png == NULL || m_info == NULL) {
+      close();
+      throw IException(IException::Unknown,
+          "Could not allocate enough memory", _FILEINFO_);
+    }
+
+    if (setjmp(png_jmpbuf(m_png))) {
+      close();
+      throw IException(IException::Programmer,
+          "Could not write image header", _FILEINFO_);
+    }
+
+    png_init_io(m_png, m_file);
+
+    int colorType = PNG_COLOR_TYPE_GRAY;
+    if (bands() == 3) colorType = PNG_COLOR_TYPE_RGB;
+    if (bands() == 4) colorType = PNG_COLOR_TYPE_RGB_ALPHA;
+    int bitDepth = (pixelType() == Isis::UnsignedByte) ? 8 : 16;
+    png_set_IHDR(m_png, m_info, samples(), lines(), bitDepth, colorType,
+                 PNG_INTERLACE_NONE, PNG_COMPRESSION_TYPE_DEFAULT, PNG_FILTER_TYPE_DEFAULT);
+
+    // Map [0,100] to zlib levels [9,0]
+    quality = std::min(std::max(quality, 0), 100);
+    png_set_compression_level(m_png, (100 - quality) * 9 / 91);
+
+    png_write_info(m_png, m_info);
+
+    // PNG words are big endian
+    if (bitDepth == 16 && IsLsb()) png_set_swap(m_png);
+
+    ImageExporter::write(outputName, quality);
+
+    if (setjmp(png_jmpbuf(m_png))) {
+      close();
+      throw IException(IException::Programmer,
+          "Could not write image", _FILEINFO_);
+    }
+    png_write_end(m_png, NULL);
+    close();
+  }
+
+
+  /**
+   * Set the DN value at the given sample and band, resolved to a single index,
+   * of the line buffer.
+   *
+   * @param s The sample component of the index into the buffer
+   * @param b The band component of the index into the buffer
+   * @param dn The value to set at the given index
+   */
+  void PngExporter::setBuffer(int s, int b, int dn) const {
+    PixelType type = pixelType();
+    int index = s * bands() + b;
+
+    switch (type) {
+      case UnsignedByte:
+        m_raster[index] = (unsigned char) dn;
+        break;
+      case UnsignedWord:
+        ((short unsigned int *) m_raster)[index] = (short unsigned int) dn;
+        break;
+      default:
+        throw IException(IException::Programmer,
+            "Invalid pixel type for data [" + toString(type) + "]",
+            _FILEINFO_);
+    }
+  }
+
+
+  /**
+   * Writes a line of buffered data to the output image on disk.  PNG rows are
+   * written in order, so the line number is not used.
+   *
+   * @param l The line of the output image
+   */
+  void PngExporter::writeLine(int l) const {
+    if (setjmp(png_jmpbuf(m_png))) {
+      throw IException(IException::Programmer,
+          "Could not write image", _FILEINFO_);
+    }
+    png_write_row(m_png, m_raster);
+  }
+
+
+  /**
+   * Writes a strip of output values to the output image on disk.
+   *
+   * @param firstLine The first line of the strip, starting at zero
+   * @param lineCount The number of lines in the strip
+   * @param dns The output values, interleaved by band for each sample
+   */
+  void PngExporter::writeStrip(int firstLine, int lineCount, const vector<int> &dns) const {
+    int size = dns.size();
+    int rowValues = samples() * bands();
+    std::vector<unsigned char> strip;
+    std::vector<png_bytep> rows(lineCount);
+
+    if (pixelType() == Isis::UnsignedByte) {
+      strip.resize(size);
+      for (int i = 0; i < size; i++) {
+        strip[i] = (unsigned char) dns[i];
+      }
+      for (int l = 0; l < lineCount; l++) {
+        rows[l] = &strip[l * rowValues];
+      }
+    }
+    else {
+      strip.resize(size * sizeof(short unsigned int));
+      short unsigned int *words = (short unsigned int *) strip.data();
+      for (int i = 0; i < size; i++) {
+        words[i] = (short unsigned int) dns[i];
+      }
+      for (int l = 0; l < lineCount; l++) {
+        rows[l] = (png_bytep) &words[l * rowValues];
+      }
+    }
+
+    if (setjmp(png_jmpbuf(m_png))) {
+      throw IException(IException::Programmer,
+          "Could not write image", _FILEINFO_);
+    }
+    png_write_rows(m_png, rows.data(), lineCount);
+  }
+
+
+  /**
+   * Releases the libpng structures and closes the output file.
+   */
+  void PngExporter::close() {
+    if (m_png) {
+      png_destroy_write_struct(&m_png, m_info ? &m_info : NULL);
+      m_png = NULL;
+      m_info = NULL;
+    }
+
+    if (m_file) {
+      fclose(m_file);
+      m_file = NULL;
+    }
+  }
+
+
+  /**
+   * Returns true if the format is "png".
+   *
+   * @param format Lowercase format abbreviation
+   *
+   * @return True if "png", false otherwise
+   */
+  bool PngExporter::canWriteFormat(QString format) {
+    return format == "png";
+  }
+};
@@ -0,0 +1,70 @@
+#ifndef PngExporter_h
+#define PngExporter_h
+
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+
+#include "StreamExporter.h"
+
+#include <cstdio>
+
+#include <png.h>
+
+namespace Isis {
+  /**
+   * @brief Exports cubes into PNG images
+   *
+   * A streamed exporter for PNG images.  Can write an arbitrarily large set of
+   * single-band Isis cubes to an arbitrarily large PNG image with an unsigned
+   * byte or unsigned word pixel type.  Unlike the QtExporter, the image is
+   * written with libpng a strip of rows at a time and is never held in memory
+   * as a whole.
+   *
+   * @ingroup HighLevelCubeIO
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class PngExporter : public StreamExporter {
+    public:
+      PngExporter();
+      virtual ~PngExporter();
+
+      virtual void write(FileName outputName, int quality=100,
+                         QString compression="none");
+
+      static bool canWriteFormat(QString format);
+
+    protected:
+      virtual void initialize(ExportDescription &desc);
+
+      virtual void createBuffer();
+
+      virtual void setBuffer(int s, int b, int dn) const;
+      virtual void writeLine(int l) const;
+      virtual void writeStrip(int firstLine, int lineCount, const vector<int> &dns) const;
+
+    private:
+      void close();
+
+      //! The file the image is written to
+      FILE *m_file;
+
+      //! The libpng write structure
+      png_structp m_png;
+
+      //! The libpng image information
+      png_infop m_info;
+
+      //! Array containing all color channels for a line
+      unsigned char *m_raster;
+  };
+};
+
+
+#endif
@@ -6,7 +6,11 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <QString>
 
+#include <algorithm>
+#include <cmath>
+
 #include "PrincipalComponentAnalysis.h"
+#include "SpecialPixel.h"
 #include "jama/jama_eig.h"
 #include "jama/jama_lu.h"
 
@@ -16,14 +20,12 @@ namespace Isis {
   //! Constructs the PrincipalComponentAnalysis object.
   PrincipalComponentAnalysis::PrincipalComponentAnalysis(const int n) {
     p_dimensions = n;
-    p_statistics.clear();
-    p_statistics.resize(n * n);
-    for(int i = 0; i < n; i++) {
-      for(int j = 0; j <= i; j++) {
-        p_statistics[n*i+j] = new Isis::MultivariateStatistics();
-        p_statistics[n*j+i] = p_statistics[n*i+j];
-      }
-    }
+    p_validPixels.assign(n * n, 0.0);
+    p_sumX.assign(n * n, 0.0);
+    p_sumY.assign(n * n, 0.0);
+    p_sumXX.assign(n * n, 0.0);
+    p_sumYY.assign(n * n, 0.0);
+    p_sumXY.assign(n * n, 0.0);
 
     p_hasTransform = false;
   };
@@ -53,14 +55,85 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
-    // add the data to the multivariate stats objects
-    for(int i = 0; i < p_dimensions; i++) {
-      for(int j = 0; j <= i; j++) {
-        p_statistics[p_dimensions*i+j]->AddData(&data[count*i], &data[count*j], count);
+    // Accumulate a block of pixels at a time. Invalid values are zeroed and
+    //  counted in the mask, so every pair of dimensions is a set of branch
+    //  free dot products over the block
+    const unsigned int blockSize = 256;
+    vector<double> values(p_dimensions * blockSize);
+    vector<double> squares(p_dimensions * blockSize);
+    vector<double> valid(p_dimensions * blockSize);
+
+    for(unsigned int start = 0; start < count; start += blockSize) {
+      unsigned int size = std::min(blockSize, count - start);
+
+      for(int i = 0; i < p_dimensions; i++) {
+        const double *in = &data[count*i+start];
+        double *value = &values[blockSize*i];
+        double *square = &squares[blockSize*i];
+        double *mask = &valid[blockSize*i];
+        for(unsigned int k = 0; k < size; k++) {
+          bool isValid = Isis::IsValidPixel(in[k]);
+          value[k] = isValid ? in[k] : 0.0;
+          square[k] = value[k] * value[k];
+          mask[k] = isValid ? 1.0 : 0.0;
+        }
+      }
+
+      for(int i = 0; i < p_dimensions; i++) {
+        const double *xValue = &values[blockSize*i];
+        const double *xSquare = &squares[blockSize*i];
+        const double *xMask = &valid[blockSize*i];
+        for(int j = 0; j <= i; j++) {
+          const double *yValue = &values[blockSize*j];
+          const double *ySquare = &squares[blockSize*j];
+          const double *yMask = &valid[blockSize*j];
+
+          double validPixels = 0.0, sumX = 0.0, sumY = 0.0;
+          double sumXX = 0.0, sumYY = 0.0, sumXY = 0.0;
+          for(unsigned int k = 0; k < size; k++) {
+            validPixels += xMask[k] * yMask[k];
+            sumX += xValue[k] * yMask[k];
+            sumY += yValue[k] * xMask[k];
+            sumXX += xSquare[k] * yMask[k];
+            sumYY += ySquare[k] * xMask[k];
+            sumXY += xValue[k] * yValue[k];
+          }
+
+          int index = p_dimensions * i + j;
+          p_validPixels[index] += validPixels;
+          p_sumX[index] += sumX;
+          p_sumY[index] += sumY;
+          p_sumXX[index] += sumXX;
+          p_sumYY[index] += sumYY;
+          p_sumXY[index] += sumXY;
+        }
       }
     }
   }
 
+  // Add the data accumulated by another PCA object, such as one filled on
+  //  another thread, to this one
+  void PrincipalComponentAnalysis::Merge(const PrincipalComponentAnalysis &other) {
+    if(p_hasTransform || other.p_hasTransform) {
+      std::string m = "Cannot merge PCAs that have a defined transform matrix";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+    if(other.p_dimensions != p_dimensions) {
+      QString m = "Cannot merge a PCA of dimension " + QString::number(other.p_dimensions) +
+                  " into a PCA of dimension " + QString::number(p_dimensions);
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    for(unsigned int index = 0; index < p_validPixels.size(); index++) {
+      p_validPixels[index] += other.p_validPixels[index];
+      p_sumX[index] += other.p_sumX[index];
+      p_sumY[index] += other.p_sumY[index];
+      p_sumXX[index] += other.p_sumXX[index];
+      p_sumYY[index] += other.p_sumYY[index];
+      p_sumXY[index] += other.p_sumXY[index];
+    }
+  }
+
   // Use VDV' decomposition to obtain the eigenvectors
   void PrincipalComponentAnalysis::ComputeTransform() {
     if(p_hasTransform) {
@@ -68,10 +141,23 @@ namespace Isis {
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
+    // The correlation is computed the same way as MultivariateStatistics
     TNT::Array2D<double> C(p_dimensions, p_dimensions);
     for(int i = 0; i < p_dimensions; i++) {
-      for(int j = 0; j < p_dimensions; j++) {
-        C[i][j] = (p_statistics[p_dimensions*i+j])->Correlation();
+      for(int j = 0; j <= i; j++) {
+        int index = p_dimensions * i + j;
+        double n = p_validPixels[index];
+        double correlation = Isis::NULL8;
+        if(n > 1.0) {
+          double varX = std::max(0.0, n * p_sumXX[index] - p_sumX[index] * p_sumX[index]);
+          double varY = std::max(0.0, n * p_sumYY[index] - p_sumY[index] * p_sumY[index]);
+          double stdX = sqrt(varX / ((n - 1.0) * n));
+          double stdY = sqrt(varY / ((n - 1.0) * n));
+          double covar = (p_sumXY[index] - p_sumX[index] * p_sumY[index] / n) / (n - 1.0);
+          if(stdX != 0.0 && stdY != 0.0) correlation = covar / (stdX * stdY);
+        }
+        C[i][j] = correlation;
+        C[j][i] = correlation;
       }
     }
 
@@ -132,4 +218,46 @@ namespace Isis {
     // the vector times the inverse matrix
     return TNT::matmult(data, p_inverse);
   }
+
+  // Transform a block of vectors into principal component space
+  //  Note: the data is stored the same way as for AddData, the first
+  //   dimension of every vector in order, then the second, ...
+  void PrincipalComponentAnalysis::Transform(const double *data, double *result,
+                                             const unsigned int count) const {
+    if(!p_hasTransform) {
+      std::string m = "This PCA does not have a transform matrix";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    Multiply(p_transform, data, result, count);
+  }
+
+  // Transform a block of vectors from principal component space
+  void PrincipalComponentAnalysis::Inverse(const double *data, double *result,
+                                           const unsigned int count) const {
+    if(!p_hasTransform) {
+      std::string m = "This PCA does not have a transform matrix";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    Multiply(p_inverse, data, result, count);
+  }
+
+  // Multiply each vector in the block by the matrix, summing in the same
+  //  order as TNT::matmult
+  void PrincipalComponentAnalysis::Multiply(const TNT::Array2D<double> &matrix,
+                                            const double *data, double *result,
+                                            const unsigned int count) const {
+    for(int k = 0; k < p_dimensions; k++) {
+      double *out = &result[count*k];
+      std::fill(out, out + count, 0.0);
+      for(int i = 0; i < p_dimensions; i++) {
+        const double *in = &data[count*i];
+        double coefficient = matrix[i][k];
+        for(unsigned int p = 0; p < count; p++) {
+          out[p] += in[p] * coefficient;
+        }
+      }
+    }
+  }
 }
@@ -8,7 +8,6 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <vector>
 #include "tnt/tnt_array2d.h"
-#include "MultivariateStatistics.h"
 #include "IException.h"
 #include "Constants.h"
 
@@ -23,6 +22,11 @@ namespace Isis {
    * If you would like to see PrincipalComponentAnalysis being used
    *         in implementation, see pca.cpp or decorstretch.cpp
    *
+   * The correlation matrix is accumulated from the pairwise sums of the
+   * dimensions, computed a block of data at a time. Data added to separate
+   * objects, for example on separate threads, can be combined with Merge()
+   * before the transform is computed.
+   *
    * @ingroup Math and Statistics
    *
    * @author 2006-05-18 Jacob Danton
@@ -38,9 +42,12 @@ namespace Isis {
       PrincipalComponentAnalysis(TNT::Array2D<double> transform);
       ~PrincipalComponentAnalysis() {};
       void AddData(const double *data, const unsigned int count);
+      void Merge(const PrincipalComponentAnalysis &other);
       void ComputeTransform();
       TNT::Array2D<double> Transform(TNT::Array2D<double> data);
       TNT::Array2D<double> Inverse(TNT::Array2D<double> data);
+      void Transform(const double *data, double *result, const unsigned int count) const;
+      void Inverse(const double *data, double *result, const unsigned int count) const;
       TNT::Array2D<double> TransformMatrix() {
         return p_transform;
       };
@@ -50,11 +57,21 @@ namespace Isis {
 
     private:
       void ComputeInverse();
+      void Multiply(const TNT::Array2D<double> &matrix, const double *data,
+                    double *result, const unsigned int count) const;
       bool p_hasTransform;
       int p_dimensions;
 
       TNT::Array2D<double> p_transform, p_inverse;
-      std::vector<Isis::MultivariateStatistics *> p_statistics;
+
+      // Sums over the data where both dimensions i and j (j <= i) are valid,
+      //   stored at index p_dimensions*i+j
+      std::vector<double> p_validPixels; //!< Number of valid pairs
+      std::vector<double> p_sumX;        //!< Sum of dimension i
+      std::vector<double> p_sumY;        //!< Sum of dimension j
+      std::vector<double> p_sumXX;       //!< Sum of dimension i squared
+      std::vector<double> p_sumYY;       //!< Sum of dimension j squared
+      std::vector<double> p_sumXY;       //!< Sum of dimension i times dimension j
   };
 }
 
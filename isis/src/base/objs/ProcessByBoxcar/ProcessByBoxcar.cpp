@@ -4,16 +4,60 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <cmath>
+#include <complex>
+
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
 #include "BoxcarCachingAlgorithm.h"
 #include "BoxcarManager.h"
+#include "Brick.h"
 #include "Buffer.h"
+#include "FourierTransform.h"
 #include "LineManager.h"
 #include "Process.h"
 #include "ProcessByBoxcar.h"
+#include "SlidingRank.h"
+#include "SpecialPixel.h"
 
 using namespace std;
 namespace Isis {
 
+  namespace {
+    /**
+     * Runs a strip function over the strips of a band on the global thread
+     * pool. The workers only record their finished strips, and this thread
+     * reports them while it waits, so strips do not wait for each other.
+     *
+     * @param strips The number of strips
+     * @param stripFunction The function processing one strip
+     * @param progress The progress, with one step per strip
+     */
+    template <typename StripFunction>
+    void processStrips(int strips, StripFunction &stripFunction, Progress *progress) {
+      QVector<int> stripIndexes(strips);
+      for(int strip = 0; strip < strips; strip++) {
+        stripIndexes[strip] = strip;
+      }
+
+      if(strips > 1 && QThreadPool::globalInstance()->maxThreadCount() > 1) {
+        QFuture<void> future = QtConcurrent::map(stripIndexes, [&](int &strip) {
+          stripFunction(strip);
+          progress->AddCompletedSteps();
+        });
+        progress->WaitForFinished(future);
+      }
+      else {
+        for(int strip = 0; strip < strips; strip++) {
+          stripFunction(stripIndexes[strip]);
+          progress->CheckStatus();
+        }
+      }
+    }
+  }
+
   /**
    * Sets the boxcar size
    *
@@ -28,18 +72,105 @@ namespace Isis {
     p_boxsizeSet = true;
   }
 
+
   /**
-   * Starts the systematic processing of the input cube by moving a boxcar,
-   * p_boxSamples by p_boxLines, through the cube one pixel at a time. The input
-   * and output buffers contain a Boxcar of the size indicated in p_boxSamples
-   * and p_boxLines. The input and output cube must be initialized prior to
-   * calling this method.
+   * Sets the kernel applied by ProcessCubeKernel(). The coefficients are in
+   * the same order as the pixels of the boxcar buffer (samples fastest), so
+   * the boxcar size must be set first.
    *
-   * @param funct (Isis::Buffer &in, double &out) Name of your processing function
+   * @param coefficients The kernel coefficients, one per boxcar pixel
+   * @param weight A factor applied to every weighted sum
+   * @param handling How special pixels inside the boxcar are handled
    *
    * @throws Isis::IException::Programmer
    */
-  void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, double &out)) {
+  void ProcessByBoxcar::SetKernel(const std::vector<double> &coefficients, double weight,
+                                  SpecialPixelHandling handling) {
+    if(!p_boxsizeSet) {
+      string m = "Use the SetBoxcarSize method to set the boxcar size before the kernel";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    if((int)coefficients.size() != p_boxSamples * p_boxLines) {
+      string m = "The number of kernel coefficients must match the boxcar size";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    p_kernel = coefficients;
+    p_kernelWeight = weight;
+    p_specialHandling = handling;
+    DecomposeKernel();
+  }
+
+
+  /**
+   * Checks whether the kernel is the outer product of a column vector and a
+   * row vector (a rank one matrix). The factors are taken from the row and
+   * column through the largest coefficient and the kernel is separable if
+   * their product reproduces every coefficient to within round off.
+   */
+  void ProcessByBoxcar::DecomposeKernel() {
+    p_separable = false;
+    p_rowKernel.clear();
+    p_columnKernel.clear();
+
+    // A single row or column gains nothing from two passes
+    if(p_boxSamples == 1 || p_boxLines == 1) return;
+
+    int pivot = 0;
+    double largest = 0.0;
+    for(unsigned int i = 0; i < p_kernel.size(); i++) {
+      if(fabs(p_kernel[i]) > largest) {
+        largest = fabs(p_kernel[i]);
+        pivot = i;
+      }
+    }
+    if(largest == 0.0) return;
+
+    int pivotLine = pivot / p_boxSamples;
+    int pivotSample = pivot % p_boxSamples;
+
+    vector<double> rowKernel(p_boxSamples);
+    vector<double> columnKernel(p_boxLines);
+    for(int s = 0; s < p_boxSamples; s++) {
+      rowKernel[s] = p_kernel[pivotLine * p_boxSamples + s] / p_kernel[pivot];
+    }
+    for(int l = 0; l < p_boxLines; l++) {
+      columnKernel[l] = p_kernel[l * p_boxSamples + pivotSample];
+    }
+
+    for(int l = 0; l < p_boxLines; l++) {
+      for(int s = 0; s < p_boxSamples; s++) {
+        double residual = p_kernel[l * p_boxSamples + s] - columnKernel[l] * rowKernel[s];
+        if(fabs(residual) > 1.0e-12 * largest) return;
+      }
+    }
+
+    p_separable = true;
+    p_rowKernel = rowKernel;
+    p_columnKernel = columnKernel;
+  }
+
+
+  /**
+   * Sets the kernel size, in pixels, above which ProcessCubeKernel() applies
+   * the kernel by FFT convolution instead of directly. The default is 225
+   * (a 15x15 kernel).
+   *
+   * @param kernelPixels The largest number of kernel pixels applied directly
+   */
+  void ProcessByBoxcar::SetFftThreshold(int kernelPixels) {
+    p_fftThreshold = kernelPixels;
+  }
+
+
+  /**
+   * Checks that there is exactly one input and one output cube of the same
+   * dimensions and that the boxcar size is set.
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::VerifyCubes() {
     // Error checks ... there must be one input and output
     if(InputCubes.size() != 1) {
       string m = "You must specify exactly one input cube";
@@ -76,6 +207,22 @@ namespace Isis {
       string m = "Use the SetBoxcarSize method to set the boxcar size";
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
+  }
+
+
+  /**
+   * Starts the systematic processing of the input cube by moving a boxcar,
+   * p_boxSamples by p_boxLines, through the cube one pixel at a time. The input
+   * and output buffers contain a Boxcar of the size indicated in p_boxSamples
+   * and p_boxLines. The input and output cube must be initialized prior to
+   * calling this method.
+   *
+   * @param funct (Isis::Buffer &in, double &out) Name of your processing function
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::StartProcess(void funct(Isis::Buffer &in, double &out)) {
+    VerifyCubes();
 
     // Construct boxcar buffer and line buffer managers
     Isis::BoxcarManager box(*InputCubes[0], p_boxSamples, p_boxLines);
@@ -103,6 +250,510 @@ namespace Isis {
 
   }
 
+  /**
+   * Applies the kernel set with SetKernel() to the input cube and writes the
+   * weighted sums to the output cube. Each output pixel is the sum of the
+   * boxcar pixels times their coefficients, times the kernel weight, with
+   * special pixels handled as requested in SetKernel(). Separable kernels
+   * are applied as a row pass and a column pass and other kernels with more
+   * pixels than the FFT threshold are applied by FFT convolution. Both match
+   * the direct sums to within floating point round off.
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::ProcessCubeKernel() {
+    VerifyCubes();
+
+    if(p_kernel.empty()) {
+      string m = "Use the SetKernel method to set the kernel";
+      throw IException(IException::Programmer, m, _FILEINFO_);
+    }
+
+    if(p_separable) {
+      ConvolveSeparable();
+    }
+    else if(p_boxSamples * p_boxLines > p_fftThreshold) {
+      ConvolveFft();
+    }
+    else {
+      ConvolveSpatial();
+    }
+  }
+
+
+  /**
+   * Computes the kernel result for one boxcar.
+   *
+   * @param box The boxcar buffer
+   *
+   * @return double The weighted sum, or Null
+   */
+  double ProcessByBoxcar::ApplyKernel(const Isis::Buffer &box) const {
+    double sum = 0.0;
+    double validWeight = 0.0;
+    int specialCount = 0;
+    for(int i = 0; i < box.size(); i++) {
+      if(IsSpecial(box[i])) {
+        if(p_specialHandling == NullIfAnySpecial) return Isis::Null;
+        specialCount++;
+      }
+      else {
+        sum += box[i] * p_kernel[i];
+        validWeight += p_kernel[i];
+      }
+    }
+
+    if(p_specialHandling == Renormalize && specialCount > 0) {
+      double kernelSum = 0.0;
+      double absWeight = 0.0;
+      for(unsigned int i = 0; i < p_kernel.size(); i++) {
+        kernelSum += p_kernel[i];
+        absWeight += fabs(p_kernel[i]);
+      }
+
+      if(specialCount == box.size() || fabs(validWeight) <= 1.0e-12 * absWeight) {
+        return Isis::Null;
+      }
+      sum *= kernelSum / validWeight;
+    }
+
+    return sum * p_kernelWeight;
+  }
+
+
+  /**
+   * Applies the kernel by moving the boxcar through the cube one pixel at a
+   * time.
+   */
+  void ProcessByBoxcar::ConvolveSpatial() {
+    Isis::BoxcarManager box(*InputCubes[0], p_boxSamples, p_boxLines);
+    Isis::LineManager line(*OutputCubes[0]);
+
+    InputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
+    OutputCubes[0]->addCachingAlgorithm(new BoxcarCachingAlgorithm());
+
+    p_progress->SetMaximumSteps(InputCubes[0]->lineCount()*InputCubes[0]->bandCount());
+    p_progress->CheckStatus();
+
+    box.begin();
+    for(line.begin(); !line.end(); line.next()) {
+      for(int i = 0; i < line.size(); i++) {
+        InputCubes[0]->read(box);
+        line[i] = ApplyKernel(box);
+        box++;
+      }
+      OutputCubes[0]->write(line);
+      p_progress->CheckStatus();
+    }
+  }
+
+
+  /**
+   * Applies a separable kernel as a horizontal pass with the row factor
+   * followed by a vertical pass with the column factor. Each band is split
+   * into strips of lines which are processed in parallel; a strip reads its
+   * lines plus the boxcar margins once. The vertical pass accumulates whole
+   * rows at a time so its inner loop runs over contiguous memory.
+   *
+   * Special pixels are replaced by zero for the sums. The row pass also
+   * counts the special pixels under each boxcar row and, for Renormalize,
+   * sums the kernel weight of the valid pixels, so the special pixel handling
+   * matches the direct path exactly.
+   */
+  void ProcessByBoxcar::ConvolveSeparable() {
+    const int stripLines = 64;
+
+    int cubeSamples = InputCubes[0]->sampleCount();
+    int cubeLines = InputCubes[0]->lineCount();
+    int cubeBands = InputCubes[0]->bandCount();
+    int strips = (cubeLines + stripLines - 1) / stripLines;
+    int blockSamples = cubeSamples + p_boxSamples - 1;
+
+    // Same placement of the boxcar around its center pixel as BoxcarManager
+    int sampleOffset = -((p_boxSamples - 1) / 2);
+    int lineOffset = -((p_boxLines - 1) / 2);
+
+    double kernelSum = 0.0;
+    double absWeight = 0.0;
+    for(unsigned int i = 0; i < p_kernel.size(); i++) {
+      kernelSum += p_kernel[i];
+      absWeight += fabs(p_kernel[i]);
+    }
+
+    Cube *icube = InputCubes[0];
+    Cube *ocube = OutputCubes[0];
+    int boxSamples = p_boxSamples;
+    int boxLines = p_boxLines;
+    int boxPixels = boxSamples * boxLines;
+    double weight = p_kernelWeight;
+    SpecialPixelHandling handling = p_specialHandling;
+    const vector<double> &rowKernel = p_rowKernel;
+    const vector<double> &columnKernel = p_columnKernel;
+
+    int band = 1;
+    auto convolveStrip = [&](int &strip) {
+      int firstLine = strip * stripLines + 1;
+      int outLines = min(stripLines, cubeLines - firstLine + 1);
+      int blockLines = outLines + boxLines - 1;
+
+      Brick block(blockSamples, blockLines, 1, icube->pixelType());
+      block.SetBasePosition(1 + sampleOffset, firstLine + lineOffset, band);
+      icube->read(block);
+
+      // Row pass
+      size_t rowPassSize = (size_t)blockLines * cubeSamples;
+      vector<double> rowSums(rowPassSize);
+      vector<double> rowWeights(handling == Renormalize ? rowPassSize : 0);
+      vector<int> rowSpecials(rowPassSize);
+      vector<double> values(blockSamples);
+      vector<double> mask(blockSamples);
+      for(int l = 0; l < blockLines; l++) {
+        const double *in = block.DoubleBuffer() + (size_t)l * blockSamples;
+        for(int s = 0; s < blockSamples; s++) {
+          bool special = IsSpecial(in[s]);
+          values[s] = special ? 0.0 : in[s];
+          mask[s] = special ? 0.0 : 1.0;
+        }
+
+        double *sums = &rowSums[(size_t)l * cubeSamples];
+        for(int s = 0; s < cubeSamples; s++) {
+          double sum = 0.0;
+          for(int c = 0; c < boxSamples; c++) {
+            sum += rowKernel[c] * values[s + c];
+          }
+          sums[s] = sum;
+        }
+
+        if(handling == Renormalize) {
+          double *weights = &rowWeights[(size_t)l * cubeSamples];
+          for(int s = 0; s < cubeSamples; s++) {
+            double sum = 0.0;
+            for(int c = 0; c < boxSamples; c++) {
+              sum += rowKernel[c] * mask[s + c];
+            }
+            weights[s] = sum;
+          }
+        }
+
+        // running count of the special pixels under the boxcar row
+        int *specials = &rowSpecials[(size_t)l * cubeSamples];
+        int count = 0;
+        for(int c = 0; c < boxSamples; c++) {
+          if(mask[c] == 0.0) count++;
+        }
+        for(int s = 0; s < cubeSamples; s++) {
+          specials[s] = count;
+          if(s + boxSamples < blockSamples) {
+            if(mask[s] == 0.0) count--;
+            if(mask[s + boxSamples] == 0.0) count++;
+          }
+        }
+      }
+
+      // Column pass
+      Brick out(cubeSamples, outLines, 1, ocube->pixelType());
+      out.SetBasePosition(1, firstLine, band);
+      vector<double> sums(cubeSamples);
+      vector<double> weights(cubeSamples);
+      vector<int> specials(cubeSamples);
+      for(int l = 0; l < outLines; l++) {
+        fill(sums.begin(), sums.end(), 0.0);
+        fill(weights.begin(), weights.end(), 0.0);
+        fill(specials.begin(), specials.end(), 0);
+        for(int r = 0; r < boxLines; r++) {
+          double coefficient = columnKernel[r];
+          size_t row = (size_t)(l + r) * cubeSamples;
+          const double *rowSum = &rowSums[row];
+          const int *rowSpecial = &rowSpecials[row];
+          for(int s = 0; s < cubeSamples; s++) {
+            sums[s] += coefficient * rowSum[s];
+            specials[s] += rowSpecial[s];
+          }
+          if(handling == Renormalize) {
+            const double *rowWeight = &rowWeights[row];
+            for(int s = 0; s < cubeSamples; s++) {
+              weights[s] += coefficient * rowWeight[s];
+            }
+          }
+        }
+
+        for(int s = 0; s < cubeSamples; s++) {
+          double result = sums[s] * weight;
+          if(handling == NullIfAnySpecial && specials[s] > 0) {
+            result = Isis::Null;
+          }
+          else if(handling == Renormalize && specials[s] > 0) {
+            if(specials[s] == boxPixels || fabs(weights[s]) <= 1.0e-12 * absWeight) {
+              result = Isis::Null;
+            }
+            else {
+              result = sums[s] * (kernelSum / weights[s]) * weight;
+            }
+          }
+          out[l * cubeSamples + s] = result;
+        }
+      }
+      ocube->write(out);
+    };
+
+    p_progress->SetMaximumSteps(strips * cubeBands);
+    p_progress->CheckStatus();
+
+    for(band = 1; band <= cubeBands; band++) {
+      processStrips(strips, convolveStrip, p_progress);
+    }
+  }
+
+
+  /**
+   * Moves the boxcar through the input cube, handing the function the center
+   * pixel and a SlidingRank window holding the valid boxcar pixels between
+   * minimum and maximum, and writes the function's result to the output
+   * cube. The window holds the same pixels the boxcar Buffer would, but is
+   * updated incrementally as the boxcar moves along a line. Strips of lines
+   * are processed in parallel, so the function must be safe to call from
+   * several threads at once.
+   *
+   * @param funct The function computing an output pixel from the center
+   *              pixel and the window
+   * @param minimum Boxcar pixels less than this are left out of the window
+   * @param maximum Boxcar pixels greater than this are left out of the window
+   *
+   * @throws Isis::IException::Programmer
+   */
+  void ProcessByBoxcar::ProcessCubeRank(void funct(double center, const SlidingRank &window,
+                                                   double &out),
+                                        double minimum, double maximum) {
+    VerifyCubes();
+
+    const int stripLines = 64;
+
+    Cube *icube = InputCubes[0];
+    Cube *ocube = OutputCubes[0];
+    int cubeSamples = icube->sampleCount();
+    int cubeLines = icube->lineCount();
+    int cubeBands = icube->bandCount();
+    int strips = (cubeLines + stripLines - 1) / stripLines;
+    int boxSamples = p_boxSamples;
+    int boxLines = p_boxLines;
+    int blockSamples = cubeSamples + boxSamples - 1;
+
+    // Same placement of the boxcar around its center pixel as BoxcarManager,
+    // and the same center pixel as the middle of a boxcar Buffer
+    int sampleOffset = -((boxSamples - 1) / 2);
+    int lineOffset = -((boxLines - 1) / 2);
+    int centerIndex = (boxSamples * boxLines - 1) / 2;
+    int centerSample = centerIndex % boxSamples;
+    int centerLine = centerIndex / boxSamples;
+
+    int band = 1;
+    auto filterStrip = [&](int &strip) {
+      int firstLine = strip * stripLines + 1;
+      int outLines = min(stripLines, cubeLines - firstLine + 1);
+      int blockLines = outLines + boxLines - 1;
+
+      Brick block(blockSamples, blockLines, 1, icube->pixelType());
+      block.SetBasePosition(1 + sampleOffset, firstLine + lineOffset, band);
+      icube->read(block);
+      const double *pixels = block.DoubleBuffer();
+
+      Brick out(cubeSamples, outLines, 1, ocube->pixelType());
+      out.SetBasePosition(1, firstLine, band);
+
+      SlidingRank window(icube->pixelType(), icube->base(), icube->multiplier(),
+                         boxSamples * boxLines, minimum, maximum);
+      for(int l = 0; l < outLines; l++) {
+        for(int r = 0; r < boxLines; r++) {
+          window.add(pixels + (size_t)(l + r) * blockSamples, boxSamples);
+        }
+
+        for(int s = 0; s < cubeSamples; s++) {
+          double center = pixels[(size_t)(l + centerLine) * blockSamples + s + centerSample];
+          funct(center, window, out[l * cubeSamples + s]);
+
+          // Slide the boxcar one sample, or empty it at the end of the line
+          for(int r = 0; r < boxLines; r++) {
+            const double *row = pixels + (size_t)(l + r) * blockSamples;
+            if(s + 1 < cubeSamples) {
+              window.remove(row[s]);
+              window.add(row[s + boxSamples]);
+            }
+            else {
+              window.remove(row + s, boxSamples);
+            }
+          }
+        }
+      }
+      ocube->write(out);
+    };
+
+    p_progress->SetMaximumSteps(strips * cubeBands);
+    p_progress->CheckStatus();
+
+    for(band = 1; band <= cubeBands; band++) {
+      processStrips(strips, filterStrip, p_progress);
+    }
+  }
+
+
+  /**
+   * Applies the kernel by overlap-save FFT convolution. Each band is split
+   * into output tiles; the input block under a tile (the tile plus the
+   * boxcar margins) is transformed, multiplied by the conjugate transform of
+   * the kernel (a correlation, which is how the boxcar applies coefficients),
+   * and transformed back. Only the part of the result that did not wrap
+   * around the block is kept. The tiles of a row of tiles are processed in
+   * parallel.
+   *
+   * Special pixels are replaced by zero before the transform. The mask of
+   * valid pixels is carried in the imaginary part of the same transform,
+   * which yields the kernel weight covering the valid pixels needed by
+   * Renormalize. Special pixel counts for each boxcar are taken from a
+   * summed area table of the block, so they are exact.
+   */
+  void ProcessByBoxcar::ConvolveFft() {
+    FourierTransform fft;
+
+    int cubeSamples = InputCubes[0]->sampleCount();
+    int cubeLines = InputCubes[0]->lineCount();
+    int cubeBands = InputCubes[0]->bandCount();
+
+    // Blocks of about four kernel widths keep most of each block useful
+    int blockSamples = fft.NextFastSize(max(4 * p_boxSamples, 256));
+    blockSamples = min(blockSamples, fft.NextFastSize(cubeSamples + p_boxSamples - 1));
+    int blockLines = fft.NextFastSize(max(4 * p_boxLines, 256));
+    blockLines = min(blockLines, fft.NextFastSize(cubeLines + p_boxLines - 1));
+
+    int tileSamples = blockSamples - p_boxSamples + 1;
+    int tileLines = blockLines - p_boxLines + 1;
+    int tilesAcross = (cubeSamples + tileSamples - 1) / tileSamples;
+    int tilesDown = (cubeLines + tileLines - 1) / tileLines;
+
+    // Same placement of the boxcar around its center pixel as BoxcarManager
+    int sampleOffset = -((p_boxSamples - 1) / 2);
+    int lineOffset = -((p_boxLines - 1) / 2);
+
+    double kernelSum = 0.0;
+    double absWeight = 0.0;
+    vector<double> paddedKernel((size_t)blockSamples * blockLines, 0.0);
+    for(int l = 0; l < p_boxLines; l++) {
+      for(int s = 0; s < p_boxSamples; s++) {
+        double coefficient = p_kernel[l * p_boxSamples + s];
+        paddedKernel[(size_t)l * blockSamples + s] = coefficient;
+        kernelSum += coefficient;
+        absWeight += fabs(coefficient);
+      }
+    }
+    vector< complex<double> > kernelSpectrum =
+        fft.RealTransform2D(paddedKernel, blockSamples, blockLines);
+    for(unsigned int i = 0; i < kernelSpectrum.size(); i++) {
+      kernelSpectrum[i] = conj(kernelSpectrum[i]);
+    }
+
+    Cube *icube = InputCubes[0];
+    Cube *ocube = OutputCubes[0];
+    int boxSamples = p_boxSamples;
+    int boxLines = p_boxLines;
+    int boxPixels = boxSamples * boxLines;
+    double weight = p_kernelWeight;
+    SpecialPixelHandling handling = p_specialHandling;
+
+    p_progress->SetMaximumSteps(tilesDown * cubeBands);
+    p_progress->CheckStatus();
+
+    for(int band = 1; band <= cubeBands; band++) {
+      for(int tileRow = 0; tileRow < tilesDown; tileRow++) {
+        int firstLine = tileRow * tileLines + 1;
+
+        auto convolveTile = [&](int &tileColumn) {
+          int firstSample = tileColumn * tileSamples + 1;
+
+          Brick block(blockSamples, blockLines, 1, icube->pixelType());
+          block.SetBasePosition(firstSample + sampleOffset, firstLine + lineOffset, band);
+          icube->read(block);
+
+          // Special pixel summed area table with a leading row and column of zeros
+          int tableSamples = blockSamples + 1;
+          vector<int> specials((size_t)tableSamples * (blockLines + 1), 0);
+          vector< complex<double> > data(block.size());
+          for(int l = 0; l < blockLines; l++) {
+            int rowCount = 0;
+            for(int s = 0; s < blockSamples; s++) {
+              int index = l * blockSamples + s;
+              if(IsSpecial(block[index])) {
+                rowCount++;
+                data[index] = 0.0;
+              }
+              else {
+                data[index] = complex<double>(block[index], 1.0);
+              }
+              specials[(size_t)(l + 1) * tableSamples + s + 1] =
+                  specials[(size_t)l * tableSamples + s + 1] + rowCount;
+            }
+          }
+
+          FourierTransform tileFft;
+          tileFft.Transform2D(data, blockSamples, blockLines);
+          for(unsigned int i = 0; i < data.size(); i++) {
+            data[i] *= kernelSpectrum[i];
+          }
+          tileFft.Transform2D(data, blockSamples, blockLines, true);
+
+          Brick out(tileSamples, tileLines, 1, ocube->pixelType());
+          out.SetBasePosition(firstSample, firstLine, band);
+          for(int l = 0; l < tileLines; l++) {
+            for(int s = 0; s < tileSamples; s++) {
+              int specialCount =
+                  specials[(size_t)(l + boxLines) * tableSamples + s + boxSamples]
+                  - specials[(size_t)l * tableSamples + s + boxSamples]
+                  - specials[(size_t)(l + boxLines) * tableSamples + s]
+                  + specials[(size_t)l * tableSamples + s];
+              const complex<double> &value = data[(size_t)l * blockSamples + s];
+
+              double result = real(value) * weight;
+              if(handling == NullIfAnySpecial && specialCount > 0) {
+                result = Isis::Null;
+              }
+              else if(handling == Renormalize) {
+                double validWeight = imag(value);
+                if(specialCount == boxPixels) {
+                  result = Isis::Null;
+                }
+                else if(specialCount > 0) {
+                  if(fabs(validWeight) <= 1.0e-12 * absWeight) {
+                    result = Isis::Null;
+                  }
+                  else {
+                    result = real(value) * (kernelSum / validWeight) * weight;
+                  }
+                }
+              }
+              out[l * tileSamples + s] = result;
+            }
+          }
+          ocube->write(out);
+        };
+
+        QVector<int> tileColumns(tilesAcross);
+        for(int i = 0; i < tilesAcross; i++) {
+          tileColumns[i] = i;
+        }
+
+        if(QThreadPool::globalInstance()->maxThreadCount() > 1) {
+          QtConcurrent::blockingMap(tileColumns, convolveTile);
+        }
+        else {
+          for(int i = 0; i < tilesAcross; i++) {
+            convolveTile(tileColumns[i]);
+          }
+        }
+
+        p_progress->CheckStatus();
+      }
+    }
+  }
+
+
   /**
    * End the boxcar processing sequence and cleans up by closing cubes, freeing
    * memory, etc.
@@ -112,6 +763,8 @@ namespace Isis {
   void ProcessByBoxcar::EndProcess() {
 
     p_boxsizeSet = false;
+    p_kernel.clear();
+    p_separable = false;
     Isis::Process::EndProcess();
 
   }
@@ -123,6 +776,8 @@ namespace Isis {
   void ProcessByBoxcar::Finalize() {
 
     p_boxsizeSet = false;
+    p_kernel.clear();
+    p_separable = false;
     Isis::Process::Finalize();
 
   }
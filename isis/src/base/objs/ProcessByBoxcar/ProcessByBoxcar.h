@@ -6,16 +6,35 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <cfloat>
+#include <vector>
+
 #include "Process.h"
 #include "Buffer.h"
 
 namespace Isis {
+  class SlidingRank;
+
   /**
    * @brief Process cubes by boxcar
    *
    * This is the processing class used to move a boxcar through cube data. This
    * class allows only one input cube and one output cube.
    *
+   * Applications that compute a weighted sum of the boxcar can hand the
+   * weights to SetKernel() and call ProcessCubeKernel() instead of supplying a
+   * processing function. Separable (rank one) kernels, such as Gaussians and
+   * boxcar averages, are detected and applied as a horizontal pass followed
+   * by a vertical pass over strips of lines, costing O(samples + lines) per
+   * pixel. Other small kernels are applied directly; kernels larger than the
+   * FFT threshold are applied by overlap-save FFT convolution over tiles of
+   * the cube, which costs roughly the same per pixel for any kernel size.
+   *
+   * Applications that compute order statistics of the boxcar, such as median
+   * and mode filters, can call ProcessCubeRank() instead. It slides a
+   * SlidingRank window across strips of lines in parallel, so each step of
+   * the boxcar updates one column instead of sorting the whole boxcar.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2003-01-03 Tracie Sucharski
@@ -38,17 +57,47 @@ namespace Isis {
 
   class ProcessByBoxcar : public Isis::Process {
 
+    public:
+      /**
+       * How special pixels inside the boxcar are treated by ProcessCubeKernel()
+       */
+      enum SpecialPixelHandling {
+        NullIfAnySpecial, //!< The output is Null if any pixel in the boxcar is special
+        SkipSpecial,      //!< Special pixels contribute nothing to the weighted sum
+        Renormalize       /**< The weighted sum of the valid pixels is divided by
+                               the kernel weight they cover, so that a partially
+                               special boxcar has the same scale as a valid one */
+      };
+
     private:
       bool p_boxsizeSet; //!< Indicates whether the boxcar size has been set
       int p_boxSamples;  //!< Number of samples in boxcar
       int p_boxLines;    //!< Number of lines in boxcar
 
+      std::vector<double> p_kernel;             //!< Kernel coefficients in boxcar order
+      double p_kernelWeight;                    //!< Weight applied to every kernel result
+      SpecialPixelHandling p_specialHandling;   //!< Special pixel handling for the kernel
+      int p_fftThreshold;  //!< Kernels with more pixels than this are applied by FFT
+      bool p_separable;    //!< True if the kernel is the product of a row and a column
+      std::vector<double> p_rowKernel;     //!< Row factor of a separable kernel
+      std::vector<double> p_columnKernel;  //!< Column factor of a separable kernel
+
+      void VerifyCubes();
+      void DecomposeKernel();
+      double ApplyKernel(const Isis::Buffer &box) const;
+      void ConvolveSpatial();
+      void ConvolveSeparable();
+      void ConvolveFft();
 
     public:
 
       //! Constructs a ProcessByBoxcar object
       ProcessByBoxcar() {
         p_boxsizeSet = false;
+        p_kernelWeight = 1.0;
+        p_specialHandling = NullIfAnySpecial;
+        p_fftThreshold = 225;
+        p_separable = false;
       };
 
       //! Destroys the ProcessByBoxcar object.
@@ -56,11 +105,26 @@ namespace Isis {
 
       void SetBoxcarSize(const int ns, const int nl);
 
+      void SetKernel(const std::vector<double> &coefficients, double weight = 1.0,
+                     SpecialPixelHandling handling = NullIfAnySpecial);
+      void SetFftThreshold(int kernelPixels);
+
+      /**
+       * @return bool True if the kernel set with SetKernel() is separable and
+       *              will be applied as a row pass and a column pass
+       */
+      bool KernelIsSeparable() const {
+        return p_separable;
+      }
+
       using Isis::Process::StartProcess;  // make parent functions visable
       virtual void StartProcess(void funct(Isis::Buffer &in, double &out));
       void ProcessCube(void funct(Isis::Buffer &in, double &out)) {
         StartProcess(funct);
       }
+      void ProcessCubeKernel();
+      void ProcessCubeRank(void funct(double center, const SlidingRank &window, double &out),
+                           double minimum = -DBL_MAX, double maximum = DBL_MAX);
 
       void EndProcess();
       void Finalize();
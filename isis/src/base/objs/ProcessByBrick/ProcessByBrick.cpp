@@ -681,46 +681,6 @@ void ProcessByBrick::SetOutputRequirements(int outputRequirements) {
   }
 
 
-  /**
-   * This method blocks until the future reports that it is finished. This
-   *   monitors the progress of the future and translates it's progress values
-   *   into Isis progress class calls.
-   *
-   * @param future The future to monitor
-   */
-  void ProcessByBrick::BlockingReportProgress(QFuture<void> &future) {
-    int isisReportedProgress = 0;
-    int lastProgressValue = future.progressValue();
-    // Using a mutex with a timeout isn't as bad of a hack as inheriting QThread
-    //   but there ought to be a better way.
-    // Does having a local mutex make sense?
-    QMutex sleeper;
-    sleeper.lock();
-    while (!future.isFinished()) {
-      sleeper.tryLock(100);
-
-      if (future.progressValue() != lastProgressValue) {
-        lastProgressValue = future.progressValue();
-        // Progress min/max are reporting as 0's currently, so we're
-        //   assuming the progress value is an Isis progress value.
-        int isisProgressValue = lastProgressValue;
-        while (isisReportedProgress < isisProgressValue) {
-          p_progress->CheckStatus();
-          isisReportedProgress++;
-        }
-      }
-    }
-
-    while (isisReportedProgress < future.progressValue()) {
-      p_progress->CheckStatus();
-      isisReportedProgress++;
-    }
-
-    // Need to unlock the mutex before it goes out of scope, otherwise Qt5 issues a warning
-    sleeper.unlock();
-  }
-
-
   /**
    * Calculates the maximum dimensions of all the cubes and returns them in a
    * vector where position 0 is the max sample, position 1 is the max line, and
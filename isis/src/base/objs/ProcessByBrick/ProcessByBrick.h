@@ -287,9 +287,14 @@ namespace Isis {
 
         int threadCount = QThreadPool::globalInstance()->maxThreadCount();
         if (threaded && threadCount > 1) {
-          QFuture<void> result = QtConcurrent::mapped(begin, end,
-              wrapperFunctor);
-          BlockingReportProgress(result);
+          // Workers only record their steps; this thread reports them
+          Progress *progress = p_progress;
+          QFuture<void> result = QtConcurrent::map(begin, end,
+              [&wrapperFunctor, progress](const int &position) {
+                wrapperFunctor(position);
+                progress->AddCompletedSteps();
+              });
+          progress->WaitForFinished(result);
         }
         else {
           while (begin != end) {
@@ -725,7 +730,6 @@ namespace Isis {
        };
 
 
-      void BlockingReportProgress(QFuture<void> &future);
       std::vector<int> CalculateMaxDimensions(std::vector<Cube *> cubes) const;
       bool PrepProcessCubeInPlace(Cube **cube, Brick **bricks);
       int PrepProcessCube(Brick **ibrick, Brick **obrick);
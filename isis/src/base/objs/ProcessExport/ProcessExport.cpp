@@ -14,6 +14,8 @@ find files of those names at the top level of this repository. **/
 #include "IException.h"
 #include "LineManager.h"
 #include "BandManager.h"
+#include "Brick.h"
+#include "Cube.h"
 #include "SpecialPixel.h"
 #include "Histogram.h"
 #include "Stretch.h"
@@ -762,6 +764,10 @@ namespace Isis {
       p_str[i]->SetLrs(OutputLrs());
       p_str[i]->SetHis(OutputHis());
       p_str[i]->SetHrs(OutputHrs());
+
+      // Byte and word cubes are stretched through a lookup table
+      p_str[i]->CompileLookup(InputCubes[i]->pixelType(), InputCubes[i]->base(),
+                              InputCubes[i]->multiplier());
     }
 
     p_progress->CheckStatus();
@@ -810,9 +816,7 @@ namespace Isis {
       // Read a line of data
       InputCubes[0]->read(*buff);
       // Stretch the pixels into the desired range
-      for (int i = 0; i < buff->size(); i++) {
-        (*buff)[i] = p_str[0]->Map((*buff)[i]);
-      }
+      p_str[0]->Map(buff->DoubleBuffer(), buff->DoubleBuffer(), buff->size());
       // Invoke the user function
       funct(*buff);
       p_progress->CheckStatus();
@@ -852,8 +856,8 @@ namespace Isis {
         InputCubes[j]->read(*imgrs[j]);
 
         // Stretch the pixels into the desired range
-        for (int i = 0; i < InputCubes[0]->sampleCount(); i++)
-          (*imgrs[j])[i] = p_str[j]->Map((*imgrs[j])[i]);
+        p_str[j]->Map(imgrs[j]->DoubleBuffer(), imgrs[j]->DoubleBuffer(),
+                      InputCubes[0]->sampleCount());
 
         ibufs.push_back(imgrs[j]);
       }
@@ -1010,6 +1014,11 @@ namespace Isis {
   * method takes care of writing the input data to an output file stream
   * specified by the user instead of relying on an external function.
   *
+  * The cube is read, stretched and converted to the output pixel type and
+  * byte order in strips of lines on multiple threads. Each strip is then
+  * written to the stream with a single write, in file order, so only one
+  * batch of strips is held in memory at a time.
+  *
   * @param &fout An open stream to which the pixel data will be written. After
   *                       calling this method once, the stream will contain all
   *                       of  the pixel data from the input cube.
@@ -1017,231 +1026,187 @@ namespace Isis {
   void ProcessExport::StartProcess(std::ofstream &fout) {
     InitProcess();
 
-    Isis::BufferManager *buff;
-    if (p_format == BSQ) {
-      buff = new Isis::LineManager(*InputCubes[0]);
-    }
-    else if (p_format == BIL) {
-      buff = new Isis::LineManager(*InputCubes[0], true);
-    }
-    else if (p_format == BIP) {
-      buff = new Isis::BandManager(*InputCubes[0]);
-    }
-    else {
+    if (p_format != BSQ && p_format != BIL && p_format != BIP) {
       string m = "Output stream cannot be generated for requested storage order type.";
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
 
-    //This if is the changed one
-    if (m_canGenerateChecksum) {
-      // Loop for each line of data
-      for (buff->begin(); !buff->end(); buff->next()) {
-        // Read a line of data
-        InputCubes[0]->read(*buff);
-        QByteArray byteArray;
-        // Stretch the pixels into the desired range
-        for (int i = 0; i < buff->size(); i++) {
-          (*buff)[i] = p_str[0]->Map((*buff)[i]);
-          byteArray.append((*buff)[i]);
-        }
-        if (p_pixelType == Isis::UnsignedByte)
-          isisOut8(*buff, fout);
-        else if (p_pixelType == Isis::UnsignedWord)
-          isisOut16u(*buff, fout);
-        else if (p_pixelType == Isis::SignedWord)
-          isisOut16s(*buff, fout);
-        else if (p_pixelType == Isis::Real)
-          isisOut32(*buff, fout);
-        p_progress->CheckStatus();
-        m_cryptographicHash->addData(byteArray);
-      }
-    }
-    else {
-      for (buff->begin(); !buff->end(); buff->next()) {
-        // Read a line of data
-        InputCubes[0]->read(*buff);
-        // Stretch the pixels into the desired range
-        for (int i = 0; i < buff->size(); i++) {
-          (*buff)[i] = p_str[0]->Map((*buff)[i]);
+    Cube *cube = InputCubes[0];
+    int samples = cube->sampleCount();
+    int lines = cube->lineCount();
+    int bands = cube->bandCount();
+
+    // BSQ strips hold lines of one band, BIL and BIP strips hold lines of every band
+    int stripBands = (p_format == BSQ) ? 1 : bands;
+    int stripLines = std::max(1, (4 * 1024 * 1024) / (int) (sizeof(double) * samples * stripBands));
+    stripLines = std::min(stripLines, lines);
+    int bandStrips = (lines + stripLines - 1) / stripLines;
+    int strips = (p_format == BSQ) ? bandStrips * bands : bandStrips;
+
+    int batchSize = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    vector< vector<char> > stripData(batchSize);
+    vector< vector<char> > stripChecksum(batchSize);
+    QVector<int> batch;
+
+    auto convertStrip = [&](int &strip) {
+      int slot = strip % batchSize;
+      int band = (p_format == BSQ) ? strip / bandStrips + 1 : 1;
+      int firstLine = (strip % bandStrips) * stripLines + 1;
+      int lineCount = std::min(stripLines, lines - firstLine + 1);
+
+      Brick brick(samples, lineCount, stripBands, cube->pixelType());
+      brick.SetBasePosition(1, firstLine, band);
+      cube->read(brick);
+
+      // Stretch the pixels into the desired range
+      p_str[0]->Map(brick.DoubleBuffer(), brick.DoubleBuffer(), brick.size());
+
+      // Put the pixels in file order. The brick is already in BSQ order.
+      vector<double> interleaved;
+      const double *pixels = brick.DoubleBuffer();
+      if (p_format != BSQ) {
+        interleaved.resize(brick.size());
+        int index = 0;
+        for (int line = 0; line < lineCount; line++) {
+          if (p_format == BIL) {
+            for (int b = 0; b < bands; b++) {
+              const double *row = pixels + line * samples + b * samples * lineCount;
+              std::copy(row, row + samples, interleaved.begin() + index);
+              index += samples;
+            }
+          }
+          else {
+            for (int samp = 0; samp < samples; samp++) {
+              for (int b = 0; b < bands; b++) {
+                interleaved[index++] = pixels[samp + line * samples + b * samples * lineCount];
+              }
+            }
+          }
         }
-        if (p_pixelType == Isis::UnsignedByte)
-          isisOut8(*buff, fout);
-        else if (p_pixelType == Isis::UnsignedWord)
-          isisOut16u(*buff, fout);
-        else if (p_pixelType == Isis::SignedWord)
-          isisOut16s(*buff, fout);
-        else if (p_pixelType == Isis::Real)
-          isisOut32(*buff, fout);
-        p_progress->CheckStatus();
+        pixels = interleaved.data();
       }
-    }
-    delete buff;
-    return;
-  }
 
+      convertOutput(pixels, brick.size(), stripData[slot]);
 
-  /**
-  * @brief Write a buffer of 8-bit pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 8 bit pixel data.
-  * It will apply the necessary endian swap to the data and write it out to the
-  * output file buffer that the user specifies. The user can only expect to
-  * access this method indirectly by calling the StartProcess method
-  *
-  * @param &in Reference to a single buffer of pixel data. Note
-  *            that this buffer will already have had the necessary
-  *            stretching operations, though it will have the
-  *            native endianness of the system.
-  *
-  * @param &fout  Name of the file stream to which the buffer
-  *               of pixel data will be written.
-  */
-  void ProcessExport::isisOut8(Buffer &in, std::ofstream &fout) {
-    char *out8 = new char[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      if (pixel <= 0.0) {
-        out8[samp] = 0;
-      }
-      else if (pixel >= 255.0) {
-        out8[samp] = (char)255;
-      }
-      else {
-        out8[samp] = (char)(in[samp] + 0.5);  //Rounds
+      if (m_canGenerateChecksum) {
+        vector<char> &checksumData = stripChecksum[slot];
+        checksumData.resize(brick.size());
+        for (int i = 0; i < brick.size(); i++) {
+          checksumData[i] = pixels[i];
+        }
       }
-    }
-    fout.write(out8, in.size());
-    delete[] out8;
-    return;
-  }
-
+    };
 
-  /**
-  * @brief Write a buffer of 16-bit signed pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is
-  * 16-bit signed pixel data. It will apply the necessary endian
-  * swap to the data and write it out to the output file buffer
-  * that the user specifies. The user can only expect to access
-  * this method indirectly by calling the StartProcess method.
-  *
-  * @param &in Reference to a single buffer of pixel data. Note
-  *            that this buffer will already have had the
-  *            necessary stretching operations, though it will
-  *            have the native endianness of the system.
-  *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
-  */
-  void ProcessExport::isisOut16s(Buffer &in, std::ofstream &fout) {
-    short *out16s = new short[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      short tempShort;
-      if (pixel <= -32768.0) {
-        tempShort = (short)32768;
-        tempShort = -1 * tempShort;
+    for (int firstStrip = 0; firstStrip < strips; firstStrip += batchSize) {
+      batch.clear();
+      for (int strip = firstStrip; strip < std::min(strips, firstStrip + batchSize); strip++) {
+        batch.append(strip);
       }
-      else if (pixel >= 32767.0) {
-        tempShort = (short)32767;
-      }
-      else {
-        //Rounds
-        if (in[samp] < 0.0) {
-          tempShort = (short)(in[samp] - 0.5);
+      QtConcurrent::blockingMap(batch, convertStrip);
+
+      for (int i = 0; i < batch.size(); i++) {
+        int slot = batch[i] % batchSize;
+        fout.write(stripData[slot].data(), stripData[slot].size());
+        if (m_canGenerateChecksum) {
+          m_cryptographicHash->addData(stripChecksum[slot].data(), stripChecksum[slot].size());
         }
-        else {
-          tempShort = (short)(in[samp] + 0.5);
+
+        // Report progress in the same steps as a buffer by buffer export
+        int firstLine = (batch[i] % bandStrips) * stripLines + 1;
+        int lineCount = std::min(stripLines, lines - firstLine + 1);
+        int steps = lineCount * ((p_format == BIL) ? bands : (p_format == BIP) ? samples : 1);
+        for (int step = 0; step < steps; step++) {
+          p_progress->CheckStatus();
         }
       }
-      void *p_swap = &tempShort;
-      out16s[samp] = p_endianSwap->ShortInt(p_swap);
     }
-    fout.write((char *)out16s, in.size() * 2);
-    delete[] out16s;
-    return;
   }
 
 
   /**
-  * @brief Write a bufferof 16-bit unsigned pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 16-bit
-  * unsigned pixel data. It will apply the necessary endian swap
-  * to the data and write it out to the output file buffer that
-  * the user specifies. The user can only expect to access this
-  * method indirectly by calling the StartProcess method.
-  *
-  * @param &in Reference to a single buffer of pixel data. Note that this buffer
-  *          will already have had the necessary stretching operations, though
-  *          it will have the native endianness of the system.
+  * @brief Convert stretched pixels to the output pixel type and byte order
   *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
+  * Rounds and clamps each pixel to the range of the output pixel type, then
+  * applies the output byte order. The pixels are converted in simple loops
+  * over contiguous arrays so the compiler can vectorize them. Output pixel
+  * types that can not be written to a stream produce no data.
   *
+  * @param in The stretched pixels, in file order
+  * @param count The number of pixels
+  * @param out The raw output bytes
   */
-  void ProcessExport::isisOut16u(Buffer &in, std::ofstream &fout) {
-    unsigned short *out16u = new unsigned short[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      unsigned short tempShort;
-      if (pixel <= 0.0) {
-        tempShort = 0;
+  void ProcessExport::convertOutput(const double *in, int count, vector<char> &out) const {
+    bool swap = (p_endianSwap != NULL) && p_endianSwap->willSwap();
+
+    if (p_pixelType == Isis::UnsignedByte) {
+      out.resize(count);
+      unsigned char *out8 = (unsigned char *) out.data();
+      for (int i = 0; i < count; i++) {
+        double pixel = in[i];
+        out8[i] = (pixel <= 0.0) ? 0 :
+                  (pixel >= 255.0) ? 255 : (unsigned char) (pixel + 0.5);  //Rounds
       }
-      else if (pixel >= 65535.0) {
-        tempShort = 65535;
+    }
+    else if (p_pixelType == Isis::UnsignedWord) {
+      out.resize(count * sizeof(unsigned short));
+      unsigned short *out16u = (unsigned short *) out.data();
+      for (int i = 0; i < count; i++) {
+        double pixel = in[i];
+        out16u[i] = (pixel <= 0.0) ? 0 :
+                    (pixel >= 65535.0) ? 65535 : (unsigned short) (pixel + 0.5);  //Rounds
       }
-      else {
-        tempShort = (unsigned short)(in[samp] + 0.5); //Rounds
+      if (swap) {
+        for (int i = 0; i < count; i++) {
+          out16u[i] = (unsigned short) ((out16u[i] >> 8) | (out16u[i] << 8));
+        }
       }
-      unsigned short *p_swap = &tempShort;
-      out16u[samp] = p_endianSwap->UnsignedShortInt(p_swap);
     }
-
-    fout.write((char *)out16u, in.size() * 2);
-    delete[] out16u;
-    return;
-  }
-
-
-  /**
-  * @brief Write a buffer of 32-bit floating point pixel data to a stream
-  *
-  * This method takes a buffer of data and assumes that it is 32-bit floating
-  * point pixel data. It will apply the necessary endian swap to the data and
-  * write it out to the output file buffer that the user specifies. The user can only
-  * expect to access this method indirectly by calling the StartProcess method.
-  *
-  * @param &in Reference to a single buffer of pixel data. Note that this buffer
-  *          will already have had the necessary stretching operations, though
-  *          it will have the native endianness of the system.
-  *
-  * @param &fout Name of the file stream to which the buffer of pixel data will
-  *              be written.
-  *
-  */
-  void ProcessExport::isisOut32(Buffer &in, std::ofstream &fout) {
-    int *out32 = new int[in.size()];
-    for (int samp = 0; samp < in.size(); samp++) {
-      double pixel = in[samp];
-      float tempFloat;
-      if (pixel <= -((double)FLT_MAX)) {
-        tempFloat = -((double)FLT_MAX);
+    else if (p_pixelType == Isis::SignedWord) {
+      out.resize(count * sizeof(short));
+      short *out16s = (short *) out.data();
+      for (int i = 0; i < count; i++) {
+        double pixel = in[i];
+        if (pixel <= -32768.0) {
+          out16s[i] = -32768;
+        }
+        else if (pixel >= 32767.0) {
+          out16s[i] = 32767;
+        }
+        else {
+          //Rounds
+          out16s[i] = (short) ((pixel < 0.0) ? pixel - 0.5 : pixel + 0.5);
+        }
       }
-      else if (pixel >= (double)FLT_MAX) {
-        tempFloat = (double)FLT_MAX;
+      if (swap) {
+        unsigned short *words = (unsigned short *) out16s;
+        for (int i = 0; i < count; i++) {
+          words[i] = (unsigned short) ((words[i] >> 8) | (words[i] << 8));
+        }
       }
-      else {
-        tempFloat = (double)in[samp];
+    }
+    else if (p_pixelType == Isis::Real) {
+      out.resize(count * sizeof(float));
+      float *out32 = (float *) out.data();
+      for (int i = 0; i < count; i++) {
+        double pixel = in[i];
+        out32[i] = (pixel <= -((double) FLT_MAX)) ? -FLT_MAX :
+                   (pixel >= (double) FLT_MAX) ? FLT_MAX : (float) pixel;
+      }
+      if (swap) {
+        uint32_t *words = (uint32_t *) out32;
+        for (int i = 0; i < count; i++) {
+          uint32_t word = words[i];
+          words[i] = (word >> 24) | ((word >> 8) & 0x0000ff00u) |
+                     ((word << 8) & 0x00ff0000u) | (word << 24);
+        }
       }
-      void *p_swap = &tempFloat;
-      out32[samp] = p_endianSwap->ExportFloat(p_swap);
     }
-    fout.write((char *)out32, in.size() * 4);
-    delete[] out32;
-    return;
+    else {
+      out.clear();
+    }
   }
 
+
   /**
   * @brief Create a standard world file for the input cube
   *
@@ -8,17 +8,24 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Process.h"
 
+#include <algorithm>
 #include <fstream>
 #include <iostream>
 #include <string>
+#include <vector>
 
 #include <QCryptographicHash>
 #include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
 
+#include "Brick.h"
 #include "Buffer.h"
 #include "BufferManager.h"
 #include "Endian.h"
 #include "EndianSwapper.h"
+#include "IException.h"
 #include "SpecialPixel.h"
 #include "Stretch.h"
 #include "UserInterface.h"
@@ -193,10 +200,8 @@ namespace Isis {
             InputCubes[cubeIndex]->read(*imgrs[cubeIndex]);
 
             // Stretch the pixels into the desired range
-            for (int sampleIndex = 0; sampleIndex < samples; sampleIndex++) {
-              (*imgrs[cubeIndex])[sampleIndex] =
-                  p_str[cubeIndex]->Map((*imgrs[cubeIndex])[sampleIndex]);
-            }
+            p_str[cubeIndex]->Map(imgrs[cubeIndex]->DoubleBuffer(),
+                                  imgrs[cubeIndex]->DoubleBuffer(), samples);
 
             ibufs.push_back(imgrs[cubeIndex]);
           }
@@ -209,6 +214,77 @@ namespace Isis {
         }
       }
 
+
+      /**
+       * Processes the input cubes a strip of lines at a time. Each strip is
+       * read from every input cube and stretched into the output range, then
+       * handed to the converter. Strips are read and converted in batches
+       * spread over the global thread pool, and the writer is called for each
+       * strip of a batch in line order on the calling thread, so only one
+       * batch of strips is in memory at any time. The input cubes must each
+       * have a single band.
+       *
+       * @param converter Called as converter(firstLine, lineCount, strips)
+       *                  with one stretched Buffer per input cube. Strips are
+       *                  converted concurrently, in no particular order.
+       * @param writer Called as writer(firstLine, lineCount) after the strip
+       *               starting at firstLine has been converted.
+       * @param stripLines The number of lines in each strip
+       */
+      template <typename Converter, typename Writer>
+      void ProcessCubeStrips(const Converter &converter, const Writer &writer, int stripLines) {
+        InitProcess();
+
+        for (unsigned int cubeIndex = 0; cubeIndex < InputCubes.size(); cubeIndex++) {
+          if (InputCubes[cubeIndex]->bandCount() != 1) {
+            std::string m = "Strip processing requires single band input cubes";
+            throw IException(IException::Programmer, m, _FILEINFO_);
+          }
+        }
+
+        int samples = InputCubes[0]->sampleCount();
+        int lines = InputCubes[0]->lineCount();
+        stripLines = std::max(1, std::min(stripLines, lines));
+        int strips = (lines + stripLines - 1) / stripLines;
+
+        auto convertStrip = [&](int &strip) {
+          int firstLine = strip * stripLines + 1;
+          int lineCount = std::min(stripLines, lines - firstLine + 1);
+
+          std::vector<Buffer *> ibufs;
+          for (unsigned int cubeIndex = 0; cubeIndex < InputCubes.size(); cubeIndex++) {
+            Brick *brick = new Brick(samples, lineCount, 1, InputCubes[cubeIndex]->pixelType());
+            brick->SetBasePosition(1, firstLine, 1);
+            InputCubes[cubeIndex]->read(*brick);
+
+            // Stretch the pixels into the desired range
+            p_str[cubeIndex]->Map(brick->DoubleBuffer(), brick->DoubleBuffer(), brick->size());
+
+            ibufs.push_back(brick);
+          }
+
+          converter(firstLine, lineCount, ibufs);
+
+          for (unsigned int i = 0; i < ibufs.size(); i++) delete ibufs[i];
+        };
+
+        int batchSize = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+        for (int firstStrip = 0; firstStrip < strips; firstStrip += batchSize) {
+          QVector<int> batch;
+          for (int strip = firstStrip; strip < std::min(strips, firstStrip + batchSize); strip++) {
+            batch.append(strip);
+          }
+          QtConcurrent::blockingMap(batch, convertStrip);
+
+          for (int i = 0; i < batch.size(); i++) {
+            int firstLine = batch[i] * stripLines + 1;
+            int lineCount = std::min(stripLines, lines - firstLine + 1);
+            writer(firstLine, lineCount);
+            for (int line = 0; line < lineCount; line++) p_progress->CheckStatus();
+          }
+        }
+      }
+
     protected:
 
       //! Current storage order
@@ -270,22 +346,8 @@ namespace Isis {
       bool m_canGenerateChecksum;  /**< Flag to determine if a file checksum will be generated. */
 
     private:
-      //!Method for writing 8-bit unsigned pixel data to a file stream
-      void isisOut8(Buffer &in, std::ofstream &fout);
-
-      //!Method for writing 16-bit signed pixel data to a file stream
-      void isisOut16s(Buffer &in, std::ofstream &fout);
-
-      //!Method for writing 16-bit unsigned pixel data to a file stream
-      void isisOut16u(Buffer &in, std::ofstream &fout);
-
-      /**Method for writing 32-bit signed floating point pixels data to a
-      file stream*/
-      void isisOut32(Buffer &in, std::ofstream &fout);
-
-      /**Method for writing 64-bit signed double precision floating point pixels
-      data to a file stream*/
-      void isisOut64(Buffer &in, std::ofstream &fout);
+      //! Method for converting stretched pixels to raw output pixels
+      void convertOutput(const double *in, int count, std::vector<char> &out) const;
 
       /** Convenience method that checks to make sure the user is only using
       valid input to the StartProcess method. Also sets the cube up to be
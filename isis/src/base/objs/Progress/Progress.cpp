@@ -9,11 +9,25 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Progress.h"
+
+#include <climits>
+
+#include <QThread>
+
 #include "Application.h"
 #include "Preference.h"
 
 using namespace std;
 namespace Isis {
+
+  namespace {
+    //! Milliseconds between checks of the steps completed by other threads
+    const int reportInterval = 10;
+
+    //! Milliseconds between Gui event processing while progress is checked
+    const int eventInterval = 50;
+  }
+
   /**
    * Constructs a Progress object.
    *
@@ -44,6 +58,7 @@ namespace Isis {
     p_percentIncrement = percent;
     p_printPercent = printPercent;
     p_autoDisplay = true;
+    p_nextPercentStep = INT_MAX;
   }
 
   //! Destroys the Progress object
@@ -91,6 +106,8 @@ namespace Isis {
     p_maximumSteps = steps;
     p_currentStep = 0;
     p_currentPercent = 0;
+    p_completedSteps.fetchAndStoreRelaxed(0);
+    updateNextPercentStep();
   }
 
   /**
@@ -124,27 +141,37 @@ namespace Isis {
     }
 
     // See if the percent processed needs to be updated
-    while(100.0 * p_currentStep / p_maximumSteps >= p_currentPercent) {
-      if(Isis::iApp != NULL) {
-        if (p_autoDisplay) {
-          Isis::iApp->UpdateProgress(p_currentPercent, p_printPercent);
-        }
-      }
-      else {
-        if(p_printPercent && p_autoDisplay) {
-          if(p_currentPercent < 100) {
-            cout << p_currentPercent << "% Processed\r" << flush;
+    bool reported = (p_currentStep == 0);
+    if(p_currentStep >= p_nextPercentStep) {
+      while(100.0 * p_currentStep / p_maximumSteps >= p_currentPercent) {
+        if(Isis::iApp != NULL) {
+          if (p_autoDisplay) {
+            Isis::iApp->UpdateProgress(p_currentPercent, p_printPercent);
           }
-          else {
-            cout << p_currentPercent << "% Processed" << endl;
+        }
+        else {
+          if(p_printPercent && p_autoDisplay) {
+            if(p_currentPercent < 100) {
+              cout << p_currentPercent << "% Processed\r" << flush;
+            }
+            else {
+              cout << p_currentPercent << "% Processed" << endl;
+            }
           }
         }
+        p_currentPercent += p_percentIncrement;
       }
-      p_currentPercent += p_percentIncrement;
+      updateNextPercentStep();
+      reported = true;
     }
 
+    // Steps between percentages only let the Gui redraw and check for a
+    // cancel a few times a second
     if(p_autoDisplay && Isis::iApp != NULL) {
-      Isis::iApp->ProcessGuiEvents();
+      if(reported || !p_eventTimer.isValid() || p_eventTimer.elapsed() >= eventInterval) {
+        Isis::iApp->ProcessGuiEvents();
+        p_eventTimer.start();
+      }
     }
 
     // Increment to the next step
@@ -154,6 +181,86 @@ namespace Isis {
   }
 
 
+  /**
+   * Records steps that were completed, possibly on another thread. This only
+   * increments an atomic counter, so it is safe and cheap to call from
+   * parallel processing loops. The steps are reported by
+   * ReportCompletedSteps() or WaitForFinished() on the thread that owns the
+   * user interface. Steps are counted the same way as calls to CheckStatus()
+   * after the first, so work that calls CheckStatus() once before it starts
+   * can record each of its steps here instead.
+   *
+   * @param steps The number of steps completed
+   */
+  void Progress::AddCompletedSteps(const int steps) {
+    p_completedSteps.fetchAndAddRelaxed(steps);
+  }
+
+
+  /**
+   * Reports the steps recorded by AddCompletedSteps() as if CheckStatus() had
+   * been called for each of them. Only the percentages the steps cross are
+   * reported, so this is cheap however many steps were recorded. This must
+   * be called from the thread that owns the user interface.
+   *
+   * @throws IException::Programmer Step exceeds maximumSteps
+   */
+  void Progress::ReportCompletedSteps() {
+    int completed = p_completedSteps.loadAcquire();
+
+    if(p_currentStep == 0) {
+      CheckStatus();
+    }
+
+    if(completed >= p_currentStep) {
+      p_currentStep = completed;
+      CheckStatus();
+    }
+  }
+
+
+  /**
+   * Blocks until the work of a future is finished, reporting the steps it
+   * records with AddCompletedSteps() every few milliseconds. If the user
+   * cancels from the Gui while waiting, the future is cancelled and waited
+   * for before the cancel is passed on, since the work may still be using
+   * the caller's data.
+   *
+   * @param future The future of the work to wait for
+   */
+  void Progress::WaitForFinished(QFuture<void> &future) {
+    try {
+      while(!future.isFinished()) {
+        QThread::msleep(reportInterval);
+        ReportCompletedSteps();
+      }
+    }
+    catch(...) {
+      future.cancel();
+      future.waitForFinished();
+      throw;
+    }
+
+    future.waitForFinished();
+    ReportCompletedSteps();
+  }
+
+
+  /**
+   * Computes the first step at which the current percent is reached, which
+   * is the step CheckStatus() next reports a percentage at.
+   */
+  void Progress::updateNextPercentStep() {
+    if(p_maximumSteps <= 0) {
+      p_nextPercentStep = INT_MAX;
+      return;
+    }
+
+    long long step = ((long long)p_currentPercent * p_maximumSteps + 99) / 100;
+    p_nextPercentStep = (int)min(step, (long long)INT_MAX);
+  }
+
+
   /**
    * Turns off updating the Isis Gui when CheckStatus() is called. You must use
    *   RedrawProgress() to visually update the current progress.
@@ -213,5 +320,7 @@ namespace Isis {
       string m = "Maximum steps must be greater than zero in [Progress::AddSteps]";
       throw IException(IException::Programmer, m, _FILEINFO_);
     }
+
+    updateNextPercentStep();
   }
 } // end namespace isis
@@ -6,6 +6,9 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <QAtomicInt>
+#include <QElapsedTimer>
+#include <QFuture>
 #include <QString>
 
 namespace Isis {
@@ -17,6 +20,12 @@ namespace Isis {
    * is created within a Process derived class. Therefore you should only use this
    * object if you are developing such a class.
    *
+   * CheckStatus() must be called from the thread that owns the user interface.
+   * Work that runs on other threads records its steps with AddCompletedSteps(),
+   * which only increments an atomic counter, and the thread that waits for the
+   * work reports them with ReportCompletedSteps() or WaitForFinished(), which
+   * samples the counter at a fixed interval.
+   *
    * @ingroup ApplicationInterface
    *
    * @author 2002-05-22 Jeff Anderson
@@ -62,6 +71,15 @@ namespace Isis {
       // Check and report status
       void CheckStatus();
 
+      // Record steps completed on any thread
+      void AddCompletedSteps(const int steps = 1);
+
+      // Report the steps recorded with AddCompletedSteps
+      void ReportCompletedSteps();
+
+      // Report recorded steps until the work of a future is finished
+      void WaitForFinished(QFuture<void> &future);
+
       void DisableAutomaticDisplay();
 
       int MaximumSteps() const;
@@ -86,6 +104,15 @@ namespace Isis {
       bool p_printPercent;
 
       bool p_autoDisplay;
+
+      int p_nextPercentStep;  /**<The first step at which p_currentPercent is
+                                  reached.*/
+      QAtomicInt p_completedSteps; /**<Steps recorded by AddCompletedSteps,
+                                       which may be called from any thread.*/
+      QElapsedTimer p_eventTimer;  /**<Time since the Gui last processed
+                                       events.*/
+
+      void updateNextPercentStep();
   };
 };
 
@@ -181,7 +181,20 @@ namespace Isis {
    */
   void PushFrameCameraDetectorMap::SetFramelet(int framelet, const double deltaT) {
     p_framelet = framelet;
+    p_camera->setTime(frameletTime(framelet) + deltaT);
+  }
+
 
+
+  /**
+   * Returns the ephemeris time at the center of a framelet, the time
+   *   SetFramelet gives the camera, without changing the current framelet.
+   *
+   * @param framelet The framelet
+   *
+   * @return @b double The ephemeris time at the center of the framelet
+   */
+  double PushFrameCameraDetectorMap::frameletTime(int framelet) const {
     // We can add framelet padding to each band.  Compute the adjusted framelet
     // number
     int adjustedFramelet = (int) framelet - p_frameletOffset;
@@ -196,7 +209,7 @@ namespace Isis {
     }
 
     etTime += p_exposureDuration / 2.0;
-    p_camera->setTime(etTime + deltaT);
+    return etTime;
   }
 
 
@@ -68,6 +68,7 @@ namespace Isis {
 
       void SetFramelet(int framelet, const double deltaT=0);
       int Framelet();
+      double frameletTime(int framelet) const;
       
       void SetBandFirstDetectorLine(int firstLine);
       int GetBandFirstDetectorLine();
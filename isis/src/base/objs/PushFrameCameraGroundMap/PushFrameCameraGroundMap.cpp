@@ -6,6 +6,8 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "PushFrameCameraGroundMap.h"
 
+#include <limits>
+
 #include <QDebug>
 
 #include "CameraDistortionMap.h"
@@ -14,7 +16,11 @@ find files of those names at the top level of this repository. **/
 #include "Latitude.h"
 #include "Longitude.h"
 #include "PushFrameCameraDetectorMap.h"
+#include "ShapeModel.h"
+#include "SpicePosition.h"
+#include "SpiceRotation.h"
 #include "SurfacePoint.h"
+#include "Target.h"
 
 namespace Isis {
   /**
@@ -31,12 +37,25 @@ namespace Isis {
 
     SurfacePoint surfacePoint(lat, lon, p_camera->LocalRadius(lat, lon));
 
+    // Intersect the ground point once. Without the back check the intersection
+    // does not depend on the spacecraft position, so the search for the closest
+    // framelet only needs the cached spacecraft position of each framelet.
+    if (!p_camera->Sensor::SetGround(surfacePoint, false)) {
+      return false;
+    }
+
+    ShapeModel *shape = p_camera->target()->shape();
+    double pB[3];
+    pB[0] = shape->surfaceIntersection()->GetX().kilometers();
+    pB[1] = shape->surfaceIntersection()->GetY().kilometers();
+    pB[2] = shape->surfaceIntersection()->GetZ().kilometers();
+
     // Get ending bounding framelets and distances for iterative loop to minimize the spacecraft distance
     int startFramelet = 1;
-    double startDist = FindSpacecraftDistance(1, surfacePoint);
+    double startDist = FindSpacecraftDistance(1, pB);
 
     int    endFramelet = detectorMap->TotalFramelets();
-    double endDist     = FindSpacecraftDistance(endFramelet, surfacePoint);
+    double endDist     = FindSpacecraftDistance(endFramelet, pB);
 
     bool minimizedSpacecraftDist = false;
 
@@ -67,7 +86,7 @@ namespace Isis {
       }
 
       int middleFramelet = startFramelet + (int)(deltaX + biasFactor * deltaX);
-      double middleDist = FindSpacecraftDistance(middleFramelet, surfacePoint);
+      double middleDist = FindSpacecraftDistance(middleFramelet, pB);
 
       if (startDist > endDist) {
         // This makes sure we don't get stuck halfway between framelets
@@ -157,7 +176,7 @@ namespace Isis {
     double ux = p_camera->FocalLength() * lookC[0] / lookC[2];
     double uy = p_camera->FocalLength() * lookC[1] / lookC[2];
 
-    if(!distortionMap->SetUndistortedFocalPlane(ux, uy)) return DBL_MAX;
+    if(!distortionMap->SetUndistortedFocalPlaneFromGrid(ux, uy)) return DBL_MAX;
 
     double dx = distortionMap->FocalPlaneX();
     double dy = distortionMap->FocalPlaneY();
@@ -178,18 +197,61 @@ namespace Isis {
    * spacecraft at the time the specified framelet was taken.
    *
    * @param framelet Which framelet was being captured (determines time)
-   * @param lat Latitude of the point on the ground
-   * @param lon Longitude of the point on the ground
+   * @param pB Body-fixed coordinate of the point on the ground in km
    *
-   * @return double Distance from spacecraft to the lat,lon
+   * @return double Distance from spacecraft to the point on the ground
    */
   double PushFrameCameraGroundMap::FindSpacecraftDistance(int framelet,
-      const SurfacePoint &surfacePoint) {
+      const double pB[3]) {
+    SpiceDouble sB[3], psB[3], upsB[3];
+    SpiceDouble dist;
+
+    FrameletPosition(framelet, sB);
+    vsub_c(pB, sB, psB);
+    unorm_c(psB, upsB, &dist);
+    return dist;
+  }
+
+
+  /**
+   * This method finds the body-fixed spacecraft position at the time the
+   * specified framelet was taken.  Positions are cached by framelet along with
+   * the framelet time, so a change of band timing simply recomputes them.
+   *
+   * @param framelet Which framelet was being captured (determines time)
+   * @param sB Returns the body-fixed spacecraft position in km
+   */
+  void PushFrameCameraGroundMap::FrameletPosition(int framelet, double sB[3]) {
     PushFrameCameraDetectorMap *detectorMap = (PushFrameCameraDetectorMap *) p_camera->DetectorMap();
 
-    detectorMap->SetFramelet(framelet);
-    if(!p_camera->Sensor::SetGround(surfacePoint, false)) return DBL_MAX;
+    int totalFramelets = detectorMap->TotalFramelets();
+    if ((int) p_frameletTimes.size() != totalFramelets) {
+      p_frameletTimes.assign(totalFramelets, std::numeric_limits<double>::quiet_NaN());
+      p_frameletPositions.assign(3 * totalFramelets, 0.0);
+    }
 
-    return p_camera->SlantDistance();
+    bool cached = (framelet >= 1 && framelet <= totalFramelets);
+    double et = detectorMap->frameletTime(framelet);
+
+    if (cached && p_frameletTimes[framelet - 1] == et) {
+      sB[0] = p_frameletPositions[3 * (framelet - 1)];
+      sB[1] = p_frameletPositions[3 * (framelet - 1) + 1];
+      sB[2] = p_frameletPositions[3 * (framelet - 1) + 2];
+      return;
+    }
+
+    detectorMap->SetFramelet(framelet);
+    std::vector<double> position =
+        p_camera->bodyRotation()->ReferenceVector(p_camera->instrumentPosition()->Coordinate());
+    sB[0] = position[0];
+    sB[1] = position[1];
+    sB[2] = position[2];
+
+    if (cached) {
+      p_frameletTimes[framelet - 1] = et;
+      p_frameletPositions[3 * (framelet - 1)] = sB[0];
+      p_frameletPositions[3 * (framelet - 1) + 1] = sB[1];
+      p_frameletPositions[3 * (framelet - 1) + 2] = sB[2];
+    }
   }
 }
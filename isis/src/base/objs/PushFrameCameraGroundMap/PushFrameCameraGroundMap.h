@@ -9,6 +9,8 @@ find files of those names at the top level of this repository. **/
 
 #include "CameraGroundMap.h"
 
+#include <vector>
+
 namespace Isis {
   /** Convert between undistorted focal plane and ground coordinates
    *
@@ -52,10 +54,15 @@ namespace Isis {
 
     private:
       double FindDistance(int framelet, const SurfacePoint &surfacePoint);
-      double FindSpacecraftDistance(int framelet,
-                                    const SurfacePoint &surfacePoint);
+      double FindSpacecraftDistance(int framelet, const double pB[3]);
+      void FrameletPosition(int framelet, double sB[3]);
 
       bool   p_evenFramelets; //!< True if the file contains even framelets
+
+      //! The time of each cached framelet position, NaN if not cached yet
+      std::vector<double> p_frameletTimes;
+      //! The body-fixed spacecraft position of each framelet in km
+      std::vector<double> p_frameletPositions;
   };
 };
 #endif
@@ -144,31 +144,26 @@ namespace Isis {
      PvlKeyword key;
 
      int inst = 0;
-     PvlGroup transGroup;
      PvlKeyword grp;
+     QStringList inputKeys = InputKeywordNames(translationGroupName);
 
      while((grp = InputGroup(translationGroupName, inst++)).name() != "") {
        if((con = GetContainer(grp)) != NULL) {
-         transGroup = TranslationTable().findGroup(translationGroupName);
-         Pvl::ConstPvlKeywordIterator it = transGroup.findKeyword("InputKey",
-                                           transGroup.begin(),
-                                           transGroup.end());
          // Loop through potential InputKeys in the translation file group currently beginning
          // translated.
-         while(it != transGroup.end()) {
-           const PvlKeyword &result = *it;
-           if(con->hasKeyword(result[0])) {
+         foreach(QString inputKey, inputKeys) {
+           if(con->hasKeyword(inputKey)) {
+             const PvlKeyword &inputKeyword = con->findKeyword(inputKey);
              key.setName(OutputName(translationGroupName));
 
-             for(int v = 0; v < (*con)[(result[0])].size(); v++) {
+             for(int v = 0; v < inputKeyword.size(); v++) {
                key.addValue(PvlTranslationTable::Translate(translationGroupName,
-                                                           (*con)[result[0]][v]),
-                            (*con)[result[0]].unit(v));
+                                                           inputKeyword[v]),
+                            inputKeyword.unit(v));
              }
 
              return key;
            }
-           it = transGroup.findKeyword("InputKey", it + 1, transGroup.end());
          }
        }
      }
@@ -198,15 +193,14 @@ namespace Isis {
    */
   void PvlToPvlTranslationManager::Auto(Pvl &outputLabel) {
     // Attempt to translate every group in the translation table
-    for(int i = 0; i < TranslationTable().groups(); i++) {
-      PvlGroup &g = TranslationTable().group(i);
-      if(IsAuto(g.name())) {
+    foreach(QString groupName, translationGroupNames()) {
+      if(IsAuto(groupName)) {
         try {
-          PvlContainer *con = CreateContainer(g.name(), outputLabel);
-          (*con) += DoTranslation(g.name());
+          PvlContainer *con = CreateContainer(groupName, outputLabel);
+          (*con) += DoTranslation(groupName);
         }
         catch(IException &e) {
-          if(!IsOptional(g.name())) {
+          if(!IsOptional(groupName)) {
             throw;
           }
         }
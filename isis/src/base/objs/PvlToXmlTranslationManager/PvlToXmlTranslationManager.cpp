@@ -221,17 +221,16 @@ namespace Isis {
   void PvlToXmlTranslationManager::Auto(QDomDocument &outputLabel) {
     Pvl pvl;
     // Attempt to translate every group in the translation table
-    for(int i = 0; i < TranslationTable().groups(); i++) {
-      PvlGroup &g = TranslationTable().group(i);
-      if(IsAuto(g.name())) {
+    foreach(QString groupName, translationGroupNames()) {
+      if(IsAuto(groupName)) {
         try {
           QDomElement element = outputLabel.documentElement();
-          QDomElement *parentElement = createParentElements(g.name(), element);
+          QDomElement *parentElement = createParentElements(groupName, element);
           // deal with siblings and attributes
-          doTranslation(g, *parentElement);
+          doTranslation(findTranslationGroup(groupName), *parentElement);
         }
         catch(IException &e) {
-          if(!IsOptional(g.name())) {
+          if(!IsOptional(groupName)) {
             throw;//???
           }
         }
@@ -5,9 +5,14 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <fstream>
+#include <mutex>
 #include <sstream>
 
+#include <QByteArray>
 #include <QDebug>
+#include <QFile>
+#include <QHash>
+#include <QVector>
 
 #include "IException.h"
 #include "IString.h"
@@ -18,6 +23,54 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 namespace Isis {
 
+  /**
+   * The keywords of a translation group, gathered when the table is compiled.
+   */
+  struct PvlTranslationTable::CompiledGroup {
+    int group;                          //!< Index of the group in the table
+    QVector<PvlKeyword> inputPositions; //!< InputPosition keywords in order
+    QVector<PvlKeyword> inputKeys;      //!< InputKey keywords in order
+    PvlKeyword inputDefault;            //!< The InputDefault keyword, if there is one
+    bool hasInputDefault;               //!< If the group has an InputDefault keyword
+    bool isAuto;                        //!< If the group has an Auto keyword
+    bool isOptional;                    //!< If the group has an Optional keyword
+    PvlKeyword outputPosition;          //!< The OutputPosition keyword, if there is one
+    bool hasOutputPosition;             //!< If the group has an OutputPosition keyword
+    QString outputName;                 //!< OutputName, empty if there is none
+    QStringList outputValues;           //!< Output value of each Translation
+    QHash<QString, int> translations;   //!< First Translation of each case folded input value
+    int wildcard;                       //!< First Translation of input value *, -1 if none
+  };
+
+
+  /**
+   * The groups of a translation table, indexed by name.
+   */
+  struct PvlTranslationTable::CompiledTable {
+    QVector<CompiledGroup> groups; //!< Compiled groups in table order
+    QHash<QString, int> index;     //!< First group of each normalized group name
+  };
+
+
+  namespace {
+    /**
+     * Normalizes a group or keyword name the way PvlKeyword::stringEqual()
+     * compares names, without white space or underscores and in upper case.
+     *
+     * @param name The group or keyword name
+     *
+     * @return QString The normalized name
+     */
+    QString normalizedName(const QString &name) {
+      QString key;
+      key.reserve(name.size());
+      for (const QChar &c : name) {
+        if (!c.isSpace() && c != '_') key += c.toUpper();
+      }
+      return key;
+    }
+  }
+
   /**
    * Constructs and initializes a PvlTranslationTable object.
    *
@@ -35,6 +88,7 @@ namespace Isis {
    */
   PvlTranslationTable::PvlTranslationTable(std::istream &istr) {
     istr >> p_trnsTbl;
+    p_compiled = compile(p_trnsTbl);
   }
 
 
@@ -55,11 +109,13 @@ namespace Isis {
   /**
    * Protected accessor for pvl translation table passed into 
    * class. This method returns a reference to the translation 
-   * table member. 
+   * table member. The table is compiled again the next time it is
+   * searched, since it may be changed through this reference.
    *  
    * @return @b Pvl The translation table as a PVL object. 
    */
   Pvl &PvlTranslationTable::TranslationTable() {
+    p_compiled.reset();
     return p_trnsTbl;
   }
 
@@ -78,11 +134,211 @@ namespace Isis {
 
   /**
    * Adds the contents of a translation table to the searchable groups/keys.
+   * The file is read through the process wide cache of translation files.
    *
    * @param transFile The name of the translation file to be added.
    */
   void PvlTranslationTable::AddTable(const QString &transFile) {
-    p_trnsTbl.read(FileName(transFile).expanded());
+    QString fileName = FileName(transFile).expanded();
+    std::shared_ptr<const CompiledTable> compiled;
+    Pvl table = readTable(fileName, compiled);
+
+    if (p_trnsTbl.groups() == 0 && p_trnsTbl.objects() == 0 && p_trnsTbl.keywords() == 0) {
+      p_trnsTbl = table;
+      p_trnsTbl.setFileName(fileName);
+      p_compiled = compiled;
+      return;
+    }
+
+    for (int i = 0; i < table.keywords(); i++) {
+      p_trnsTbl.addKeyword(table[i]);
+    }
+    for (int i = 0; i < table.groups(); i++) {
+      p_trnsTbl.addGroup(table.group(i));
+    }
+    for (int i = 0; i < table.objects(); i++) {
+      p_trnsTbl.addObject(table.object(i));
+    }
+    p_trnsTbl.setFileName(fileName);
+    p_compiled = compile(p_trnsTbl);
+  }
+
+
+  /**
+   * Reads a translation file and compiles it, or returns the table and index
+   * read earlier by this process if the contents of the file have not changed
+   * since. The contents are compared rather than the modification time, which
+   * may not change when a file is rewritten quickly.
+   *
+   * @param fileName The expanded name of the translation file
+   * @param compiled Set to the index of the returned table
+   *
+   * @return Pvl The translation table
+   *
+   * @throws IException::Io - The file could not be opened
+   * @throws IException::Unknown - "Unable to read PVL file"
+   */
+  Pvl PvlTranslationTable::readTable(const QString &fileName,
+                                     std::shared_ptr<const CompiledTable> &compiled) {
+    struct CachedTable {
+      QByteArray contents;
+      Pvl table;
+      std::shared_ptr<const CompiledTable> compiled;
+    };
+    static std::mutex cacheMutex;
+    static QHash< QString, std::shared_ptr<const CachedTable> > cache;
+
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+      QString message = Message::FileOpen(fileName);
+      throw IException(IException::Io, message, _FILEINFO_);
+    }
+    QByteArray contents = file.readAll();
+    file.close();
+
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      std::shared_ptr<const CachedTable> cached = cache.value(fileName);
+      if (cached && cached->contents == contents) {
+        compiled = cached->compiled;
+        return cached->table;
+      }
+    }
+
+    std::shared_ptr<CachedTable> entry = std::make_shared<CachedTable>();
+    entry->contents = contents;
+    istringstream stream(contents.toStdString());
+    try {
+      stream >> entry->table;
+    }
+    catch (IException &e) {
+      QString message = "Unable to read PVL file [" + fileName + "]";
+      throw IException(e, IException::Unknown, message, _FILEINFO_);
+    }
+    catch (...) {
+      QString message = "Unable to read PVL file [" + fileName + "]";
+      throw IException(IException::Unknown, message, _FILEINFO_);
+    }
+    entry->table.setFileName(fileName);
+    entry->compiled = compile(entry->table);
+
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    cache.insert(fileName, entry);
+    compiled = entry->compiled;
+    return entry->table;
+  }
+
+
+  /**
+   * Builds the index of a translation table.
+   *
+   * @param table The translation table
+   *
+   * @return std::shared_ptr<const CompiledTable> The index of the table
+   */
+  std::shared_ptr<const PvlTranslationTable::CompiledTable> PvlTranslationTable::compile(
+      const Pvl &table) {
+    std::shared_ptr<CompiledTable> compiled = std::make_shared<CompiledTable>();
+    compiled->groups.reserve(table.groups());
+
+    for (int i = 0; i < table.groups(); i++) {
+      const PvlGroup &translationGroup = table.group(i);
+
+      CompiledGroup group;
+      group.group = i;
+      group.hasInputDefault = false;
+      group.isAuto = false;
+      group.isOptional = false;
+      group.hasOutputPosition = false;
+      group.wildcard = -1;
+      bool hasOutputName = false;
+
+      for (int k = 0; k < translationGroup.keywords(); k++) {
+        const PvlKeyword &key = translationGroup[k];
+        QString name = normalizedName(key.name());
+
+        if (name == "INPUTPOSITION") {
+          group.inputPositions.append(key);
+        }
+        else if (name == "INPUTKEY") {
+          group.inputKeys.append(key);
+        }
+        else if (name == "INPUTDEFAULT" && !group.hasInputDefault) {
+          group.inputDefault = key;
+          group.hasInputDefault = true;
+        }
+        else if (name == "AUTO") {
+          group.isAuto = true;
+        }
+        else if (name == "OPTIONAL") {
+          group.isOptional = true;
+        }
+        else if (name == "OUTPUTPOSITION" && !group.hasOutputPosition) {
+          group.outputPosition = key;
+          group.hasOutputPosition = true;
+        }
+        else if (name == "OUTPUTNAME" && !hasOutputName) {
+          if (key.size() > 0) group.outputName = key[0];
+          hasOutputName = true;
+        }
+        else if (name == "TRANSLATION" && key.size() > 1) {
+          int translation = group.outputValues.size();
+          group.outputValues.append(key[0]);
+          QString inputValue = key[1].toCaseFolded();
+          if (!group.translations.contains(inputValue)) {
+            group.translations.insert(inputValue, translation);
+          }
+          if (key[1] == "*" && group.wildcard < 0) {
+            group.wildcard = translation;
+          }
+        }
+      }
+
+      QString key = normalizedName(translationGroup.name());
+      if (!compiled->index.contains(key)) {
+        compiled->index.insert(key, compiled->groups.size());
+      }
+      compiled->groups.append(group);
+    }
+
+    return compiled;
+  }
+
+
+  /**
+   * Returns the index of the translation table, compiling it if the table
+   * changed since it was last compiled.
+   *
+   * @return const CompiledTable& The index of the table
+   */
+  const PvlTranslationTable::CompiledTable &PvlTranslationTable::compiledTable() const {
+    if (!p_compiled) {
+      p_compiled = compile(p_trnsTbl);
+    }
+    return *p_compiled;
+  }
+
+
+  /**
+   * Returns the compiled translation group with the given name.
+   *
+   * @param translationGroupName The name of the PVL translation group
+   *
+   * @return const CompiledGroup& The first compiled group with the given name
+   *
+   * @throws IException::Programmer - "Unable to find translation group in file."
+   */
+  const PvlTranslationTable::CompiledGroup &PvlTranslationTable::compiledGroup(
+      const QString &translationGroupName) const {
+    const CompiledTable &table = compiledTable();
+    QHash<QString, int>::const_iterator group = table.index.find(normalizedName(translationGroupName));
+    if (group == table.index.end()) {
+      QString msg = "Unable to find translation group [" + translationGroupName +
+                   "] in file [" + p_trnsTbl.fileName() + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    return table.groups[group.value()];
   }
 
 
@@ -100,6 +356,7 @@ namespace Isis {
                                  Error in file."
    */
   void PvlTranslationTable::AddTable(std::istream &transStm) {
+    p_compiled.reset();
     transStm >> p_trnsTbl;
     
     // pair< name, size > of acceptable keywords.
@@ -167,6 +424,8 @@ namespace Isis {
         }
       }
     }
+
+    p_compiled = compile(p_trnsTbl);
   }
   
   
@@ -216,13 +475,13 @@ namespace Isis {
   QString PvlTranslationTable::Translate(const QString translationGroupName,
                                          const QString inputKeyValue) const {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
+    const CompiledGroup &translationGroup = compiledGroup(translationGroupName);
 
     // If no input value was passed in search using the input default
     QString tmpFValue = inputKeyValue;
     if (tmpFValue.isEmpty()) {
-      if (translationGroup.hasKeyword("InputDefault")) {
-        tmpFValue = (QString) translationGroup["InputDefault"];
+      if (translationGroup.hasInputDefault) {
+        tmpFValue = (QString) translationGroup.inputDefault;
       }
       else {
         QString msg = "No value or default value to translate for ";
@@ -233,28 +492,21 @@ namespace Isis {
       }
     }
 
-    // Search the Translation keywords for a match to the input value
-    Pvl::ConstPvlKeywordIterator it = translationGroup.findKeyword("Translation",
-                                      translationGroup.begin(),
-                                      translationGroup.end());
-
-    while (it != translationGroup.end()) {
-      const PvlKeyword &key = *it;
-      // compare the value from the input file to the second value of each Translation in the trans file.
-      // ignore cases for input values  
-      if (QString::compare((QString) key[1], tmpFValue, Qt::CaseInsensitive) == 0) {
-        return key[0];
+    // The first Translation whose input value matches, ignoring case, or is
+    // the wildcard wins
+    int translation = translationGroup.translations.value(tmpFValue.toCaseFolded(), -1);
+    if (translation >= 0 &&
+        (translationGroup.wildcard < 0 || translation <= translationGroup.wildcard)) {
+      return translationGroup.outputValues[translation];
+    }
+    else if (translationGroup.wildcard >= 0) {
+      const QString &outputValue = translationGroup.outputValues[translationGroup.wildcard];
+      if (outputValue == "*") {
+        return tmpFValue;
       }
-      else if ((QString) key[1] == "*") {
-        if ((QString) key[0] == "*") {
-          return tmpFValue;
-        }
-        else {
-          return key[0];
-        }
+      else {
+        return outputValue;
       }
-
-      it = translationGroup.findKeyword("Translation", it + 1, translationGroup.end());
     }
 
     QString msg = "Unable to find a translation value for [" +
@@ -285,26 +537,20 @@ namespace Isis {
   PvlKeyword PvlTranslationTable::InputGroup(const QString translationGroupName,
                                              const int inst) const {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
+    const CompiledGroup &translationGroup = compiledGroup(translationGroupName);
 
     //bool foundLegalInputGroup = false;
 
-    Pvl::ConstPvlKeywordIterator it = translationGroup.findKeyword("InputPosition",
-                                      translationGroup.begin(),
-                                      translationGroup.end());
-
     int currentInstance = 0;
 
     // If no InputPosition keyword exists, the answer is root
-    if (inst == 0 && it == translationGroup.end()) {
+    if (inst == 0 && translationGroup.inputPositions.isEmpty()) {
       PvlKeyword root("InputPosition");
       root += "ROOT";
       return root;
     }
 
-    while (it != translationGroup.end()) {
-      const PvlKeyword &result = *it;
-
+    for (const PvlKeyword &result : translationGroup.inputPositions) {
       // This check is to prevent backtracking to the old "value,value" way of
       //   doing translation file input groups for the new keyword. Flag it
       //   immediately to give a good error message.
@@ -324,8 +570,6 @@ namespace Isis {
 
         currentInstance ++;
       }
-
-      it = translationGroup.findKeyword("InputPosition", it + 1, translationGroup.end());
     }
 
     /* Error if no containers were listed
@@ -359,14 +603,37 @@ namespace Isis {
    */
   QString PvlTranslationTable::InputKeywordName(const QString translationGroupName) const {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
+    const CompiledGroup &translationGroup = compiledGroup(translationGroupName);
 
-    if (translationGroup.hasKeyword("InputKey")) return translationGroup["InputKey"];
+    if (!translationGroup.inputKeys.isEmpty()) return translationGroup.inputKeys.first();
 
     return "";
   }
 
 
+  /**
+   * Returns the names of all of the input keywords of a translation group,
+   * in the order they are listed in the translation table.
+   *
+   * @param translationGroupName The name of the PVL translation 
+   *                             group used to identify the
+   *                             input/output keywords to be
+   *                             translated. Often, this is the
+   *                             same as the output keyword name.
+   *
+   * @return QStringList The values of the InputKey keywords
+   */
+  QStringList PvlTranslationTable::InputKeywordNames(const QString translationGroupName) const {
+
+    QStringList inputKeywordNames;
+    for (const PvlKeyword &inputKey : compiledGroup(translationGroupName).inputKeys) {
+      inputKeywordNames.append(inputKey[0]);
+    }
+
+    return inputKeywordNames;
+  }
+
+
   /**
    * Returns the input default value from the translation table corresponding
    * to the output name argument.
@@ -381,9 +648,9 @@ namespace Isis {
    */
   QString PvlTranslationTable::InputDefault(const QString translationGroupName) const {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
+    const CompiledGroup &translationGroup = compiledGroup(translationGroupName);
 
-    if (translationGroup.hasKeyword("InputDefault")) return translationGroup["InputDefault"];
+    if (translationGroup.hasInputDefault) return translationGroup.inputDefault;
 
     return "";
   }
@@ -406,11 +673,7 @@ namespace Isis {
    */
   bool PvlTranslationTable::hasInputDefault(const QString translationGroupName) {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
-
-    if (translationGroup.hasKeyword("InputDefault")) return true;
-
-    return false;
+    return compiledGroup(translationGroupName).hasInputDefault;
   }
 
 
@@ -431,11 +694,7 @@ namespace Isis {
    */
   bool PvlTranslationTable::IsAuto(const QString translationGroupName) {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
-
-    if (translationGroup.hasKeyword("Auto")) return true;
-
-    return false;
+    return compiledGroup(translationGroupName).isAuto;
   }
 
 
@@ -456,11 +715,7 @@ namespace Isis {
    */
   bool PvlTranslationTable::IsOptional(const QString translationGroupName) {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
-
-    if (translationGroup.hasKeyword("Optional")) return true;
-
-    return false;
+    return compiledGroup(translationGroupName).isOptional;
   }
 
 
@@ -482,16 +737,16 @@ namespace Isis {
    */
   PvlKeyword PvlTranslationTable::OutputPosition(const QString translationGroupName) {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
+    const CompiledGroup &translationGroup = compiledGroup(translationGroupName);
 
-    if (!translationGroup.hasKeyword("OutputPosition")) {
+    if (!translationGroup.hasOutputPosition) {
       QString msg = "Unable to find translation keyword [OutputPostion] in [" +
                    translationGroupName + "] in file [" + p_trnsTbl.fileName() + "]";
       throw IException(IException::Programmer, msg, _FILEINFO_);
 
     }
 
-    return translationGroup["OutputPosition"];
+    return translationGroup.outputPosition;
   }
 
 
@@ -510,13 +765,7 @@ namespace Isis {
    */
   QString PvlTranslationTable::OutputName(const QString translationGroupName) {
 
-    const PvlGroup &translationGroup = findTranslationGroup(translationGroupName);
-
-    if (translationGroup.hasKeyword("OutputName")) {
-      return translationGroup["OutputName"];
-    }
-
-    return "";
+    return compiledGroup(translationGroupName).outputName;
   }
 
   /**
@@ -536,13 +785,22 @@ namespace Isis {
    *                   group in file."
    */
   const PvlGroup &PvlTranslationTable::findTranslationGroup(const QString translationGroupName) const {
-    if (!p_trnsTbl.hasGroup(translationGroupName)) {
-      QString msg = "Unable to find translation group [" + translationGroupName +
-                   "] in file [" + p_trnsTbl.fileName() + "]";
-      throw IException(IException::Programmer, msg, _FILEINFO_);
-    }
+    return p_trnsTbl.group(compiledGroup(translationGroupName).group);
+  }
 
-    return p_trnsTbl.findGroup(translationGroupName);
+
+  /**
+   * Returns the names of the translation groups in the order they are listed
+   * in the translation table.
+   *
+   * @return QStringList The translation group names
+   */
+  QStringList PvlTranslationTable::translationGroupNames() const {
+    QStringList names;
+    for (const CompiledGroup &group : compiledTable().groups) {
+      names.append(p_trnsTbl.group(group.group).name());
+    }
+    return names;
   }
 } // end namespace isis
 
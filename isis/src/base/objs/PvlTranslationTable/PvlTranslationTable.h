@@ -7,9 +7,12 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include <iostream>
+#include <memory>
 #include <vector>
 #include <string>
 
+#include <QStringList>
+
 #include "FileName.h"
 #include "Pvl.h"
 
@@ -68,6 +71,13 @@ namespace Isis {
    *    End
    *   @endcode
    *
+   * The table is compiled into an index when it is read: translation groups
+   * are found with one hash lookup by name, and each group keeps its input
+   * positions, input keys, defaults and a hash of its Translation values, so
+   * translating a value does not search the table. Translation files are
+   * parsed and compiled once per process and shared by every table that
+   * reads them until the file changes.
+   *
    * @ingroup Parsing
    *
    * @author 2003-05-01 Stuart Sides
@@ -140,9 +150,22 @@ namespace Isis {
       PvlKeyword OutputPosition(const QString translationGroupName);
       QString OutputName(const QString translationGroupName);
       const PvlGroup &findTranslationGroup(const QString translationGroupName) const;
+      QStringList InputKeywordNames(const QString translationGroupName) const;
+      QStringList translationGroupNames() const;
 
     private:
+      struct CompiledGroup;
+      struct CompiledTable;
+
+      static std::shared_ptr<const CompiledTable> compile(const Pvl &table);
+      static Pvl readTable(const QString &fileName,
+                           std::shared_ptr<const CompiledTable> &compiled);
+      const CompiledTable &compiledTable() const;
+      const CompiledGroup &compiledGroup(const QString &translationGroupName) const;
+
       Pvl p_trnsTbl;
+      //! The index of p_trnsTbl, NULL until it is compiled again after a change
+      mutable std::shared_ptr<const CompiledTable> p_compiled;
   };
 };
 
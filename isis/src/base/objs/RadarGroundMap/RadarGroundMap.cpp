@@ -5,6 +5,11 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "RadarGroundMap.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "iTime.h"
 #include "Latitude.h"
 #include "Longitude.h"
@@ -12,6 +17,13 @@ find files of those names at the top level of this repository. **/
 
 using namespace std;
 
+namespace {
+  //! True if neither Doppler shift is on the other side of zero
+  bool sameSide(double xv1, double xv2) {
+    return (xv1 < 0.0 && xv2 < 0.0) || (xv1 > 0.0 && xv2 > 0.0);
+  }
+}
+
 namespace Isis {
   RadarGroundMap::RadarGroundMap(Camera *parent, Radar::LookDirection ldir,
                                  double waveLength) :
@@ -32,6 +44,7 @@ namespace Isis {
     double et1 = p_camera->Spice::cacheStartTime().Et();
     double et2 = p_camera->Spice::cacheEndTime().Et();
     p_timeTolerance = (et2 - et1) / p_camera->Lines() / 20.0;
+    p_tableNode = 0;
   }
 
   /** Compute ground position from slant range
@@ -222,33 +235,37 @@ namespace Isis {
     SpiceDouble X[3];
     surfacePoint.ToNaifArray(X);
 
-    // Compute lower bound for Doppler shift
-    double et1 = p_camera->Spice::cacheStartTime().Et();
-    p_camera->Sensor::setTime(et1);
-    double xv1 = ComputeXv(X);
-
-    // Compute upper bound for Doppler shift
-    double et2 = p_camera->Spice::cacheEndTime().Et();
-    p_camera->Sensor::setTime(et2);
-    double xv2 = ComputeXv(X);
-
-    // Make sure we bound root (xv = 0.0)
-    if((xv1 < 0.0) && (xv2 < 0.0)) return false;
-    if((xv1 > 0.0) && (xv2 > 0.0)) return false;
-
-    // Order the bounds
+    // Bound the root (xv = 0.0) by the line the spacecraft state table finds,
+    // or by the whole image if the table cannot find it
     double fl, fh, xl, xh;
-    if(xv1 < xv2) {
-      fl = xv1;
-      fh = xv2;
-      xl = et1;
-      xh = et2;
-    }
-    else {
-      fl = xv2;
-      fh = xv1;
-      xl = et2;
-      xh = et1;
+    if(!FindTableBracket(X, xl, xh, fl, fh)) {
+      // Compute lower bound for Doppler shift
+      double et1 = p_camera->Spice::cacheStartTime().Et();
+      p_camera->Sensor::setTime(et1);
+      double xv1 = ComputeXv(X);
+
+      // Compute upper bound for Doppler shift
+      double et2 = p_camera->Spice::cacheEndTime().Et();
+      p_camera->Sensor::setTime(et2);
+      double xv2 = ComputeXv(X);
+
+      // Make sure we bound root (xv = 0.0)
+      if((xv1 < 0.0) && (xv2 < 0.0)) return false;
+      if((xv1 > 0.0) && (xv2 > 0.0)) return false;
+
+      // Order the bounds
+      if(xv1 < xv2) {
+        fl = xv1;
+        fh = xv2;
+        xl = et1;
+        xh = et2;
+      }
+      else {
+        fl = xv2;
+        fh = xv1;
+        xl = et2;
+        xh = et1;
+      }
     }
 
     // Iterate a max of 30 times
@@ -403,9 +420,51 @@ namespace Isis {
   }
 
 
+  /** Compute the Doppler shift of a ground point at the current time
+   *
+   * @param X Body-fixed ground point in km
+   *
+   * @return The Doppler shift in hertz
+   */
   double RadarGroundMap::ComputeXv(SpiceDouble X[3]) {
-    // Get the spacecraft position (Xsc) and velocity (Vsc) in body fixed
-    // coordinates
+    SpiceDouble state[6];
+    ComputeState(state);
+
+    // Compute the slant range
+    SpiceDouble lookB[3];
+    vsub_c(state, X, lookB);
+    p_slantRange = vnorm_c(lookB);   // units are km
+
+    return ComputeXv(state, X);
+  }
+
+
+  /** Compute the Doppler shift of a ground point from a body-fixed
+   *  spacecraft state
+   *
+   * @param state Body-fixed spacecraft position and velocity in km and km/s
+   * @param X Body-fixed ground point in km
+   *
+   * @return The Doppler shift in hertz
+   */
+  double RadarGroundMap::ComputeXv(const SpiceDouble state[6], const SpiceDouble X[3]) const {
+    SpiceDouble lookB[3];
+    vsub_c(state, X, lookB);
+
+    // Compute and return xv = -2 * (point - observer) dot (point velocity - observer velocity) / (slantRange*wavelength)
+    // In body-fixed coordinates, the point velocity = 0. so the equation becomes
+    //    double xv = 2.0 * vdot_c(lookB,&Vsc[0]) / (vnorm_c(lookB) * WaveLength() );
+    double xv = -2.0 * vdot_c(lookB, &state[3]) / (vnorm_c(lookB) * p_waveLength); // - is applied to lookB above
+    return xv;
+  }
+
+
+  /** Get the spacecraft position and velocity in body-fixed coordinates at
+   *  the current time
+   *
+   * @param state Returns the body-fixed position and velocity
+   */
+  void RadarGroundMap::ComputeState(SpiceDouble state[6]) {
     SpiceRotation *bodyFrame = p_camera->bodyRotation();
     SpicePosition *spaceCraft = p_camera->instrumentPosition();
 
@@ -415,25 +474,132 @@ namespace Isis {
     vequ_c((SpiceDouble *) & (spaceCraft->Velocity()[0]), &Ssc[3]);
 
     // Rotate the state to body-fixed
-    std::vector<double> bfSsc(6);
-    bfSsc = bodyFrame->ReferenceVector(Ssc);
+    std::vector<double> bfSsc = bodyFrame->ReferenceVector(Ssc);
+    std::copy(bfSsc.begin(), bfSsc.begin() + 6, state);
+  }
 
-    // Extract the body-fixed position and velocity
-    std::vector<double> Vsc(3);
-    std::vector<double> Xsc(3);
-    vequ_c(&bfSsc[0], &Xsc[0]);
-    vequ_c(&bfSsc[3], &Vsc[0]);
 
-    // Compute the slant range
-    SpiceDouble lookB[3];
-    vsub_c(&Xsc[0], X, lookB);
-    p_slantRange = vnorm_c(lookB);   // units are km
+  /** Return the body-fixed spacecraft state at a node of the state table,
+   *  computing it the first time the node is used
+   *
+   * @param node Index of the node
+   *
+   * @return The body-fixed position and velocity at the node time
+   */
+  const double *RadarGroundMap::TableState(int node) {
+    double *state = &p_tableStates[6 * node];
+    if (std::isnan(state[0])) {
+      p_camera->Sensor::setTime(p_tableTimes[node]);
+      ComputeState(state);
+    }
+    return state;
+  }
 
-    // Compute and return xv = -2 * (point - observer) dot (point velocity - observer velocity) / (slantRange*wavelength)
-    // In body-fixed coordinates, the point velocity = 0. so the equation becomes
-    //    double xv = 2.0 * vdot_c(lookB,&Vsc[0]) / (vnorm_c(lookB) * WaveLength() );
-    double xv = -2.0 * vdot_c(lookB, &Vsc[0]) / (vnorm_c(lookB) * WaveLength()); // - is applied to lookB above
-    return xv;
+
+  /** Find the line of the image that bounds the zero Doppler time of a
+   *  ground point
+   *
+   * The spacecraft state is tabulated once per line and the Doppler shift at
+   * the table nodes is searched outward from the line of the previous ground
+   * point, so neighboring points only compute a few new states.  The bracket
+   * is checked against the current spacecraft state before it is used.
+   *
+   * @param X Body-fixed ground point in km
+   * @param xl Returns the time of the negative Doppler shift bound
+   * @param xh Returns the time of the positive Doppler shift bound
+   * @param fl Returns the negative Doppler shift bound
+   * @param fh Returns the positive Doppler shift bound
+   *
+   * @return True if a line bounding the root was found
+   */
+  bool RadarGroundMap::FindTableBracket(SpiceDouble X[3], double &xl, double &xh,
+                                        double &fl, double &fh) {
+    if (p_tableTimes.empty()) {
+      double et1 = p_camera->Spice::cacheStartTime().Et();
+      double et2 = p_camera->Spice::cacheEndTime().Et();
+      int intervals = std::max(p_camera->Lines(), 1);
+
+      p_tableTimes.resize(intervals + 1);
+      for (int i = 0; i < intervals; i++) {
+        p_tableTimes[i] = et1 + (et2 - et1) * i / intervals;
+      }
+      p_tableTimes[intervals] = et2;
+      p_tableStates.assign(6 * (intervals + 1), std::numeric_limits<double>::quiet_NaN());
+    }
+
+    int last = p_tableTimes.size() - 1;
+    int low = std::min(p_tableNode, last - 1);
+    int high = low + 1;
+    double xvLow = ComputeXv(TableState(low), X);
+    double xvHigh = ComputeXv(TableState(high), X);
+
+    // The Doppler shift changes monotonically along the orbit, so step towards
+    // the smaller shift, doubling the step, until the root is bounded
+    bool forward = fabs(xvHigh) < fabs(xvLow);
+    int step = 1;
+    while (sameSide(xvLow, xvHigh)) {
+      if (forward) {
+        if (high == last) return false;
+        low = high;
+        xvLow = xvHigh;
+        high = std::min(high + step, last);
+        xvHigh = ComputeXv(TableState(high), X);
+      }
+      else {
+        if (low == 0) return false;
+        high = low;
+        xvHigh = xvLow;
+        low = std::max(low - step, 0);
+        xvLow = ComputeXv(TableState(low), X);
+      }
+      step *= 2;
+    }
+
+    // Bisect down to a single line
+    while (high - low > 1) {
+      int middle = (low + high) / 2;
+      double xvMiddle = ComputeXv(TableState(middle), X);
+      if (sameSide(xvLow, xvMiddle)) {
+        low = middle;
+        xvLow = xvMiddle;
+      }
+      else {
+        high = middle;
+        xvHigh = xvMiddle;
+      }
+    }
+
+    // Check the bounds with the current spacecraft state in case the
+    // ephemeris changed after the table was computed
+    double et1 = p_tableTimes[low];
+    p_camera->Sensor::setTime(et1);
+    double xv1 = ComputeXv(X);
+
+    double et2 = p_tableTimes[high];
+    p_camera->Sensor::setTime(et2);
+    double xv2 = ComputeXv(X);
+
+    if (sameSide(xv1, xv2)) {
+      p_tableStates.assign(p_tableStates.size(), std::numeric_limits<double>::quiet_NaN());
+      return false;
+    }
+
+    p_tableNode = low;
+
+    // Order the bounds
+    if (xv1 < xv2) {
+      fl = xv1;
+      fh = xv2;
+      xl = et1;
+      xh = et2;
+    }
+    else {
+      fl = xv2;
+      fh = xv1;
+      xl = et2;
+      xh = et1;
+    }
+    return true;
   }
 
 
@@ -136,6 +136,11 @@ namespace Isis {
 
     private:
       double ComputeXv(SpiceDouble X[3]);
+      double ComputeXv(const SpiceDouble state[6], const SpiceDouble X[3]) const;
+      void ComputeState(SpiceDouble state[6]);
+      const double *TableState(int node);
+      bool FindTableBracket(SpiceDouble X[3], double &xl, double &xh,
+                            double &fl, double &fh);
       double GetRadius(const Latitude &lat, const Longitude &lon);
 
       bool Iterate(SpiceDouble &R, const double &slantRangeSqr, const SpiceDouble c[],
@@ -157,6 +162,12 @@ namespace Isis {
       double p_groundSlantRange;   //!< units are km
       double p_groundDopplerFreq;  //!< units are hertz
 
+      //! Times of the spacecraft state table nodes, one per line boundary
+      std::vector<double> p_tableTimes;
+      //! Body-fixed spacecraft state at each node, NaN until it is computed
+      std::vector<double> p_tableStates;
+      int p_tableNode;             //!< First node of the last bracket found
+
       Camera *p_camera;
   };
 };
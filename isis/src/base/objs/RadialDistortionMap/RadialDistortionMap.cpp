@@ -89,4 +89,9 @@ namespace Isis {
     p_focalPlaneY = guess_dy;
     return true;
   }
+
+  // Return the radial distortion coefficient.
+  double RadialDistortionMap::K1() const {
+    return p_k1;
+  }
 }
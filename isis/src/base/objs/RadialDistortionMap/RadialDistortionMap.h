@@ -23,6 +23,8 @@ namespace Isis {
       bool SetFocalPlane(const double dx, const double dy);
       bool SetUndistortedFocalPlane(const double ux, const double uy);
 
+      double K1() const;
+
     private:
       double p_k1;
       //double p_cameraSpec;
@@ -5,6 +5,15 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "Reduce.h"
+
+#include <algorithm>
+
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
+#include "Brick.h"
+#include "IException.h"
 #include "IString.h"
 #include "SpecialPixel.h"
 #include "SubArea.h"
@@ -34,8 +43,6 @@ namespace Isis {
     // Input Cube
     mInCube = pInCube;
     
-    mdLine      = 1;
-    miBandIndex = 1;
     // Set input image area to defaults
     miStartSample = 1;
     miEndSample   = mInCube->sampleCount();
@@ -54,8 +61,8 @@ namespace Isis {
     miOutputSamples = (int)((double)miInputSamples / mdSampleScale + 0.5);
     miOutputLines   = (int)((double)miInputLines / mdLineScale + 0.5);
     
-    // Initialize the input portal
-    m_iPortal = new Isis::Portal(miInputSamples, 1, mInCube->pixelType());
+    // Width of the input lines read
+    miPortalSamples = miInputSamples;
   }
   
   /**
@@ -64,7 +71,6 @@ namespace Isis {
    * @author Sharmila Prasad (5/11/2011)
    */
   Reduce::~Reduce(){
-    delete(m_iPortal);
   }
   
   /**
@@ -92,11 +98,12 @@ namespace Isis {
     miStartLine  = startLine;
     miEndLine    = endLine;
     miInputLines = endLine - startLine + 1;
-    mdLine       = miStartLine;  
 
     // Calculate output size based on the sample and line scales
     miOutputSamples = (int)((double)miInputSamples / mdSampleScale + 0.5);
     miOutputLines   = (int)((double)miInputLines / mdLineScale + 0.5);
+
+    prepare();
   }
   
   /**
@@ -136,6 +143,140 @@ namespace Isis {
     return resultsGrp;
   }
   
+  /**
+   * Averages the input cube down by 2, 4, 8, ... in a single pass over the
+   * input. Output cube i (counting from zero) is reduced by 2^(i+1) and must
+   * have ceil(input / 2^(i+1)) samples and lines and the same number of
+   * bands as the input. Each output pixel is the average of the valid pixels
+   * in its block of the input; it is Null unless the number of valid pixels
+   * is more than validPer times the block size, which is the same test the
+   * Average functor uses.
+   *
+   * The input is read in strips as tall as the largest block, and the strips
+   * are spread over the global thread pool. Each level is computed from the
+   * sums and counts of the level below it, so the input is only read once.
+   *
+   * @param inCube The input cube
+   * @param outCubes The output cubes, one per level
+   * @param validPer Fraction (0 to 1) of the block that must be valid
+   *
+   * @throws IException::Programmer If an output cube is the wrong size
+   */
+  void Reduce::averageLevels(Isis::Cube *inCube, const std::vector<Isis::Cube *> &outCubes,
+                             double validPer) {
+    int levels = outCubes.size();
+    if (levels == 0) return;
+
+    int inputSamples = inCube->sampleCount();
+    int inputLines = inCube->lineCount();
+    int bands = inCube->bandCount();
+
+    vector<int> levelSamples(levels + 1, inputSamples);
+    vector<int> levelLines(levels + 1, 0);
+    for (int level = 1; level <= levels; level++) {
+      int factor = 1 << level;
+      levelSamples[level] = (inputSamples + factor - 1) / factor;
+      Cube *outCube = outCubes[level - 1];
+      if (outCube->sampleCount() != levelSamples[level] ||
+          outCube->lineCount() != (inputLines + factor - 1) / factor ||
+          outCube->bandCount() != bands) {
+        QString msg = "Output cube [" + toString(level) + "] must be [" +
+                      toString(levelSamples[level]) + "] samples by [" +
+                      toString((inputLines + factor - 1) / factor) + "] lines by [" +
+                      toString(bands) + "] bands";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
+
+    int stripLines = 1 << levels;
+    int strips = (inputLines + stripLines - 1) / stripLines;
+
+    int band = 1;
+    auto reduceStrip = [&](int &strip) {
+      Brick in(inputSamples, stripLines, 1, inCube->pixelType());
+      in.SetBasePosition(1, strip * stripLines + 1, band);
+      inCube->read(in);
+
+      // Level 0 sums and counts are the valid input pixels themselves
+      vector<double> sums(in.size());
+      vector<double> counts(in.size());
+      for (int i = 0; i < in.size(); i++) {
+        bool valid = IsValidPixel(in[i]);
+        sums[i] = valid ? in[i] : 0.0;
+        counts[i] = valid ? 1.0 : 0.0;
+      }
+
+      int lines = stripLines;
+      for (int level = 1; level <= levels; level++) {
+        int fineSamples = levelSamples[level - 1];
+        int samples = levelSamples[level];
+        lines /= 2;
+
+        vector<double> levelSums((size_t)samples * lines, 0.0);
+        vector<double> levelCounts((size_t)samples * lines, 0.0);
+        for (int l = 0; l < lines; l++) {
+          for (int fineLine = 2 * l; fineLine <= 2 * l + 1; fineLine++) {
+            const double *fineSum = &sums[(size_t)fineLine * fineSamples];
+            const double *fineCount = &counts[(size_t)fineLine * fineSamples];
+            double *sum = &levelSums[(size_t)l * samples];
+            double *count = &levelCounts[(size_t)l * samples];
+            for (int s = 0; s < fineSamples; s++) {
+              sum[s / 2] += fineSum[s];
+              count[s / 2] += fineCount[s];
+            }
+          }
+        }
+
+        int factor = 1 << level;
+        double minimum = (double)factor * factor * validPer;
+        Brick out(samples, lines, 1, outCubes[level - 1]->pixelType());
+        out.SetBasePosition(1, strip * lines + 1, band);
+        for (int i = 0; i < out.size(); i++) {
+          out[i] = (levelCounts[i] > minimum) ? levelSums[i] / levelCounts[i] : Isis::Null;
+        }
+        outCubes[level - 1]->write(out);
+
+        sums.swap(levelSums);
+        counts.swap(levelCounts);
+      }
+    };
+
+    int batchSize = std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+    for (band = 1; band <= bands; band++) {
+      for (int firstStrip = 0; firstStrip < strips; firstStrip += batchSize) {
+        QVector<int> batch;
+        for (int strip = firstStrip; strip < std::min(strips, firstStrip + batchSize); strip++) {
+          batch.append(strip);
+        }
+        QtConcurrent::blockingMap(batch, reduceStrip);
+      }
+    }
+  }
+
+
+  /**
+   * Precomputes the input line read for each output line and the input
+   * sample used for each output sample.
+   */
+  void Nearest::prepare() {
+    // Band 1 starts at the start line of the input area, later bands at line 1
+    for (int pass = 0; pass < 2; pass++) {
+      vector<int> &lines = (pass == 0) ? m_firstBandLines : m_bandLines;
+      lines.resize(miOutputLines);
+      double line = (pass == 0) ? miStartLine : 1;
+      for (int oline = 0; oline < miOutputLines; oline++) {
+        lines[oline] = (int)(line + 0.5);
+        line += mdLineScale;
+      }
+    }
+
+    m_samples.resize(miOutputSamples);
+    for (int os = 0; os < miOutputSamples; os++) {
+      m_samples[os] = (int)((double) os * mdSampleScale);
+    }
+  }
+
+
   /**
    * Near Operator () overload, parameter for StartProcessInPlace 
    * refer ProcessByLine, ProcessByBrick 
@@ -144,25 +285,25 @@ namespace Isis {
    */
   void Nearest::operator()(Isis::Buffer & out) const
   {
-    int readLine = (int)(mdLine + 0.5);
-
-    m_iPortal->SetPosition(miStartSample, readLine, miBandIndex);
-    mInCube->read(*m_iPortal);
-    
-    // Scale down buffer
-    for(int os = 0; os < miOutputSamples; os++) {
-      out[os] = (*m_iPortal)[(int)((double) os * mdSampleScale)];
+    const vector<int> &lines = (out.Band() == 1) ? m_firstBandLines : m_bandLines;
+    if (out.Line() > (int)lines.size()) {
+      for (int os = 0; os < out.size(); os++) {
+        out[os] = Isis::Null;
+      }
+      return;
     }
 
-    if(out.Line() == miOutputLines) {
-      miBandIndex++;
-      mdLine = 1;
-    }
-    else {
-      mdLine += mdLineScale;
+    Brick in(miPortalSamples, 1, 1, mInCube->pixelType());
+    in.SetBasePosition(miStartSample, lines[out.Line() - 1], out.Band());
+    mInCube->read(in);
+
+    // Scale down buffer
+    for(int os = 0; os < out.size(); os++) {
+      out[os] = (os < miOutputSamples) ? in[m_samples[os]] : Isis::Null;
     }
   }
   
+
   /**
    * Average Operator () overload, parameter for StartProcessInPlace 
    * refer ProcessByLine, ProcessByBrick 
@@ -171,133 +312,171 @@ namespace Isis {
    */
   void Average::operator() (Isis::Buffer & out) const
   {
-    double rline = (double)out.Line() * mdLineScale;
-
-    if(out.Line() == 1 && out.Band() == 1) {
-      mdIncTab = new double[miOutputSamples];
-      mdSum    = new double[miOutputSamples];
-      mdNpts   = new double[miOutputSamples];
-      mdSum2   = new double[miOutputSamples];
-      mdNpts2  = new double[miOutputSamples];
-
-      //  Fill mdIncTab and Initialize buffers for first band
-      for(int osamp = 0; osamp < miOutputSamples; osamp++) {
-        mdIncTab[osamp] = ((double)osamp + 1.) * mdSampleScale;
-        mdSum[osamp]   = 0.0;
-        mdNpts[osamp]  = 0.0;
-        mdSum2[osamp]  = 0.0;
-        mdNpts2[osamp] = 0.0;
+    const vector<LineWeights> &schedule = (out.Band() == 1) ? m_firstBandLines : m_bandLines;
+    if (out.Line() > (int)schedule.size()) {
+      for (int osamp = 0; osamp < out.size(); osamp++) {
+        out[osamp] = Isis::Null;
       }
-      mdIncTab[miOutputSamples-1] = miInputSamples;
+      return;
     }
+    const LineWeights &lineWeights = schedule[out.Line() - 1];
 
-    while(mdLine <= rline) {
-      if((int)mdLine <= miInputLines) {
-        m_iPortal->SetPosition(miStartSample, mdLine, miBandIndex);
-        mInCube->read(*m_iPortal);
-      }
-      int isamp = 1;
-      for(int osamp = 0; osamp < out.size(); osamp++) {
-        while((double)isamp <= mdIncTab[osamp]) {
-          // If Pixel is valid add it to mdSum
-          if(IsValidPixel((*m_iPortal)[isamp-1])) {
-            mdSum[osamp]  += (*m_iPortal)[isamp-1];
-            mdNpts[osamp] += 1.0;
-          }
-          isamp++;
-        }
+    // Read every input line under this output line at once
+    int firstLine = lineWeights.replacementLine;
+    int lastLine = lineWeights.replacementLine;
+    for (unsigned int i = 0; i < lineWeights.lines.size(); i++) {
+      firstLine = std::min(firstLine, lineWeights.lines[i]);
+      lastLine = std::max(lastLine, lineWeights.lines[i]);
+    }
+    Brick in(miPortalSamples, lastLine - firstLine + 1, 1, mInCube->pixelType());
+    in.SetBasePosition(miStartSample, firstLine, out.Band());
+    mInCube->read(in);
 
-        double sdel = (double) isamp - mdIncTab[osamp];
-        if(isamp > miInputSamples) continue;
+    vector<double> sum(miOutputSamples, 0.0);
+    vector<double> npts(miOutputSamples, 0.0);
+    vector<double> values(miPortalSamples);
+    vector<double> valid(miPortalSamples);
+    for (unsigned int i = 0; i < lineWeights.lines.size(); i++) {
+      const double *row = in.DoubleBuffer() + (size_t)(lineWeights.lines[i] - firstLine) * miPortalSamples;
+      double lineWeight = lineWeights.weights[i];
 
-        if(IsValidPixel((*m_iPortal)[isamp-1])) {
-          mdSum[osamp]  += (*m_iPortal)[isamp-1] * (1.0 - sdel);
-          mdNpts[osamp] += (1.0 - sdel);
-          if(osamp + 1 < miOutputSamples) {
-            mdSum[osamp+1]  += (*m_iPortal)[isamp-1] * sdel;
-            mdNpts[osamp+1] += sdel;
-          }
+      // Split the line into values and weights once so the sums below are branch free
+      for (int isamp = 0; isamp < miPortalSamples; isamp++) {
+        bool isValid = IsValidPixel(row[isamp]);
+        values[isamp] = isValid ? row[isamp] : 0.0;
+        valid[isamp] = isValid ? 1.0 : 0.0;
+      }
+
+      for (int osamp = 0; osamp < miOutputSamples; osamp++) {
+        double lineSum = 0.0;
+        double linePts = 0.0;
+        for (int j = m_sampleOffsets[osamp]; j < m_sampleOffsets[osamp + 1]; j++) {
+          double weight = m_sampleWeights[j] * lineWeight;
+          lineSum += values[m_sampleIndexes[j]] * weight;
+          linePts += valid[m_sampleIndexes[j]] * weight;
         }
-        isamp++;
+        sum[osamp] += lineSum;
+        npts[osamp] += linePts;
+      }
+    }
+
+    const double *replacementRow =
+        in.DoubleBuffer() + (size_t)(lineWeights.replacementLine - firstLine) * miPortalSamples;
+    double npix = mdSampleScale * mdLineScale;
+    for (int osamp = 0; osamp < out.size(); osamp++) {
+      if (osamp >= miOutputSamples) {
+        out[osamp] = Isis::Null;
+      }
+      else if (npts[osamp] > npix * mdValidPer) {
+        out[osamp] = sum[osamp] / npts[osamp];
+      }
+      else if (msReplaceMode == "NEAREST") {
+        out[osamp] = replacementRow[m_replacementSamples[osamp]];
+      }
+      else {
+        out[osamp] = Isis::Null;
       }
-      mdLine++;
     }
+  }
+
 
-    if(mdLine <= miInputLines) {
-      m_iPortal->SetPosition(miStartSample, mdLine, miBandIndex);
-      mInCube->read(*m_iPortal);
+  /**
+   * Precomputes the area weights of the input samples for each output
+   * sample and the weights of the input lines for each output line.
+   *
+   * Output sample o covers input samples o * SampleScale to
+   * (o + 1) * SampleScale (the last one extends to the end of the input) and
+   * an input sample is weighted by the fraction of it inside that range.
+   */
+  void Average::prepare() {
+    vector<double> incTab(miOutputSamples);
+    for (int osamp = 0; osamp < miOutputSamples; osamp++) {
+      incTab[osamp] = ((double)osamp + 1.) * mdSampleScale;
     }
-    double ldel = (double)mdLine - rline;
-    double ldel2 = 1.0 - ldel;
+    if (miOutputSamples > 0) incTab[miOutputSamples - 1] = miInputSamples;
+
+    // Weights in the order they are accumulated, grouped by output sample below
+    vector< vector< pair<int, double> > > weights(miOutputSamples);
     int isamp = 1;
-    for(int osamp = 0; osamp < miOutputSamples; osamp++) {
-      while(isamp <= mdIncTab[osamp]) {
-        if(IsValidPixel((*m_iPortal)[isamp-1])) {
-          mdSum[osamp]   += (*m_iPortal)[isamp-1] * ldel2;
-          mdNpts[osamp]  += ldel2;
-          mdSum2[osamp]  += (*m_iPortal)[isamp-1] * ldel;
-          mdNpts2[osamp] += ldel;
-        }
+    for (int osamp = 0; osamp < miOutputSamples; osamp++) {
+      while ((double)isamp <= incTab[osamp]) {
+        weights[osamp].push_back(make_pair(isamp - 1, 1.0));
         isamp++;
       }
 
-      double sdel = (double) isamp - mdIncTab[osamp];
-      if(isamp > miInputSamples) continue;
-      if(IsValidPixel((*m_iPortal)[isamp-1])) {
-        mdSum[osamp]  += (*m_iPortal)[isamp-1] * (1.0 - sdel) * ldel2;
-        mdNpts[osamp] += (1.0 - sdel) * ldel2;
-        if(osamp + 1 < miOutputSamples) {
-          mdSum[osamp+1]  += (*m_iPortal)[isamp-1] * sdel * ldel2;
-          mdNpts[osamp+1] += sdel * ldel2;
-        }
-        mdSum2[osamp]  += (*m_iPortal)[isamp-1] * (1.0 - sdel) * ldel;
-        mdNpts2[osamp] += (1.0 - sdel) * ldel;
-        if(osamp + 1 < miOutputSamples) {
-          mdSum2[osamp+1]  += (*m_iPortal)[isamp-1] * sdel * ldel;
-          mdNpts2[osamp+1] += sdel * ldel;
-        }
+      double sdel = (double) isamp - incTab[osamp];
+      if (isamp > miInputSamples) continue;
+
+      weights[osamp].push_back(make_pair(isamp - 1, 1.0 - sdel));
+      if (osamp + 1 < miOutputSamples) {
+        weights[osamp + 1].push_back(make_pair(isamp - 1, sdel));
       }
       isamp++;
     }
 
-    if(mdLine < miInputLines) mdLine++;
-
-    double npix = mdSampleScale * mdLineScale;
-    for(int osamp = 0; osamp < miOutputSamples; osamp++) {
-      if(mdNpts[osamp] > npix * mdValidPer) {
-        out[osamp] = mdSum[osamp] / mdNpts[osamp];
-      }
-      else {
-        if(msReplaceMode == "NEAREST") {
-          out[osamp] = (*m_iPortal)[(int)(mdIncTab[osamp] + 0.5) - 1];
-        }
-        else {
-          out[osamp] = Isis::Null;
-        }
+    m_sampleOffsets.assign(1, 0);
+    m_sampleIndexes.clear();
+    m_sampleWeights.clear();
+    m_replacementSamples.resize(miOutputSamples);
+    for (int osamp = 0; osamp < miOutputSamples; osamp++) {
+      for (unsigned int i = 0; i < weights[osamp].size(); i++) {
+        m_sampleIndexes.push_back(weights[osamp][i].first);
+        m_sampleWeights.push_back(weights[osamp][i].second);
       }
-      mdSum[osamp]   = mdSum2[osamp];
-      mdNpts[osamp]  = mdNpts2[osamp];
-      mdSum2[osamp]  = 0.0;
-      mdNpts2[osamp] = 0.0;
+      m_sampleOffsets.push_back(m_sampleIndexes.size());
+      m_replacementSamples[osamp] = (int)(incTab[osamp] + 0.5) - 1;
     }
 
-    if(out.Line() == miOutputLines && out.Band() != miInputBands) {
-      miBandIndex++;
-      mdLine = 1;
-      for(int osamp = 0; osamp < miOutputSamples; osamp++) {
-        mdSum[osamp]   = 0.0;
-        mdNpts[osamp]  = 0.0;
-        mdSum2[osamp]  = 0.0;
-        mdNpts2[osamp] = 0.0;
+    // Band 1 starts at the start line of the input area, later bands at line 1
+    m_firstBandLines = lineWeights(miStartLine);
+    m_bandLines = lineWeights(1);
+  }
+
+
+  /**
+   * Computes the input lines and weights for each output line of a band.
+   * Output line o covers input lines (o - 1) * LineScale to o * LineScale
+   * and an input line is weighted by the fraction of it inside that range.
+   * Lines past the end of the input repeat the last input line.
+   *
+   * @param startLine The first input line of the band
+   *
+   * @return std::vector<LineWeights> The weights of each output line
+   */
+  std::vector<Average::LineWeights> Average::lineWeights(int startLine) const {
+    vector<LineWeights> schedule(miOutputLines);
+
+    double line = startLine;
+    int lastRead = 0;
+    LineWeights carry;
+    for (int oline = 1; oline <= miOutputLines; oline++) {
+      double rline = (double)oline * mdLineScale;
+      LineWeights &current = schedule[oline - 1];
+      current.lines = carry.lines;
+      current.weights = carry.weights;
+      carry.lines.clear();
+      carry.weights.clear();
+
+      while (line <= rline) {
+        if ((int)line <= miInputLines) lastRead = (int)line;
+        current.lines.push_back(lastRead);
+        current.weights.push_back(1.0);
+        line++;
       }
-    }
 
-    if(out.Line() == miOutputLines && out.Band() == miInputBands) {
-      delete [] mdIncTab;
-      delete [] mdSum;
-      delete [] mdNpts;
-      delete [] mdSum2;
-      delete [] mdNpts2;
+      // The line straddling the edge of this output line is split between it
+      // and the next one
+      if (line <= miInputLines) lastRead = (int)line;
+      double ldel = line - rline;
+      current.lines.push_back(lastRead);
+      current.weights.push_back(1.0 - ldel);
+      carry.lines.push_back(lastRead);
+      carry.weights.push_back(ldel);
+
+      if (line < miInputLines) line++;
+      current.replacementLine = lastRead;
     }
-  } 
+
+    return schedule;
+  }
 }
@@ -12,6 +12,7 @@ find files of those names at the top level of this repository. **/
 #include "Portal.h"
 
 #include <cmath>
+#include <vector>
 
 namespace Isis {
   /**
@@ -50,7 +51,7 @@ namespace Isis {
     Reduce(Isis::Cube *pInCube,const double sampleScale, const double lineScale);
 
     //! Destructor
-    ~Reduce();
+    virtual ~Reduce();
 
     //! Create label for the reduced output image
     Isis::PvlGroup  UpdateOutputLabel(Isis::Cube *pOutCube);
@@ -59,7 +60,13 @@ namespace Isis {
     void setInputBoundary(int startSample, int endSample,
                           int startLine, int endLine);
 
+    static void averageLevels(Isis::Cube *inCube, const std::vector<Isis::Cube *> &outCubes,
+                              double validPer);
+
     protected:
+      //! Rebuilds the precomputed reduction tables after the input area changes
+      virtual void prepare() = 0;
+
       Isis::Cube *mInCube;        //!< Input image
       double mdSampleScale;       //!< Sample scale
       double mdLineScale;         //!< Line scale
@@ -67,20 +74,21 @@ namespace Isis {
       int miEndSample;            //!< Input end sample
       int miStartLine;            //!< Input start line
       int miEndLine;              //!< Input end line
-      mutable double mdLine;              //!< Line index
       int miOutputSamples;        //!< Output Samples
       int miOutputLines;          //!< Output Lines
       int miInputSamples;         //!< Input Samples
       int miInputLines;           //!< Input Lines
       int miInputBands;           //!< Input Bands
-      mutable int miBandIndex;            //!< Band Index
-      Isis::Portal *m_iPortal;    //!< Input portal
+      int miPortalSamples;        //!< Number of samples read from each input line
   };
 
 
   /**
    * Functor for reduce using near functionality
    *
+   * The input line used for each output line is precomputed, so output lines
+   * can be processed in any order and from multiple threads.
+   *
    * @author 2011-04-15 Sharmila Prasad
    *
    * @internal
@@ -90,16 +98,30 @@ namespace Isis {
       //! Constructor
       Nearest(Isis::Cube *pInCube, double pdSampleScale, double pdLineScale)
       :Reduce(pInCube, pdSampleScale, pdLineScale){
+        prepare();
       }
 
       //! Operator () overload
       void operator() (Isis::Buffer & out) const;
+
+    protected:
+      void prepare();
+
+    private:
+      std::vector<int> m_firstBandLines;  //!< Input line for each output line of band 1
+      std::vector<int> m_bandLines;       //!< Input line for each output line of later bands
+      std::vector<int> m_samples;         //!< Input sample index for each output sample
   };
 
 
   /**
    * Functor for reduce using average functionality
    *
+   * The area weights of the input samples and lines contributing to each
+   * output pixel are precomputed, so output lines can be processed in any
+   * order and from multiple threads. Each output line reads the input lines
+   * under it once and accumulates the weighted sums a line at a time.
+   *
    * @author 2011-04-15 Sharmila Prasad
    *
    * @internal
@@ -112,19 +134,35 @@ namespace Isis {
       : Reduce(pInCube, pdSampleScale, pdLineScale){
         mdValidPer    = pdValidPer;
         msReplaceMode = psReplaceMode;
+        prepare();
       }
 
       //! Operator () overload
       void operator() (Isis::Buffer & out) const;
 
+    protected:
+      void prepare();
+
     private:
-      mutable double mdValidPer;   //!< Valid Percentage
+      /**
+       * The input lines, and their area weights, that contribute to one output line
+       */
+      struct LineWeights {
+        std::vector<int> lines;      //!< Input lines, in the order they are accumulated
+        std::vector<double> weights; //!< Area weight of each input line
+        int replacementLine;         //!< Input line used when VALIDPER is not met
+      };
+
+      std::vector<LineWeights> lineWeights(int startLine) const;
+
+      double mdValidPer;   //!< Valid Percentage
       QString msReplaceMode;//!< Replace Mode (scale/total)
-      mutable double *mdIncTab;
-      mutable double *mdSum;
-      mutable double *mdNpts;
-      mutable double *mdSum2;
-      mutable double *mdNpts2;
+      std::vector<int> m_sampleOffsets;      //!< Start of each output sample's weights
+      std::vector<int> m_sampleIndexes;      //!< Input sample index of each weight
+      std::vector<double> m_sampleWeights;   //!< Area weights of the input samples
+      std::vector<int> m_replacementSamples; //!< Input sample used when VALIDPER is not met
+      std::vector<LineWeights> m_firstBandLines; //!< Line weights for band 1
+      std::vector<LineWeights> m_bandLines;      //!< Line weights for later bands
   };
 
 }
@@ -10,6 +10,8 @@ find files of those names at the top level of this repository. **/
 #include "CameraFocalPlaneMap.h"
 #include "Pvl.h"
 #include "Statistics.h"
+#include <algorithm>
+#include <cmath>
 #include <float.h>
 
 using namespace std;
@@ -66,6 +68,9 @@ namespace Isis {
       msg += "do not appear to be equal";
       throw IException(IException::User, msg, _FILEINFO_);
     }
+
+    p_refinedGrid.build(p_rsamps, p_rlines);
+    p_masterGrid.build(p_msamps, p_mlines);
   }
 
   /**
@@ -88,26 +93,10 @@ namespace Isis {
     double focalLine = dy / p_pixelPitch +
                        p_camera->FocalPlaneMap()->DetectorLineOrigin();
 
-    // Find distance from input point to all nominal reseaus
-    double distances[p_numRes], wt[5];
-    int closepts[5];
-    double ldiffsq, sdiffsq;
-    for(int i = 0; i < p_numRes; i++) {
-      sdiffsq = (focalSamp - p_rsamps[i]) * (focalSamp - p_rsamps[i]);
-      ldiffsq = (focalLine - p_rlines[i]) * (focalLine - p_rlines[i]);
-      distances[i]  =  ldiffsq + sdiffsq;
-    }
-
     // Get 5 closest reseaus to the input point
-    for(int ifpt = 0;  ifpt < 5;  ifpt++)  {
-      int imin = 0;
-      for(int i = 0;  i < p_numRes;  i++)  {
-        if(distances[i] < distances[imin])  imin = i;
-      }
-      closepts[ifpt] = imin;
-      wt[ifpt] = distances[imin];
-      distances[imin] = DBL_MAX;  /* Arbitrary big number */
-    }
+    double wt[5];
+    int closepts[5];
+    p_refinedGrid.nearest(focalSamp, focalLine, 5, closepts, wt);
 
     // Make sure 5 closest points are not colinear
     Statistics lstats, sstats;
@@ -198,28 +187,10 @@ namespace Isis {
     double undistortedFocalSamp = ux / p_pixelPitch + p_undistortedSamps / 2.0;
     double undistortedFocalLine = uy / p_pixelPitch + p_undistortedLines / 2.0;
 
-    // Find distance from input point to all nominal reseaus
-    double distances[p_numRes], wt[5];
-    int closepts[5];
-    double ldiffsq, sdiffsq;
-    for(int i = 0; i < p_numRes; i++) {
-      sdiffsq = (undistortedFocalSamp - p_msamps[i]) *
-                (undistortedFocalSamp - p_msamps[i]);
-      ldiffsq = (undistortedFocalLine - p_mlines[i]) *
-                (undistortedFocalLine - p_mlines[i]);
-      distances[i]  =  ldiffsq + sdiffsq;
-    }
-
     // Get 5 closest reseaus to the input point
-    for(int ifpt = 0;  ifpt < 5;  ifpt++)  {
-      int imin = 0;
-      for(int i = 0;  i < p_numRes;  i++)  {
-        if(distances[i] < distances[imin])  imin = i;
-      }
-      closepts[ifpt] = imin;
-      wt[ifpt] = distances[imin];
-      distances[imin] = DBL_MAX;  /* Arbitrary big number */
-    }
+    double wt[5];
+    int closepts[5];
+    p_masterGrid.nearest(undistortedFocalSamp, undistortedFocalLine, 5, closepts, wt);
 
     // Make sure 5 closest points are not colinear
     Statistics lstats, sstats;
@@ -292,4 +263,144 @@ namespace Isis {
     return true;
   }
 
+
+  /**
+   * Sort reseau locations into a uniform grid of cells, with about two
+   * reseaus per cell.
+   *
+   * @param samples The sample of each reseau
+   * @param lines The line of each reseau
+   */
+  void ReseauDistortionMap::ReseauGrid::build(const vector<double> &samples,
+                                              const vector<double> &lines) {
+    m_samples = samples;
+    m_lines = lines;
+    int reseaus = m_samples.size();
+
+    double maxSample = -DBL_MAX;
+    double maxLine = -DBL_MAX;
+    m_minSample = DBL_MAX;
+    m_minLine = DBL_MAX;
+    for(int i = 0; i < reseaus; i++) {
+      m_minSample = min(m_minSample, m_samples[i]);
+      m_minLine = min(m_minLine, m_lines[i]);
+      maxSample = max(maxSample, m_samples[i]);
+      maxLine = max(maxLine, m_lines[i]);
+    }
+    if(reseaus == 0) {
+      m_minSample = m_minLine = maxSample = maxLine = 0.0;
+    }
+
+    int cellsAcross = max(1, (int) ceil(sqrt(reseaus / 2.0)));
+    m_cellSize = max(maxSample - m_minSample, maxLine - m_minLine) / cellsAcross;
+    if(!(m_cellSize > 0.0)) m_cellSize = 1.0;
+    m_columns = (int) floor((maxSample - m_minSample) / m_cellSize) + 1;
+    m_rows = (int) floor((maxLine - m_minLine) / m_cellSize) + 1;
+
+    // Count the reseaus in each cell, then list them by cell in reseau order
+    vector<int> cells(reseaus);
+    m_cellStart.assign(m_columns * m_rows + 1, 0);
+    for(int i = 0; i < reseaus; i++) {
+      int column = min(m_columns - 1, (int) floor((m_samples[i] - m_minSample) / m_cellSize));
+      int row = min(m_rows - 1, (int) floor((m_lines[i] - m_minLine) / m_cellSize));
+      cells[i] = row * m_columns + column;
+      m_cellStart[cells[i] + 1]++;
+    }
+    for(int cell = 0; cell < m_columns * m_rows; cell++) {
+      m_cellStart[cell + 1] += m_cellStart[cell];
+    }
+    m_cellReseaus.resize(reseaus);
+    vector<int> next(m_cellStart.begin(), m_cellStart.end() - 1);
+    for(int i = 0; i < reseaus; i++) {
+      m_cellReseaus[next[cells[i]]++] = i;
+    }
+  }
+
+
+  /**
+   * Find the reseaus closest to a location.  The cells are searched in rings
+   * around the location until no unsearched cell can hold a closer reseau.
+   * Reseaus at the same distance are ordered by their index, so the result is
+   * the same as repeatedly taking the closest remaining reseau from a list of
+   * all of them.  If there are fewer reseaus than requested the remaining
+   * entries are reseau 0 at a distance of DBL_MAX.
+   *
+   * @param sample The sample of the location
+   * @param line The line of the location
+   * @param count The number of reseaus to find
+   * @param closest Returns the indices of the closest reseaus, closest first
+   * @param distances Returns the squared distances to the closest reseaus
+   */
+  void ReseauDistortionMap::ReseauGrid::nearest(double sample, double line, int count,
+                                                int *closest, double *distances) const {
+    for(int k = 0; k < count; k++) {
+      closest[k] = 0;
+      distances[k] = DBL_MAX;
+    }
+
+    double column = floor((sample - m_minSample) / m_cellSize);
+    double row = floor((line - m_minLine) / m_cellSize);
+    int centerColumn = (int) max(0.0, min((double) m_columns - 1, column));
+    int centerRow = (int) max(0.0, min((double) m_rows - 1, row));
+
+    int found = 0;
+    int rings = max(m_columns, m_rows);
+    for(int ring = 0; ring < rings; ring++) {
+      int firstRow = max(0, centerRow - ring);
+      int lastRow = min(m_rows - 1, centerRow + ring);
+      for(int r = firstRow; r <= lastRow; r++) {
+        // Only the edge of the ring is new
+        int step = (r == centerRow - ring || r == centerRow + ring) ? 1 : 2 * ring;
+        for(int c = centerColumn - ring; c <= centerColumn + ring; c += max(1, step)) {
+          if(c < 0 || c >= m_columns) continue;
+
+          int cell = r * m_columns + c;
+          for(int p = m_cellStart[cell]; p < m_cellStart[cell + 1]; p++) {
+            int i = m_cellReseaus[p];
+            double sdiffsq = (sample - m_samples[i]) * (sample - m_samples[i]);
+            double ldiffsq = (line - m_lines[i]) * (line - m_lines[i]);
+            double distance = ldiffsq + sdiffsq;
+            if(found == count && (distance > distances[count - 1] ||
+                (distance == distances[count - 1] && i > closest[count - 1]))) {
+              continue;
+            }
+
+            // Insert in (distance, index) order
+            int k = min(found, count - 1);
+            while(k > 0 && (distances[k - 1] > distance ||
+                  (distances[k - 1] == distance && closest[k - 1] > i))) {
+              distances[k] = distances[k - 1];
+              closest[k] = closest[k - 1];
+              k--;
+            }
+            distances[k] = distance;
+            closest[k] = i;
+            found = min(found + 1, count);
+          }
+        }
+      }
+
+      // Stop when every unsearched cell is farther away than the last reseau
+      if(found == count) {
+        double gap = DBL_MAX;
+        if(centerColumn - ring > 0) {
+          gap = min(gap, sample - (m_minSample + (centerColumn - ring) * m_cellSize));
+        }
+        if(centerColumn + ring < m_columns - 1) {
+          gap = min(gap, m_minSample + (centerColumn + ring + 1) * m_cellSize - sample);
+        }
+        if(centerRow - ring > 0) {
+          gap = min(gap, line - (m_minLine + (centerRow - ring) * m_cellSize));
+        }
+        if(centerRow + ring < m_rows - 1) {
+          gap = min(gap, m_minLine + (centerRow + ring + 1) * m_cellSize - line);
+        }
+
+        // Allow for rounding in the cell assignment of reseaus on a cell edge
+        gap -= 1.0e-9 * m_cellSize;
+        if(gap > 0.0 && gap * gap > distances[count - 1]) break;
+      }
+    }
+  }
+
 } // end namespace isis
@@ -32,6 +32,30 @@ namespace Isis {
 
       virtual bool SetUndistortedFocalPlane(const double ux, const double uy);
 
+      /**
+       * Uniform grid of reseau locations that finds the reseaus closest to a
+       * point without measuring the distance to every reseau.
+       *
+       * @author 2026-10-18 ISIS Development Team
+       */
+      class ReseauGrid {
+        public:
+          void build(const std::vector<double> &samples, const std::vector<double> &lines);
+          void nearest(double sample, double line, int count,
+                       int *closest, double *distances) const;
+
+        private:
+          std::vector<double> m_samples;   //!< Sample of each reseau
+          std::vector<double> m_lines;     //!< Line of each reseau
+          std::vector<int> m_cellStart;    //!< Index of the first reseau of each cell
+          std::vector<int> m_cellReseaus;  //!< Reseau indices ordered by cell
+          double m_minSample;              //!< Sample of the left edge of the grid
+          double m_minLine;                //!< Line of the top edge of the grid
+          double m_cellSize;               //!< Width and height of a cell in pixels
+          int m_columns;                   //!< Number of cells across
+          int m_rows;                      //!< Number of cells down
+      };
+
     private:
       std::vector<double> p_rlines, p_rsamps;        //!<Refined Reseau Locations
       std::vector<double> p_mlines, p_msamps;        //!<Master Reseau Locations
@@ -42,6 +66,8 @@ namespace Isis {
       int p_numRes;                                  //!<Number of Reseaus
       double p_pixelPitch;                           /**<Pixel Pitch of parent
                                                         Camera*/
+      ReseauGrid p_refinedGrid;                      //!<Index of the refined reseaus
+      ReseauGrid p_masterGrid;                       //!<Index of the master reseaus
   };
 };
 #endif
@@ -97,22 +97,26 @@ namespace Isis {
   PvlGroup SerialNumber::FindSerialTranslation(Pvl &label) {
     Pvl outLabel;
 
+    // The translation managers are kept for each thread so serial numbers
+    // can be composed in parallel, see SerialNumberList
+
     // check if label has CSM information
     if(label.findObject("IsisCube").hasGroup("CsmInfo")) {
       static QString csmTransFile = "$ISISROOT/appdata/translations/CsmSerialNumber.trn";
-      PvlToPvlTranslationManager csmTranslator(label, csmTransFile);
+      static thread_local PvlToPvlTranslationManager csmTranslator(csmTransFile);
+      csmTranslator.SetLabel(label);
       csmTranslator.Auto(outLabel);
     }
     else {
       // Get the mission name
       static QString missionTransFile = "$ISISROOT/appdata/translations/MissionName2DataDir.trn";
-      static PvlToPvlTranslationManager missionXlater(missionTransFile);
+      static thread_local PvlToPvlTranslationManager missionXlater(missionTransFile);
       missionXlater.SetLabel(label);
       QString mission = missionXlater.Translate("MissionName");
 
       // Get the instrument name
       static QString instTransFile = "$ISISROOT/appdata/translations/Instruments.trn";
-      static PvlToPvlTranslationManager instrumentXlater(instTransFile);
+      static thread_local PvlToPvlTranslationManager instrumentXlater(instTransFile);
       instrumentXlater.SetLabel(label);
       QString instrument = instrumentXlater.Translate("InstrumentName");
 
@@ -123,7 +127,7 @@ namespace Isis {
       //   needs to have the mission name and the instrument name.
 
       //  Create the static map to keep the translation managers in memory
-      static std::map<QString, PvlToPvlTranslationManager> missionTranslators;
+      static thread_local std::map<QString, PvlToPvlTranslationManager> missionTranslators;
 
       // Determine the key for this translation manager - must have both mission and instrument
       QString key = mission + "_" + instrument;
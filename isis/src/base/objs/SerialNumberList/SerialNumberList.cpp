@@ -6,17 +6,179 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "SerialNumberList.h"
 
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <string>
+
+#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QString>
+#include <QThreadPool>
+#include <QVector>
+#include <QtConcurrentMap>
+
+#include <nlohmann/json.hpp>
 
 #include "IException.h"
 #include "FileList.h"
 #include "FileName.h"
 #include "ObservationNumber.h"
+#include "Preference.h"
 #include "Progress.h"
 #include "Pvl.h"
 #include "SerialNumber.h"
 
+using json = nlohmann::json;
+
 namespace Isis {
+
+  /**
+   * The parts of a cube label that add() uses, gathered before the cube is
+   * added so that the labels of a list can be read in parallel and kept in
+   * the serial number cache.
+   */
+  struct SerialNumberList::CubeSummary {
+    QString name;              //!< The file name as it was given
+    QString filename;          //!< The expanded file name
+    QString serialNumber;      //!< Serial number, Unknown if it could not be composed
+    QString observationNumber; //!< Observation number, Unknown if it could not be composed
+    bool hasInstrument;        //!< If the label has an Instrument group
+    bool hasMapping;           //!< If the label has a Mapping group
+    QString instrumentTarget;  //!< TargetName of the Instrument group, null if missing
+    QString mappingTarget;     //!< TargetName of the Mapping group, null if missing
+    QString spacecraftName;    //!< SpacecraftName or CSMPlatformID
+    QString instrumentId;      //!< InstrumentId or CSMInstrumentId
+  };
+
+
+  namespace {
+    std::mutex cacheMutex;    //!< Guards the serial number cache
+    QString cacheName;        //!< The file the cache was read from
+    json cacheEntries;        //!< Cached cube summaries by expanded file name
+    bool cacheChanged = false; //!< If entries were added since the cache was read
+
+
+    /**
+     * Reads the serial number cache named by the SerialNumberCache keyword of
+     * the Performance preferences, unless it was already read.  cacheMutex
+     * must be held.
+     *
+     * @return bool False if the cache is turned off
+     */
+    bool loadCache() {
+      PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+      if (!performance.hasKeyword("SerialNumberCache")) return false;
+      QString name = performance["SerialNumberCache"][0];
+      if (name.isEmpty() || name.toUpper() == "NONE") return false;
+      name = FileName(name).expanded();
+
+      if (name != cacheName) {
+        cacheName = name;
+        cacheEntries = json::object();
+        cacheChanged = false;
+        std::ifstream input(name.toStdString());
+        if (input) {
+          try {
+            json contents = json::parse(input);
+            if (contents.is_object()) {
+              cacheEntries = contents;
+            }
+          }
+          catch (json::exception &) {
+            // A damaged cache is rebuilt
+          }
+        }
+      }
+      return true;
+    }
+
+
+    /**
+     * Writes the serial number cache if entries were added to it.  The cache
+     * only saves time, so failing to write it is not an error.
+     */
+    void saveCache() {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      if (!cacheChanged || cacheName.isEmpty()) return;
+
+      QSaveFile file(cacheName);
+      if (file.open(QIODevice::WriteOnly)) {
+        std::string contents = cacheEntries.dump();
+        file.write(contents.data(), contents.size());
+        if (file.commit()) {
+          cacheChanged = false;
+        }
+      }
+    }
+
+
+    /**
+     * Reads the IsisCube object of a cube label.  The label is scanned as
+     * text and only the IsisCube object is parsed, skipping the tables,
+     * history and NAIF keywords that follow it.  Labels that can not be
+     * scanned are read whole.
+     *
+     * @param fileName The expanded name of the cube or detached label
+     *
+     * @return Pvl The label with the IsisCube object
+     */
+    Pvl readIsisCube(const QString &fileName) {
+      std::ifstream input(fileName.toLatin1().data());
+      std::string line;
+      std::string text;
+      int depth = 0;
+      bool found = false;
+      bool complete = false;
+      while (!complete && std::getline(input, line)) {
+        // Stop at the binary data after the label
+        bool binary = std::any_of(line.begin(), line.end(), [](char c) {
+          return (c < 32 && c != '\t' && c != '\r') || c > 126;
+        });
+        if (binary) break;
+
+        QString keyword = QString::fromStdString(line).trimmed().toUpper();
+        keyword.remove(' ');
+        keyword.remove('\t');
+        bool object = keyword.startsWith("OBJECT=");
+        bool endObject = keyword.startsWith("END_OBJECT") || keyword.startsWith("ENDOBJECT");
+
+        if (!found) {
+          if (keyword == "END") break;
+          if (keyword != "OBJECT=ISISCUBE") continue;
+          found = true;
+        }
+
+        text += line + "\n";
+        if (object) {
+          depth++;
+        }
+        else if (endObject) {
+          depth--;
+          complete = (depth == 0);
+        }
+      }
+
+      if (complete) {
+        try {
+          Pvl label;
+          std::istringstream stream(text + "End\n");
+          stream >> label;
+          label.setFileName(fileName);
+          return label;
+        }
+        catch (IException &) {
+          // Read the whole label below
+        }
+      }
+      return Pvl(fileName);
+    }
+  }
+
+
   /**
    * Creates an empty SerialNumberList
    *
@@ -30,7 +192,8 @@ namespace Isis {
 
 
   /**
-   * Creates a SerialNumberList from a list of filenames
+   * Creates a SerialNumberList from a list of filenames.  The labels are read
+   * in parallel batches and the cubes added in list order.
    *
    * @param listfile The list of files to be given serial numbers
    * @param checkTarget Specifies whether or not to check to make sure the target names
@@ -56,18 +219,51 @@ namespace Isis {
         progress->SetMaximumSteps((int) flist.size() + 1);
         progress->CheckStatus();
       }
-      for (int i = 0; i < flist.size(); i++) {
-        add(flist[i].toString());
-        if (progress != NULL) {
-          progress->CheckStatus();
+
+      {
+        // Read the cache before the labels are read in parallel
+        std::lock_guard<std::mutex> lock(cacheMutex);
+        loadCache();
+      }
+
+      int batchSize = 16 * std::max(1, QThreadPool::globalInstance()->maxThreadCount());
+      for (int first = 0; first < flist.size(); first += batchSize) {
+        QVector<int> batch;
+        for (int i = first; i < std::min(flist.size(), first + batchSize); i++) {
+          batch.append(i);
+        }
+        std::vector<CubeSummary> summaries(batch.size());
+        std::vector<std::exception_ptr> errors(batch.size());
+
+        auto summarize = [&](int &i) {
+          try {
+            summaries[i - first] = readSummary(flist[i].toString());
+          }
+          catch (...) {
+            errors[i - first] = std::current_exception();
+          }
+        };
+        QtConcurrent::blockingMap(batch, summarize);
+
+        // Add in list order so the errors and duplicates are reported as if
+        // the files were read one at a time
+        for (int i = 0; i < batch.size(); i++) {
+          if (errors[i]) {
+            std::rethrow_exception(errors[i]);
+          }
+          add(summaries[i], false);
+          if (progress != NULL) {
+            progress->CheckStatus();
+          }
         }
       }
     }
     catch (IException &e) {
+      saveCache();
       QString msg = "Can't open or invalid file list [" + listfile + "].";
       throw IException(e, IException::User, msg, _FILEINFO_);
     }
-
+    saveCache();
   }
 
 
@@ -119,22 +315,148 @@ namespace Isis {
    *                           does not exist.
    */
   void SerialNumberList::add(const QString &filename, bool def2filename) {
-    Pvl p(Isis::FileName(filename).expanded());
-    PvlObject cubeObj = p.findObject("IsisCube");
+    add(readSummary(filename), def2filename);
+  }
+
+
+  /**
+   * Reads the parts of a cube label that add() uses, from the serial number
+   * cache if the cube has not changed since it was cached.  Safe to call from
+   * several threads at once.
+   *
+   * @param filename The cube to read
+   *
+   * @return CubeSummary The serial numbers, targets and instrument of the cube
+   */
+  SerialNumberList::CubeSummary SerialNumberList::readSummary(const QString &filename) {
+    CubeSummary summary;
+    summary.name = filename;
+    summary.filename = Isis::FileName(filename).expanded();
+
+    QFileInfo info(summary.filename);
+    std::string key = summary.filename.toStdString();
+    qint64 size = info.size();
+    qint64 modified = info.lastModified().toMSecsSinceEpoch();
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      if (info.exists() && loadCache() && cacheEntries.contains(key)) {
+        const json &entry = cacheEntries[key];
+        if (entry.value("size", (qint64) -1) == size &&
+            entry.value("modified", (qint64) -1) == modified) {
+          summary.serialNumber = QString::fromStdString(entry.value("serialNumber", ""));
+          summary.observationNumber = QString::fromStdString(entry.value("observationNumber", ""));
+          summary.hasInstrument = entry.value("hasInstrument", false);
+          summary.hasMapping = entry.value("hasMapping", false);
+          if (entry.contains("instrumentTarget")) {
+            summary.instrumentTarget = QString::fromStdString(entry["instrumentTarget"].get<std::string>());
+          }
+          if (entry.contains("mappingTarget")) {
+            summary.mappingTarget = QString::fromStdString(entry["mappingTarget"].get<std::string>());
+          }
+          summary.spacecraftName = QString::fromStdString(entry.value("spacecraftName", ""));
+          summary.instrumentId = QString::fromStdString(entry.value("instrumentId", ""));
+          return summary;
+        }
+      }
+    }
+
+    // Report label errors the way add() reports the other errors of a cube
+    try {
+      Pvl p = readIsisCube(summary.filename);
+      PvlObject &cubeObj = p.findObject("IsisCube");
+
+      summary.hasInstrument = cubeObj.hasGroup("Instrument");
+      summary.hasMapping = cubeObj.hasGroup("Mapping");
+      if (summary.hasInstrument && cubeObj.findGroup("Instrument").hasKeyword("TargetName")) {
+        summary.instrumentTarget = cubeObj.findGroup("Instrument")["TargetName"][0];
+      }
+      if (summary.hasMapping && cubeObj.findGroup("Mapping").hasKeyword("TargetName")) {
+        summary.mappingTarget = cubeObj.findGroup("Mapping")["TargetName"][0];
+      }
+
+      // Compose without defaulting to the file name so the cached serial
+      // numbers do not depend on how the cube is added
+      summary.serialNumber = SerialNumber::Compose(p);
+      summary.observationNumber = ObservationNumber::Compose(p);
+
+      // If a CSM cube, obtain the CSMPlatformID and CSMInstrumentId from the CsmInfo
+      // group for use in bundle adjustment
+      if (cubeObj.hasGroup("CsmInfo")) {
+        PvlGroup &csmGroup = cubeObj.findGroup("CsmInfo");
+        if (csmGroup.hasKeyword("CSMPlatformID") && csmGroup.hasKeyword("CSMInstrumentId")) {
+          summary.spacecraftName = csmGroup["CSMPlatformID"][0];
+          summary.instrumentId = csmGroup["CSMInstrumentId"][0];
+        }
+      }
+
+      // Otherwise obtain the SpacecraftName and InstrumentId from the Instrument
+      // group for use in bundle adjustment
+      else if (summary.hasInstrument) {
+        PvlGroup &instGroup = cubeObj.findGroup("Instrument");
+        if (instGroup.hasKeyword("SpacecraftName") && instGroup.hasKeyword("InstrumentId")) {
+          summary.spacecraftName = instGroup["SpacecraftName"][0];
+          summary.instrumentId = instGroup["InstrumentId"][0];
+        }
+      }
+    }
+    catch (IException &e) {
+      QString msg = "FileName [" + summary.filename +
+                        "] can not be added to serial number list.";
+      throw IException(e, IException::User, msg, _FILEINFO_);
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(cacheMutex);
+      if (info.exists() && loadCache()) {
+        json entry;
+        entry["size"] = size;
+        entry["modified"] = modified;
+        entry["serialNumber"] = summary.serialNumber.toStdString();
+        entry["observationNumber"] = summary.observationNumber.toStdString();
+        entry["hasInstrument"] = summary.hasInstrument;
+        entry["hasMapping"] = summary.hasMapping;
+        if (!summary.instrumentTarget.isNull()) {
+          entry["instrumentTarget"] = summary.instrumentTarget.toStdString();
+        }
+        if (!summary.mappingTarget.isNull()) {
+          entry["mappingTarget"] = summary.mappingTarget.toStdString();
+        }
+        entry["spacecraftName"] = summary.spacecraftName.toStdString();
+        entry["instrumentId"] = summary.instrumentId.toStdString();
+        cacheEntries[key] = entry;
+        cacheChanged = true;
+      }
+    }
+    return summary;
+  }
+
+
+  /**
+   * Adds a cube to the list from the summary of its label.
+   *
+   * @param summary The summary of the cube label from readSummary()
+   * @param def2filename If a serial number could not be found, use the filename
+   *
+   * @see add(QString, bool)
+   */
+  void SerialNumberList::add(const CubeSummary &summary, bool def2filename) {
+    const QString &filename = summary.name;
 
     try {
 
       // Test the target name if desired
       if (m_checkTarget) {
         QString target;
-        PvlGroup targetGroup;
-        if (cubeObj.hasGroup("Instrument")) {
-          targetGroup = cubeObj.findGroup("Instrument");
+        QString groupName;
+        if (summary.hasInstrument) {
+          target = summary.instrumentTarget;
+          groupName = "Instrument";
         }
         else if (def2filename) {
           // No instrument, try Mapping
-          if (cubeObj.hasGroup("Mapping")) {
-            targetGroup = cubeObj.findGroup("Mapping");
+          if (summary.hasMapping) {
+            target = summary.mappingTarget;
+            groupName = "Mapping";
           }
           else {
             QString msg = "Unable to find Instrument or Mapping group in "
@@ -149,7 +471,11 @@ namespace Isis {
           throw IException(IException::User, msg, _FILEINFO_);
         }
 
-        target = targetGroup["TargetName"][0];
+        if (target.isNull()) {
+          QString msg = "PVL Keyword [TargetName] does not exist in [Group = " + groupName +
+                        "] in file [" + summary.filename + "]";
+          throw IException(IException::Unknown, msg, _FILEINFO_);
+        }
         target = target.toUpper();
         if (m_target.isEmpty()) {
           m_target = target;
@@ -161,9 +487,14 @@ namespace Isis {
         }
       }
 
-      // Create the SN
-      QString sn = SerialNumber::Compose(p, def2filename);
-      QString on = ObservationNumber::Compose(p, def2filename);
+      // Fall back to the file name the way SerialNumber::Compose does
+      QString sn = summary.serialNumber;
+      QString on = summary.observationNumber;
+      if (def2filename) {
+        if (sn == "Unknown") sn = Isis::FileName(summary.filename).name();
+        if (on == "Unknown") on = Isis::FileName(summary.filename).name();
+      }
+
       if (sn == "Unknown") {
         QString msg = "Invalid serial number [Unknown] from file ["
                       + filename + "].";
@@ -177,36 +508,18 @@ namespace Isis {
       }
 
       Pair nextpair;
-      nextpair.filename = Isis::FileName(filename).expanded();
+      nextpair.filename = summary.filename;
       nextpair.serialNumber = sn;
       nextpair.observationNumber = on;
-
-      // If a CSM cube, obtain the CSMPlatformID and CSMInstrumentId from the CsmInfo
-      // group for use in bundle adjustment
-      if (cubeObj.hasGroup("CsmInfo")) {
-        PvlGroup csmGroup = cubeObj.findGroup("CsmInfo");
-        if (csmGroup.hasKeyword("CSMPlatformID") && csmGroup.hasKeyword("CSMInstrumentId")) {
-          nextpair.spacecraftName = cubeObj.findGroup("CsmInfo")["CSMPlatformID"][0];
-          nextpair.instrumentId = cubeObj.findGroup("CsmInfo")["CSMInstrumentId"][0];
-        }
-      }
-
-      // Otherwise obtain the SpacecraftName and InstrumentId from the Instrument
-      // group for use in bundle adjustment
-      else if (cubeObj.hasGroup("Instrument")) {
-        PvlGroup instGroup = cubeObj.findGroup("Instrument");
-        if (instGroup.hasKeyword("SpacecraftName") && instGroup.hasKeyword("InstrumentId")) {
-          nextpair.spacecraftName = cubeObj.findGroup("Instrument")["SpacecraftName"][0];
-          nextpair.instrumentId = cubeObj.findGroup("Instrument")["InstrumentId"][0];
-        }
-      }
+      nextpair.spacecraftName = summary.spacecraftName;
+      nextpair.instrumentId = summary.instrumentId;
 
       m_pairs.push_back(nextpair);
       m_serialMap.insert(std::pair<QString, int>(sn, (int)(m_pairs.size() - 1)));
       m_fileMap.insert(std::pair<QString, int>(nextpair.filename, (int)(m_pairs.size() - 1)));
     }
     catch (IException &e) {
-      QString msg = "FileName [" + Isis::FileName(filename).expanded() +
+      QString msg = "FileName [" + summary.filename +
                         "] can not be added to serial number list.";
       throw IException(e, IException::User, msg, _FILEINFO_);
     }
@@ -249,7 +562,7 @@ namespace Isis {
    *
    */
   void SerialNumberList::add(const QString &serialNumber, const QString &filename) {
-    Pvl p(Isis::FileName(filename).expanded());
+    Pvl p = readIsisCube(Isis::FileName(filename).expanded());
     PvlObject cubeObj = p.findObject("IsisCube");
 
     try {
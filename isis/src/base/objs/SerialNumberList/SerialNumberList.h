@@ -21,6 +21,12 @@ namespace Isis {
    *
    * Create a list of serial numbers from a list of files
    *
+   * Only the IsisCube object of each label is read.  The labels of a list
+   * file are read and their serial numbers composed in parallel, then added
+   * in list order.  If the SerialNumberCache keyword of the Performance
+   * preferences names a file, the serial numbers are kept there between runs
+   * for cubes whose size and modification time have not changed.
+   *
    * @ingroup ControlNetworks
    *
    * @author  2005-08-03 Jeff Anderson
@@ -101,6 +107,10 @@ namespace Isis {
         QString instrumentId;
       };
 
+      struct CubeSummary;
+      static CubeSummary readSummary(const QString &filename);
+      void add(const CubeSummary &summary, bool def2filename);
+
       std::vector<Pair> m_pairs;            //!< List of serial number Pair entities
       std::map<QString, int> m_serialMap;   //!< Maps serial numbers to their positions in the list 
       std::map<QString, int> m_fileMap;     //!< Maps filenames to their positions in the list
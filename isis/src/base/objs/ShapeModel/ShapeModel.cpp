@@ -24,7 +24,6 @@ find files of those names at the top level of this repository. **/
 #include "SurfacePoint.h"
 #include "IException.h"
 #include "IString.h"
-#include "NaifStatus.h"
 #include "Spice.h"
 #include "Target.h"
 
@@ -270,30 +269,16 @@ namespace Isis {
     // Clear out previous surface point and normal
     clearSurfacePoint();
 
-    SpiceDouble lookB[3];
-
-    // This memcpy does:
-    // lookB[0] = observerLookVectorToTarget[0];
-    // lookB[1] = observerLookVectorToTarget[1];
-    // lookB[2] = observerLookVectorToTarget[2];
-    memcpy(lookB,&observerLookVectorToTarget[0], 3*sizeof(double));
-
     // get target radii
     std::vector<Distance> radii = targetRadii();
-    SpiceDouble a = radii[0].kilometers();
-    SpiceDouble b = radii[1].kilometers();
-    SpiceDouble c = radii[2].kilometers();
+    double a = radii[0].kilometers();
+    double b = radii[1].kilometers();
+    double c = radii[2].kilometers();
 
     // check if observer look vector intersects the target
-    SpiceDouble intersectionPoint[3];
-    SpiceBoolean intersected = false;
-
-    NaifStatus::CheckErrors();
-    surfpt_c((SpiceDouble *) &observerBodyFixedPosition[0], lookB, a, b, c,
-             intersectionPoint, &intersected);
-    NaifStatus::CheckErrors();
-
-    if (intersected) {
+    double intersectionPoint[3];
+    if (rayEllipsoidIntersection(&observerBodyFixedPosition[0], &observerLookVectorToTarget[0],
+                                 a, b, c, intersectionPoint)) {
       m_surfacePoint->FromNaifArray(intersectionPoint);
       m_hasIntersection = true;
     }
@@ -306,6 +291,106 @@ namespace Isis {
   }
 
 
+  /**
+   * Finds the first intersection of a ray with an ellipsoid centered on the
+   * origin, the computation of the NAIF routine surfpt_c without its error
+   * handling overhead.  The ellipsoid is scaled to the unit sphere, where the
+   * intersection is the closest point of the ray to the center moved back
+   * along the ray by half of the chord.  An observer inside the ellipsoid
+   * sees the point where the ray leaves it.
+   *
+   * @param observer Position of the observer in the body-fixed frame
+   * @param look Direction vector from the observer in the body-fixed frame
+   * @param a Length of the ellipsoid semi-axis along the x-axis
+   * @param b Length of the ellipsoid semi-axis along the y-axis
+   * @param c Length of the ellipsoid semi-axis along the z-axis
+   * @param intersection Returns the intersection point
+   *
+   * @return @b bool True if the ray intersects the ellipsoid
+   */
+  bool ShapeModel::rayEllipsoidIntersection(const double observer[3], const double look[3],
+                                            double a, double b, double c,
+                                            double intersection[3]) {
+    if (!(a > 0.0 && b > 0.0 && c > 0.0)) {
+      QString msg = "The ellipsoid radii [" + toString(a) + ", " + toString(b) + ", " +
+                    toString(c) + "] must be positive";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // Scale the ellipsoid to the unit sphere
+    double x[3] = {observer[0] / a, observer[1] / b, observer[2] / c};
+    double y[3] = {look[0] / a, look[1] / b, look[2] / c};
+
+    double yLength = sqrt(y[0] * y[0] + y[1] * y[1] + y[2] * y[2]);
+    if (yLength == 0.0) {
+      QString msg = "The look direction must not be the zero vector";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+    y[0] /= yLength;
+    y[1] /= yLength;
+    y[2] /= yLength;
+
+    // An observer outside the sphere looking away from it sees nothing
+    double along = x[0] * y[0] + x[1] * y[1] + x[2] * y[2];
+    double xSquared = x[0] * x[0] + x[1] * x[1] + x[2] * x[2];
+    bool outside = (xSquared >= 1.0);
+    if (outside && along > 0.0) {
+      return false;
+    }
+
+    // The point of the ray closest to the center must be inside the sphere
+    double p[3] = {x[0] - along * y[0], x[1] - along * y[1], x[2] - along * y[2]};
+    double pSquared = p[0] * p[0] + p[1] * p[1] + p[2] * p[2];
+    if (pSquared > 1.0) {
+      return false;
+    }
+
+    double halfChord = sqrt(1.0 - pSquared);
+    if (outside) {
+      halfChord = -halfChord;
+    }
+
+    intersection[0] = (p[0] + halfChord * y[0]) * a;
+    intersection[1] = (p[1] + halfChord * y[1]) * b;
+    intersection[2] = (p[2] + halfChord * y[2]) * c;
+    return true;
+  }
+
+
+  /**
+   * Computes the unit outward normal of an ellipsoid centered on the origin
+   * at a point on its surface, the computation of the NAIF routine surfnm_c
+   * without its error handling overhead.
+   *
+   * @param point A point on the surface of the ellipsoid
+   * @param a Length of the ellipsoid semi-axis along the x-axis
+   * @param b Length of the ellipsoid semi-axis along the y-axis
+   * @param c Length of the ellipsoid semi-axis along the z-axis
+   * @param normal Returns the unit normal
+   */
+  void ShapeModel::ellipsoidNormal(const double point[3], double a, double b, double c,
+                                   double normal[3]) {
+    if (!(a > 0.0 && b > 0.0 && c > 0.0)) {
+      QString msg = "The ellipsoid radii [" + toString(a) + ", " + toString(b) + ", " +
+                    toString(c) + "] must be positive";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    // The gradient of x^2/a^2 + y^2/b^2 + z^2/c^2, scaled by the smallest
+    // radius squared to keep it well conditioned
+    double m = std::min(a, std::min(b, c));
+    double a1 = m / a;
+    double b1 = m / b;
+    double c1 = m / c;
+
+    double gradient[3];
+    gradient[0] = point[0] * (a1 * a1);
+    gradient[1] = point[1] * (b1 * b1);
+    gradient[2] = point[2] * (c1 * c1);
+    vhat_c(gradient, normal);
+  }
+
+
   /**
    * Computes and returns phase angle, in degrees, given the positions of the
    * observer and illuminator.
@@ -147,6 +147,13 @@ namespace Isis {
       virtual bool isVisibleFrom(const std::vector<double> observerPos,
                                  const std::vector<double> lookDirection);
 
+      // Native ray and normal computations for an ellipsoid
+      static bool rayEllipsoidIntersection(const double observer[3], const double look[3],
+                                           double a, double b, double c,
+                                           double intersection[3]);
+      static void ellipsoidNormal(const double point[3], double a, double b, double c,
+                                  double normal[3]);
+
     protected:
 
       // Set the normal (surface or local) of the current intersection point
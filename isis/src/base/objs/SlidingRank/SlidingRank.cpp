@@ -0,0 +1,203 @@
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include "SlidingRank.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "SpecialPixel.h"
+
+using namespace std;
+
+namespace Isis {
+  /**
+   * Constructs an empty window for the pixels of a cube.
+   *
+   * @param type The pixel type of the cube
+   * @param base The base of the cube
+   * @param multiplier The multiplier of the cube
+   * @param windowSize The most pixels the window will hold
+   * @param minimum Pixels less than this are ignored
+   * @param maximum Pixels greater than this are ignored
+   */
+  SlidingRank::SlidingRank(PixelType type, double base, double multiplier, int windowSize,
+                           double minimum, double maximum) {
+    m_base = base;
+    m_multiplier = multiplier;
+    m_minimum = minimum;
+    m_maximum = maximum;
+    m_count = 0;
+    m_firstRaw = 0;
+    m_bucketWidth = 0;
+
+    // A word histogram only pays for its scans when the window is large
+    int bins = 0;
+    if (multiplier > 0.0) {
+      if (type == UnsignedByte) {
+        bins = 256;
+        m_bucketWidth = 16;
+      }
+      else if ((type == SignedWord || type == UnsignedWord) && windowSize >= 64) {
+        bins = 65536;
+        m_bucketWidth = 256;
+        m_firstRaw = (type == SignedWord) ? -32768 : 0;
+      }
+    }
+
+    if (bins > 0) {
+      m_bins.resize(bins, 0);
+      m_buckets.resize(bins / m_bucketWidth, 0);
+    }
+    else {
+      m_sorted.reserve(windowSize);
+    }
+  }
+
+
+  //! Destroys the SlidingRank
+  SlidingRank::~SlidingRank() {
+  }
+
+
+  /**
+   * @param value A pixel value
+   *
+   * @return bool True if the pixel belongs in the window
+   */
+  bool SlidingRank::accept(double value) const {
+    return !IsSpecial(value) && value >= m_minimum && value <= m_maximum;
+  }
+
+
+  /**
+   * @param value A pixel value from the cube
+   *
+   * @return int The histogram bin of the pixel
+   */
+  int SlidingRank::bin(double value) const {
+    int raw = (int) floor((value - m_base) / m_multiplier + 0.5) - m_firstRaw;
+    return max(0, min(raw, (int) m_bins.size() - 1));
+  }
+
+
+  /**
+   * Adds a pixel to the window if it is valid.
+   *
+   * @param value The pixel to add
+   */
+  void SlidingRank::add(double value) {
+    if (!accept(value)) return;
+
+    if (!m_bins.empty()) {
+      int b = bin(value);
+      m_bins[b]++;
+      m_buckets[b / m_bucketWidth]++;
+    }
+    else {
+      m_sorted.insert(upper_bound(m_sorted.begin(), m_sorted.end(), value), value);
+    }
+    m_count++;
+  }
+
+
+  /**
+   * Adds the valid pixels of an array to the window.
+   *
+   * @param values The pixels to add
+   * @param count The number of pixels
+   */
+  void SlidingRank::add(const double *values, int count) {
+    for (int i = 0; i < count; i++) {
+      add(values[i]);
+    }
+  }
+
+
+  /**
+   * Removes a pixel, previously added, from the window.
+   *
+   * @param value The pixel to remove
+   */
+  void SlidingRank::remove(double value) {
+    if (!accept(value)) return;
+
+    if (!m_bins.empty()) {
+      int b = bin(value);
+      if (m_bins[b] == 0) return;
+      m_bins[b]--;
+      m_buckets[b / m_bucketWidth]--;
+    }
+    else {
+      vector<double>::iterator it = lower_bound(m_sorted.begin(), m_sorted.end(), value);
+      if (it == m_sorted.end() || *it != value) return;
+      m_sorted.erase(it);
+    }
+    m_count--;
+  }
+
+
+  /**
+   * Removes the valid pixels of an array, previously added, from the window.
+   *
+   * @param values The pixels to remove
+   * @param count The number of pixels
+   */
+  void SlidingRank::remove(const double *values, int count) {
+    for (int i = 0; i < count; i++) {
+      remove(values[i]);
+    }
+  }
+
+
+  //! Empties the window
+  void SlidingRank::clear() {
+    if (!m_bins.empty()) {
+      fill(m_bins.begin(), m_bins.end(), 0);
+      fill(m_buckets.begin(), m_buckets.end(), 0);
+    }
+    m_sorted.clear();
+    m_count = 0;
+  }
+
+
+  /**
+   * Returns the k'th smallest pixel in the window, counting from zero.
+   *
+   * @param k The rank of the pixel
+   *
+   * @return double The pixel, or Null if k is not less than the number of
+   *                pixels in the window
+   */
+  double SlidingRank::rank(int k) const {
+    if (k < 0 || k >= m_count) return Isis::Null;
+
+    if (m_bins.empty()) return m_sorted[k];
+
+    int bucket = 0;
+    while (k >= m_buckets[bucket]) {
+      k -= m_buckets[bucket];
+      bucket++;
+    }
+    int b = bucket * m_bucketWidth;
+    while (k >= m_bins[b]) {
+      k -= m_bins[b];
+      b++;
+    }
+    return binValue(b);
+  }
+
+
+  /**
+   * Returns the median of the window. For an even number of pixels this is
+   * the lower of the two middle pixels.
+   *
+   * @return double The median, or Null if the window is empty
+   */
+  double SlidingRank::median() const {
+    return rank((m_count - 1) / 2);
+  }
+}
@@ -0,0 +1,122 @@
+#ifndef SlidingRank_h
+#define SlidingRank_h
+/** This is free and unencumbered software released into the public domain.
+The authors of ISIS do not claim copyright on the contents of this file.
+For more details about the LICENSE terms and the AUTHORS, you will
+find files of those names at the top level of this repository. **/
+
+/* SPDX-License-Identifier: CC0-1.0 */
+#include <vector>
+
+#include "PixelType.h"
+
+namespace Isis {
+  /**
+   * @brief Order statistics of a sliding window of pixels
+   *
+   * Holds the valid pixels of a window that moves across a cube, such as a
+   * boxcar, and answers rank (median, percentile) and distinct value queries
+   * about them. Pixels are added as they enter the window and removed as they
+   * leave it, so moving a boxcar by one sample costs one column of updates
+   * instead of gathering and sorting the whole boxcar.
+   *
+   * Byte cubes, and word cubes with large windows, are held in a two level
+   * histogram of their raw values, as in Huang's running median filter: an
+   * update is a counter increment and a rank query scans at most a few hundred
+   * counters. Other data is held in a sorted array, which is updated by binary
+   * search and answers rank queries directly.
+   *
+   * Special pixels and pixels outside the valid range are ignored by add and
+   * remove, so whole boxcar rows and columns can be passed to them.
+   *
+   * @ingroup Utility
+   *
+   * @author 2026-10-18 ISIS Development Team
+   *
+   * @internal
+   */
+  class SlidingRank {
+    public:
+      SlidingRank(PixelType type, double base, double multiplier, int windowSize,
+                  double minimum, double maximum);
+      ~SlidingRank();
+
+      void add(double value);
+      void add(const double *values, int count);
+      void remove(double value);
+      void remove(const double *values, int count);
+      void clear();
+
+      /**
+       * @return int The number of valid pixels in the window
+       */
+      int count() const {
+        return m_count;
+      }
+
+      double rank(int k) const;
+      double median() const;
+
+      /**
+       * @return bool True if the window is held in a histogram
+       */
+      bool usesHistogram() const {
+        return !m_bins.empty();
+      }
+
+      /**
+       * Calls visit(value, count) for each distinct value in the window, in
+       * ascending order.
+       *
+       * @param visit The function to call for each value
+       */
+      template <typename Visitor> void forEachValue(Visitor visit) const {
+        if (m_bins.empty()) {
+          int i = 0;
+          while (i < m_count) {
+            int run = 1;
+            while (i + run < m_count && m_sorted[i + run] == m_sorted[i]) run++;
+            visit(m_sorted[i], run);
+            i += run;
+          }
+          return;
+        }
+
+        for (unsigned int bucket = 0; bucket < m_buckets.size(); bucket++) {
+          if (m_buckets[bucket] == 0) continue;
+          int first = bucket * m_bucketWidth;
+          for (int bin = first; bin < first + m_bucketWidth; bin++) {
+            if (m_bins[bin] > 0) visit(binValue(bin), m_bins[bin]);
+          }
+        }
+      }
+
+    private:
+      bool accept(double value) const;
+      int bin(double value) const;
+
+      /**
+       * @param bin A histogram bin
+       *
+       * @return double The pixel value of the bin
+       */
+      double binValue(int bin) const {
+        return (double) (bin + m_firstRaw) * m_multiplier + m_base;
+      }
+
+      double m_base;          //!< Base of the cube the pixels come from
+      double m_multiplier;    //!< Multiplier of the cube the pixels come from
+      double m_minimum;       //!< Smallest valid pixel value
+      double m_maximum;       //!< Largest valid pixel value
+      int m_count;            //!< Number of valid pixels in the window
+
+      int m_firstRaw;         //!< Raw value of the first histogram bin
+      int m_bucketWidth;      //!< Number of bins counted by each bucket
+      std::vector<int> m_bins;     //!< Count of each raw value, empty when not used
+      std::vector<int> m_buckets;  //!< Count of each group of bins
+
+      std::vector<double> m_sorted;  //!< The valid pixels in ascending order
+  };
+};
+
+#endif
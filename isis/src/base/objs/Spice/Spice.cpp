@@ -152,6 +152,7 @@ namespace Isis {
    *   @history 2011-02-08 Jeannie Walldren - Initialize pointers to null.
    */
   void Spice::init(Pvl &lab, bool noTables, json isd) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     // Initialize members
     defaultInit();
@@ -484,6 +485,7 @@ namespace Isis {
    * @throw Isis::IException::Io - "Spice file does not exist."
    */
   void Spice::load(PvlKeyword &key, bool noTables) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     for (int i = 0; i < key.size(); i++) {
@@ -509,6 +511,7 @@ namespace Isis {
    * Destroys the Spice object
    */
   Spice::~Spice() {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     if (m_solarLongitude != NULL) {
@@ -648,6 +651,7 @@ namespace Isis {
    */
   void Spice::createCache(iTime startTime, iTime endTime,
       int cacheSize, double tol) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     // Check for errors
@@ -1062,6 +1066,7 @@ namespace Isis {
 
     if (storedClockTime.isNull()) {
       SpiceDouble timeOutput;
+      NaifLock lock;
       NaifStatus::CheckErrors();
       if (clockTicks) {
         sct2e_c(sclkCode, (SpiceDouble) clockValue.toDouble(), &timeOutput);
@@ -1094,6 +1099,7 @@ namespace Isis {
     QVariant result;
 
     if (m_usingNaif && !m_usingAle) {
+      NaifLock lock;
       NaifStatus::CheckErrors();
 
       // This is the success status of the naif call
@@ -1276,6 +1282,7 @@ namespace Isis {
    *             first."
    */
   void Spice::subSpacecraftPoint(double &lat, double &lon) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     if (m_et == NULL) {
@@ -1327,6 +1334,7 @@ namespace Isis {
    *             first."
    */
   void Spice::subSolarPoint(double &lat, double &lon) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     if (m_et == NULL) {
@@ -1398,6 +1406,7 @@ namespace Isis {
    * @param et Ephemeris time
    */
   void Spice::computeSolarLongitude(iTime et) {
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     if (m_target->isSky()) {
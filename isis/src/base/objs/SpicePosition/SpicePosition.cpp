@@ -247,8 +247,6 @@ namespace Isis {
    *                      to make software more readable.
    */
   const std::vector<double> &SpicePosition::SetEphemerisTime(double et) {
-    NaifStatus::CheckErrors();
-
     // Save the time
     if(et == p_et) {
       return p_coordinate;
@@ -269,12 +267,10 @@ namespace Isis {
     else if(p_source == PolyFunctionOverHermiteConstant) {
       SetEphemerisTimePolyFunctionOverHermiteConstant();
     }
-    else {  // Read from the kernel
+    else {  // Read from the kernel, which checks for NAIF errors
       SetEphemerisTimeSpice();
     }
 
-    NaifStatus::CheckErrors();
-
     // Return the coordinate
     return p_coordinate;
   }
@@ -1746,6 +1742,7 @@ namespace Isis {
                                          double &lightTime) const {
 
     // First try getting the entire state (including the velocity vector)
+    NaifLock lock;
     NaifStatus::CheckErrors();
     hasVelocity = true;
     lightTime = 0.0;
@@ -20,6 +20,7 @@ find files of those names at the top level of this repository. **/
 #include <SpiceZmc.h>
 
 #include "BasisFunction.h"
+#include "Constants.h"
 #include "IException.h"
 #include "IString.h"
 #include "LeastSquares.h"
@@ -48,6 +49,61 @@ extern int ck3sdn(double sdntol, bool avflag, int *nrec,
                   int *intarr);
 
 namespace Isis {
+  namespace {
+    /**
+     * Sets a row-major matrix to the rotation of the frame by an angle about
+     * an axis (1, 2 or 3), as rotate_c, or to its derivative with respect to
+     * the angle, as drotat.
+     */
+    void axisRotation(double angle, int axis, double matrix[9], bool derivative = false) {
+      int i = axis - 1;
+      int j = (i + 1) % 3;
+      int k = (i + 2) % 3;
+      double c = cos(angle);
+      double s = sin(angle);
+
+      std::fill(matrix, matrix + 9, 0.0);
+      if (derivative) {
+        matrix[3*j + j] = -s;
+        matrix[3*j + k] = c;
+        matrix[3*k + j] = -c;
+        matrix[3*k + k] = -s;
+      }
+      else {
+        matrix[3*i + i] = 1.0;
+        matrix[3*j + j] = c;
+        matrix[3*j + k] = s;
+        matrix[3*k + j] = -s;
+        matrix[3*k + k] = c;
+      }
+    }
+
+
+    //! Multiplies two row-major matrices.  The product may overwrite either one.
+    void multiply(const double a[9], const double b[9], double product[9]) {
+      double result[9];
+      for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+          result[3*row + col] = a[3*row] * b[col] + a[3*row + 1] * b[3 + col] +
+                                a[3*row + 2] * b[6 + col];
+        }
+      }
+      std::copy(result, result + 9, product);
+    }
+
+
+    //! Checks an Euler angle axis sequence, which eul2m_c and m2eul_c reject
+    void checkAxes(int axis3, int axis2, int axis1) {
+      if (axis3 < 1 || axis3 > 3 || axis2 < 1 || axis2 > 3 || axis1 < 1 || axis1 > 3 ||
+          axis2 == axis3 || axis2 == axis1) {
+        QString msg = "The Euler angle axis sequence [" + toString(axis3) + ", " +
+                      toString(axis2) + ", " + toString(axis1) + "] is not valid";
+        throw IException(IException::Programmer, msg, _FILEINFO_);
+      }
+    }
+  }
+
+
   /**
    * Construct an empty SpiceRotation class using a valid Naif frame code to
    * set up for getting rotation from Spice kernels.  See required reading
@@ -1307,17 +1363,14 @@ namespace Isis {
    * @return @b vector<double> Camera angles (ra, dec, twist)
    */
   std::vector<double> SpiceRotation::Angles(int axis3, int axis2, int axis1) {
-    NaifStatus::CheckErrors();
-
-    SpiceDouble ang1, ang2, ang3;
-    m2eul_c((SpiceDouble *) &p_CJ[0], axis3, axis2, axis1, &ang3, &ang2, &ang1);
+    double ang1, ang2, ang3;
+    matrixToEuler(&p_CJ[0], axis3, axis2, axis1, ang3, ang2, ang1);
 
     std::vector<double> angles;
     angles.push_back(ang1);
     angles.push_back(ang2);
     angles.push_back(ang3);
 
-    NaifStatus::CheckErrors();
     return angles;
   }
 
@@ -1334,7 +1387,7 @@ namespace Isis {
    * @param[in]  axis1    The rotation axis for the first angle
    */
   void SpiceRotation::SetAngles(std::vector<double> angles, int axis3, int axis2, int axis1) {
-    eul2m_c(angles[2], angles[1], angles[0], axis3, axis2, axis1, (SpiceDouble (*)[3]) &(p_CJ[0]));
+    eulerToMatrix(angles[2], angles[1], angles[0], axis3, axis2, axis1, &p_CJ[0]);
 
     if (m_orientation) {
       delete m_orientation;
@@ -1357,6 +1410,92 @@ namespace Isis {
   }
 
 
+  /**
+   * Computes the rotation matrix for three Euler angles, matching eul2m_c:
+   * matrix = [angle3]axis3 [angle2]axis2 [angle1]axis1, where [angle]axis
+   * rotates the frame by angle about axis.
+   *
+   * @param angle3 The third rotation angle in radians
+   * @param angle2 The second rotation angle in radians
+   * @param angle1 The first rotation angle in radians
+   * @param axis3 The axis (1, 2 or 3) of the third rotation
+   * @param axis2 The axis of the second rotation, different from axis1 and axis3
+   * @param axis1 The axis of the first rotation
+   * @param[out] matrix The row-major rotation matrix
+   *
+   * @throws IException::Programmer "The Euler angle axis sequence is not valid"
+   */
+  void SpiceRotation::eulerToMatrix(double angle3, double angle2, double angle1,
+                                    int axis3, int axis2, int axis1, double matrix[9]) {
+    checkAxes(axis3, axis2, axis1);
+
+    double rotation[9];
+    axisRotation(angle1, axis1, matrix);
+    axisRotation(angle2, axis2, rotation);
+    multiply(rotation, matrix, matrix);
+    axisRotation(angle3, axis3, rotation);
+    multiply(rotation, matrix, matrix);
+  }
+
+
+  /**
+   * Decomposes a rotation matrix into Euler angles, matching m2eul_c.  The
+   * first and third angles are in [-pi, pi].  The second angle is in [0, pi]
+   * when axis3 equals axis1 and in [-pi/2, pi/2] otherwise.  When the second
+   * angle lines the first and third axes up only their combined rotation is
+   * known; the third angle is then set to zero.
+   *
+   * @param matrix The row-major rotation matrix
+   * @param axis3 The axis (1, 2 or 3) of the third rotation
+   * @param axis2 The axis of the second rotation, different from axis1 and axis3
+   * @param axis1 The axis of the first rotation
+   * @param[out] angle3 The third rotation angle in radians
+   * @param[out] angle2 The second rotation angle in radians
+   * @param[out] angle1 The first rotation angle in radians
+   *
+   * @throws IException::Programmer "The Euler angle axis sequence is not valid"
+   */
+  void SpiceRotation::matrixToEuler(const double matrix[9], int axis3, int axis2, int axis1,
+                                    double &angle3, double &angle2, double &angle1) {
+    checkAxes(axis3, axis2, axis1);
+
+    // Rows and columns of the matrix by axis, and the sign of the elements
+    // that depends on whether the sequence runs forward (1, 2, 3, 1, ...)
+    int a = axis3 - 1;
+    int b = axis2 - 1;
+    double sign = (b == (a + 1) % 3) ? 1.0 : -1.0;
+    bool degenerate;
+
+    if (axis3 == axis1) {
+      int c = 3 - a - b;
+      angle2 = atan2(hypot(matrix[3*a + b], matrix[3*a + c]), matrix[3*a + a]);
+      degenerate = (matrix[3*a + b] == 0.0 && matrix[3*a + c] == 0.0);
+      if (!degenerate) {
+        angle1 = atan2(matrix[3*a + b], -sign * matrix[3*a + c]);
+        angle3 = atan2(matrix[3*b + a], sign * matrix[3*c + a]);
+      }
+    }
+    else {
+      int c = axis1 - 1;
+      angle2 = atan2(-sign * matrix[3*a + c], hypot(matrix[3*a + a], matrix[3*a + b]));
+      degenerate = (matrix[3*a + a] == 0.0 && matrix[3*a + b] == 0.0);
+      if (!degenerate) {
+        angle1 = atan2(sign * matrix[3*a + b], matrix[3*a + a]);
+        angle3 = atan2(sign * matrix[3*b + c], matrix[3*c + c]);
+      }
+    }
+
+    // The first and third rotations line up, so put all of it in the first
+    if (degenerate) {
+      int p = axis1 - 1;
+      int o = 3 - p - b;
+      double rowSign = (b == (p + 1) % 3) ? 1.0 : -1.0;
+      angle3 = 0.0;
+      angle1 = atan2(rowSign * matrix[3*b + o], matrix[3*b + b]);
+    }
+  }
+
+
   /**
    * Accessor method to get the angular velocity
    *
@@ -1406,14 +1545,14 @@ namespace Isis {
    * @return vector<double>  A direction vector in J2000 frame.
    */
   std::vector<double> SpiceRotation::J2000Vector(const std::vector<double> &rVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> jVec;
     if (rVec.size() == 3) {
-      double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
+      double TJ[9];
+      multiply(&p_TC[0], &p_CJ[0], TJ);
       jVec.resize(3);
-      mtxv_c(TJ, (SpiceDouble *) &rVec[0], (SpiceDouble *) &jVec[0]);
+      for (int i = 0; i < 3; i++) {
+        jVec[i] = TJ[i] * rVec[0] + TJ[3 + i] * rVec[1] + TJ[6 + i] * rVec[2];
+      }
     }
 
     else if (rVec.size() == 6) {
@@ -1426,6 +1565,8 @@ namespace Isis {
       stateTJ = StateTJ();
 
       // Now invert (inverse of a state matrix is NOT simply the transpose)
+      NaifLock lock;
+      NaifStatus::CheckErrors();
       xpose6_c(&stateTJ[0], (SpiceDouble( *) [6]) &stateTJ[0]);
       double stateJT[6][6];
       invstm_((doublereal *) &stateTJ[0], (doublereal *) stateJT);
@@ -1433,8 +1574,8 @@ namespace Isis {
       jVec.resize(6);
 
       mxvg_c(stateJT, (SpiceDouble *) &rVec[0], 6, 6, (SpiceDouble *) &jVec[0]);
+      NaifStatus::CheckErrors();
     }
-    NaifStatus::CheckErrors();
     return (jVec);
   }
 
@@ -1698,15 +1839,14 @@ namespace Isis {
    * @return @b vector<double> A direction vector in reference frame.
    */
   std::vector<double> SpiceRotation::ReferenceVector(const std::vector<double> &jVec) {
-    NaifStatus::CheckErrors();
-
     std::vector<double> rVec(3);
 
     if (jVec.size() == 3) {
-      double TJ[3][3];
-      mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], TJ);
-      rVec.resize(3);
-      mxv_c(TJ, (SpiceDouble *) &jVec[0], (SpiceDouble *) &rVec[0]);
+      double TJ[9];
+      multiply(&p_TC[0], &p_CJ[0], TJ);
+      for (int i = 0; i < 3; i++) {
+        rVec[i] = TJ[3*i] * jVec[0] + TJ[3*i + 1] * jVec[1] + TJ[3*i + 2] * jVec[2];
+      }
     }
     else if (jVec.size() == 6) {
       // See Naif routine frmchg for the format of the state matrix.  The constant rotation, TC,
@@ -1720,7 +1860,6 @@ namespace Isis {
       mxvg_c((SpiceDouble *) &stateTJ[0], (SpiceDouble *) &jVec[0], 6, 6, (SpiceDouble *) &rVec[0]);
     }
 
-    NaifStatus::CheckErrors();
     return (rVec);
   }
 
@@ -2863,11 +3002,9 @@ namespace Isis {
    * @return @b vector<double> Returned matrix.
    */
   std::vector<double> SpiceRotation::Matrix() {
-    NaifStatus::CheckErrors();
     std::vector<double> TJ;
     TJ.resize(9);
-    mxm_c((SpiceDouble *) &p_TC[0], (SpiceDouble *) &p_CJ[0], (SpiceDouble( *) [3]) &TJ[0]);
-    NaifStatus::CheckErrors();
+    multiply(&p_TC[0], &p_CJ[0], &TJ[0]);
     return TJ;
   }
 
@@ -2949,6 +3086,7 @@ namespace Isis {
    * @param et Ephemeris time.
    */
   void SpiceRotation::InitConstantRotation(double et) {
+    NaifLock lock;
     FrameTrace(et);
     // Get constant rotation which applies in all cases
     int targetFrame = p_constantFrames[0];
@@ -2980,8 +3118,6 @@ namespace Isis {
    *                                 polynomials"
    */
   void SpiceRotation::ComputeAv() {
-    NaifStatus::CheckErrors();
-
     // Make sure the angles have been fit to polynomials so we can calculate the derivative
     if (p_source < PolyFunction ) {
       QString msg = "The SpiceRotation pointing angles must be fit to polynomials in order to ";
@@ -3009,12 +3145,17 @@ namespace Isis {
       case NOTJ2000PCK:
         break;
       }
+    // omega = transpose(dCJdt) * CJ
     double omega[3][3];
-    mtxm_c((SpiceDouble( *)[3]) &dCJdt[0], (SpiceDouble( *)[3]) &p_CJ[0], omega);
+    for (int row = 0; row < 3; row++) {
+      for (int col = 0; col < 3; col++) {
+        omega[row][col] = dCJdt[row] * p_CJ[col] + dCJdt[3 + row] * p_CJ[3 + col] +
+                          dCJdt[6 + row] * p_CJ[6 + col];
+      }
+    }
     p_av[0] = omega[2][1];
     p_av[1] = omega[0][2];
     p_av[2] = omega[1][0];
-    NaifStatus::CheckErrors();
   }
 
 
@@ -3025,21 +3166,18 @@ namespace Isis {
    * @param[out]  dCJ       Derivative of p_CJ
    */
   void SpiceRotation::DCJdt(std::vector<double> &dCJ) {
-    NaifStatus::CheckErrors();
-
     // Get the rotation angles and axes
     std::vector<double> angles = Angles(p_axis3, p_axis2, p_axis1);
     int axes[3] = {p_axis1, p_axis2, p_axis3};
 
-    double dmatrix[3][3];
+    double dmatrix[9];
     double dangle;
-    double wmatrix[3][3]; // work matrix
+    double wmatrix[9]; // work matrix
+    double rotation[9];
     dCJ.assign(9, 0.);
 
     for (int angleIndex = 0; angleIndex < 3; angleIndex++) {
-      drotat_(&(angles[angleIndex]), (integer *) axes + angleIndex, (doublereal *) dmatrix);
-      // Transpose to obtain row-major order
-      xpose_c(dmatrix, dmatrix);
+      axisRotation(angles[angleIndex], axes[angleIndex], dmatrix, true);
 
       // To get the derivative of the polynomial fit to the angle with respect to time
       // first create the function object for this angle and load its coefficients
@@ -3051,37 +3189,34 @@ namespace Isis {
       dangle = function.DerivativeVar((p_et - p_baseTime) / p_timeScale) / p_timeScale;
 
       // Multiply dangle to complete dmatrix
-      for (int row = 0;  row < 3;  row++) {
-        for (int col = 0;  col < 3;  col++) {
-          dmatrix[row][col] *= dangle;
-        }
+      for (int index = 0; index < 9; index++) {
+        dmatrix[index] *= dangle;
       }
       // Apply the other 2 angles and chain them all together
       switch (angleIndex) {
         case 0:
-          rotmat_c(dmatrix, angles[1], axes[1], dmatrix);
-          rotmat_c(dmatrix, angles[2], axes[2], dmatrix);
+          axisRotation(angles[1], axes[1], rotation);
+          multiply(rotation, dmatrix, dmatrix);
+          axisRotation(angles[2], axes[2], rotation);
+          multiply(rotation, dmatrix, dmatrix);
           break;
         case 1:
-          rotate_c(angles[0], axes[0], wmatrix);
-          mxm_c(dmatrix, wmatrix, dmatrix);
-          rotmat_c(dmatrix, angles[2], axes[2], dmatrix);
+          axisRotation(angles[0], axes[0], wmatrix);
+          multiply(dmatrix, wmatrix, dmatrix);
+          axisRotation(angles[2], axes[2], rotation);
+          multiply(rotation, dmatrix, dmatrix);
           break;
         case 2:
-          rotate_c(angles[0], axes[0], wmatrix);
-          rotmat_c(wmatrix, angles[1], axes[1], wmatrix);
-          mxm_c(dmatrix, wmatrix, dmatrix);
+          axisRotation(angles[0], axes[0], wmatrix);
+          axisRotation(angles[1], axes[1], rotation);
+          multiply(rotation, wmatrix, wmatrix);
+          multiply(dmatrix, wmatrix, dmatrix);
           break;
       }
-      int i, j;
       for (int index = 0; index < 9; index++) {
-        i = index / 3;
-        j = index % 3;
-        dCJ[index] += dmatrix[i][j];
+        dCJ[index] += dmatrix[index];
       }
     }
-
-    NaifStatus::CheckErrors();
   }
 
 
@@ -3267,7 +3402,6 @@ namespace Isis {
    */
   void SpiceRotation::setEphemerisTimeMemcache() {
    // If the cache has only one rotation, set it
-    NaifStatus::CheckErrors();
     if (p_cacheTime.size() == 1) {
       p_CJ = m_orientation->getRotations()[0].toRotationMatrix();
       if (p_hasAngularVelocity) {
@@ -3288,7 +3422,6 @@ namespace Isis {
         p_av[2] = av.z;
       }
     }
-    NaifStatus::CheckErrors();
   }
 
 
@@ -3304,6 +3437,7 @@ namespace Isis {
    //      spkez call.
 
    // Make sure the constant frame is loaded.  This method also does the frame trace.
+   NaifLock lock;
    NaifStatus::CheckErrors();
     if (p_timeFrames.size() == 0) InitConstantRotation(p_et);
 
@@ -3337,6 +3471,7 @@ namespace Isis {
    * @see SpiceRotation::SetEphemerisTime
    */
   void SpiceRotation::setEphemerisTimeSpice() {
+   NaifLock lock;
    NaifStatus::CheckErrors();
    SpiceInt j2000 = J2000Code;
 
@@ -3413,11 +3548,11 @@ namespace Isis {
    angles.push_back(function3.Evaluate(rtime));
 
    // Get the first angle back into the range Naif expects [-180.,180.]
-   if (angles[0] <= -1 * pi_c()) {
-     angles[0] += twopi_c();
+   if (angles[0] <= -1 * PI) {
+     angles[0] += TWOPI;
    }
-   else if (angles[0] > pi_c()) {
-     angles[0] -= twopi_c();
+   else if (angles[0] > PI) {
+     angles[0] -= TWOPI;
    }
    return angles;
   }
@@ -3430,7 +3565,6 @@ namespace Isis {
    * @see SpiceRotatation::SetEphemerisTime
    */
   void SpiceRotation::setEphemerisTimePolyFunction() {
-   NaifStatus::CheckErrors();
    Isis::PolynomialUnivariate function1(p_degree);
    Isis::PolynomialUnivariate function2(p_degree);
    Isis::PolynomialUnivariate function3(p_degree);
@@ -3447,16 +3581,14 @@ namespace Isis {
    double angle3 = function3.Evaluate(rtime);
 
    // Get the first angle back into the range Naif expects [-180.,180.]
-   if (angle1 < -1 * pi_c()) {
-     angle1 += twopi_c();
+   if (angle1 < -1 * PI) {
+     angle1 += TWOPI;
    }
-   else if (angle1 > pi_c()) {
-     angle1 -= twopi_c();
+   else if (angle1 > PI) {
+     angle1 -= TWOPI;
    }
 
-   eul2m_c((SpiceDouble) angle3, (SpiceDouble) angle2, (SpiceDouble) angle1,
-           p_axis3,              p_axis2,              p_axis1,
-           (SpiceDouble( *)[3]) &p_CJ[0]);
+   eulerToMatrix(angle3, angle2, angle1, p_axis3, p_axis2, p_axis1, &p_CJ[0]);
 
    if (p_hasAngularVelocity) {
      if ( p_degree == 0){
@@ -3469,7 +3601,6 @@ namespace Isis {
        ComputeAv();
      }
    }
-   NaifStatus::CheckErrors();
   }
 
 
@@ -3481,7 +3612,6 @@ namespace Isis {
    */
   void SpiceRotation::setEphemerisTimePolyFunctionOverSpice() {
     setEphemerisTimeMemcache();
-    NaifStatus::CheckErrors();
     std::vector<double> cacheAngles(3);
     std::vector<double> cacheVelocity(3);
     cacheAngles = Angles(p_axis3, p_axis2, p_axis1);
@@ -3500,23 +3630,21 @@ namespace Isis {
       p_av[index] += cacheVelocity[index];
     }
 
-   if (angles[0] <= -1 * pi_c()) {
-     angles[0] += twopi_c();
+   if (angles[0] <= -1 * PI) {
+     angles[0] += TWOPI;
    }
-   else if (angles[0] > pi_c()) {
-     angles[0] -= twopi_c();
+   else if (angles[0] > PI) {
+     angles[0] -= TWOPI;
    }
 
-   if (angles[2] <= -1 * pi_c()) {
-     angles[2] += twopi_c();
+   if (angles[2] <= -1 * PI) {
+     angles[2] += TWOPI;
    }
-   else if (angles[2] > pi_c()) {
-     angles[2] -= twopi_c();
+   else if (angles[2] > PI) {
+     angles[2] -= TWOPI;
    }
 
-   eul2m_c((SpiceDouble) angles[2], (SpiceDouble) angles[1], (SpiceDouble) angles[0],
-           p_axis3,                 p_axis2,                 p_axis1,
-           (SpiceDouble( *)[3]) &p_CJ[0]);
+   eulerToMatrix(angles[2], angles[1], angles[0], p_axis3, p_axis2, p_axis1, &p_CJ[0]);
   }
 
 
@@ -3590,6 +3718,7 @@ namespace Isis {
     SpiceDouble BJs[6][6];
     vpack_c(w, delta, phi, angsDangs);
     vpack_c(dw, ddelta, dphi, &angsDangs[3]);
+    NaifLock lock;
     eul2xf_c (angsDangs, p_axis3, p_axis2, p_axis1, BJs);
 
     // Decompose the state matrix to the rotation and its angular velocity
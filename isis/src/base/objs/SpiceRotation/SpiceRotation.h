@@ -349,6 +349,12 @@ namespace Isis {
       std::vector<double> Angles(int axis3, int axis2, int axis1);
       void SetAngles(std::vector<double> angles, int axis3, int axis2, int axis1);
 
+      // Native Euler angle conversions, equivalent to eul2m_c and m2eul_c
+      static void eulerToMatrix(double angle3, double angle2, double angle1,
+                                int axis3, int axis2, int axis1, double matrix[9]);
+      static void matrixToEuler(const double matrix[9], int axis3, int axis2, int axis1,
+                                double &angle3, double &angle2, double &angle1);
+
       bool IsCached() const;
 
       void SetPolynomial(const Source type=PolyFunction);
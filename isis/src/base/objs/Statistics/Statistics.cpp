@@ -252,6 +252,41 @@ namespace Isis {
   }
 
 
+  /**
+   * Add the accumulators and counters of another Statistics object, for
+   * example one filled on another thread, to this one. The result is the same
+   * as if the other object's data had been added to this one.
+   *
+   * @param other The statistics to add to these
+   *
+   * @throws IException::Programmer The valid ranges of the objects differ
+   */
+  void Statistics::Merge(const Statistics &other) {
+    if (other.m_validMinimum != m_validMinimum || other.m_validMaximum != m_validMaximum) {
+      QString msg = "Cannot merge statistics with a valid range of [" +
+                    toString(other.m_validMinimum) + ", " + toString(other.m_validMaximum) +
+                    "] into statistics with a valid range of [" + toString(m_validMinimum) +
+                    ", " + toString(m_validMaximum) + "]";
+      throw IException(IException::Programmer, msg, _FILEINFO_);
+    }
+
+    m_sum += other.m_sum;
+    m_sumsum += other.m_sumsum;
+    if (other.m_minimum < m_minimum) m_minimum = other.m_minimum;
+    if (other.m_maximum > m_maximum) m_maximum = other.m_maximum;
+    m_totalPixels += other.m_totalPixels;
+    m_validPixels += other.m_validPixels;
+    m_nullPixels += other.m_nullPixels;
+    m_lisPixels += other.m_lisPixels;
+    m_lrsPixels += other.m_lrsPixels;
+    m_hrsPixels += other.m_hrsPixels;
+    m_hisPixels += other.m_hisPixels;
+    m_overRangePixels += other.m_overRangePixels;
+    m_underRangePixels += other.m_underRangePixels;
+    m_removedData = m_removedData || other.m_removedData;
+  }
+
+
   void Statistics::SetValidRange(const double minimum, const double maximum) {
     m_validMinimum = minimum;
     m_validMaximum = maximum;
@@ -6,7 +6,10 @@ find files of those names at the top level of this repository. **/
 /* SPDX-License-Identifier: CC0-1.0 */
 #include "StreamExporter.h"
 
+#include <algorithm>
+
 #include "Buffer.h"
+#include "Constants.h"
 #include "ExportDescription.h"
 #include "ProcessExport.h"
 
@@ -77,6 +80,77 @@ namespace Isis {
   }
 
 
+  /**
+   * Export the input channels a strip of lines at a time.  The strips are
+   * stretched and clamped to output pixel values in parallel, then passed to
+   * writeStrip() in line order.
+   */
+  void StreamExporter::exportChannels() {
+    int stripHeight = stripLines();
+    int channels = bands();
+    int width = samples();
+
+    // Output values of each strip in the current batch, indexed by strip
+    vector< vector<int> > strips((lines() + stripHeight - 1) / stripHeight);
+
+    process().ProcessCubeStrips(
+        [&](int firstLine, int lineCount, vector<Buffer *> &in) {
+          vector<int> &dns = strips[(firstLine - 1) / stripHeight];
+          dns.resize(lineCount * width * channels);
+          for (int b = 0; b < channels; b++) {
+            const double *pixels = in[b]->DoubleBuffer();
+            for (int i = 0; i < lineCount * width; i++) {
+              dns[i * channels + b] = outputPixelValue(pixels[i]);
+            }
+          }
+        },
+        [&](int firstLine, int lineCount) {
+          vector<int> &dns = strips[(firstLine - 1) / stripHeight];
+          writeStrip(firstLine - 1, lineCount, dns);
+          vector<int>().swap(dns);
+        },
+        stripHeight);
+  }
+
+
+  /**
+   * Write a strip of output pixel values to the output image.  The default
+   * writes the strip a line at a time through setBuffer() and writeLine().
+   *
+   * @param firstLine The first line of the output image in the strip,
+   *                  starting at zero
+   * @param lineCount The number of lines in the strip
+   * @param dns The output values, interleaved by band for each sample of each
+   *            line
+   */
+  void StreamExporter::writeStrip(int firstLine, int lineCount, const vector<int> &dns) const {
+    int index = 0;
+    for (int l = 0; l < lineCount; l++) {
+      for (int s = 0; s < samples(); s++) {
+        for (int b = 0; b < bands(); b++) {
+          setBuffer(s, b, dns[index++]);
+        }
+      }
+      writeLine(firstLine + l);
+    }
+  }
+
+
+  /**
+   * The number of lines processed together by exportChannels().  Strips are
+   * sized to hold about 4 MB of input data so memory use does not depend on
+   * the size of the image.
+   *
+   * @return The number of lines in each strip
+   */
+  int StreamExporter::stripLines() const {
+    BigInt bytesPerLine = (BigInt) samples() * bands() * sizeof(double);
+    BigInt stripBytes = 4 * 1024 * 1024;
+    BigInt stripLines = std::max((BigInt) 1, stripBytes / std::max((BigInt) 1, bytesPerLine));
+    return (int) std::min(stripLines, (BigInt) std::max(1, lines()));
+  }
+
+
   /**
    * Write a line of grayscale data to the output image.
    *
@@ -19,6 +19,11 @@ namespace Isis {
    * as opposed to keeping the export data all in memory.  In this way, they can
    * be run on arbitrarily large images.
    *
+   * When written with write(), the input channels are stretched and converted
+   * to output pixel values in strips of lines on multiple threads, and the
+   * strips are handed to writeStrip() in order.  Only a few strips are held in
+   * memory at once, regardless of the image size.
+   *
    * @ingroup HighLevelCubeIO
    *
    * @author 2012-04-03 Travis Addair
@@ -43,6 +48,10 @@ namespace Isis {
     protected:
       virtual void initialize(ExportDescription &desc);
 
+      virtual void exportChannels();
+      virtual void writeStrip(int firstLine, int lineCount, const vector<int> &dns) const;
+      int stripLines() const;
+
       virtual void writeGrayscale(vector<Buffer *> &in) const;
       virtual void writeRgb(vector<Buffer *> &in) const;
       virtual void writeRgba(vector<Buffer *> &in) const;
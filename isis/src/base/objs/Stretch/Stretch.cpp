@@ -4,6 +4,8 @@ For more details about the LICENSE terms and the AUTHORS, you will
 find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 
 #include <QDebug>
@@ -31,6 +33,7 @@ namespace Isis {
     p_minimum = p_lrs;
     p_maximum = p_hrs;
     p_pairs = 0;
+    ClearLookup();
   }
 
 
@@ -56,6 +59,7 @@ namespace Isis {
     p_input.push_back(input);
     p_output.push_back(output);
     p_pairs++;
+    ClearLookup();
   }
 
   /**
@@ -130,6 +134,157 @@ namespace Isis {
     return slope * (value - p_input[end]) + p_output[end];
   }
 
+  /**
+   * Maps an array of values, using the compiled lookup table when there is
+   * one. Values the table does not cover, including special pixels, are
+   * mapped with Map(double), so the results only differ from it by the
+   * interpolation error of a quantized table. The input and output may be the
+   * same array.
+   *
+   * @param input The values to map
+   * @param output The mapped values
+   * @param count The number of values
+   */
+  void Stretch::Map(const double *input, double *output, int count) const {
+    if (p_lookup.empty()) {
+      for (int i = 0; i < count; i++) {
+        output[i] = Map(input[i]);
+      }
+    }
+    else if (p_lookupQuantized) {
+      int lastNode = (int) p_lookup.size() - 2;
+      for (int i = 0; i < count; i++) {
+        double value = input[i];
+        if (value >= p_lookupMinimum && value <= p_lookupMaximum) {
+          double position = (value - p_lookupBase) / p_lookupStep;
+          int node = std::min((int) position, lastNode);
+          output[i] = p_lookup[node] + (position - node) * (p_lookup[node + 1] - p_lookup[node]);
+        }
+        else {
+          output[i] = Map(value);
+        }
+      }
+    }
+    else {
+      int lastRaw = p_lookupFirst + (int) p_lookup.size() - 1;
+      for (int i = 0; i < count; i++) {
+        double value = input[i];
+        if (value >= p_lookupMinimum && value <= p_lookupMaximum) {
+          int raw = (int) std::floor((value - p_lookupBase) / p_lookupStep + 0.5);
+          raw = std::max(p_lookupFirst, std::min(raw, lastRaw));
+          // Only values a cube of this type can hold are in the table
+          if ((double) raw * p_lookupStep + p_lookupBase == value) {
+            output[i] = p_lookup[raw - p_lookupFirst];
+            continue;
+          }
+        }
+        output[i] = Map(value);
+      }
+    }
+  }
+
+
+  /**
+   * Compiles the stretch into an exact lookup table with an entry for every
+   * raw value of an integer pixel type. The entries are the mapped cube
+   * values, raw * multiplier + base, so the table gives the same results as
+   * Map(double) for the data of a cube with that pixel type, base and
+   * multiplier. Special pixels are still mapped to their special pixel
+   * mappings. Real and double pixel types do not get a table.
+   *
+   * @param type The pixel type of the cube
+   * @param base The base of the cube
+   * @param multiplier The multiplier of the cube
+   */
+  void Stretch::CompileLookup(PixelType type, double base, double multiplier) {
+    ClearLookup();
+
+    int first;
+    int last;
+    if (type == UnsignedByte) {
+      first = 0;
+      last = 255;
+    }
+    else if (type == SignedWord) {
+      first = -32768;
+      last = 32767;
+    }
+    else if (type == UnsignedWord) {
+      first = 0;
+      last = 65535;
+    }
+    else {
+      return;
+    }
+
+    if (multiplier == 0.0) return;
+
+    p_lookup.resize(last - first + 1);
+    for (int raw = first; raw <= last; raw++) {
+      p_lookup[raw - first] = Map((double) raw * multiplier + base);
+    }
+
+    p_lookupFirst = first;
+    p_lookupBase = base;
+    p_lookupStep = multiplier;
+    p_lookupMinimum = std::min((double) first * multiplier + base, (double) last * multiplier + base);
+    p_lookupMaximum = std::max((double) first * multiplier + base, (double) last * multiplier + base);
+  }
+
+
+  /**
+   * Compiles the stretch into a lookup table of evenly spaced nodes between
+   * the minimum and maximum, limited to the range of the stretch pairs.
+   * Values between nodes are linearly interpolated, so the results can differ
+   * slightly from Map(double) wherever a stretch pair falls between two nodes.
+   * Use this only where that approximation is acceptable, such as when
+   * displaying real valued cubes. Values outside the range and special pixels
+   * are mapped exactly. Nothing is compiled if there are no pairs.
+   *
+   * @param minimum The smallest value to put in the table
+   * @param maximum The largest value to put in the table
+   * @param nodes The number of nodes in the table
+   */
+  void Stretch::CompileQuantizedLookup(double minimum, double maximum, int nodes) {
+    ClearLookup();
+    if (p_pairs == 0 || nodes < 2) return;
+
+    minimum = std::max(minimum, p_input[0]);
+    maximum = std::min(maximum, p_input[p_pairs - 1]);
+    if (!(minimum < maximum)) return;
+
+    double step = (maximum - minimum) / (nodes - 1);
+    std::vector<double> lookup(nodes);
+    for (int i = 0; i < nodes; i++) {
+      lookup[i] = Map((i == nodes - 1) ? maximum : minimum + i * step);
+      // Interpolating to or from a special pixel has no meaning
+      if (IsSpecial(lookup[i])) return;
+    }
+
+    p_lookup.swap(lookup);
+    p_lookupQuantized = true;
+    p_lookupBase = minimum;
+    p_lookupStep = step;
+    p_lookupMinimum = minimum;
+    p_lookupMaximum = maximum;
+  }
+
+
+  /**
+   * Discards the compiled lookup table. Every change to the stretch does this,
+   * since the table would no longer match it.
+   */
+  void Stretch::ClearLookup() {
+    p_lookup.clear();
+    p_lookupQuantized = false;
+    p_lookupFirst = 0;
+    p_lookupBase = 0.0;
+    p_lookupStep = 1.0;
+    p_lookupMinimum = 0.0;
+    p_lookupMaximum = -1.0;
+  }
+
+
   /**
   * Given a string containing stretch pairs for example "0:0 50:0 100:255 255:255"
   * evaluate the first pair and return a pair of doubles where first is the first
@@ -183,6 +338,7 @@ namespace Isis {
     p_input.clear();
     p_output.clear();
     p_pairs = 0;
+    ClearLookup();
 
     std::pair<double, double> pear;
 
@@ -220,6 +376,7 @@ namespace Isis {
     p_input.clear();
     p_output.clear();
     p_pairs = 0;
+    ClearLookup();
 
     QString p(pairs);
     std::pair<double, double> pear;
@@ -393,5 +550,6 @@ namespace Isis {
     this->p_pairs = other.p_pairs;
     this->p_input = other.p_input;
     this->p_output = other.p_output;
+    ClearLookup();
   }
 } // end namespace isis
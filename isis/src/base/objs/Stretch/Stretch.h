@@ -11,6 +11,7 @@ find files of those names at the top level of this repository. **/
 #include "Pvl.h"
 #include "ImageHistogram.h"
 #include "Histogram.h"
+#include "PixelType.h"
 
 namespace Isis {
   /**
@@ -27,6 +28,12 @@ namespace Isis {
    * unless overridden with methods such as SetNull. Input values outside the
    * minimum and maximum input pair values are mapped to LRS and HRS respectively.
    *
+   * When many pixels are mapped through the same stretch, the stretch can be
+   * compiled into a lookup table with CompileLookup (exact, for cubes stored
+   * as bytes or words) or CompileQuantizedLookup (interpolated, for real
+   * cubes where a small error is acceptable) and applied to whole buffers
+   * with the array version of Map. Changing the stretch discards the table.
+   *
    * If you would like to see Stretch being used in implementation,
    * see stretch.cpp
    *
@@ -74,6 +81,14 @@ namespace Isis {
       double p_minimum; //!<By default this value is set to p_lrs
       double p_maximum; //!<By default this value is set to p_hrs
 
+      std::vector<double> p_lookup; //!< Compiled outputs, empty when not compiled
+      bool p_lookupQuantized;  //!< True if p_lookup interpolates between nodes
+      int p_lookupFirst;       //!< Raw value of the first integer lookup entry
+      double p_lookupBase;     //!< Value of raw zero for the lookup, or the first node
+      double p_lookupStep;     //!< Value step between lookup entries
+      double p_lookupMinimum;  //!< Smallest value covered by the lookup
+      double p_lookupMaximum;  //!< Largest value covered by the lookup
+
       std::pair<double, double> NextPair(QString &pairs);
 
     public:
@@ -93,6 +108,7 @@ namespace Isis {
        */
       void SetNull(const double value) {
         p_null = value;
+        ClearLookup();
       }
 
       /**
@@ -104,6 +120,7 @@ namespace Isis {
        */
       void SetLis(const double value) {
         p_lis = value;
+        ClearLookup();
       }
 
       /**
@@ -115,6 +132,7 @@ namespace Isis {
        */
       void SetLrs(const double value) {
         p_lrs = value;
+        ClearLookup();
       }
 
       /**
@@ -126,6 +144,7 @@ namespace Isis {
        */
       void SetHis(const double value) {
         p_his = value;
+        ClearLookup();
       }
 
       /**
@@ -137,13 +156,16 @@ namespace Isis {
        */
       void SetHrs(const double value) {
         p_hrs = value;
+        ClearLookup();
       }
 
       void SetMinimum(const double value) {
         p_minimum = value;
+        ClearLookup();
       }
       void SetMaximum(const double value) {
         p_maximum = value;
+        ClearLookup();
       }
 
       void Load(Pvl &pvl, QString &grpName);
@@ -152,6 +174,16 @@ namespace Isis {
       void Save(QString &file, QString &grpName);
 
       double Map(const double value) const;
+      void Map(const double *input, double *output, int count) const;
+
+      void CompileLookup(PixelType type, double base = 0.0, double multiplier = 1.0);
+      void CompileQuantizedLookup(double minimum, double maximum, int nodes = 65536);
+      void ClearLookup();
+
+      //! Returns true if the stretch has been compiled into a lookup table
+      bool HasLookup() const {
+        return !p_lookup.empty();
+      }
 
       void Parse(const QString &pairs);
       void Parse(const QString &pairs, const Isis::Histogram *hist);
@@ -171,6 +203,7 @@ namespace Isis {
         p_pairs = 0;
         p_input.clear();
         p_output.clear();
+        ClearLookup();
       };
 
       void CopyPairs(const Stretch &other);
@@ -453,6 +453,7 @@ namespace Isis {
     // Load the most recent target attitude and shape kernel for NAIF
     static bool pckLoaded = false;
 
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     FileName kern("$base/kernels/pck/pck?????.tpc");
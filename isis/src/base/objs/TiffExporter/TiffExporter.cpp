@@ -8,6 +8,8 @@ find files of those names at the top level of this repository. **/
 
 #include <QDebug>
 
+#include <vector>
+
 #include "Buffer.h"
 #include "FileName.h"
 #include "IException.h"
@@ -85,7 +87,7 @@ namespace Isis {
 
     TIFFSetField(m_image, TIFFTAG_IMAGEWIDTH, samples());
     TIFFSetField(m_image, TIFFTAG_IMAGELENGTH, lines());
-    TIFFSetField(m_image, TIFFTAG_ROWSPERSTRIP, 1);
+    TIFFSetField(m_image, TIFFTAG_ROWSPERSTRIP, stripLines());
     if (compression == "packbits") {
       TIFFSetField(m_image, TIFFTAG_COMPRESSION, COMPRESSION_PACKBITS);
     }
@@ -159,6 +161,52 @@ namespace Isis {
   }
 
 
+  /**
+   * Writes a strip of output values to the output image on disk as a single
+   * TIFF strip.
+   *
+   * @param firstLine The first line of the strip, starting at zero
+   * @param lineCount The number of lines in the strip
+   * @param dns The output values, interleaved by band for each sample
+   */
+  void TiffExporter::writeStrip(int firstLine, int lineCount, const vector<int> &dns) const {
+    PixelType type = pixelType();
+    int size = dns.size();
+    std::vector<unsigned char> strip;
+
+    switch (type) {
+      case UnsignedByte:
+        strip.resize(size);
+        for (int i = 0; i < size; i++) {
+          strip[i] = (unsigned char) dns[i];
+        }
+        break;
+      case SignedWord:
+        strip.resize(size * sizeof(short int));
+        for (int i = 0; i < size; i++) {
+          ((short int *) strip.data())[i] = (short int) dns[i];
+        }
+        break;
+      case UnsignedWord:
+        strip.resize(size * sizeof(short unsigned int));
+        for (int i = 0; i < size; i++) {
+          ((short unsigned int *) strip.data())[i] = (short unsigned int) dns[i];
+        }
+        break;
+      default:
+        throw IException(IException::Programmer,
+            "Invalid pixel type for data [" + toString(type) + "]",
+            _FILEINFO_);
+    }
+
+    if (TIFFWriteEncodedStrip(m_image, TIFFComputeStrip(m_image, firstLine, 0),
+                              strip.data(), strip.size()) < 0) {
+      throw IException(IException::Programmer,
+          "Could not write image", _FILEINFO_);
+    }
+  }
+
+
   /**
    * Returns true if the format is "tiff".
    *
@@ -18,7 +18,8 @@ namespace Isis {
    *
    * A streamed exporter for TIFF images.  Can write an arbitrarily large set of
    * single-band Isis cubes to an arbitrarily large TIFF image with the given
-   * pixel type.
+   * pixel type.  The TIFF strips match the strips processed by the
+   * StreamExporter, so each one is encoded and written in a single call.
    *
    * @ingroup HighLevelCubeIO
    *
@@ -53,6 +54,7 @@ namespace Isis {
 
       virtual void setBuffer(int s, int b, int dn) const;
       virtual void writeLine(int l) const;
+      virtual void writeStrip(int firstLine, int lineCount, const vector<int> &dns) const;
 
     private:
       //! Object responsible for writing data to the output image
@@ -169,7 +169,9 @@ namespace Isis {
       throw IException(IException::Unknown, msg, _FILEINFO_);
     }
 
-    const Pvl &transTable = TranslationTable();
+    // The const table keeps the compiled index of the translation table
+    const XmlToPvlTranslationManager &manager = *this;
+    const Pvl &transTable = manager.TranslationTable();
     PvlGroup transGroup;
     try {
       transGroup = transTable.findGroup(translationGroupName);
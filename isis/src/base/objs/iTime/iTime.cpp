@@ -22,7 +22,7 @@ using namespace std;
 namespace Isis {
 
   // Static initializations
-  bool iTime::p_lpInitialized = false;
+  std::atomic<bool> iTime::p_lpInitialized(false);
 
   //---------------------------------------------------------------------------
   // Constructors
@@ -42,6 +42,7 @@ namespace Isis {
   iTime::iTime(const QString &time) {
     LoadLeapSecondKernel();
 
+    NaifLock lock;
     NaifStatus::CheckErrors();
 
     // Convert the time string to a double ephemeris time
@@ -66,6 +67,7 @@ namespace Isis {
   void iTime::operator=(const QString &time) {
     LoadLeapSecondKernel();
 
+    NaifLock lock;
     NaifStatus::CheckErrors();
     // Convert the time string to a double ephemeris time
     SpiceDouble et;
@@ -79,6 +81,7 @@ namespace Isis {
   void iTime::operator=(const char *time) {
     LoadLeapSecondKernel();
 
+    NaifLock lock;
     NaifStatus::CheckErrors();
     // Convert the time string to a double ephemeris time
     SpiceDouble et;
@@ -227,6 +230,7 @@ namespace Isis {
    * @return int
    */
   int iTime::Year() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[5];
 
@@ -251,6 +255,7 @@ namespace Isis {
    * @return int
    */
   int iTime::Month() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[3];
 
@@ -275,6 +280,7 @@ namespace Isis {
    * @return int
    */
   int iTime::Day() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[3];
 
@@ -299,6 +305,7 @@ namespace Isis {
    * @return int
    */
   int iTime::Hour() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[3];
 
@@ -323,6 +330,7 @@ namespace Isis {
    * @return int
    */
   int iTime::Minute() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[3];
 
@@ -354,6 +362,7 @@ namespace Isis {
    * @return double
    */
   double iTime::Second() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[256];
 
@@ -378,6 +387,7 @@ namespace Isis {
    * @return int
    */
   int iTime::DayOfYear() const {
+    NaifLock lock;
     NaifStatus::CheckErrors();
     SpiceChar out[4];
 
@@ -453,6 +463,7 @@ namespace Isis {
       utcString = dateString + "T" + timeString;
     }
 
+    NaifLock lock;
     NaifStatus::CheckErrors();
     LoadLeapSecondKernel();
 
@@ -473,6 +484,9 @@ namespace Isis {
     // kernel is loaded only once and left open.
     if(p_lpInitialized) return;
 
+    NaifLock lock;
+    if(p_lpInitialized) return;
+
     // Get the leap second kernel file open
     Isis::PvlGroup &dataDir = Isis::Preference::Preferences().findGroup("DataDirectory");
     QString baseDir = dataDir["Base"];
@@ -7,6 +7,7 @@ find files of those names at the top level of this repository. **/
 
 /* SPDX-License-Identifier: CC0-1.0 */
 
+#include <atomic>
 #include <string>
 
 #include <SpiceUsr.h>
@@ -140,7 +141,7 @@ namespace Isis {
 
       void LoadLeapSecondKernel();
 
-      static bool p_lpInitialized;
+      static std::atomic<bool> p_lpInitialized;
   };
 };
 
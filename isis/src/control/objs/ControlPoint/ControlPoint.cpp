@@ -1106,7 +1106,7 @@ namespace Isis {
 
         // Now map through the camera steps to take X from slant range to ground
         // range to pixels.  Y just tracks through as 0.
-        if (cam->DistortionMap()->SetUndistortedFocalPlane(computedX,
+        if (cam->DistortionMap()->SetUndistortedFocalPlaneFromGrid(computedX,
                                                            computedY)){
           double focalPlaneX = cam->DistortionMap()->FocalPlaneX();
           double focalPlaneY = cam->DistortionMap()->FocalPlaneY();
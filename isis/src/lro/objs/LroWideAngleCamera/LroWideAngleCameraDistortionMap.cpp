@@ -84,8 +84,14 @@ namespace Isis {
     }
 
     //  Install new parameters
+    bool changed = (p_odk != m_odkFilters[vband-1]);
     p_odk = m_odkFilters[vband-1];
 
+    // The inverse grid only holds for the band it was built for
+    if (changed) {
+      ClearInverseGrid();
+    }
+
     return;
 
   }
@@ -25,6 +25,7 @@ namespace Isis {
    *
    */
   MarciDistortionMap::MarciDistortionMap(Camera *parent, int naifIkCode) : CameraDistortionMap(parent) {
+    p_filter = -1;
     QString odkkey = "INS" + toString(naifIkCode) + "_DISTORTION_COEFFS";
 
     for(int i = 0; i < 4; i++) {
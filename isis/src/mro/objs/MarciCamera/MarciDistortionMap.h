@@ -43,6 +43,10 @@ namespace Isis {
       virtual bool SetUndistortedFocalPlane(const double ux, const double uy);
 
       void SetFilter(int filter) {
+        // The inverse grid only holds for the filter it was built for
+        if (filter != p_filter) {
+          ClearInverseGrid();
+        }
         p_filter = filter;
       }
 
@@ -17,6 +17,7 @@ namespace Isis {
    */
   ThemisIrDistortionMap::ThemisIrDistortionMap(Camera *parent) :
     CameraDistortionMap(parent, 1.0) {
+    p_k = 0.0;
     SetBand(1);
     p_alpha1 = 0.00447623;  // Currently not used
     p_alpha2 = 0.00107556;  // Disabled Y portion of optical distortion
@@ -31,6 +32,10 @@ namespace Isis {
                    0.991474, 0.990505, 0.989611, 0.988653, 0.9877
                  };
 
+    // The inverse grid only holds for the band it was built for
+    if (k[band-1] != p_k) {
+      ClearInverseGrid();
+    }
     p_k = k[band-1];
   }
 
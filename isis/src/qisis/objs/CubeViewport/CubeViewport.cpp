@@ -29,6 +29,7 @@ find files of those names at the top level of this repository. **/
 
 #include "Brick.h"
 #include "Camera.h"
+#include "Cube.h"
 #include "CubeDataThread.h"
 #include "IException.h"
 #include "IString.h"
@@ -49,6 +50,32 @@ find files of those names at the top level of this repository. **/
 using namespace std;
 
 
+namespace {
+  /**
+   * Compiles a display stretch into a lookup table when the area being
+   * painted has more pixels than the table has entries. Byte and word cubes
+   * get an exact table; real cubes get an interpolated one, which is close
+   * enough once the output is rounded to a screen intensity.
+   *
+   * @param stretch The stretch to compile
+   * @param cube The cube being displayed
+   * @param pixels The number of pixels that will be stretched
+   */
+  void compileDisplayStretch(Isis::Stretch &stretch, Isis::Cube *cube, int pixels) {
+    Isis::PixelType type = cube->pixelType();
+    if (type == Isis::UnsignedByte || type == Isis::SignedWord || type == Isis::UnsignedWord) {
+      int entries = (type == Isis::UnsignedByte) ? 256 : 65536;
+      if (pixels > entries) {
+        stretch.CompileLookup(type, cube->base(), cube->multiplier());
+      }
+    }
+    else if (pixels > 4096 && stretch.Pairs() > 0) {
+      stretch.CompileQuantizedLookup(stretch.Input(0), stretch.Input(stretch.Pairs() - 1), 4096);
+    }
+  }
+}
+
+
 namespace Isis {
   /**
    * Construct a cube viewport
@@ -1165,6 +1192,19 @@ namespace Isis {
 
       dataArea = QRect(p_grayBuffer->bufferXYRect().intersected(rect));
 
+      // This is still RGB; the pairs are identical but the boundary
+      //   conditions are different. Display saturations cause this.
+      CubeStretch redStretch = p_red.getStretch();
+      CubeStretch greenStretch = p_green.getStretch();
+      CubeStretch blueStretch = p_blue.getStretch();
+      int pixels = dataArea.width() * dataArea.height();
+      compileDisplayStretch(redStretch, p_cube, pixels);
+      compileDisplayStretch(greenStretch, p_cube, pixels);
+      compileDisplayStretch(blueStretch, p_cube, pixels);
+      vector<double> redPixels(dataArea.width());
+      vector<double> greenPixels(dataArea.width());
+      vector<double> bluePixels(dataArea.width());
+
       for(int y = dataArea.top();
           !dataArea.isNull() && y <= dataArea.bottom();
           y++) {
@@ -1181,34 +1221,30 @@ namespace Isis {
 
         QRgb *rgb = (QRgb *) p_image->scanLine(y);
 
-        CubeStretch redStretch = p_red.getStretch();
-        CubeStretch greenStretch = p_green.getStretch();
-        CubeStretch blueStretch = p_blue.getStretch();
-
-        for(int x = dataArea.left(); x <= dataArea.right(); x++) {
-          int bufferLeft = p_grayBuffer->bufferXYRect().left();
-          int bufferX = x - bufferLeft;
-
-          if(bufferX >= (int)line.size()){
-            break;
-          }
+        int bufferLeft = p_grayBuffer->bufferXYRect().left();
+        int firstBufferX = dataArea.left() - bufferLeft;
+        if(firstBufferX < 0) {
+          throw IException(IException::Programmer, "bufferX < 0", _FILEINFO_);
+        }
 
-          if(bufferX < 0) {
-            throw IException(IException::Programmer, "bufferX < 0", _FILEINFO_);
-          }
+        int count = min(dataArea.width(), (int)line.size() - firstBufferX);
+        if(count <= 0) {
+          continue;
+        }
 
-          if(x >= p_image->width()) {
-            throw IException(IException::Programmer, "x too big", _FILEINFO_);
-          }
+        if(dataArea.left() + count - 1 >= p_image->width()) {
+          throw IException(IException::Programmer, "x too big", _FILEINFO_);
+        }
 
-          double bufferVal = line.at(bufferX);
+        redStretch.Map(&line[firstBufferX], redPixels.data(), count);
+        greenStretch.Map(&line[firstBufferX], greenPixels.data(), count);
+        blueStretch.Map(&line[firstBufferX], bluePixels.data(), count);
 
-          // This is still RGB; the pairs are identical but the boundary
-          //   conditions are different. Display saturations cause this.
-          int redPix = (int)(redStretch.Map(bufferVal) + 0.5);
-          int greenPix = (int)(greenStretch.Map(bufferVal) + 0.5);
-          int bluePix = (int)(blueStretch.Map(bufferVal) + 0.5);
-          rgb[x] =  qRgb(redPix, greenPix, bluePix);
+        for(int i = 0; i < count; i++) {
+          int redPix = (int)(redPixels[i] + 0.5);
+          int greenPix = (int)(greenPixels[i] + 0.5);
+          int bluePix = (int)(bluePixels[i] + 0.5);
+          rgb[dataArea.left() + i] =  qRgb(redPix, greenPix, bluePix);
         }
       }
     }
@@ -1240,6 +1276,17 @@ namespace Isis {
 
         dataArea = QRect(p_redBuffer->bufferXYRect().intersected(rect));
 
+        CubeStretch redStretch = p_red.getStretch();
+        CubeStretch greenStretch = p_green.getStretch();
+        CubeStretch blueStretch = p_blue.getStretch();
+        int pixels = dataArea.width() * dataArea.height();
+        compileDisplayStretch(redStretch, p_cube, pixels);
+        compileDisplayStretch(greenStretch, p_cube, pixels);
+        compileDisplayStretch(blueStretch, p_cube, pixels);
+        vector<double> redPixels(dataArea.width());
+        vector<double> greenPixels(dataArea.width());
+        vector<double> bluePixels(dataArea.width());
+
         for(int y = dataArea.top();
             !dataArea.isNull() && y <= dataArea.bottom();
             y++) {
@@ -1259,16 +1306,19 @@ namespace Isis {
 
           QRgb *rgb = (QRgb *) p_image->scanLine(y);
 
-          CubeStretch redStretch = p_red.getStretch();
-          CubeStretch greenStretch = p_green.getStretch();
-          CubeStretch blueStretch = p_blue.getStretch();
+          redStretch.Map(&redLine[dataArea.left() - p_redBuffer->bufferXYRect().left()],
+                         redPixels.data(), dataArea.width());
+          greenStretch.Map(&greenLine[dataArea.left() - p_greenBuffer->bufferXYRect().left()],
+                           greenPixels.data(), dataArea.width());
+          blueStretch.Map(&blueLine[dataArea.left() - p_blueBuffer->bufferXYRect().left()],
+                          bluePixels.data(), dataArea.width());
 
-          for(int x = dataArea.left(); x <= dataArea.right(); x++) {
-            int redPix = (int)(redStretch.Map(redLine[ x - p_redBuffer->bufferXYRect().left()]) + 0.5);
-            int greenPix = (int)(greenStretch.Map(greenLine[ x - p_greenBuffer->bufferXYRect().left()]) + 0.5);
-            int bluePix = (int)(blueStretch.Map(blueLine[ x - p_blueBuffer->bufferXYRect().left()]) + 0.5);
+          for(int i = 0; i < dataArea.width(); i++) {
+            int redPix = (int)(redPixels[i] + 0.5);
+            int greenPix = (int)(greenPixels[i] + 0.5);
+            int bluePix = (int)(bluePixels[i] + 0.5);
 
-            rgb[x] = qRgb(redPix, greenPix, bluePix);
+            rgb[dataArea.left() + i] = qRgb(redPix, greenPix, bluePix);
           }
         }
       }
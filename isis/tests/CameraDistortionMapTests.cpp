@@ -0,0 +1,79 @@
+#include "CameraDistortionMap.h"
+
+#include <cmath>
+
+#include "Camera.h"
+#include "Fixtures.h"
+#include "IException.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // The default polynomial distortion with strong coefficients
+  class PolynomialDistortionMap : public CameraDistortionMap {
+    public:
+      PolynomialDistortionMap(Camera *parent) : CameraDistortionMap(parent) {
+        p_odk.push_back(0.0);
+        p_odk.push_back(1.0e-4);
+        p_odk.push_back(2.0e-7);
+      }
+  };
+}
+
+
+TEST_F(DefaultCube, CameraDistortionMapInverseGrid) {
+  Camera *cam = testCube->camera();
+  CameraDistortionMap *map = new PolynomialDistortionMap(cam);
+  double tolerance = 1.0e-5;
+  ASSERT_TRUE(map->BuildInverseGrid(-6.0, 6.0, -5.0, 5.0, tolerance));
+  EXPECT_TRUE(map->HasInverseGrid());
+
+  for (double uy = -5.0; uy <= 5.0; uy += 0.37) {
+    for (double ux = -6.0; ux <= 6.0; ux += 0.41) {
+      ASSERT_TRUE(map->SetUndistortedFocalPlane(ux, uy));
+      double x = map->FocalPlaneX();
+      double y = map->FocalPlaneY();
+      ASSERT_TRUE(map->SetUndistortedFocalPlaneFromGrid(ux, uy));
+      EXPECT_NEAR(map->FocalPlaneX(), x, 2.0 * tolerance);
+      EXPECT_NEAR(map->FocalPlaneY(), y, 2.0 * tolerance);
+      EXPECT_EQ(map->UndistortedFocalPlaneX(), ux);
+      EXPECT_EQ(map->UndistortedFocalPlaneY(), uy);
+    }
+  }
+
+  // Outside of the grid the distortion model is used
+  map->SetUndistortedFocalPlane(7.0, 1.0);
+  double x = map->FocalPlaneX();
+  map->SetUndistortedFocalPlaneFromGrid(7.0, 1.0);
+  EXPECT_EQ(map->FocalPlaneX(), x);
+
+  map->ClearInverseGrid();
+  EXPECT_FALSE(map->HasInverseGrid());
+  map->SetUndistortedFocalPlane(3.0, 2.0);
+  x = map->FocalPlaneX();
+  map->SetUndistortedFocalPlaneFromGrid(3.0, 2.0);
+  EXPECT_EQ(map->FocalPlaneX(), x);
+
+  EXPECT_THROW(map->BuildInverseGrid(1.0, -1.0, -1.0, 1.0, tolerance), IException);
+  EXPECT_THROW(map->BuildInverseGrid(-1.0, 1.0, -1.0, 1.0, 0.0), IException);
+}
+
+
+TEST_F(DefaultCube, CameraDistortionMapCameraGrid) {
+  Camera *cam = testCube->camera();
+  new PolynomialDistortionMap(cam);
+  ASSERT_TRUE(cam->DistortionMap()->BuildInverseGrid());
+
+  for (double line = 1.0; line <= cam->Lines(); line += 97.0) {
+    for (double sample = 1.0; sample <= cam->Samples(); sample += 101.0) {
+      if (!cam->SetImage(sample, line)) continue;
+      double lat = cam->UniversalLatitude();
+      double lon = cam->UniversalLongitude();
+      ASSERT_TRUE(cam->SetUniversalGround(lat, lon));
+      EXPECT_NEAR(cam->Sample(), sample, 0.02);
+      EXPECT_NEAR(cam->Line(), line, 0.02);
+    }
+  }
+}
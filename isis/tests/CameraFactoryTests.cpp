@@ -0,0 +1,84 @@
+#include "CameraFactory.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTextStream>
+
+#include "Camera.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "Preference.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // Instrument label of a camera named by the test Camera.plugin
+  Pvl instrumentLabel(const QString &spacecraft, const QString &instrument) {
+    PvlGroup inst("Instrument");
+    inst += PvlKeyword("SpacecraftName", spacecraft);
+    inst += PvlKeyword("InstrumentId", instrument);
+    Pvl lab;
+    lab.addGroup(inst);
+    return lab;
+  }
+}
+
+
+// The camera plugins are read once per process from the Camera.plugin in the
+// working directory and then the system one, so these tests write their own
+// before anything creates a camera.
+TEST_F(TempTestingFiles, CameraFactoryPluginGroups) {
+  QFile pluginFile(tempDir.path() + "/Camera.plugin");
+  ASSERT_TRUE(pluginFile.open(QIODevice::WriteOnly | QIODevice::Text));
+  QTextStream plugin(&pluginFile);
+  plugin << "Group = TestCraft/TestCam\n"
+            "  Library = TestCam\n"
+            "  Routine = TestCamPlugin\n"
+            "  Version = 1\n"
+            "End_Group\n"
+            "Group = TestCraft/TestCam\n"
+            "  Library = TestCam\n"
+            "  Routine = TestCamPlugin\n"
+            "  Version = 2\n"
+            "End_Group\n";
+  pluginFile.close();
+
+  // A later group for the same camera is a newer version
+  Pvl lab = instrumentLabel("TestCraft", "TestCam");
+  QString workingDir = QDir::currentPath();
+  ASSERT_TRUE(QDir::setCurrent(tempDir.path()));
+  int version = CameraFactory::CameraVersion(lab);
+  QDir::setCurrent(workingDir);
+  EXPECT_EQ(version, 2);
+
+  // Names are matched regardless of spaces and underscores
+  Pvl spaced = instrumentLabel("Test Craft", "TEST_CAM");
+  EXPECT_EQ(CameraFactory::CameraVersion(spaced), 2);
+  Pvl underscored = instrumentLabel("TEST_CRAFT", "Test Cam");
+  EXPECT_EQ(CameraFactory::CameraVersion(underscored), 2);
+
+  Pvl unknown = instrumentLabel("TestCraft", "OtherCam");
+  EXPECT_THROW(CameraFactory::CameraVersion(unknown), IException);
+}
+
+
+TEST_F(DefaultCube, CameraFactoryCreateWithoutCsm) {
+  // Loading the CSM libraries needs the CSMDirectory preference, so a camera
+  // can only be created without it if the CSM libraries are left alone
+  PvlGroup &plugins = Preference::Preferences().findGroup("Plugins");
+  PvlKeyword csmDirectories = plugins["CSMDirectory"];
+  plugins.deleteKeyword("CSMDirectory");
+
+  ASSERT_FALSE(testCube->hasBlob("CSMState", "String"));
+  Camera *cam = NULL;
+  EXPECT_NO_THROW(cam = testCube->camera());
+  EXPECT_NE(cam, nullptr);
+  EXPECT_THROW(CameraFactory::initPlugin(), IException);
+
+  plugins += csmDirectories;
+}
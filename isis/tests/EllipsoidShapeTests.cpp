@@ -0,0 +1,110 @@
+#include "ShapeModel.h"
+
+#include <cmath>
+
+#include <SpiceUsr.h>
+
+#include "IException.h"
+#include "NaifStatus.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // A triaxial ellipsoid, observers at several distances and look directions
+  // towards points scattered around it so that some of the rays miss
+  const double a = 3396.19;
+  const double b = 3390.0;
+  const double c = 3376.2;
+
+  void ray(int i, double observer[3], double look[3]) {
+    double distances[] = {3000.0, 3380.0, 3400.0, 5000.0, 20000.0};
+    double distance = distances[i % 5];
+    double theta = 0.731 * i;
+    double phi = std::acos(std::cos(1.37 * i));
+    observer[0] = distance * std::sin(phi) * std::cos(theta);
+    observer[1] = distance * std::sin(phi) * std::sin(theta);
+    observer[2] = distance * std::cos(phi);
+
+    double target[3] = {3600.0 * std::sin(2.1 * i), 3600.0 * std::cos(1.9 * i),
+                        3600.0 * std::sin(0.7 * i + 1.0)};
+    look[0] = target[0] - observer[0];
+    look[1] = target[1] - observer[1];
+    look[2] = target[2] - observer[2];
+  }
+}
+
+
+TEST(EllipsoidShape, RayIntersectionMatchesNaif) {
+  int found = 0;
+  for (int i = 0; i < 5000; i++) {
+    double observer[3], look[3];
+    ray(i, observer, look);
+
+    SpiceDouble naifPoint[3];
+    SpiceBoolean naifFound;
+    surfpt_c(observer, look, a, b, c, naifPoint, &naifFound);
+    NaifStatus::CheckErrors();
+
+    double point[3];
+    bool intersected = ShapeModel::rayEllipsoidIntersection(observer, look, a, b, c, point);
+    ASSERT_EQ(intersected, (bool) naifFound) << "ray " << i;
+    if (intersected) {
+      found++;
+      EXPECT_NEAR(point[0], naifPoint[0], 1.0e-8) << "ray " << i;
+      EXPECT_NEAR(point[1], naifPoint[1], 1.0e-8) << "ray " << i;
+      EXPECT_NEAR(point[2], naifPoint[2], 1.0e-8) << "ray " << i;
+    }
+  }
+  // Both hits and misses were tested
+  EXPECT_GT(found, 0);
+  EXPECT_LT(found, 5000);
+}
+
+
+TEST(EllipsoidShape, NormalMatchesNaif) {
+  for (int i = 0; i < 1000; i++) {
+    double observer[3], look[3], point[3];
+    ray(i, observer, look);
+    if (!ShapeModel::rayEllipsoidIntersection(observer, look, a, b, c, point)) continue;
+
+    SpiceDouble naifNormal[3];
+    surfnm_c(a, b, c, point, naifNormal);
+    NaifStatus::CheckErrors();
+
+    double normal[3];
+    ShapeModel::ellipsoidNormal(point, a, b, c, normal);
+    EXPECT_NEAR(normal[0], naifNormal[0], 1.0e-14);
+    EXPECT_NEAR(normal[1], naifNormal[1], 1.0e-14);
+    EXPECT_NEAR(normal[2], naifNormal[2], 1.0e-14);
+  }
+}
+
+
+TEST(EllipsoidShape, RayIntersectionErrors) {
+  double observer[3] = {5000.0, 0.0, 0.0};
+  double look[3] = {-1.0, 0.0, 0.0};
+  double zero[3] = {0.0, 0.0, 0.0};
+  double point[3];
+
+  EXPECT_THROW(ShapeModel::rayEllipsoidIntersection(observer, zero, a, b, c, point),
+               IException);
+  EXPECT_THROW(ShapeModel::rayEllipsoidIntersection(observer, look, a, 0.0, c, point),
+               IException);
+  EXPECT_THROW(ShapeModel::ellipsoidNormal(observer, a, b, -c, point), IException);
+
+  // Straight down the x axis
+  ASSERT_TRUE(ShapeModel::rayEllipsoidIntersection(observer, look, a, b, c, point));
+  EXPECT_DOUBLE_EQ(point[0], a);
+  EXPECT_DOUBLE_EQ(point[1], 0.0);
+  EXPECT_DOUBLE_EQ(point[2], 0.0);
+
+  // Looking away
+  look[0] = 1.0;
+  EXPECT_FALSE(ShapeModel::rayEllipsoidIntersection(observer, look, a, b, c, point));
+
+  // From the center the ray leaves the ellipsoid
+  ASSERT_TRUE(ShapeModel::rayEllipsoidIntersection(zero, look, a, b, c, point));
+  EXPECT_DOUBLE_EQ(point[0], a);
+}
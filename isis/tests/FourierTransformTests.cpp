@@ -0,0 +1,132 @@
+#include "FourierTransform.h"
+#include "IException.h"
+
+#include <complex>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  vector< complex<double> > naiveDft(const vector< complex<double> > &input) {
+    int n = input.size();
+    vector< complex<double> > output(n);
+    for (int k = 0; k < n; k++) {
+      complex<double> sum = 0.0;
+      for (int j = 0; j < n; j++) {
+        sum += input[j] * polar(1.0, -2.0 * PI * ((j * k) % n) / n);
+      }
+      output[k] = sum;
+    }
+    return output;
+  }
+}
+
+class FourierTransformLength : public ::testing::TestWithParam<int> {};
+
+TEST_P(FourierTransformLength, MatchesDft) {
+  int n = GetParam();
+  vector< complex<double> > input(n);
+  for (int i = 0; i < n; i++) {
+    input[i] = complex<double>(sin(1.3 * i) + i % 7, cos(0.7 * i));
+  }
+
+  FourierTransform fft;
+  vector< complex<double> > expected = naiveDft(input);
+  vector< complex<double> > output(input);
+  fft.TransformInPlace(output);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(real(output[i]), real(expected[i]), 1e-9);
+    EXPECT_NEAR(imag(output[i]), imag(expected[i]), 1e-9);
+  }
+
+  fft.TransformInPlace(output, true);
+  for (int i = 0; i < n; i++) {
+    EXPECT_NEAR(real(output[i]), real(input[i]), 1e-12);
+    EXPECT_NEAR(imag(output[i]), imag(input[i]), 1e-12);
+  }
+
+  vector<double> realInput(n);
+  for (int i = 0; i < n; i++) {
+    realInput[i] = real(input[i]);
+  }
+  vector< complex<double> > realExpected = naiveDft(vector< complex<double> >(realInput.begin(),
+                                                                                realInput.end()));
+  vector< complex<double> > realOutput = fft.RealTransform(realInput);
+  ASSERT_EQ(realOutput.size(), (size_t) n / 2 + 1);
+  for (int k = 0; k <= n / 2; k++) {
+    EXPECT_NEAR(real(realOutput[k]), real(realExpected[k]), 1e-9);
+    EXPECT_NEAR(imag(realOutput[k]), imag(realExpected[k]), 1e-9);
+  }
+}
+
+// powers of two, 2/3/5 smooth, small primes and primes that use Bluestein's algorithm
+INSTANTIATE_TEST_SUITE_P(FourierTransform, FourierTransformLength,
+                         ::testing::Values(1, 2, 7, 12, 16, 30, 67, 100, 127, 243, 256, 1009));
+
+
+TEST(FourierTransform, Transform2D) {
+  int samples = 33;
+  int lines = 20;
+  vector<double> image(samples * lines);
+  for (unsigned int i = 0; i < image.size(); i++) {
+    image[i] = sin(0.37 * i) + i % 11;
+  }
+
+  // separable reference: transform the rows and then the columns
+  vector< complex<double> > expected(image.begin(), image.end());
+  for (int line = 0; line < lines; line++) {
+    vector< complex<double> > row(expected.begin() + line * samples,
+                                  expected.begin() + (line + 1) * samples);
+    row = naiveDft(row);
+    copy(row.begin(), row.end(), expected.begin() + line * samples);
+  }
+  for (int samp = 0; samp < samples; samp++) {
+    vector< complex<double> > column(lines);
+    for (int line = 0; line < lines; line++) {
+      column[line] = expected[line * samples + samp];
+    }
+    column = naiveDft(column);
+    for (int line = 0; line < lines; line++) {
+      expected[line * samples + samp] = column[line];
+    }
+  }
+
+  FourierTransform fft;
+  vector< complex<double> > complexOutput(image.begin(), image.end());
+  fft.Transform2D(complexOutput, samples, lines);
+  vector< complex<double> > realOutput = fft.RealTransform2D(image, samples, lines);
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(real(complexOutput[i]), real(expected[i]), 1e-9);
+    EXPECT_NEAR(imag(complexOutput[i]), imag(expected[i]), 1e-9);
+    EXPECT_NEAR(real(realOutput[i]), real(expected[i]), 1e-9);
+    EXPECT_NEAR(imag(realOutput[i]), imag(expected[i]), 1e-9);
+  }
+
+  fft.Transform2D(complexOutput, samples, lines, true);
+  for (unsigned int i = 0; i < image.size(); i++) {
+    EXPECT_NEAR(real(complexOutput[i]), image[i], 1e-12);
+    EXPECT_NEAR(imag(complexOutput[i]), 0.0, 1e-12);
+  }
+}
+
+
+TEST(FourierTransform, Transform2DBadDimensions) {
+  FourierTransform fft;
+  vector< complex<double> > data(10);
+  EXPECT_THROW(fft.Transform2D(data, 3, 4), IException);
+  EXPECT_THROW(fft.RealTransform2D(vector<double>(10), 5, 0), IException);
+}
+
+
+TEST(FourierTransform, FastSizes) {
+  FourierTransform fft;
+  EXPECT_TRUE(fft.IsFastSize(1));
+  EXPECT_TRUE(fft.IsFastSize(1000));
+  EXPECT_FALSE(fft.IsFastSize(7));
+  EXPECT_EQ(fft.NextFastSize(7), 8);
+  EXPECT_EQ(fft.NextFastSize(1001), 1024);
+  EXPECT_EQ(fft.NextFastSize(121), 125);
+}
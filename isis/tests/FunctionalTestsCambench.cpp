@@ -0,0 +1,97 @@
+#include <fstream>
+
+#include <QString>
+
+#include <nlohmann/json.hpp>
+
+#include "cambench.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "TestUtilities.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+using json = nlohmann::json;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/cambench.xml").expanded();
+
+namespace {
+  json readReport(QString fileName) {
+    std::ifstream input(fileName.toStdString());
+    return json::parse(input);
+  }
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCambenchReport) {
+  QString toName = tempDir.path() + "/report.json";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + toName,
+                           "SAMPLES=5", "LINES=4", "TOLERANCE=0.5"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+
+  cambench(options, &appLog);
+
+  json report = readReport(toName);
+  ASSERT_EQ(report["cameras"].size(), 1);
+  json camera = report["cameras"][0];
+  EXPECT_EQ(camera["instrument"], testCube->camera()->instrumentId().toStdString());
+  EXPECT_EQ(camera["cameraType"], "Framing");
+
+  EXPECT_EQ(camera["original"]["setImage"]["calls"], 20);
+  EXPECT_EQ(camera["original"]["setImage"]["succeeded"], 20);
+  EXPECT_EQ(camera["original"]["setGround"]["succeeded"], 20);
+  EXPECT_LT(camera["original"]["roundTrip"]["maximum"], 0.1);
+
+  ASSERT_TRUE(camera.contains("accelerated"));
+  EXPECT_EQ(camera["accelerated"]["mode"], "InverseDistortionGrid");
+  EXPECT_EQ(camera["accelerated"]["mismatchedPoints"], 0);
+  EXPECT_TRUE(camera["accelerated"]["withinTolerance"]);
+
+  PvlGroup results = appLog.findGroup("Results");
+  EXPECT_PRED_FORMAT2(AssertQStringsEqual, results.findKeyword("From"),
+                      testCube->fileName());
+  EXPECT_TRUE(results.hasKeyword("MaximumAcceleratedDifference"));
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCambenchTolerance) {
+  QString toName = tempDir.path() + "/report.json";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + toName,
+                           "SAMPLES=5", "LINES=5", "TOLERANCE=0.0"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+
+  // The grid interpolates, so it never matches the iterated model exactly
+  EXPECT_THROW(cambench(options, &appLog), IException);
+
+  // The report is still written
+  json report = readReport(toName);
+  EXPECT_FALSE(report["cameras"][0]["accelerated"]["withinTolerance"]);
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCambenchList) {
+  QString listName = tempDir.path() + "/cubes.lis";
+  QString toName = tempDir.path() + "/report.json";
+  std::ofstream list(listName.toStdString());
+  list << testCube->fileName().toStdString() << std::endl;
+  list << (tempDir.path() + "/missing.cub").toStdString() << std::endl;
+  list.close();
+
+  QVector<QString> args = {"FROMLIST=" + listName, "TO=" + toName,
+                           "SAMPLES=2", "LINES=2", "ACCELERATED=false"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+
+  cambench(options, &appLog);
+
+  json report = readReport(toName);
+  ASSERT_EQ(report["cameras"].size(), 2);
+  EXPECT_FALSE(report["cameras"][0].contains("accelerated"));
+  EXPECT_EQ(report["cameras"][0]["original"]["setImage"]["calls"], 4);
+  EXPECT_TRUE(report["cameras"][1].contains("error"));
+}
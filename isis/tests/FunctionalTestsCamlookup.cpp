@@ -0,0 +1,188 @@
+#include <memory>
+#include <sstream>
+
+#include <QString>
+
+#include "cam2map.h"
+#include "camlookup.h"
+#include "Camera.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "GeometryLookup.h"
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "SerialNumber.h"
+#include "Statistics.h"
+#include "TestUtilities.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/camlookup.xml").expanded();
+static QString CAM2MAP_XML = FileName("$ISISROOT/bin/xml/cam2map.xml").expanded();
+
+
+TEST_F(DefaultCube, FunctionalTestCamlookupGrids) {
+  QString toName = tempDir.path() + "/lookup.cub";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + toName, "SPACING=20"};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+
+  camlookup(options, &appLog);
+
+  Cube lookupCube(toName);
+  PvlGroup &group = lookupCube.group("GeometryLookup");
+  EXPECT_EQ(int(group["Samples"]), testCube->sampleCount());
+  EXPECT_EQ(int(group["Lines"]), testCube->lineCount());
+  EXPECT_EQ(int(group["Spacing"]), 20);
+  EXPECT_EQ(QString(group["From"]), FileName(testCube->fileName()).name());
+  EXPECT_EQ(QString(group["SerialNumber"]), SerialNumber::Compose(*testCube));
+  EXPECT_EQ(lookupCube.bandCount(), 3);
+
+  PvlGroup results = appLog.findGroup("Results");
+  EXPECT_EQ(int(results["SampleNodes"]), lookupCube.sampleCount());
+  EXPECT_EQ(int(results["LineNodes"]), lookupCube.lineCount());
+
+  // The lookup agrees with the camera model between the grid nodes
+  GeometryLookup lookup(lookupCube);
+  Camera *cam = testCube->camera();
+  int tested = 0;
+  for (double line = 3.3; line < testCube->lineCount(); line += 97.1) {
+    for (double sample = 5.7; sample < testCube->sampleCount(); sample += 101.3) {
+      if (!cam->SetImage(sample, line)) continue;
+      double lat = cam->UniversalLatitude();
+      double lon = cam->UniversalLongitude();
+
+      ASSERT_TRUE(lookup.SetImage(sample, line));
+      EXPECT_NEAR(lookup.UniversalLatitude(), lat, 1.0e-4);
+      EXPECT_NEAR(lookup.UniversalLongitude(), lon, 1.0e-4);
+      EXPECT_NEAR(lookup.LocalRadius().meters(), cam->LocalRadius().meters(), 1.0);
+
+      ASSERT_TRUE(lookup.SetUniversalGround(lat, lon));
+      EXPECT_NEAR(lookup.Sample(), sample, 0.05);
+      EXPECT_NEAR(lookup.Line(), line, 0.05);
+      tested++;
+    }
+  }
+  EXPECT_GT(tested, 50);
+
+  EXPECT_FALSE(lookup.SetImage(0.0, 10.0));
+  EXPECT_FALSE(lookup.SetUniversalGround(lookup.UniversalLatitude() + 45.0,
+                                         lookup.UniversalLongitude()));
+
+  // The Newton step is singular at the poles
+  EXPECT_FALSE(lookup.SetUniversalGround(90.0, 0.0));
+  EXPECT_FALSE(lookup.SetUniversalGround(-90.0, 180.0));
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCamlookupCam2map) {
+  QString lookupName = tempDir.path() + "/lookup.cub";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + lookupName, "SPACING=8"};
+  UserInterface options(APP_XML, args);
+  camlookup(options);
+
+  std::istringstream labelStrm(R"(
+    Group = Mapping
+      ProjectionName     = Sinusoidal
+      PixelResolution    = 10000 <meters/pixel>
+    End_Group
+  )");
+  Pvl userMap;
+  labelStrm >> userMap;
+  PvlGroup &userGrp = userMap.findGroup("Mapping", Pvl::Traverse);
+  Pvl lookupMap = userMap;
+  PvlGroup &lookupGrp = lookupMap.findGroup("Mapping", Pvl::Traverse);
+
+  QVector<QString> cameraArgs = {"TO=" + tempDir.path() + "/camera.cub", "PIXRES=MAP"};
+  UserInterface cameraUi(CAM2MAP_XML, cameraArgs);
+  Pvl log;
+  cam2map(testCube, userMap, userGrp, cameraUi, &log);
+
+  QVector<QString> lookupArgs = {"TO=" + tempDir.path() + "/lookup2map.cub", "PIXRES=MAP",
+                                 "LOOKUP=" + lookupName};
+  UserInterface lookupUi(CAM2MAP_XML, lookupArgs);
+  cam2map(testCube, lookupMap, lookupGrp, lookupUi, &log);
+
+  // The lookup projection matches the camera projection
+  Cube cameraCube(tempDir.path() + "/camera.cub");
+  Cube lookupCube(tempDir.path() + "/lookup2map.cub");
+  ASSERT_EQ(lookupCube.sampleCount(), cameraCube.sampleCount());
+  ASSERT_EQ(lookupCube.lineCount(), cameraCube.lineCount());
+
+  std::unique_ptr<Statistics> cameraStats(cameraCube.statistics());
+  std::unique_ptr<Statistics> lookupStats(lookupCube.statistics());
+  EXPECT_NEAR(lookupStats->ValidPixels(), cameraStats->ValidPixels(),
+              0.01 * cameraStats->ValidPixels());
+  EXPECT_NEAR(lookupStats->Average(), cameraStats->Average(), 0.5);
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCamlookupMismatch) {
+  QString lookupName = tempDir.path() + "/lookup.cub";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + lookupName};
+  UserInterface options(APP_XML, args);
+  camlookup(options);
+
+  // A lookup cube made from a different image size is rejected
+  resizeCube(20, 20, 1);
+  std::istringstream labelStrm(R"(
+    Group = Mapping
+      ProjectionName     = Sinusoidal
+    End_Group
+  )");
+  Pvl userMap;
+  labelStrm >> userMap;
+  PvlGroup &userGrp = userMap.findGroup("Mapping", Pvl::Traverse);
+
+  QVector<QString> lookupArgs = {"TO=" + tempDir.path() + "/lookup2map.cub",
+                                 "LOOKUP=" + lookupName};
+  UserInterface lookupUi(CAM2MAP_XML, lookupArgs);
+  Pvl log;
+  try {
+    cam2map(testCube, userMap, userGrp, lookupUi, &log);
+    FAIL() << "Expected an exception";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("was made from an image with"));
+  }
+
+  // Cubes that are not lookup cubes are rejected
+  EXPECT_THROW(GeometryLookup lookup(*testCube), IException);
+}
+
+
+TEST_F(DefaultCube, FunctionalTestCamlookupOtherImage) {
+  QString lookupName = tempDir.path() + "/lookup.cub";
+  QVector<QString> args = {"FROM=" + testCube->fileName(), "TO=" + lookupName, "SPACING=64"};
+  UserInterface options(APP_XML, args);
+  camlookup(options);
+
+  // An image of the same size with another serial number is rejected
+  testCube->camera();
+  PvlGroup &inst = testCube->label()->findObject("IsisCube").findGroup("Instrument");
+  inst["SpacecraftClockCount"] = "33322516";
+
+  std::istringstream labelStrm(R"(
+    Group = Mapping
+      ProjectionName     = Sinusoidal
+    End_Group
+  )");
+  Pvl userMap;
+  labelStrm >> userMap;
+  PvlGroup &userGrp = userMap.findGroup("Mapping", Pvl::Traverse);
+
+  QVector<QString> lookupArgs = {"TO=" + tempDir.path() + "/lookup2map.cub",
+                                 "LOOKUP=" + lookupName};
+  UserInterface lookupUi(CAM2MAP_XML, lookupArgs);
+  Pvl log;
+  try {
+    cam2map(testCube, userMap, userGrp, lookupUi, &log);
+    FAIL() << "Expected an exception";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("not from the input cube"));
+  }
+}
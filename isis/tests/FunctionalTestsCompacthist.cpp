@@ -0,0 +1,143 @@
+#include <QFileInfo>
+#include <QString>
+
+#include "compacthist.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "History.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "PvlObject.h"
+#include "Table.h"
+#include "TableField.h"
+#include "TableRecord.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+static QString APP_XML = FileName("$ISISROOT/bin/xml/compacthist.xml").expanded();
+
+TEST_F(SmallCube, FunctionalTestCompacthistDefault) {
+  TableField field("Value", TableField::Double);
+  TableRecord record;
+  record += field;
+  Table table("Values", record);
+  for (int i = 0; i < 10; i++) {
+    record[0] = (double) i;
+    table += record;
+  }
+  testCube->write(table);
+
+  // Append entries to the history, then write it again so the first copy is left behind
+  History history = testCube->readHistory();
+  for (int i = 0; i < 5; i++) {
+    PvlObject entry("step" + QString::number(i));
+    entry += PvlKeyword("Step", QString::number(i));
+    history.AddEntry(entry);
+    testCube->write(history);
+  }
+  History rewritten = testCube->readHistory();
+  PvlObject last("last");
+  rewritten.AddEntry(last);
+  Blob historyBlob = rewritten.toBlob();
+  testCube->write(historyBlob);
+
+  History appended = testCube->readHistory();
+  PvlObject chunked("chunked");
+  appended.AddEntry(chunked);
+  testCube->write(appended);
+  ASSERT_TRUE(testCube->label()->findObject("History").hasKeyword("ChunkBytes"));
+
+  QString path = testCube->fileName();
+  testCube->close();
+  qint64 originalBytes = QFileInfo(path).size();
+
+  QVector<QString> args = {"FROM=" + path};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  compacthist(options, &appLog);
+
+  PvlGroup &results = appLog.findGroup("Results");
+  EXPECT_EQ((int) results["Blobs"], 2);
+  EXPECT_EQ((BigInt) results["OriginalBytes"], originalBytes);
+  EXPECT_LT((BigInt) results["CompactedBytes"], originalBytes);
+  EXPECT_EQ(QFileInfo(path).size(), (BigInt) results["CompactedBytes"]);
+
+  Cube cube;
+  cube.open(path);
+  PvlObject &historyObject = cube.label()->findObject("History");
+  EXPECT_FALSE(historyObject.hasKeyword("ChunkBytes"));
+  EXPECT_FALSE(historyObject.hasKeyword("ChunkStartBytes"));
+
+  Pvl historyPvl = cube.readHistory().ReturnHist();
+  ASSERT_EQ(historyPvl.objects(), 7);
+  EXPECT_EQ(historyPvl.object(0).name(), "step0");
+  EXPECT_EQ(historyPvl.object(5).name(), "last");
+  EXPECT_EQ(historyPvl.object(6).name(), "chunked");
+
+  Table values = cube.readTable("Values");
+  ASSERT_EQ(values.Records(), 10);
+  EXPECT_EQ((double) values[9][0], 9.0);
+}
+
+TEST_F(SmallCube, FunctionalTestCompacthistRewrittenFirstBlob) {
+  // The history written right after the DN data is rewritten at the end of
+  // the file, leaving its old space before the table
+  History history = testCube->readHistory();
+  history.AddEntry(PvlObject("first"));
+  testCube->write(history);
+
+  TableField field("Value", TableField::Double);
+  TableRecord record;
+  record += field;
+  Table table("Values", record);
+  for (int i = 0; i < 10; i++) {
+    record[0] = (double) i;
+    table += record;
+  }
+  testCube->write(table);
+
+  History rewritten = testCube->readHistory();
+  PvlObject second("second");
+  second += PvlKeyword("Step", "2");
+  rewritten.AddEntry(second);
+  Blob historyBlob = rewritten.toBlob();
+  testCube->write(historyBlob);
+
+  BigInt dataEnd = (BigInt) testCube->labelSize() + testCube->dataSize();
+  PvlObject &historyObject = testCube->label()->findObject("History");
+  PvlObject &tableObject = testCube->label()->findObject("Table");
+  ASSERT_GT((BigInt) tableObject["StartByte"], dataEnd + 1);
+  ASSERT_GT((BigInt) historyObject["StartByte"], (BigInt) tableObject["StartByte"]);
+  BigInt blobBytes = (BigInt) historyObject["Bytes"] + (BigInt) tableObject["Bytes"];
+
+  QString path = testCube->fileName();
+  testCube->close();
+
+  QVector<QString> args = {"FROM=" + path};
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  compacthist(options, &appLog);
+
+  PvlGroup &results = appLog.findGroup("Results");
+  EXPECT_EQ((int) results["Blobs"], 2);
+  EXPECT_EQ((BigInt) results["CompactedBytes"], dataEnd + blobBytes);
+  EXPECT_EQ(QFileInfo(path).size(), dataEnd + blobBytes);
+
+  Cube cube;
+  cube.open(path);
+  EXPECT_EQ((BigInt) cube.label()->findObject("Table")["StartByte"], dataEnd + 1);
+  EXPECT_EQ((BigInt) cube.label()->findObject("History")["StartByte"],
+            dataEnd + 1 + (BigInt) cube.label()->findObject("Table")["Bytes"]);
+
+  Pvl historyPvl = cube.readHistory().ReturnHist();
+  ASSERT_EQ(historyPvl.objects(), 2);
+  EXPECT_EQ(historyPvl.object(0).name(), "first");
+  EXPECT_EQ(historyPvl.object(1).name(), "second");
+
+  Table values = cube.readTable("Values");
+  ASSERT_EQ(values.Records(), 10);
+  EXPECT_EQ((double) values[9][0], 9.0);
+}
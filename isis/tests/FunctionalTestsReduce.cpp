@@ -3,6 +3,7 @@
 #include "PvlGroup.h"
 #include "TestUtilities.h"
 #include "Histogram.h"
+#include "LineManager.h"
 
 #include "reduce_app.h"
 
@@ -209,3 +210,72 @@ TEST_F(LargeCube, FunctionalTestReduceError) {
   }
 
 }
+
+TEST_F(LargeCube, FunctionalTestReduceLevels) {
+  QTemporaryDir prefix;
+  QString outCubeFileName = prefix.path() + "/outTemp.cub";
+  QVector<QString> args = {"from=" + testCube->fileName(),
+                            "to=" + outCubeFileName,
+                            "mode=levels",
+                            "levels=2"
+                          };
+
+  UserInterface options(APP_XML, args);
+  Pvl appLog;
+  try {
+    reduce(options, &appLog);
+  }
+  catch (IException &e) {
+    FAIL() << "Unable to open image: " << e.what() << std::endl;
+  }
+
+  ASSERT_EQ(appLog.groups(), 2);
+  EXPECT_EQ((int) appLog.group(0)["Level"], 1);
+  EXPECT_EQ((int) appLog.group(1)["Level"], 2);
+  EXPECT_EQ((int) appLog.group(1)["OutputSamples"], 250);
+
+  Cube half(outCubeFileName);
+  ASSERT_EQ(half.sampleCount(), 500);
+  ASSERT_EQ(half.lineCount(), 500);
+  ASSERT_EQ(half.bandCount(), 10);
+
+  Cube quarter(prefix.path() + "/outTemp.4x.cub");
+  ASSERT_EQ(quarter.sampleCount(), 250);
+  ASSERT_EQ(quarter.lineCount(), 250);
+  ASSERT_EQ(quarter.bandCount(), 10);
+
+  // Every input line holds its line number minus one, so each output line
+  // holds the average line number of its block
+  LineManager line(quarter);
+  line.SetLine(3, 2);
+  quarter.read(line);
+  EXPECT_DOUBLE_EQ(line[0], 1000 + 9.5);
+  EXPECT_DOUBLE_EQ(line[249], 1000 + 9.5);
+
+  std::unique_ptr<Histogram> halfHist (half.histogram());
+  EXPECT_DOUBLE_EQ(halfHist->Average(), 499.5);
+  EXPECT_EQ(halfHist->ValidPixels(), 250000);
+
+  std::unique_ptr<Histogram> quarterHist (quarter.histogram());
+  EXPECT_DOUBLE_EQ(quarterHist->Average(), 499.5);
+  EXPECT_EQ(quarterHist->ValidPixels(), 62500);
+}
+
+TEST_F(LargeCube, FunctionalTestReduceLevelsNearest) {
+  QTemporaryDir prefix;
+  QString outCubeFileName = prefix.path() + "/outTemp.cub";
+  QVector<QString> args = {"from=" + testCube->fileName(),
+                            "to=" + outCubeFileName,
+                            "algorithm=nearest",
+                            "mode=levels"
+                          };
+
+  UserInterface options(APP_XML, args);
+  try{
+    reduce(options);
+    FAIL() << "Should throw an exception" << std::endl;
+  }
+  catch (IException &e){
+    EXPECT_THAT(e.what(), HasSubstr("MODE=LEVELS only supports ALGORITHM=AVERAGE"));
+  }
+}
@@ -0,0 +1,56 @@
+#include "FusedCameraPipeline.h"
+
+#include <vector>
+
+#include "Camera.h"
+#include "Fixtures.h"
+#include "RadialDistortionMap.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+TEST_F(DefaultCube, FusedCameraPipelineMatchesCamera) {
+  PvlGroup &kernels = testCube->label()->findObject("IsisCube").findGroup("Kernels");
+  kernels["ShapeModel"] = "Null";
+  Camera *cam = testCube->camera();
+
+  // The Viking reseau distortion has no fused stage
+  FramingRadialEllipsoidPipeline pipeline;
+  EXPECT_FALSE(pipeline.setUp(cam));
+  EXPECT_FALSE(pipeline.isValid());
+
+  new RadialDistortionMap(cam, -2.5e-5);
+  ASSERT_TRUE(pipeline.setUp(cam));
+
+  std::vector<double> samples, lines;
+  for (double line = -100.5; line <= testCube->lineCount() + 100.0; line += 61.25) {
+    for (double sample = -100.5; sample <= testCube->sampleCount() + 100.0; sample += 73.75) {
+      samples.push_back(sample);
+      lines.push_back(line);
+    }
+  }
+  int count = samples.size();
+  std::vector<double> latitudes(count), longitudes(count), radii(count);
+  int hits = pipeline.mapImage(count, samples.data(), lines.data(),
+                               latitudes.data(), longitudes.data(), radii.data());
+
+  int expectedHits = 0;
+  for (int i = 0; i < count; i++) {
+    if (cam->SetImage(samples[i], lines[i])) {
+      expectedHits++;
+      ASSERT_FALSE(IsSpecial(latitudes[i])) << "at (" << samples[i] << ", " << lines[i] << ")";
+      EXPECT_NEAR(latitudes[i], cam->UniversalLatitude(), 1e-10);
+      EXPECT_NEAR(longitudes[i], cam->UniversalLongitude(), 1e-10);
+      EXPECT_NEAR(radii[i], cam->LocalRadius().meters(), 1e-6);
+    }
+    else {
+      EXPECT_TRUE(IsNullPixel(latitudes[i])) << "at (" << samples[i] << ", " << lines[i] << ")";
+      EXPECT_TRUE(IsNullPixel(longitudes[i]));
+      EXPECT_TRUE(IsNullPixel(radii[i]));
+    }
+  }
+  EXPECT_EQ(hits, expectedHits);
+  EXPECT_GT(hits, 0);
+}
@@ -1,3 +1,4 @@
+#include "Cube.h"
 #include "Fixtures.h"
 #include "History.h"
 
@@ -89,3 +90,97 @@ TEST_F(HistoryBlob, HistoryTeststoBlob) {
   ASSERT_TRUE(newHistoryPvl.hasObject("mroctx2isis"));
   EXPECT_TRUE(newHistoryPvl.findObject("mroctx2isis").hasGroup("UserParameters"));
 }
+
+TEST_F(SmallCube, HistoryTestsAppendToCube) {
+  PvlObject first("first");
+  first += PvlKeyword("Step", "1");
+  PvlObject second("second");
+  second += PvlKeyword("Step", "2");
+  PvlObject third("third");
+  third += PvlKeyword("Step", "3");
+
+  History history = testCube->readHistory();
+  history.AddEntry(first);
+  testCube->write(history);
+  PvlObject &historyObject = testCube->label()->findObject("History");
+  EXPECT_FALSE(historyObject.hasKeyword("ChunkBytes"));
+
+  // Entries added after the history was written are appended
+  history.AddEntry(second);
+  testCube->write(history);
+  ASSERT_TRUE(historyObject.hasKeyword("ChunkBytes"));
+  EXPECT_EQ(historyObject["ChunkBytes"].size(), 1);
+  EXPECT_EQ(historyObject["ChunkStartBytes"].size(), 1);
+
+  History readHistory = testCube->readHistory();
+  readHistory.AddEntry(third);
+  testCube->write(readHistory);
+  EXPECT_EQ(historyObject["ChunkBytes"].size(), 2);
+
+  QString path = testCube->fileName();
+  testCube->close();
+  testCube->open(path, "rw");
+  Pvl historyPvl = testCube->readHistory().ReturnHist();
+  ASSERT_EQ(historyPvl.objects(), 3);
+  EXPECT_EQ(historyPvl.object(0).name(), "first");
+  EXPECT_EQ(historyPvl.object(1).name(), "second");
+  EXPECT_EQ(historyPvl.object(2).name(), "third");
+
+  // The whole history is written again when it was not read from the cube
+  History newHistory;
+  newHistory.AddEntry(first);
+  testCube->write(newHistory);
+  PvlObject &newHistoryObject = testCube->label()->findObject("History");
+  EXPECT_FALSE(newHistoryObject.hasKeyword("ChunkBytes"));
+  EXPECT_FALSE(newHistoryObject.hasKeyword("ChunkStartBytes"));
+  EXPECT_EQ(testCube->readHistory().ReturnHist().objects(), 1);
+}
+
+TEST_F(SmallCube, HistoryTestsAppendConsolidatesChunks) {
+  History history = testCube->readHistory();
+  for (int i = 0; i < 40; i++) {
+    history.AddEntry(PvlObject("step" + QString::number(i)));
+    testCube->write(history);
+    PvlObject &written = testCube->label()->findObject("History");
+    if (written.hasKeyword("ChunkStartBytes")) {
+      EXPECT_LE(written["ChunkStartBytes"].size(), 16);
+    }
+  }
+
+  QString path = testCube->fileName();
+  testCube->close();
+  testCube->open(path, "rw");
+  Pvl historyPvl = testCube->readHistory().ReturnHist();
+  ASSERT_EQ(historyPvl.objects(), 40);
+  EXPECT_EQ(historyPvl.object(0).name(), "step0");
+  EXPECT_EQ(historyPvl.object(39).name(), "step39");
+}
+
+TEST_F(TempTestingFiles, HistoryTestsAppendWithFullLabel) {
+  // Measure the label of a cube with a history, then leave little room for chunks
+  Cube probe;
+  probe.setDimensions(10, 10, 1);
+  probe.create(tempDir.path() + "/probe.cub");
+  History probeHistory = probe.readHistory();
+  probeHistory.AddEntry(PvlObject("step"));
+  probe.write(probeHistory);
+  int labelBytes = probe.labelSize(true) + 100;
+  probe.close();
+
+  Cube cube;
+  cube.setDimensions(10, 10, 1);
+  cube.setLabelSize(labelBytes);
+  cube.create(tempDir.path() + "/tight.cub");
+  History history = cube.readHistory();
+  for (int i = 0; i < 12; i++) {
+    history.AddEntry(PvlObject("step" + QString::number(i)));
+    cube.write(history);
+  }
+  QString path = cube.fileName();
+  EXPECT_NO_THROW(cube.close());
+
+  cube.open(path);
+  Pvl historyPvl = cube.readHistory().ReturnHist();
+  ASSERT_EQ(historyPvl.objects(), 12);
+  EXPECT_EQ(historyPvl.object(11).name(), "step11");
+}
@@ -0,0 +1,73 @@
+#include "ImageExporter.h"
+
+#include <QImage>
+
+#include "CubeAttribute.h"
+#include "ExportDescription.h"
+#include "FileName.h"
+#include "Fixtures.h"
+#include "PngExporter.h"
+#include "QtExporter.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  void exportImage(ImageExporter &exporter, Cube *cube, int channels, QString outputName) {
+    ExportDescription desc;
+    desc.setPixelType(UnsignedByte);
+    for (int band = 1; band <= channels; band++) {
+      CubeAttributeInput att("+" + QString::number(band));
+      desc.addChannel(FileName(cube->fileName()), att, 0.0, 500.0);
+    }
+
+    if (channels == 1) {
+      exporter.setGrayscale(desc);
+    }
+    else if (channels == 3) {
+      exporter.setRgb(desc);
+    }
+    else {
+      exporter.setRgba(desc);
+    }
+    exporter.write(FileName(outputName));
+  }
+}
+
+
+class ImageExporterChannels : public SmallCube, public ::testing::WithParamInterface<int> {};
+
+TEST_P(ImageExporterChannels, PngMatchesQt) {
+  int channels = GetParam();
+  QString streamedName = tempDir.path() + "/streamed.png";
+  QString qtName = tempDir.path() + "/qt.png";
+  // Flush the fixture data so the exporters can open the cube by name
+  testCube->reopen("r");
+
+  PngExporter streamed;
+  exportImage(streamed, testCube, channels, streamedName);
+  QtExporter qt("png");
+  exportImage(qt, testCube, channels, qtName);
+
+  QImage streamedImage(streamedName);
+  QImage qtImage(qtName);
+  ASSERT_EQ(streamedImage.width(), testCube->sampleCount());
+  ASSERT_EQ(streamedImage.height(), testCube->lineCount());
+  ASSERT_EQ(streamedImage.size(), qtImage.size());
+  EXPECT_EQ(streamedImage.hasAlphaChannel(), qtImage.hasAlphaChannel());
+  for (int line = 0; line < qtImage.height(); line++) {
+    for (int samp = 0; samp < qtImage.width(); samp++) {
+      EXPECT_EQ(streamedImage.pixel(samp, line), qtImage.pixel(samp, line));
+    }
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ImageExporter, ImageExporterChannels, ::testing::Values(1, 3, 4));
+
+
+TEST_F(SmallCube, ImageExporterPngFormat) {
+  ImageExporter *exporter = ImageExporter::fromFormat("png");
+  EXPECT_NE(dynamic_cast<PngExporter *>(exporter), nullptr);
+  delete exporter;
+}
@@ -0,0 +1,104 @@
+#include "ImageHistogram.h"
+
+#include <cmath>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "LineManager.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // Histogram of a cube band filled line by line, or every band for band 0
+  ImageHistogram serialHistogram(Cube &cube, int band, double minimum, double maximum) {
+    ImageHistogram hist(minimum, maximum, 65536);
+    LineManager line(cube);
+    for (line.begin(); !line.end(); line++) {
+      if (band == 0 || line.Band() == band) {
+        cube.read(line);
+        hist.AddData(line.DoubleBuffer(), line.size());
+      }
+    }
+    return hist;
+  }
+
+  void expectSameHistogram(const ImageHistogram &actual, const ImageHistogram &expected) {
+    ASSERT_EQ(actual.Bins(), expected.Bins());
+    EXPECT_EQ(actual.BinRangeStart(), expected.BinRangeStart());
+    EXPECT_EQ(actual.BinRangeEnd(), expected.BinRangeEnd());
+    EXPECT_EQ(actual.TotalPixels(), expected.TotalPixels());
+    EXPECT_EQ(actual.ValidPixels(), expected.ValidPixels());
+    EXPECT_EQ(actual.NullPixels(), expected.NullPixels());
+    EXPECT_NEAR(actual.Sum(), expected.Sum(), 1e-9 * std::abs(expected.Sum()));
+    for (int i = 0; i < expected.Bins(); i++) {
+      ASSERT_EQ(actual.BinCount(i), expected.BinCount(i)) << "bin " << i;
+    }
+  }
+
+  // A tall cube so each band is split into several strips, with some Nulls
+  void createTallCube(Cube &cube, QString fileName) {
+    cube.setDimensions(7, 150, 2);
+    cube.create(fileName);
+    LineManager line(cube);
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        line[i] = std::sin(0.1 * (line.Line() * 7 + i)) * 100.0 + line.Band() * 50.0;
+        if ((line.Line() + i) % 23 == 0) line[i] = Isis::Null;
+      }
+      cube.write(line);
+    }
+  }
+}
+
+
+TEST_F(TempTestingFiles, ImageHistogramCubeMatchesSerial) {
+  Cube cube;
+  createTallCube(cube, tempDir.path() + "/tall.cub");
+
+  for (int band = 0; band <= cube.bandCount(); band++) {
+    ImageHistogram parallel(cube, band, NULL, 1.0, 1.0, Null, Null, 0, true);
+    ImageHistogram serial = serialHistogram(cube, band, parallel.BinRangeStart(),
+                                            parallel.BinRangeEnd());
+    EXPECT_DOUBLE_EQ(parallel.BinRangeStart(), serial.Minimum());
+    EXPECT_DOUBLE_EQ(parallel.BinRangeEnd(), serial.Maximum());
+    expectSameHistogram(parallel, serial);
+  }
+}
+
+
+TEST_F(TempTestingFiles, ImageHistogramCubeHistogram) {
+  Cube cube;
+  createTallCube(cube, tempDir.path() + "/tall.cub");
+
+  Histogram *hist = cube.histogram(2);
+  ImageHistogram serial = serialHistogram(cube, 2, hist->BinRangeStart(), hist->BinRangeEnd());
+  expectSameHistogram(*dynamic_cast<ImageHistogram *>(hist), serial);
+  EXPECT_DOUBLE_EQ(hist->Percent(50.0), serial.Percent(50.0));
+  delete hist;
+}
+
+
+TEST_F(SmallCube, ImageHistogramMerge) {
+  ImageHistogram first(0.0, 999.0, 1000);
+  ImageHistogram second(0.0, 999.0, 1000);
+  ImageHistogram whole(0.0, 999.0, 1000);
+  LineManager line(*testCube);
+  for (line.begin(); !line.end(); line++) {
+    testCube->read(line);
+    whole.AddData(line.DoubleBuffer(), line.size());
+    ImageHistogram &part = (line.Band() % 2) ? first : second;
+    part.AddData(line.DoubleBuffer(), line.size());
+  }
+  first.Merge(second);
+  expectSameHistogram(first, whole);
+  EXPECT_DOUBLE_EQ(first.Minimum(), whole.Minimum());
+  EXPECT_DOUBLE_EQ(first.Maximum(), whole.Maximum());
+
+  EXPECT_THROW(first.Merge(ImageHistogram(0.0, 999.0, 10)), IException);
+  EXPECT_THROW(first.Merge(ImageHistogram(0.0, 500.0, 1000)), IException);
+}
@@ -0,0 +1,94 @@
+#include "NaifStatus.h"
+
+#include <thread>
+#include <vector>
+
+#include <SpiceUsr.h>
+
+#include "IException.h"
+#include "iTime.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+
+TEST(NaifStatus, ErrorsStayOnTheirThread) {
+  bool workerThrew = false;
+  std::thread worker([&workerThrew]() {
+    {
+      NaifLock lock;
+      sigerr_c("SPICE(WORKERERROR)");
+    }
+
+    // The error was moved off the NAIF status when the lock was released
+    EXPECT_FALSE(failed_c());
+    try {
+      NaifStatus::CheckErrors();
+    }
+    catch (IException &e) {
+      workerThrew = true;
+      EXPECT_THAT(e.what(), testing::HasSubstr("SPICE(WORKERERROR)"));
+    }
+
+    // The error is reported once
+    NaifStatus::CheckErrors();
+  });
+  worker.join();
+
+  EXPECT_TRUE(workerThrew);
+  NaifStatus::CheckErrors();
+}
+
+
+TEST(NaifStatus, KeepErrorWithoutReset) {
+  {
+    NaifLock lock;
+    sigerr_c("SPICE(KEPTERROR)");
+  }
+
+  EXPECT_THROW(NaifStatus::CheckErrors(false), IException);
+  EXPECT_THROW(NaifStatus::CheckErrors(), IException);
+  NaifStatus::CheckErrors();
+}
+
+
+TEST(NaifStatus, NestedLocks) {
+  {
+    NaifLock outer;
+    {
+      NaifLock inner;
+      sigerr_c("SPICE(NESTEDERROR)");
+    }
+
+    // Still set while the outer lock is held
+    EXPECT_TRUE(failed_c());
+  }
+  EXPECT_THROW(NaifStatus::CheckErrors(), IException);
+}
+
+
+TEST(NaifStatus, ConcurrentTimeConversions) {
+  iTime expected("2000-12-31T23:59:01.6789");
+
+  std::vector<std::thread> workers;
+  std::vector<int> mismatches(4, 0);
+  for (int t = 0; t < 4; t++) {
+    workers.push_back(std::thread([t, &expected, &mismatches]() {
+      for (int i = 0; i < 200; i++) {
+        iTime time("2000-12-31T23:59:01.6789");
+        if (time.Et() != expected.Et() || time.Year() != 2000 || time.DayOfYear() != 366) {
+          mismatches[t]++;
+        }
+        NaifStatus::CheckErrors();
+      }
+    }));
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  for (int count : mismatches) {
+    EXPECT_EQ(count, 0);
+  }
+}
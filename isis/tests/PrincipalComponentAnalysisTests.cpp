@@ -0,0 +1,132 @@
+#include "PrincipalComponentAnalysis.h"
+
+#include <cmath>
+#include <vector>
+
+#include "IException.h"
+#include "MultivariateStatistics.h"
+#include "SpecialPixel.h"
+#include "jama/jama_eig.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  const int bands = 4;
+  const int pixels = 700;
+
+  // Correlated bands, with some Nulls so the pairwise counts differ
+  vector<double> testData() {
+    vector<double> data(bands * pixels);
+    for (int i = 0; i < pixels; i++) {
+      double base = sin(0.05 * i) * 10.0;
+      for (int band = 0; band < bands; band++) {
+        data[band * pixels + i] = base * (band + 1) + cos(0.3 * i * (band + 1)) + band;
+      }
+    }
+    for (int i = 3; i < pixels; i += 17) {
+      data[(i % bands) * pixels + i] = Isis::Null;
+    }
+    return data;
+  }
+}
+
+
+TEST(PrincipalComponentAnalysis, MatchesMultivariateStatistics) {
+  vector<double> data = testData();
+
+  TNT::Array2D<double> correlation(bands, bands);
+  for (int i = 0; i < bands; i++) {
+    for (int j = 0; j < bands; j++) {
+      MultivariateStatistics stats;
+      stats.AddData(&data[pixels * i], &data[pixels * j], pixels);
+      correlation[i][j] = stats.Correlation();
+    }
+  }
+  JAMA::Eigenvalue<double> eigen(correlation);
+  TNT::Array2D<double> eigenvectors;
+  eigen.getV(eigenvectors);
+
+  PrincipalComponentAnalysis pca(bands);
+  pca.AddData(data.data(), pixels);
+  pca.ComputeTransform();
+  TNT::Array2D<double> transform = pca.TransformMatrix();
+  for (int i = 0; i < bands; i++) {
+    for (int j = 0; j < bands; j++) {
+      EXPECT_NEAR(transform[i][j], eigenvectors[i][bands - j - 1], 1e-8);
+    }
+  }
+}
+
+
+TEST(PrincipalComponentAnalysis, Merge) {
+  vector<double> data = testData();
+  PrincipalComponentAnalysis whole(bands);
+  whole.AddData(data.data(), pixels);
+  whole.ComputeTransform();
+
+  // Split the pixels between two objects
+  int first = 300;
+  vector<double> firstData(bands * first);
+  vector<double> secondData(bands * (pixels - first));
+  for (int band = 0; band < bands; band++) {
+    for (int i = 0; i < pixels; i++) {
+      if (i < first) {
+        firstData[band * first + i] = data[band * pixels + i];
+      }
+      else {
+        secondData[band * (pixels - first) + i - first] = data[band * pixels + i];
+      }
+    }
+  }
+  PrincipalComponentAnalysis merged(bands);
+  merged.AddData(firstData.data(), first);
+  PrincipalComponentAnalysis second(bands);
+  second.AddData(secondData.data(), pixels - first);
+  merged.Merge(second);
+  merged.ComputeTransform();
+
+  TNT::Array2D<double> expected = whole.TransformMatrix();
+  TNT::Array2D<double> actual = merged.TransformMatrix();
+  for (int i = 0; i < bands; i++) {
+    for (int j = 0; j < bands; j++) {
+      EXPECT_NEAR(actual[i][j], expected[i][j], 1e-10);
+    }
+  }
+
+  EXPECT_THROW(merged.Merge(PrincipalComponentAnalysis(bands)), IException);
+  EXPECT_THROW(PrincipalComponentAnalysis(bands).Merge(PrincipalComponentAnalysis(bands + 1)),
+               IException);
+}
+
+
+TEST(PrincipalComponentAnalysis, BlockTransform) {
+  vector<double> data = testData();
+  for (unsigned int i = 0; i < data.size(); i++) {
+    if (IsSpecial(data[i])) data[i] = 0.0;
+  }
+
+  PrincipalComponentAnalysis pca(bands);
+  pca.AddData(data.data(), pixels);
+  EXPECT_THROW(pca.Transform(data.data(), data.data(), pixels), IException);
+  pca.ComputeTransform();
+
+  vector<double> components(data.size());
+  vector<double> inverted(data.size());
+  pca.Transform(data.data(), components.data(), pixels);
+  pca.Inverse(components.data(), inverted.data(), pixels);
+
+  for (int i = 0; i < pixels; i++) {
+    TNT::Array2D<double> pixel(1, bands);
+    for (int band = 0; band < bands; band++) {
+      pixel[0][band] = data[band * pixels + i];
+    }
+    TNT::Array2D<double> expected = pca.Transform(pixel);
+    for (int band = 0; band < bands; band++) {
+      EXPECT_DOUBLE_EQ(components[band * pixels + i], expected[0][band]);
+      EXPECT_NEAR(inverted[band * pixels + i], data[band * pixels + i], 1e-9);
+    }
+  }
+}
@@ -0,0 +1,280 @@
+#include "ProcessByBoxcar.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Cube.h"
+#include "CubeAttribute.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "SlidingRank.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  /**
+   * Applies the kernel to the fixture cube once directly and once by FFT and
+   * checks that the outputs match.
+   */
+  void compareKernelPaths(Cube *inputCube, const QString &outputDir,
+                          int samples, int lines, const vector<double> &coefficients,
+                          ProcessByBoxcar::SpecialPixelHandling handling) {
+    QString spatialPath = outputDir + "/spatial.cub";
+    QString fftPath = outputDir + "/fft.cub";
+    CubeAttributeOutput att;
+
+    ProcessByBoxcar spatial;
+    spatial.SetInputCube(inputCube);
+    spatial.SetOutputCube(spatialPath, att, inputCube->sampleCount(),
+                          inputCube->lineCount(), inputCube->bandCount());
+    spatial.SetBoxcarSize(samples, lines);
+    spatial.SetKernel(coefficients, 0.5, handling);
+    spatial.SetFftThreshold(samples * lines);
+    spatial.ProcessCubeKernel();
+    spatial.Finalize();
+
+    ProcessByBoxcar fft;
+    fft.SetInputCube(inputCube);
+    fft.SetOutputCube(fftPath, att, inputCube->sampleCount(),
+                      inputCube->lineCount(), inputCube->bandCount());
+    fft.SetBoxcarSize(samples, lines);
+    fft.SetKernel(coefficients, 0.5, handling);
+    fft.SetFftThreshold(0);
+    EXPECT_FALSE(fft.KernelIsSeparable());
+    fft.ProcessCubeKernel();
+    fft.Finalize();
+
+    Cube spatialCube(spatialPath);
+    Cube fftCube(fftPath);
+    LineManager spatialLine(spatialCube);
+    LineManager fftLine(fftCube);
+    for (spatialLine.begin(), fftLine.begin(); !spatialLine.end(); spatialLine++, fftLine++) {
+      spatialCube.read(spatialLine);
+      fftCube.read(fftLine);
+      for (int i = 0; i < spatialLine.size(); i++) {
+        if (IsSpecial(spatialLine[i])) {
+          EXPECT_EQ(fftLine[i], spatialLine[i]);
+        }
+        else {
+          EXPECT_NEAR(fftLine[i], spatialLine[i], 1e-8);
+        }
+      }
+    }
+  }
+
+
+  vector<double> referenceKernel;
+
+  // The weighted sum kernfilter computed before it used ProcessCubeKernel()
+  void referenceFilter(Buffer &in, double &result) {
+    result = 0.0;
+    for (int i = 0; i < in.size(); i++) {
+      if (IsSpecial(in[i])) {
+        result = Isis::Null;
+        return;
+      }
+      result += in[i] * referenceKernel[i];
+    }
+  }
+
+
+  double rankLow;
+  double rankHigh;
+
+  // Combines the center pixel and the median so both are checked
+  double centerAndMedian(double center, double median) {
+    if (IsSpecial(center)) return center;
+    if (IsSpecial(median)) return Isis::Null;
+    return center * 1000.0 + median;
+  }
+
+  // The median computed by sorting the whole boxcar, as median did before
+  // it used ProcessCubeRank()
+  void referenceMedian(Buffer &in, double &result) {
+    vector<double> boxdata;
+    for (int i = 0; i < in.size(); i++) {
+      if (!IsSpecial(in[i]) && in[i] >= rankLow && in[i] <= rankHigh) {
+        boxdata.push_back(in[i]);
+      }
+    }
+    sort(boxdata.begin(), boxdata.end());
+    double median = boxdata.empty() ? Isis::Null : boxdata[(boxdata.size() - 1) / 2];
+    result = centerAndMedian(in[(in.size() - 1) / 2], median);
+  }
+
+  void rankMedian(double center, const SlidingRank &window, double &result) {
+    result = centerAndMedian(center, window.median());
+  }
+
+  void compareRankPaths(Cube *inputCube, const QString &outputDir, int samples, int lines,
+                        double low, double high) {
+    QString referencePath = outputDir + "/reference.cub";
+    QString rankPath = outputDir + "/rank.cub";
+    CubeAttributeOutput att("+Real");
+    rankLow = low;
+    rankHigh = high;
+
+    ProcessByBoxcar reference;
+    reference.SetInputCube(inputCube);
+    reference.SetOutputCube(referencePath, att, inputCube->sampleCount(),
+                            inputCube->lineCount(), inputCube->bandCount());
+    reference.SetBoxcarSize(samples, lines);
+    reference.StartProcess(referenceMedian);
+    reference.Finalize();
+
+    ProcessByBoxcar rank;
+    rank.SetInputCube(inputCube);
+    rank.SetOutputCube(rankPath, att, inputCube->sampleCount(),
+                       inputCube->lineCount(), inputCube->bandCount());
+    rank.SetBoxcarSize(samples, lines);
+    rank.ProcessCubeRank(rankMedian, low, high);
+    rank.Finalize();
+
+    Cube referenceCube(referencePath);
+    Cube rankCube(rankPath);
+    LineManager referenceLine(referenceCube);
+    LineManager rankLine(rankCube);
+    for (referenceLine.begin(), rankLine.begin(); !referenceLine.end();
+         referenceLine++, rankLine++) {
+      referenceCube.read(referenceLine);
+      rankCube.read(rankLine);
+      for (int i = 0; i < referenceLine.size(); i++) {
+        EXPECT_EQ(rankLine[i], referenceLine[i]);
+      }
+    }
+  }
+
+
+  // Creates a cube whose pixels repeat often enough for a histogram to matter
+  Cube *integerCube(const QString &path, PixelType type) {
+    Cube *cube = new Cube();
+    cube->setDimensions(30, 20, 2);
+    cube->setPixelType(type);
+    cube->create(path);
+
+    LineManager line(*cube);
+    for (line.begin(); !line.end(); line++) {
+      for (int i = 0; i < line.size(); i++) {
+        int value = (i * 7 + line.Line() * 13 + line.Band() * 5) % 97;
+        line[i] = (value == 11) ? Isis::Null : value + 1;
+      }
+      cube->write(line);
+    }
+    cube->reopen("r");
+    return cube;
+  }
+
+
+  vector<double> asymmetricKernel(int samples, int lines) {
+    vector<double> coefficients(samples * lines);
+    for (unsigned int i = 0; i < coefficients.size(); i++) {
+      coefficients[i] = 1.0 + (i % 3) - 0.25 * (i % 5);
+    }
+    return coefficients;
+  }
+}
+
+
+TEST_F(SpecialSmallCube, ProcessByBoxcarKernelFftNullIfAnySpecial) {
+  compareKernelPaths(testCube, tempDir.path(), 5, 3, asymmetricKernel(5, 3),
+                     ProcessByBoxcar::NullIfAnySpecial);
+}
+
+
+TEST_F(SpecialSmallCube, ProcessByBoxcarKernelFftSkipSpecial) {
+  compareKernelPaths(testCube, tempDir.path(), 4, 7, asymmetricKernel(4, 7),
+                     ProcessByBoxcar::SkipSpecial);
+}
+
+
+TEST_F(SpecialSmallCube, ProcessByBoxcarKernelFftRenormalize) {
+  compareKernelPaths(testCube, tempDir.path(), 3, 3, asymmetricKernel(3, 3),
+                     ProcessByBoxcar::Renormalize);
+}
+
+
+TEST_F(SmallCube, ProcessByBoxcarKernelSize) {
+  ProcessByBoxcar p;
+  vector<double> coefficients(9, 1.0);
+  EXPECT_THROW(p.SetKernel(coefficients), IException);
+
+  p.SetBoxcarSize(3, 2);
+  EXPECT_THROW(p.SetKernel(coefficients), IException);
+}
+
+
+TEST_F(SpecialSmallCube, ProcessByBoxcarKernelSeparable) {
+  int samples = 5;
+  int lines = 3;
+  double rowFactors[] = {1.0, -2.0, 3.5, 0.25, 1.0};
+  double columnFactors[] = {0.5, 2.0, -1.0};
+  referenceKernel.resize(samples * lines);
+  for (int l = 0; l < lines; l++) {
+    for (int s = 0; s < samples; s++) {
+      referenceKernel[l * samples + s] = columnFactors[l] * rowFactors[s];
+    }
+  }
+
+  QString referencePath = tempDir.path() + "/reference.cub";
+  QString separablePath = tempDir.path() + "/separable.cub";
+  CubeAttributeOutput att;
+
+  ProcessByBoxcar reference;
+  reference.SetInputCube(testCube);
+  reference.SetOutputCube(referencePath, att, testCube->sampleCount(),
+                          testCube->lineCount(), testCube->bandCount());
+  reference.SetBoxcarSize(samples, lines);
+  reference.StartProcess(referenceFilter);
+  reference.Finalize();
+
+  ProcessByBoxcar separable;
+  separable.SetInputCube(testCube);
+  separable.SetOutputCube(separablePath, att, testCube->sampleCount(),
+                          testCube->lineCount(), testCube->bandCount());
+  separable.SetBoxcarSize(samples, lines);
+  separable.SetKernel(referenceKernel, 1.0, ProcessByBoxcar::NullIfAnySpecial);
+  EXPECT_TRUE(separable.KernelIsSeparable());
+  separable.ProcessCubeKernel();
+  separable.Finalize();
+
+  Cube referenceCube(referencePath);
+  Cube separableCube(separablePath);
+  LineManager referenceLine(referenceCube);
+  LineManager separableLine(separableCube);
+  for (referenceLine.begin(), separableLine.begin(); !referenceLine.end();
+       referenceLine++, separableLine++) {
+    referenceCube.read(referenceLine);
+    separableCube.read(separableLine);
+    for (int i = 0; i < referenceLine.size(); i++) {
+      if (IsSpecial(referenceLine[i])) {
+        EXPECT_EQ(separableLine[i], referenceLine[i]);
+      }
+      else {
+        EXPECT_NEAR(separableLine[i], referenceLine[i], 1e-8);
+      }
+    }
+  }
+}
+
+
+TEST_F(SpecialSmallCube, ProcessByBoxcarRankSorted) {
+  compareRankPaths(testCube, tempDir.path(), 4, 3, 50.0, 600.0);
+}
+
+
+TEST_F(TempTestingFiles, ProcessByBoxcarRankByteHistogram) {
+  Cube *cube = integerCube(tempDir.path() + "/byte.cub", UnsignedByte);
+  compareRankPaths(cube, tempDir.path(), 5, 5, -DBL_MAX, DBL_MAX);
+  delete cube;
+}
+
+
+TEST_F(TempTestingFiles, ProcessByBoxcarRankWordHistogram) {
+  Cube *cube = integerCube(tempDir.path() + "/word.cub", SignedWord);
+  compareRankPaths(cube, tempDir.path(), 9, 8, 10.0, 80.0);
+  delete cube;
+}
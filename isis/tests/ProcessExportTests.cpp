@@ -0,0 +1,102 @@
+#include "ProcessExport.h"
+
+#include <fstream>
+#include <vector>
+
+#include <QByteArray>
+#include <QCryptographicHash>
+#include <QFile>
+
+#include "Cube.h"
+#include "Endian.h"
+#include "Fixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  // SmallCube pixel values in the file order of an export format
+  vector<double> smallCubeValues(ProcessExport::ExportFormat format) {
+    vector<double> values;
+    for (int outer = 0; outer < 10; outer++) {
+      for (int middle = 0; middle < 10; middle++) {
+        for (int inner = 0; inner < 10; inner++) {
+          int band = outer, line = middle, sample = inner;
+          if (format == ProcessExport::BIL) {
+            line = outer;
+            band = middle;
+          }
+          else if (format == ProcessExport::BIP) {
+            line = outer;
+            sample = middle;
+            band = inner;
+          }
+          values.push_back(band * 100 + line * 10 + sample);
+        }
+      }
+    }
+    return values;
+  }
+}
+
+
+class ProcessExportFormat : public SmallCube,
+                            public ::testing::WithParamInterface<ProcessExport::ExportFormat> {};
+
+TEST_P(ProcessExportFormat, StreamWordsMsb) {
+  QString outputName = tempDir.path() + "/export.raw";
+  ProcessExport p;
+  p.SetInputCube(testCube);
+  p.SetOutputType(SignedWord);
+  p.SetOutputEndian(Msb);
+  p.setFormat(GetParam());
+  p.setCanGenerateChecksum(true);
+
+  ofstream fout(outputName.toLatin1().data(), ios::out | ios::binary);
+  p.StartProcess(fout);
+  fout.close();
+
+  QFile output(outputName);
+  ASSERT_TRUE(output.open(QIODevice::ReadOnly));
+  QByteArray data = output.readAll();
+  vector<double> expected = smallCubeValues(GetParam());
+  ASSERT_EQ(data.size(), (int) expected.size() * 2);
+
+  QByteArray checksumData;
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    short value = (short) (((unsigned char) data[2 * i] << 8) | (unsigned char) data[2 * i + 1]);
+    EXPECT_EQ(value, expected[i]);
+    checksumData.append((char) expected[i]);
+  }
+  EXPECT_EQ(p.checksum(),
+            QString(QCryptographicHash::hash(checksumData, QCryptographicHash::Md5).toHex()));
+}
+
+TEST_P(ProcessExportFormat, StreamReal) {
+  QString outputName = tempDir.path() + "/export.raw";
+  ProcessExport p;
+  p.SetInputCube(testCube);
+  p.setFormat(GetParam());
+
+  ofstream fout(outputName.toLatin1().data(), ios::out | ios::binary);
+  p.StartProcess(fout);
+  fout.close();
+
+  QFile output(outputName);
+  ASSERT_TRUE(output.open(QIODevice::ReadOnly));
+  QByteArray data = output.readAll();
+  vector<double> expected = smallCubeValues(GetParam());
+  ASSERT_EQ(data.size(), (int) (expected.size() * sizeof(float)));
+
+  const float *values = (const float *) data.constData();
+  for (unsigned int i = 0; i < expected.size(); i++) {
+    EXPECT_EQ(values[i], expected[i]);
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(ProcessExport, ProcessExportFormat,
+                         ::testing::Values(ProcessExport::BSQ, ProcessExport::BIL,
+                                           ProcessExport::BIP));
+
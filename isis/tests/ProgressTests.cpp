@@ -0,0 +1,89 @@
+#include <QFuture>
+#include <QVector>
+#include <QtConcurrentMap>
+
+#include "IException.h"
+#include "Preference.h"
+#include "Progress.h"
+#include "PvlGroup.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+class ProgressOutput : public ::testing::Test {
+  protected:
+    PvlGroup userInterface;
+
+    void SetUp() override {
+      PvlGroup &group = Preference::Preferences().findGroup("UserInterface");
+      userInterface = group;
+      group["ProgressBar"] = "On";
+      group["ProgressBarPercent"] = "10";
+    }
+
+    void TearDown() override {
+      Preference::Preferences().findGroup("UserInterface") = userInterface;
+    }
+};
+
+
+TEST_F(ProgressOutput, CompletedStepsMatchCheckStatus) {
+  Progress checked;
+  checked.SetText("Working");
+  checked.SetMaximumSteps(1000);
+  testing::internal::CaptureStdout();
+  checked.CheckStatus();
+  for (int step = 1; step <= 1000; step++) {
+    checked.CheckStatus();
+  }
+  std::string checkedOutput = testing::internal::GetCapturedStdout();
+
+  // Steps recorded on worker threads report the same percentages
+  Progress recorded;
+  recorded.SetText("Working");
+  recorded.SetMaximumSteps(1000);
+  QVector<int> steps(1000);
+  testing::internal::CaptureStdout();
+  recorded.CheckStatus();
+  QFuture<void> future = QtConcurrent::map(steps, [&recorded](int &) {
+    recorded.AddCompletedSteps();
+  });
+  recorded.WaitForFinished(future);
+  std::string recordedOutput = testing::internal::GetCapturedStdout();
+
+  EXPECT_EQ(recordedOutput, checkedOutput);
+  EXPECT_THAT(recordedOutput, testing::HasSubstr("100% Processed"));
+  EXPECT_EQ(recorded.CurrentStep(), checked.CurrentStep());
+}
+
+
+TEST_F(ProgressOutput, ReportCompletedSteps) {
+  Progress progress;
+  progress.SetMaximumSteps(10);
+
+  testing::internal::CaptureStdout();
+  progress.ReportCompletedSteps();
+  EXPECT_EQ(progress.CurrentStep(), 1);
+
+  progress.AddCompletedSteps(4);
+  progress.ReportCompletedSteps();
+  EXPECT_EQ(progress.CurrentStep(), 5);
+  std::string output = testing::internal::GetCapturedStdout();
+  EXPECT_THAT(output, testing::HasSubstr("40% Processed"));
+  EXPECT_THAT(output, testing::Not(testing::HasSubstr("50% Processed")));
+
+  // Nothing new to report
+  progress.ReportCompletedSteps();
+  EXPECT_EQ(progress.CurrentStep(), 5);
+
+  progress.AddCompletedSteps(7);
+  EXPECT_THROW(progress.ReportCompletedSteps(), IException);
+
+  // Setting the maximum steps starts the count again
+  progress.SetMaximumSteps(2);
+  progress.AddCompletedSteps(2);
+  testing::internal::CaptureStdout();
+  progress.ReportCompletedSteps();
+  EXPECT_THAT(testing::internal::GetCapturedStdout(), testing::HasSubstr("100% Processed"));
+}
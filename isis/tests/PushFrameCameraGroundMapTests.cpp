@@ -0,0 +1,68 @@
+#include "PushFrameCameraGroundMap.h"
+
+#include <vector>
+
+#include "Camera.h"
+#include "Cube.h"
+#include "PvlGroup.h"
+#include "PvlObject.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // Opens the MARCI push frame test cube on the ellipsoid
+  Camera *openCamera(Cube &cube) {
+    cube.open("data/marcical/K14_059003_3475_MA_00N112W_cropped.cub");
+    cube.label()->findObject("IsisCube").findGroup("Kernels")["ShapeModel"] = "Null";
+    return cube.camera();
+  }
+}
+
+
+TEST(PushFrameCameraGroundMap, CachedFrameletPositions) {
+  Cube cube;
+  Camera *cam = openCamera(cube);
+  ASSERT_EQ(cam->GetCameraType(), Camera::PushFrame);
+  ASSERT_NE(dynamic_cast<PushFrameCameraGroundMap *>(cam->GroundMap()), nullptr);
+
+  std::vector<double> latitudes, longitudes, samples, lines;
+  for (double line = 1.5; line <= cube.lineCount(); line += 2.75) {
+    for (double sample = 1.25; sample <= cube.sampleCount(); sample += 3.5) {
+      if (cam->SetImage(sample, line)) {
+        latitudes.push_back(cam->UniversalLatitude());
+        longitudes.push_back(cam->UniversalLongitude());
+        samples.push_back(sample);
+        lines.push_back(line);
+      }
+    }
+  }
+  ASSERT_GT(latitudes.size(), 4u);
+
+  // The first search fills the framelet position cache
+  std::vector<double> groundSamples, groundLines;
+  for (size_t i = 0; i < latitudes.size(); i++) {
+    ASSERT_TRUE(cam->SetUniversalGround(latitudes[i], longitudes[i]));
+    EXPECT_NEAR(cam->Sample(), samples[i], 0.1);
+    EXPECT_NEAR(cam->Line(), lines[i], 0.1);
+    groundSamples.push_back(cam->Sample());
+    groundLines.push_back(cam->Line());
+  }
+
+  // Searching again from the cache, in another order, gives the same pixels
+  for (size_t i = latitudes.size(); i-- > 0;) {
+    ASSERT_TRUE(cam->SetUniversalGround(latitudes[i], longitudes[i]));
+    EXPECT_NEAR(cam->Sample(), groundSamples[i], 1e-9);
+    EXPECT_NEAR(cam->Line(), groundLines[i], 1e-9);
+  }
+
+  // So does a camera whose cache is empty
+  for (size_t i = 0; i < latitudes.size(); i += 2) {
+    Cube fresh;
+    Camera *freshCam = openCamera(fresh);
+    ASSERT_TRUE(freshCam->SetUniversalGround(latitudes[i], longitudes[i]));
+    EXPECT_NEAR(freshCam->Sample(), groundSamples[i], 1e-9);
+    EXPECT_NEAR(freshCam->Line(), groundLines[i], 1e-9);
+  }
+}
@@ -0,0 +1,168 @@
+#include <fstream>
+#include <sstream>
+
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+
+#include "IException.h"
+#include "Pvl.h"
+#include "PvlToPvlTranslationManager.h"
+#include "PvlTranslationTable.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  const char *TRANSLATION_TABLE = R"(
+    Group = SpacecraftName
+      Auto
+      InputKey       = MISSION_NAME
+      InputPosition  = ROOT
+      InputDefault   = UNKNOWN
+      OutputName     = SpacecraftName
+      OutputPosition = (Group, Instrument)
+      Translation    = (Mars_Global_Surveyor, "MARS GLOBAL SURVEYOR")
+      Translation    = (Unknown, UNKNOWN)
+    EndGroup
+
+    Group = Filter_Name
+      InputKey       = FILTER_NAME
+      InputPosition  = (IMAGE, FILTER)
+      InputPosition  = IMAGE
+      Translation    = (Red, RED)
+      Translation    = (Other, *)
+      Translation    = (Blue, BLUE)
+    EndGroup
+
+    Group = StartTime
+      Auto
+      Optional
+      InputKey       = START_TIME
+      InputKey       = IMAGE_TIME
+      OutputName     = StartTime
+      OutputPosition = (Group, Instrument)
+      Translation    = (*, *)
+    EndGroup
+    End
+  )";
+}
+
+
+TEST(PvlTranslationTable, CompiledLookups) {
+  std::istringstream tableStream(TRANSLATION_TABLE);
+  PvlTranslationTable table(tableStream);
+
+  // Group names match the way Pvl compares names
+  EXPECT_EQ(table.InputKeywordName("SPACECRAFT_NAME"), "MISSION_NAME");
+  EXPECT_EQ(table.InputKeywordName("FilterName"), "FILTER_NAME");
+
+  EXPECT_EQ(table.Translate("SpacecraftName", "mars global surveyor"), "Mars_Global_Surveyor");
+  EXPECT_EQ(table.Translate("SpacecraftName"), "Unknown");
+  EXPECT_THROW(table.Translate("SpacecraftName", "VIKING"), IException);
+  EXPECT_THROW(table.Translate("NotInTable", "VIKING"), IException);
+
+  // The first matching Translation wins, including the wildcard
+  EXPECT_EQ(table.Translate("FilterName", "red"), "Red");
+  EXPECT_EQ(table.Translate("FilterName", "BLUE"), "Other");
+  EXPECT_EQ(table.Translate("StartTime", "2003-01-01"), "2003-01-01");
+
+  EXPECT_EQ(table.InputGroup("FilterName", 0)[1], "FILTER");
+  EXPECT_EQ(table.InputGroup("FilterName", 1)[0], "IMAGE");
+  EXPECT_EQ(table.InputGroup("FilterName", 2).name(), "");
+  EXPECT_EQ(table.InputGroup("StartTime")[0], "ROOT");
+}
+
+
+TEST(PvlTranslationTable, AutoTranslation) {
+  std::istringstream tableStream(TRANSLATION_TABLE);
+  std::istringstream labelStream(R"(
+    MISSION_NAME = "MARS GLOBAL SURVEYOR"
+    IMAGE_TIME   = 2003-01-01T00:00:00
+    End
+  )");
+  Pvl inputLabel;
+  labelStream >> inputLabel;
+
+  PvlToPvlTranslationManager translator(inputLabel, tableStream);
+  Pvl outputLabel;
+  translator.Auto(outputLabel);
+
+  PvlGroup &instrument = outputLabel.findGroup("Instrument");
+  EXPECT_EQ(instrument["SpacecraftName"][0], "Mars_Global_Surveyor");
+  EXPECT_EQ(instrument["StartTime"][0], "2003-01-01T00:00:00");
+}
+
+
+TEST(PvlTranslationTable, SharedTranslationFiles) {
+  QTemporaryDir tempDir;
+  QString fileName = tempDir.path() + "/table.trn";
+  {
+    std::ofstream file(fileName.toStdString());
+    file << TRANSLATION_TABLE;
+  }
+
+  PvlTranslationTable first{FileName(fileName)};
+  PvlTranslationTable second{FileName(fileName)};
+  EXPECT_EQ(first.Translate("FilterName", "RED"), "Red");
+  EXPECT_EQ(second.Translate("FilterName", "RED"), "Red");
+
+  // A changed translation file is read again
+  {
+    std::ofstream file(fileName.toStdString());
+    file << "Group = FilterName\n"
+            "  InputKey    = FILTER_NAME\n"
+            "  Translation = (Green, RED)\n"
+            "  Translation = (Red, RED_FILTER)\n"
+            "EndGroup\n"
+            "End\n";
+  }
+  PvlTranslationTable changed{FileName(fileName)};
+  EXPECT_EQ(changed.Translate("FilterName", "RED"), "Green");
+  EXPECT_THROW(changed.Translate("SpacecraftName", "UNKNOWN"), IException);
+
+  // Tables read from several files combine their groups
+  std::istringstream tableStream(TRANSLATION_TABLE);
+  PvlTranslationTable combined(tableStream);
+  combined.AddTable(fileName);
+  EXPECT_EQ(combined.Translate("SpacecraftName"), "Unknown");
+  EXPECT_EQ(combined.Translate("FilterName", "RED"), "Red");
+}
+
+
+TEST(PvlTranslationTable, RewrittenTranslationFile) {
+  QTemporaryDir tempDir;
+  QString fileName = tempDir.path() + "/table.trn";
+  {
+    std::ofstream file(fileName.toStdString());
+    file << "Group = FilterName\n"
+            "  InputKey    = FILTER_NAME\n"
+            "  Translation = (Green, RED)\n"
+            "EndGroup\n"
+            "End\n";
+  }
+  QDateTime modified = QFileInfo(fileName).lastModified();
+
+  PvlTranslationTable first{FileName(fileName)};
+  EXPECT_EQ(first.Translate("FilterName", "RED"), "Green");
+
+  // Rewrite the file with the same size and modification time
+  {
+    std::ofstream file(fileName.toStdString());
+    file << "Group = FilterName\n"
+            "  InputKey    = FILTER_NAME\n"
+            "  Translation = (Brown, RED)\n"
+            "EndGroup\n"
+            "End\n";
+  }
+  QFile file(fileName);
+  ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+  ASSERT_TRUE(file.setFileTime(modified, QFileDevice::FileModificationTime));
+  file.close();
+  ASSERT_EQ(QFileInfo(fileName).lastModified(), modified);
+
+  PvlTranslationTable rewritten{FileName(fileName)};
+  EXPECT_EQ(rewritten.Translate("FilterName", "RED"), "Brown");
+}
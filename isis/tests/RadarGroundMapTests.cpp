@@ -0,0 +1,57 @@
+#include "RadarGroundMap.h"
+
+#include <vector>
+
+#include "Camera.h"
+#include "Fixtures.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  struct GroundPoint {
+    double sample;
+    double line;
+    double lat;
+    double lon;
+  };
+}
+
+
+TEST_F(MiniRFCube, RadarGroundMapSetGround) {
+  Camera *cam = testCube->camera();
+
+  std::vector<GroundPoint> points;
+  for (int line = 1; line <= cam->Lines(); line++) {
+    for (int sample = 1; sample <= cam->Samples(); sample++) {
+      ASSERT_TRUE(cam->SetImage(sample, line));
+      GroundPoint point = {(double) sample, (double) line,
+                           cam->UniversalLatitude(), cam->UniversalLongitude()};
+      points.push_back(point);
+    }
+  }
+
+  // Map the points back in image order, where each search starts next to the
+  // previous point
+  std::vector<double> samples;
+  std::vector<double> lines;
+  for (const GroundPoint &point : points) {
+    ASSERT_TRUE(cam->SetUniversalGround(point.lat, point.lon));
+    EXPECT_NEAR(cam->Sample(), point.sample, 0.1);
+    EXPECT_NEAR(cam->Line(), point.line, 0.1);
+    samples.push_back(cam->Sample());
+    lines.push_back(cam->Line());
+  }
+
+  // The search bounds the same line from any starting point, so visiting the
+  // points in reverse order gives identical results
+  for (int i = points.size() - 1; i >= 0; i--) {
+    ASSERT_TRUE(cam->SetUniversalGround(points[i].lat, points[i].lon));
+    EXPECT_DOUBLE_EQ(cam->Sample(), samples[i]);
+    EXPECT_DOUBLE_EQ(cam->Line(), lines[i]);
+  }
+
+  // The antipode is not seen from the spacecraft
+  EXPECT_FALSE(cam->SetUniversalGround(-points[0].lat, points[0].lon + 180.0));
+}
@@ -0,0 +1,219 @@
+#include "Reduce.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "Brick.h"
+#include "Cube.h"
+#include "Fixtures.h"
+#include "LineManager.h"
+#include "ProcessByLine.h"
+#include "SpecialPixel.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  // Average of the valid pixels in a block of the cube, or Null if too few are valid
+  double blockAverage(Cube *cube, int sample, int line, int band, int size, double validPer) {
+    Brick block(size, size, 1, cube->pixelType());
+    block.SetBasePosition(sample, line, band);
+    cube->read(block);
+
+    double sum = 0.0;
+    double count = 0.0;
+    for (int i = 0; i < block.size(); i++) {
+      if (IsValidPixel(block[i])) {
+        sum += block[i];
+        count++;
+      }
+    }
+    return (count > size * size * validPer) ? sum / count : Isis::Null;
+  }
+
+  double pixel(Cube *cube, int sample, int line, int band) {
+    Brick brick(1, 1, 1, cube->pixelType());
+    brick.SetBasePosition(sample, line, band);
+    cube->read(brick);
+    return brick[0];
+  }
+
+  // Length of the overlap of input pixel index (0-based, covering [index, index + 1])
+  // with the range [start, end]
+  double overlap(int index, double start, double end) {
+    return max(0.0, min(end, index + 1.0) - max(start, (double) index));
+  }
+}
+
+
+TEST_F(SmallCube, ReduceAverageLevels) {
+  Cube half;
+  half.setDimensions(5, 5, 10);
+  half.create(tempDir.path() + "/half.cub");
+  Cube quarter;
+  quarter.setDimensions(3, 3, 10);
+  quarter.create(tempDir.path() + "/quarter.cub");
+
+  vector<Cube *> levels;
+  levels.push_back(&half);
+  levels.push_back(&quarter);
+  Reduce::averageLevels(testCube, levels, 0.5);
+
+  for (unsigned int level = 0; level < levels.size(); level++) {
+    int size = 2 << level;
+    LineManager line(*levels[level]);
+    for (line.begin(); !line.end(); line++) {
+      levels[level]->read(line);
+      for (int i = 0; i < line.size(); i++) {
+        double expected = blockAverage(testCube, i * size + 1, (line.Line() - 1) * size + 1,
+                                       line.Band(), size, 0.5);
+        if (IsSpecial(expected)) {
+          EXPECT_EQ(line[i], expected);
+        }
+        else {
+          EXPECT_DOUBLE_EQ(line[i], expected);
+        }
+      }
+    }
+  }
+
+  // The last row and column of the quarter level only cover 4 of 16 pixels
+  Brick corner(1, 1, 1, quarter.pixelType());
+  corner.SetBasePosition(3, 3, 1);
+  quarter.read(corner);
+  EXPECT_EQ(corner[0], Isis::Null);
+}
+
+
+TEST_F(SmallCube, ReduceAverageLevelsBadSize) {
+  Cube half;
+  half.setDimensions(4, 5, 10);
+  half.create(tempDir.path() + "/half.cub");
+
+  vector<Cube *> levels;
+  levels.push_back(&half);
+  EXPECT_THROW(Reduce::averageLevels(testCube, levels, 0.5), IException);
+}
+
+
+TEST_F(SmallCube, ReduceAverageThreaded) {
+  ProcessByLine p;
+  p.SetOutputCube(tempDir.path() + "/average.cub", CubeAttributeOutput(), 5, 5, 10);
+  Average average(testCube, 2.0, 2.0, 0.5, "NULL");
+  p.ProcessCubeInPlace(average, true);
+  p.Finalize();
+
+  Cube output(tempDir.path() + "/average.cub");
+  LineManager line(output);
+  for (line.begin(); !line.end(); line++) {
+    output.read(line);
+    for (int i = 0; i < line.size(); i++) {
+      EXPECT_DOUBLE_EQ(line[i], blockAverage(testCube, i * 2 + 1, (line.Line() - 1) * 2 + 1,
+                                             line.Band(), 2, 0.5));
+    }
+  }
+}
+
+
+TEST_F(SmallCube, ReduceNearestThreaded) {
+  ProcessByLine p;
+  p.SetOutputCube(tempDir.path() + "/nearest.cub", CubeAttributeOutput(), 3, 4, 10);
+  Nearest nearest(testCube, 3.0, 2.5);
+  p.ProcessCubeInPlace(nearest, true);
+  p.Finalize();
+
+  Cube output(tempDir.path() + "/nearest.cub");
+  LineManager line(output);
+  for (line.begin(); !line.end(); line++) {
+    output.read(line);
+    int inputLine = (int)(1.0 + (line.Line() - 1) * 2.5 + 0.5);
+    for (int i = 0; i < line.size(); i++) {
+      EXPECT_EQ(line[i], pixel(testCube, i * 3 + 1, inputLine, line.Band()));
+    }
+  }
+}
+
+
+TEST_F(SmallCube, ReduceAverageNonIntegerScale) {
+  double sampleScale = 2.5;
+  double lineScale = 1.6;
+  ProcessByLine p;
+  p.SetOutputCube(tempDir.path() + "/average.cub", CubeAttributeOutput(), 4, 6, 10);
+  Average average(testCube, sampleScale, lineScale, 0.5, "NULL");
+  p.ProcessCubeInPlace(average, true);
+  p.Finalize();
+
+  // Each output pixel is the area weighted average of the input pixels under it
+  Cube output(tempDir.path() + "/average.cub");
+  LineManager line(output);
+  for (line.begin(); !line.end(); line++) {
+    output.read(line);
+    double lineStart = (line.Line() - 1) * lineScale;
+    double lineEnd = line.Line() * lineScale;
+    for (int i = 0; i < line.size(); i++) {
+      double sampleStart = i * sampleScale;
+      double sampleEnd = (i == line.size() - 1) ? testCube->sampleCount() : (i + 1) * sampleScale;
+      double sum = 0.0;
+      double weights = 0.0;
+      for (int l = 0; l < testCube->lineCount(); l++) {
+        for (int s = 0; s < testCube->sampleCount(); s++) {
+          double weight = overlap(s, sampleStart, sampleEnd) * overlap(l, lineStart, lineEnd);
+          if (weight > 0.0) {
+            sum += weight * pixel(testCube, s + 1, l + 1, line.Band());
+            weights += weight;
+          }
+        }
+      }
+      EXPECT_NEAR(line[i], sum / weights, 1e-9);
+    }
+  }
+}
+
+
+TEST_F(SmallCube, ReduceSubAreaOfBand) {
+  QString path = testCube->fileName();
+  testCube->close();
+
+  // Reduce a sub-area of band 4 only
+  Cube input;
+  QList<QString> bands;
+  bands.append("4");
+  input.setVirtualBands(bands);
+  input.open(path);
+
+  ProcessByLine averageProcess;
+  averageProcess.SetOutputCube(tempDir.path() + "/average.cub", CubeAttributeOutput(), 3, 4, 1);
+  Average average(&input, 2.0, 2.0, 0.5, "NULL");
+  average.setInputBoundary(3, 8, 1, 8);
+  averageProcess.ProcessCubeInPlace(average, true);
+  averageProcess.Finalize();
+
+  ProcessByLine nearestProcess;
+  nearestProcess.SetOutputCube(tempDir.path() + "/nearest.cub", CubeAttributeOutput(), 3, 4, 1);
+  Nearest nearest(&input, 2.0, 2.0);
+  nearest.setInputBoundary(3, 8, 2, 9);
+  nearestProcess.ProcessCubeInPlace(nearest, true);
+  nearestProcess.Finalize();
+
+  Cube averageOutput(tempDir.path() + "/average.cub");
+  Cube nearestOutput(tempDir.path() + "/nearest.cub");
+  ASSERT_EQ(averageOutput.bandCount(), 1);
+  LineManager averageLine(averageOutput);
+  LineManager nearestLine(nearestOutput);
+  for (int oline = 1; oline <= 4; oline++) {
+    averageLine.SetLine(oline);
+    averageOutput.read(averageLine);
+    nearestLine.SetLine(oline);
+    nearestOutput.read(nearestLine);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_DOUBLE_EQ(averageLine[i],
+                       blockAverage(&input, 3 + i * 2, 1 + (oline - 1) * 2, 1, 2, 0.5));
+      EXPECT_EQ(nearestLine[i], pixel(&input, 3 + i * 2, 2 + (oline - 1) * 2, 1));
+    }
+  }
+
+  // Band 1 of the input is band 4 of the cube
+  EXPECT_EQ(pixel(&input, 3, 2, 1), 3 * 100 + 1 * 10 + 2);
+}
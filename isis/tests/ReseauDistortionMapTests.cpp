@@ -0,0 +1,134 @@
+#include "ReseauDistortionMap.h"
+
+#include <float.h>
+#include <vector>
+
+#include "Cube.h"
+#include "IString.h"
+#include "Pvl.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+
+namespace {
+  // The closest reseaus found by measuring the distance to every reseau
+  void bruteForceNearest(const std::vector<double> &samples, const std::vector<double> &lines,
+                         double sample, double line, int count,
+                         int *closest, double *distances) {
+    std::vector<double> all(samples.size());
+    for (size_t i = 0; i < samples.size(); i++) {
+      double sdiffsq = (sample - samples[i]) * (sample - samples[i]);
+      double ldiffsq = (line - lines[i]) * (line - lines[i]);
+      all[i] = ldiffsq + sdiffsq;
+    }
+    for (int k = 0; k < count; k++) {
+      int imin = 0;
+      for (size_t i = 0; i < all.size(); i++) {
+        if (all[i] < all[imin]) imin = i;
+      }
+      closest[k] = imin;
+      distances[k] = all[imin];
+      all[imin] = DBL_MAX;
+    }
+  }
+
+  void expectSameAsBruteForce(const ReseauDistortionMap::ReseauGrid &grid,
+                              const std::vector<double> &samples,
+                              const std::vector<double> &lines,
+                              double sample, double line) {
+    int closest[5], expectedClosest[5];
+    double distances[5], expectedDistances[5];
+    grid.nearest(sample, line, 5, closest, distances);
+    bruteForceNearest(samples, lines, sample, line, 5, expectedClosest, expectedDistances);
+    for (int k = 0; k < 5; k++) {
+      EXPECT_EQ(closest[k], expectedClosest[k]) << "at (" << sample << ", " << line << ")";
+      EXPECT_EQ(distances[k], expectedDistances[k]) << "at (" << sample << ", " << line << ")";
+    }
+  }
+}
+
+
+TEST(ReseauDistortionMap, ReseauGridMatchesBruteForce) {
+  Cube cube("data/vikingThemisNetwork/F857a32.lev1_slo_crop.cub");
+  PvlGroup &reseaus = cube.label()->findGroup("Reseaus", Pvl::Traverse);
+  PvlKeyword &lineKey = reseaus["Line"];
+  PvlKeyword &sampleKey = reseaus["Sample"];
+  ASSERT_EQ(lineKey.size(), sampleKey.size());
+  ASSERT_GT(lineKey.size(), 5);
+
+  std::vector<double> samples, lines;
+  for (int i = 0; i < lineKey.size(); i++) {
+    samples.push_back(toDouble(sampleKey[i]));
+    lines.push_back(toDouble(lineKey[i]));
+  }
+
+  ReseauDistortionMap::ReseauGrid grid;
+  grid.build(samples, lines);
+
+  // Points over and around the image
+  for (double line = -200.0; line <= 1300.0; line += 37.5) {
+    for (double sample = -200.0; sample <= 1400.0; sample += 41.25) {
+      expectSameAsBruteForce(grid, samples, lines, sample, line);
+    }
+  }
+
+  // On the reseaus themselves and far off the grid
+  for (size_t i = 0; i < samples.size(); i++) {
+    expectSameAsBruteForce(grid, samples, lines, samples[i], lines[i]);
+  }
+  expectSameAsBruteForce(grid, samples, lines, -1.0e5, -1.0e5);
+  expectSameAsBruteForce(grid, samples, lines, 1.0e5, 600.0);
+  expectSameAsBruteForce(grid, samples, lines, 500.0, -1.0e5);
+}
+
+
+TEST(ReseauDistortionMap, ReseauGridTies) {
+  // A square lattice with a repeated reseau, so many points are equidistant
+  std::vector<double> samples, lines;
+  for (int line = 0; line < 9; line++) {
+    for (int sample = 0; sample < 11; sample++) {
+      samples.push_back(100.0 * sample);
+      lines.push_back(100.0 * line);
+    }
+  }
+  samples.push_back(500.0);
+  lines.push_back(400.0);
+
+  ReseauDistortionMap::ReseauGrid grid;
+  grid.build(samples, lines);
+
+  // Lattice points, cell centers and edge midpoints are all tied with others
+  for (double line = -150.0; line <= 950.0; line += 50.0) {
+    for (double sample = -150.0; sample <= 1150.0; sample += 50.0) {
+      expectSameAsBruteForce(grid, samples, lines, sample, line);
+    }
+  }
+  expectSameAsBruteForce(grid, samples, lines, 500.0, -1.0e4);
+  expectSameAsBruteForce(grid, samples, lines, -1.0e4, -1.0e4);
+}
+
+
+TEST(ReseauDistortionMap, ReseauGridTooFewReseaus) {
+  std::vector<double> samples = {10.0, 20.0, 10.0};
+  std::vector<double> lines = {10.0, 10.0, 10.0};
+
+  ReseauDistortionMap::ReseauGrid grid;
+  grid.build(samples, lines);
+
+  int closest[5];
+  double distances[5];
+  grid.nearest(12.0, 10.0, 5, closest, distances);
+  EXPECT_EQ(closest[0], 0);
+  EXPECT_EQ(closest[1], 2);
+  EXPECT_EQ(closest[2], 1);
+  EXPECT_EQ(distances[0], 4.0);
+  EXPECT_EQ(distances[1], 4.0);
+  EXPECT_EQ(distances[2], 64.0);
+  EXPECT_EQ(closest[3], 0);
+  EXPECT_EQ(distances[3], DBL_MAX);
+  EXPECT_EQ(closest[4], 0);
+  EXPECT_EQ(distances[4], DBL_MAX);
+}
@@ -0,0 +1,103 @@
+#include <fstream>
+
+#include <QString>
+
+#include <nlohmann/json.hpp>
+
+#include "FileName.h"
+#include "Fixtures.h"
+#include "IException.h"
+#include "ObservationNumber.h"
+#include "Preference.h"
+#include "PvlGroup.h"
+#include "PvlKeyword.h"
+#include "SerialNumber.h"
+#include "SerialNumberList.h"
+
+#include "gmock/gmock.h"
+
+using namespace Isis;
+using json = nlohmann::json;
+
+namespace {
+  QString writeList(const QString &listName, const QStringList &files) {
+    std::ofstream list(listName.toStdString());
+    for (const QString &file : files) {
+      list << file.toStdString() << std::endl;
+    }
+    return listName;
+  }
+
+  void setCache(const QString &cacheName) {
+    PvlGroup &performance = Preference::Preferences().findGroup("Performance");
+    performance.addKeyword(PvlKeyword("SerialNumberCache", cacheName), Pvl::Replace);
+  }
+}
+
+
+TEST_F(DefaultCube, SerialNumberListMatchesCompose) {
+  QString serialNumber = SerialNumber::Compose(*testCube);
+  QString observationNumber = ObservationNumber::Compose(*testCube);
+  QString fileName = testCube->fileName();
+  testCube->close();
+
+  SerialNumberList list(writeList(tempDir.path() + "/cubes.lis", {fileName}));
+  ASSERT_EQ(list.size(), 1);
+  EXPECT_EQ(list.serialNumber(0), serialNumber);
+  EXPECT_EQ(list.observationNumber(0), observationNumber);
+  EXPECT_EQ(list.fileName(0), FileName(fileName).expanded());
+
+  SerialNumberList single;
+  single.add(fileName);
+  EXPECT_EQ(single.serialNumber(0), serialNumber);
+  EXPECT_EQ(single.spacecraftInstrumentId(0), list.spacecraftInstrumentId(0));
+
+  // Errors are reported in list order
+  QString missing = tempDir.path() + "/missing.cub";
+  EXPECT_THROW(SerialNumberList(writeList(tempDir.path() + "/missing.lis", {fileName, missing})),
+               IException);
+  try {
+    SerialNumberList(writeList(tempDir.path() + "/duplicate.lis", {fileName, fileName}));
+    FAIL() << "Expected an exception";
+  }
+  catch (IException &e) {
+    EXPECT_THAT(e.what(), testing::HasSubstr("Duplicate serial number"));
+  }
+}
+
+
+TEST_F(DefaultCube, SerialNumberListCache) {
+  QString serialNumber = SerialNumber::Compose(*testCube);
+  QString fileName = testCube->fileName();
+  testCube->close();
+  QString listName = writeList(tempDir.path() + "/cubes.lis", {fileName});
+
+  QString cacheName = tempDir.path() + "/serialnumbers.json";
+  setCache(cacheName);
+  SerialNumberList first(listName);
+  EXPECT_EQ(first.serialNumber(0), serialNumber);
+
+  std::ifstream input(cacheName.toStdString());
+  json cache = json::parse(input);
+  std::string key = FileName(fileName).expanded().toStdString();
+  ASSERT_TRUE(cache.contains(key));
+  EXPECT_EQ(cache[key]["serialNumber"], serialNumber.toStdString());
+
+  // Cached serial numbers are used while the cube is unchanged
+  cache[key]["serialNumber"] = "CACHED/SERIAL";
+  QString editedName = tempDir.path() + "/edited.json";
+  std::ofstream(editedName.toStdString()) << cache.dump();
+  setCache(editedName);
+  SerialNumberList cached(listName);
+  EXPECT_EQ(cached.serialNumber(0), "CACHED/SERIAL");
+
+  // and composed again when its size or modification time changes
+  cache[key]["modified"] = 0;
+  QString staleName = tempDir.path() + "/stale.json";
+  std::ofstream(staleName.toStdString()) << cache.dump();
+  setCache(staleName);
+  SerialNumberList stale(listName);
+  EXPECT_EQ(stale.serialNumber(0), serialNumber);
+
+  setCache("None");
+}
@@ -0,0 +1,114 @@
+#include "SlidingRank.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <cstdlib>
+#include <vector>
+
+#include "SpecialPixel.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  // Adds and removes pseudo random pixels, checking every rank against a sorted copy
+  void checkRanks(SlidingRank &window, double base, double multiplier, int rawValues) {
+    vector<double> expected;
+    vector<double> added;
+    srand(42);
+    for (int step = 0; step < 2000; step++) {
+      bool remove = !added.empty() && (rand() % 3 == 0);
+      if (remove) {
+        int index = rand() % added.size();
+        double value = added[index];
+        added.erase(added.begin() + index);
+        window.remove(value);
+        if (!IsSpecial(value)) {
+          expected.erase(find(expected.begin(), expected.end(), value));
+        }
+      }
+      else {
+        double value = (rand() % 10 == 0) ? Isis::Null :
+                       (rand() % rawValues) * multiplier + base;
+        added.push_back(value);
+        window.add(value);
+        if (!IsSpecial(value)) {
+          expected.insert(upper_bound(expected.begin(), expected.end(), value), value);
+        }
+      }
+
+      ASSERT_EQ(window.count(), (int) expected.size());
+      for (unsigned int k = 0; k < expected.size(); k++) {
+        EXPECT_EQ(window.rank(k), expected[k]);
+      }
+      EXPECT_EQ(window.median(), expected.empty() ? Isis::Null : expected[(expected.size() - 1) / 2]);
+    }
+  }
+}
+
+
+TEST(SlidingRank, ByteHistogram) {
+  SlidingRank window(UnsignedByte, 10.0, 0.5, 9, -DBL_MAX, DBL_MAX);
+  EXPECT_TRUE(window.usesHistogram());
+  checkRanks(window, 10.0, 0.5, 256);
+}
+
+
+TEST(SlidingRank, WordHistogram) {
+  SlidingRank window(SignedWord, -3.0, 2.0, 225, -DBL_MAX, DBL_MAX);
+  EXPECT_TRUE(window.usesHistogram());
+  checkRanks(window, -3.0, 2.0, 30000);
+}
+
+
+TEST(SlidingRank, SortedWindow) {
+  SlidingRank smallWord(SignedWord, 0.0, 1.0, 9, -DBL_MAX, DBL_MAX);
+  EXPECT_FALSE(smallWord.usesHistogram());
+
+  SlidingRank window(Real, 0.0, 1.0, 49, -DBL_MAX, DBL_MAX);
+  EXPECT_FALSE(window.usesHistogram());
+  checkRanks(window, 0.25, 0.125, 300);
+}
+
+
+TEST(SlidingRank, Range) {
+  SlidingRank window(UnsignedByte, 0.0, 1.0, 9, 3.0, 5.0);
+  for (int value = 1; value <= 7; value++) {
+    window.add(value);
+  }
+  window.add(Isis::Hrs);
+  EXPECT_EQ(window.count(), 3);
+  EXPECT_EQ(window.median(), 4.0);
+  EXPECT_EQ(window.rank(3), Isis::Null);
+
+  window.remove(1.0);
+  window.remove(3.0);
+  EXPECT_EQ(window.count(), 2);
+  EXPECT_EQ(window.rank(0), 4.0);
+
+  window.clear();
+  EXPECT_EQ(window.count(), 0);
+  EXPECT_EQ(window.median(), Isis::Null);
+}
+
+
+TEST(SlidingRank, DistinctValues) {
+  double values[] = {4.0, 1.5, 4.0, 9.0, 1.5, 4.0};
+  SlidingRank histogram(UnsignedByte, 0.0, 0.5, 6, -DBL_MAX, DBL_MAX);
+  SlidingRank sorted(Real, 0.0, 1.0, 6, -DBL_MAX, DBL_MAX);
+  histogram.add(values, 6);
+  sorted.add(values, 6);
+
+  for (SlidingRank *window : {&histogram, &sorted}) {
+    vector<double> distinct;
+    vector<int> counts;
+    window->forEachValue([&](double value, int count) {
+      distinct.push_back(value);
+      counts.push_back(count);
+    });
+    EXPECT_EQ(distinct, vector<double>({1.5, 4.0, 9.0}));
+    EXPECT_EQ(counts, vector<int>({2, 3, 1}));
+  }
+}
@@ -817,3 +817,41 @@ TEST(SpiceRotation, WrapAngle) {
   EXPECT_NEAR(rot.WrapAngle(Isis::PI / 6.0, Isis::PI / 2.0),
               Isis::PI / 2.0, testTolerance);
 }
+
+TEST(SpiceRotation, EulerAnglesMatchNaif) {
+  int sequences[12][3] = {{1, 2, 1}, {1, 2, 3}, {1, 3, 1}, {1, 3, 2},
+                          {2, 1, 2}, {2, 1, 3}, {2, 3, 1}, {2, 3, 2},
+                          {3, 1, 2}, {3, 1, 3}, {3, 2, 1}, {3, 2, 3}};
+  for (int sequence = 0; sequence < 12; sequence++) {
+    int axis3 = sequences[sequence][0];
+    int axis2 = sequences[sequence][1];
+    int axis1 = sequences[sequence][2];
+
+    for (int i = 0; i < 50; i++) {
+      double angle3 = 3.1 * sin(1.3 * i);
+      double angle1 = 3.1 * cos(0.7 * i);
+      double angle2 = (axis3 == axis1) ? 1.5 + 1.5 * sin(0.9 * i) : 1.5 * sin(0.9 * i);
+
+      double naifMatrix[3][3];
+      eul2m_c(angle3, angle2, angle1, axis3, axis2, axis1, naifMatrix);
+      double matrix[9];
+      SpiceRotation::eulerToMatrix(angle3, angle2, angle1, axis3, axis2, axis1, matrix);
+      for (int index = 0; index < 9; index++) {
+        EXPECT_NEAR(matrix[index], naifMatrix[index / 3][index % 3], 1.0e-14);
+      }
+
+      SpiceDouble naifAngle3, naifAngle2, naifAngle1;
+      m2eul_c(naifMatrix, axis3, axis2, axis1, &naifAngle3, &naifAngle2, &naifAngle1);
+      double decomposed3, decomposed2, decomposed1;
+      SpiceRotation::matrixToEuler(matrix, axis3, axis2, axis1,
+                                   decomposed3, decomposed2, decomposed1);
+      EXPECT_NEAR(decomposed3, naifAngle3, 1.0e-10);
+      EXPECT_NEAR(decomposed2, naifAngle2, 1.0e-10);
+      EXPECT_NEAR(decomposed1, naifAngle1, 1.0e-10);
+    }
+  }
+
+  double matrix[9];
+  EXPECT_THROW(SpiceRotation::eulerToMatrix(0.1, 0.2, 0.3, 3, 3, 1, matrix), IException);
+  EXPECT_THROW(SpiceRotation::eulerToMatrix(0.1, 0.2, 0.3, 3, 1, 4, matrix), IException);
+}
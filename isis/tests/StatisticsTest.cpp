@@ -269,3 +269,35 @@ TEST(Statistics,XMLReadWrite) {
     EXPECT_STREQ(removedData.text().toStdString().c_str(), "No");
 
 }
+
+
+TEST(Statistics, Merge) {
+    double data[] = {10.0, Isis::Null, 30.0, Isis::Hrs, -5.0, 250.0, Isis::Lis, 42.0, 7.5};
+    int count = sizeof(data) / sizeof(data[0]);
+
+    Statistics whole;
+    whole.SetValidRange(-1.0, 100.0);
+    whole.AddData(data, count);
+
+    Statistics merged;
+    merged.SetValidRange(-1.0, 100.0);
+    merged.AddData(data, 4);
+    Statistics second;
+    second.SetValidRange(-1.0, 100.0);
+    second.AddData(&data[4], count - 4);
+    merged.Merge(second);
+
+    EXPECT_DOUBLE_EQ(merged.Sum(), whole.Sum());
+    EXPECT_DOUBLE_EQ(merged.SumSquare(), whole.SumSquare());
+    EXPECT_DOUBLE_EQ(merged.Minimum(), whole.Minimum());
+    EXPECT_DOUBLE_EQ(merged.Maximum(), whole.Maximum());
+    EXPECT_EQ(merged.TotalPixels(), whole.TotalPixels());
+    EXPECT_EQ(merged.ValidPixels(), whole.ValidPixels());
+    EXPECT_EQ(merged.NullPixels(), whole.NullPixels());
+    EXPECT_EQ(merged.HrsPixels(), whole.HrsPixels());
+    EXPECT_EQ(merged.LisPixels(), whole.LisPixels());
+    EXPECT_EQ(merged.OverRangePixels(), whole.OverRangePixels());
+    EXPECT_EQ(merged.UnderRangePixels(), whole.UnderRangePixels());
+
+    EXPECT_THROW(merged.Merge(Statistics()), IException);
+}
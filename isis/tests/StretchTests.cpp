@@ -0,0 +1,119 @@
+#include "Stretch.h"
+
+#include <vector>
+
+#include "SpecialPixel.h"
+
+#include <gtest/gtest.h>
+
+using namespace Isis;
+using namespace std;
+
+namespace {
+  Stretch testStretch() {
+    Stretch stretch;
+    stretch.AddPair(-100.0, 0.0);
+    stretch.AddPair(12.5, 40.0);
+    stretch.AddPair(900.0, 255.0);
+    stretch.SetNull(0.0);
+    stretch.SetLis(1.0);
+    stretch.SetHrs(254.0);
+    stretch.SetMinimum(0.0);
+    stretch.SetMaximum(255.0);
+    return stretch;
+  }
+}
+
+
+TEST(Stretch, WordLookupMatchesMap) {
+  Stretch stretch = testStretch();
+  double base = -5.0;
+  double multiplier = 0.25;
+  stretch.CompileLookup(SignedWord, base, multiplier);
+  ASSERT_TRUE(stretch.HasLookup());
+
+  vector<double> input;
+  for (int raw = -32768; raw <= 32767; raw += 7) {
+    input.push_back((double) raw * multiplier + base);
+  }
+  // Values no word cube can hold fall back to the exact mapping
+  input.push_back(3.1);
+  input.push_back(1.0e6);
+  input.push_back(Isis::Null);
+  input.push_back(Isis::Lis);
+  input.push_back(Isis::Hrs);
+
+  vector<double> output(input.size());
+  stretch.Map(input.data(), output.data(), input.size());
+  for (unsigned int i = 0; i < input.size(); i++) {
+    EXPECT_EQ(output[i], stretch.Map(input[i]));
+  }
+}
+
+
+TEST(Stretch, ByteLookupInPlace) {
+  Stretch stretch = testStretch();
+  stretch.CompileLookup(UnsignedByte, 0.0, 2.0);
+
+  vector<double> values;
+  for (int raw = 0; raw <= 255; raw++) {
+    values.push_back(2.0 * raw);
+  }
+  vector<double> expected(values.size());
+  for (unsigned int i = 0; i < values.size(); i++) {
+    expected[i] = stretch.Map(values[i]);
+  }
+
+  stretch.Map(values.data(), values.data(), values.size());
+  for (unsigned int i = 0; i < values.size(); i++) {
+    EXPECT_EQ(values[i], expected[i]);
+  }
+}
+
+
+TEST(Stretch, LookupClearedByChanges) {
+  Stretch stretch = testStretch();
+  stretch.CompileLookup(UnsignedByte);
+  EXPECT_TRUE(stretch.HasLookup());
+  stretch.SetNull(5.0);
+  EXPECT_FALSE(stretch.HasLookup());
+
+  stretch.CompileLookup(UnsignedByte);
+  stretch.AddPair(1000.0, 255.0);
+  EXPECT_FALSE(stretch.HasLookup());
+
+  stretch.CompileLookup(UnsignedByte);
+  stretch.ClearPairs();
+  EXPECT_FALSE(stretch.HasLookup());
+
+  stretch.CompileLookup(Real);
+  EXPECT_FALSE(stretch.HasLookup());
+}
+
+
+TEST(Stretch, QuantizedLookup) {
+  Stretch stretch = testStretch();
+  stretch.CompileQuantizedLookup(-1000.0, 1000.0, 4097);
+  ASSERT_TRUE(stretch.HasLookup());
+
+  vector<double> input;
+  for (double value = -200.0; value <= 1000.0; value += 0.37) {
+    input.push_back(value);
+  }
+  input.push_back(Isis::Null);
+  input.push_back(Isis::Lis);
+
+  // Only the interpolation across the middle pair can differ from the stretch
+  double step = (900.0 + 100.0) / 4096;
+  double tolerance = step * (40.0 / 112.5);
+  vector<double> output(input.size());
+  stretch.Map(input.data(), output.data(), input.size());
+  for (unsigned int i = 0; i < input.size(); i++) {
+    if (IsSpecial(input[i]) || input[i] < -100.0 || input[i] > 900.0) {
+      EXPECT_EQ(output[i], stretch.Map(input[i]));
+    }
+    else {
+      EXPECT_NEAR(output[i], stretch.Map(input[i]), tolerance);
+    }
+  }
+}